@@ -0,0 +1,209 @@
+// Measures MdbxLogger storage layouts: database size of legacy (v1) and
+// compact (v2) record rows, the cost of secondary indexes in write time and
+// database size (write amplification), and query time for level, file and
+// session filters with and without the indexes (query speedup).
+
+#include <logit.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t k_default_records = 200000;
+constexpr std::size_t k_file_count = 50;
+constexpr std::size_t k_error_every = 100;
+constexpr int k_query_repeats = 5;
+constexpr uint64_t k_writer_session_id = 42;
+
+std::size_t get_env_size_t(const char* name, std::size_t def) {
+    if (const char* v = std::getenv(name)) {
+        try {
+            return static_cast<std::size_t>(std::stoull(v));
+        } catch (...) {
+            // fallthrough
+        }
+    }
+    return def;
+}
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string make_file_name(std::size_t index) {
+    return "src/module_" + std::to_string(index % k_file_count) + "/Source.cpp";
+}
+
+void remove_db(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    std::filesystem::remove(path + "-lck", ec);
+}
+
+struct WriteResult {
+    double write_ms = 0.0;
+    std::uintmax_t db_bytes = 0;
+};
+
+logit::MdbxLogger::Config make_config(const std::string& path, bool is_indexed) {
+    logit::MdbxLogger::Config config;
+    config.path = path;
+    config.async = true;
+    config.drop_on_overflow = false;
+    config.index_by_level = is_indexed;
+    config.index_by_file = is_indexed;
+    config.index_by_session = is_indexed;
+    return config;
+}
+
+WriteResult write_records(const std::string& path, bool is_indexed, std::size_t records, uint32_t schema_version) {
+    remove_db(path);
+    // File names must outlive the records; LogRecord keeps raw pointers.
+    std::vector<std::string> files;
+    for (std::size_t i = 0; i < k_file_count; ++i) {
+        files.push_back(make_file_name(i));
+    }
+
+    WriteResult result;
+    {
+        logit::MdbxLogger::Config config = make_config(path, is_indexed);
+        config.session_id = k_writer_session_id;
+        config.record_schema_version = schema_version;
+        logit::MdbxLogger logger(config);
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < records; ++i) {
+            const logit::LogLevel level = i % k_error_every == 0
+                ? logit::LogLevel::LOG_LVL_ERROR
+                : logit::LogLevel::LOG_LVL_INFO;
+            logit::LogRecord record(level, 1000000 + static_cast<int64_t>(i),
+                                    files[i % k_file_count].c_str(), static_cast<int>(i), "write_records",
+                                    "", "", -1, false);
+            logger.log(record, "order " + std::to_string(i) + " accepted: symbol=BTCUSDT side=BUY qty=0.010");
+        }
+        logger.wait();
+        result.write_ms = elapsed_ms(start);
+        logger.shutdown();
+    }
+    std::error_code ec;
+    const std::uintmax_t bytes = std::filesystem::file_size(path, ec);
+    result.db_bytes = ec ? 0 : bytes;
+    return result;
+}
+
+double time_query(const std::function<std::size_t()>& run, std::size_t& matches) {
+    double best_ms = 0.0;
+    for (int i = 0; i < k_query_repeats; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        matches = run();
+        const double ms = elapsed_ms(start);
+        if (i == 0 || ms < best_ms) best_ms = ms;
+    }
+    return best_ms;
+}
+
+// Returns false when the plain and indexed databases disagree on the matches.
+bool report_query(const char* name, logit::MdbxLogger& plain, logit::MdbxLogger& indexed,
+                  const std::function<std::size_t(logit::MdbxLogger&)>& run) {
+    std::size_t plain_matches = 0;
+    std::size_t indexed_matches = 0;
+    const double plain_ms = time_query([&]() { return run(plain); }, plain_matches);
+    const double indexed_ms = time_query([&]() { return run(indexed); }, indexed_matches);
+    std::cout << std::left << std::setw(24) << name
+              << " matches=" << std::setw(8) << indexed_matches
+              << " scan_ms=" << std::setw(10) << plain_ms
+              << " index_ms=" << std::setw(10) << indexed_ms
+              << " speedup=" << (indexed_ms > 0.0 ? plain_ms / indexed_ms : 0.0) << "x";
+    if (plain_matches != indexed_matches) {
+        std::cout << " MISMATCH scan_matches=" << plain_matches;
+    }
+    std::cout << std::endl;
+    return plain_matches == indexed_matches;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t records = get_env_size_t("LOGIT_MDBX_BENCH_RECORDS", k_default_records);
+    const std::string dir = logit::get_exec_dir();
+    const std::string plain_path = dir + "/mdbx_index_bench_plain.mdbx";
+    const std::string indexed_path = dir + "/mdbx_index_bench_indexed.mdbx";
+    const std::string legacy_path = dir + "/mdbx_index_bench_legacy.mdbx";
+
+    const WriteResult legacy_write = write_records(legacy_path, false, records, 1);
+    remove_db(legacy_path);
+    const WriteResult plain_write = write_records(plain_path, false, records, 2);
+    const WriteResult indexed_write = write_records(indexed_path, true, records, 2);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "records=" << records << std::endl;
+    std::cout << "rows legacy_ms=" << legacy_write.write_ms
+              << " compact_ms=" << plain_write.write_ms
+              << " legacy_bytes=" << legacy_write.db_bytes
+              << " compact_bytes=" << plain_write.db_bytes
+              << " size_ratio="
+              << (legacy_write.db_bytes > 0
+                  ? static_cast<double>(plain_write.db_bytes) / static_cast<double>(legacy_write.db_bytes)
+                  : 0.0)
+              << std::endl;
+    std::cout << "write plain_ms=" << plain_write.write_ms
+              << " indexed_ms=" << indexed_write.write_ms
+              << " time_ratio=" << (plain_write.write_ms > 0.0 ? indexed_write.write_ms / plain_write.write_ms : 0.0)
+              << std::endl;
+    std::cout << "size plain_bytes=" << plain_write.db_bytes
+              << " indexed_bytes=" << indexed_write.db_bytes
+              << " write_amplification="
+              << (plain_write.db_bytes > 0
+                  ? static_cast<double>(indexed_write.db_bytes) / static_cast<double>(plain_write.db_bytes)
+                  : 0.0)
+              << std::endl;
+
+    bool is_consistent = true;
+    {
+        logit::MdbxLogger::Config plain_config = make_config(plain_path, false);
+        plain_config.async = false;
+        logit::MdbxLogger::Config indexed_config = make_config(indexed_path, true);
+        indexed_config.async = false;
+        logit::MdbxLogger plain(plain_config);
+        logit::MdbxLogger indexed(indexed_config);
+
+        logit::LogQuery errors;
+        errors.min_level = logit::LogLevel::LOG_LVL_ERROR;
+        is_consistent &= report_query("count level>=ERROR", plain, indexed,
+                     [&errors](logit::MdbxLogger& logger) { return logger.count(errors); });
+        is_consistent &= report_query("query level>=ERROR", plain, indexed,
+                     [&errors](logit::MdbxLogger& logger) { return logger.query(errors).size(); });
+
+        logit::LogQuery by_file;
+        by_file.file = make_file_name(7);
+        is_consistent &= report_query("query file", plain, indexed,
+                     [&by_file](logit::MdbxLogger& logger) { return logger.query(by_file).size(); });
+
+        logit::LogQuery last_errors = errors;
+        last_errors.limit = 10;
+        last_errors.order = logit::LogReadOrder::Descending;
+        is_consistent &= report_query("newest 10 ERROR", plain, indexed,
+                     [&last_errors](logit::MdbxLogger& logger) { return logger.query(last_errors).size(); });
+
+        logit::LogQuery session_tail;
+        session_tail.limit = 100;
+        session_tail.order = logit::LogReadOrder::Descending;
+        is_consistent &= report_query("newest 100 of session", plain, indexed, [&session_tail](logit::MdbxLogger& logger) {
+            return logger.query_session(k_writer_session_id, session_tail).size();
+        });
+
+        plain.shutdown();
+        indexed.shutdown();
+    }
+
+    remove_db(plain_path);
+    remove_db(indexed_path);
+    return is_consistent ? 0 : 1;
+}
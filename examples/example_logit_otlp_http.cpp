@@ -26,6 +26,9 @@ int main() {
     config.format.service_namespace = "examples";
     config.format.service_instance_id = "local-dev";
     config.format.deployment_environment = env_or("LOGIT_ENVIRONMENT", "dev");
+    if (env_or("LOGIT_OTLP_PROTOCOL", "http/json") == "http/protobuf") {
+        config.format.encoding = logit::OtlpEncoding::Protobuf;
+    }
     config.max_queue_size = 1024;
     config.max_batch_size = 64;
     config.max_in_flight_requests = 2;
@@ -342,6 +342,95 @@ namespace logit {
             return strategy->logger->read_log_files(paths);
         }
 
+        /// \brief Reads a chunk of a persisted log file into a caller-provided buffer.
+        /// \param logger_index Index of logger.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Offset of the first byte to read.
+        /// \param buffer Destination buffer.
+        /// \param capacity Size of `buffer` in bytes.
+        /// \return Chunk result with `ok=false` when unavailable or unsupported.
+        LogFileChunkResult read_log_file_chunk(
+                int logger_index,
+                const std::string& path,
+                uint64_t offset,
+                char* buffer,
+                std::size_t capacity) const {
+            auto strategy = m_shutdown ? nullptr : get_strategy_snapshot(logger_index);
+            if (!strategy) {
+                LogFileChunkResult result;
+                result.file.path = path;
+                result.offset = offset;
+                result.next_offset = offset;
+                result.ok = false;
+                return result;
+            }
+
+            return strategy->logger->read_log_file_chunk(path, offset, buffer, capacity);
+        }
+
+        /// \brief Reads a byte range of a persisted log file.
+        /// \param logger_index Index of logger.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Offset in the uncompressed content.
+        /// \param length Maximum number of bytes to read.
+        /// \return Read result with `ok=false` when unavailable or unsupported.
+        LogFileReadResult read_log_file_range(
+                int logger_index,
+                const std::string& path,
+                uint64_t offset,
+                uint64_t length) const {
+            auto strategy = m_shutdown ? nullptr : get_strategy_snapshot(logger_index);
+            if (!strategy) {
+                LogFileReadResult result;
+                result.file.path = path;
+                result.ok = false;
+                return result;
+            }
+
+            return strategy->logger->read_log_file_range(path, offset, length);
+        }
+
+        /// \brief Iterates over the lines of a persisted log file from the last one backwards.
+        /// \param logger_index Index of logger.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param callback Receives each line; return false to stop.
+        /// \return True when the file was read.
+        bool for_each_log_file_line_reverse(
+                int logger_index,
+                const std::string& path,
+                const std::function<bool(const std::string&)>& callback) const {
+            auto strategy = m_shutdown ? nullptr : get_strategy_snapshot(logger_index);
+            if (!strategy) return false;
+            return strategy->logger->for_each_log_file_line_reverse(path, callback);
+        }
+
+        /// \brief Waits until a persisted log file has readable content beyond `offset`.
+        /// \param logger_index Index of logger.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Content size the caller has already consumed.
+        /// \param timeout_ms Maximum time to wait in milliseconds.
+        /// \return True when new data is readable, false on timeout or when unsupported.
+        bool wait_log_file_data(
+                int logger_index,
+                const std::string& path,
+                uint64_t offset,
+                int64_t timeout_ms) const {
+            auto strategy = m_shutdown ? nullptr : get_strategy_snapshot(logger_index);
+            if (!strategy) return false;
+            return strategy->logger->wait_log_file_data(path, offset, timeout_ms);
+        }
+
+        /// \brief Reads the persisted log content written in a time range.
+        /// \param logger_index Index of logger.
+        /// \param from_ms Start of the range in milliseconds (inclusive).
+        /// \param to_ms End of the range in milliseconds (inclusive).
+        /// \return Per-file slices ordered from the oldest file, or an empty vector when unsupported.
+        std::vector<LogFileReadResult> read_log_range(int logger_index, int64_t from_ms, int64_t to_ms) const {
+            auto strategy = m_shutdown ? nullptr : get_strategy_snapshot(logger_index);
+            if (!strategy) return std::vector<LogFileReadResult>();
+            return strategy->logger->read_log_range(from_ms, to_ms);
+        }
+
         /// \brief Retrieves the current minimal log level for a logger.
         /// \param logger_index Index of logger.
         /// \return Current minimal log level, or TRACE when the logger index is invalid.
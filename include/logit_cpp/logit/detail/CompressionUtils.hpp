@@ -3,9 +3,10 @@
 #define _LOGIT_DETAIL_COMPRESSION_UTILS_HPP_INCLUDED
 
 /// \file CompressionUtils.hpp
-/// \brief Shared gzip/zstd compression helpers used by OTLP and MDBX backends.
+/// \brief Shared gzip/zstd compression helpers used by file, OTLP and MDBX backends.
 
 #include <cstddef>
+#include <cstring>
 #include <string>
 
 #if defined(LOGIT_HAS_ZLIB)
@@ -122,6 +123,71 @@ inline bool decompress_string_gzip(const std::string& input, std::string& output
 #endif
 }
 
+/// \brief Decompress a gzip stream made of one or more concatenated members.
+/// \details A truncated trailing member (for example after a crash in the middle of
+/// a write) is ignored, so the result covers every complete member.
+/// \param input Compressed data.
+/// \param[out] output Decompressed result (valid only on success).
+/// \return true on success, false if zlib is unavailable or the data is corrupt.
+inline bool decompress_string_gzip_members(const std::string& input, std::string& output) {
+#if defined(LOGIT_HAS_ZLIB)
+    z_stream zs;
+    zs.zalloc = Z_NULL;
+    zs.zfree = Z_NULL;
+    zs.opaque = Z_NULL;
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    zs.avail_in = static_cast<uInt>(input.size());
+    zs.next_out = Z_NULL;
+    zs.avail_out = 0;
+
+    int window_bits = 15 + 16;
+    if (inflateInit2(&zs, window_bits) != Z_OK) {
+        return false;
+    }
+
+    output.clear();
+
+    std::size_t produced = 0;
+    std::size_t committed = 0;
+    const std::size_t buf_size = 32768;
+
+    for (;;) {
+        output.resize(produced + buf_size);
+        zs.next_out = reinterpret_cast<Bytef*>(&output[produced]);
+        zs.avail_out = static_cast<uInt>(buf_size);
+
+        const int ret = inflate(&zs, Z_NO_FLUSH);
+        produced += buf_size - zs.avail_out;
+
+        if (ret == Z_STREAM_END) {
+            committed = produced;
+            if (zs.avail_in == 0) break;
+            if (inflateReset(&zs) != Z_OK) {
+                inflateEnd(&zs);
+                output.clear();
+                return false;
+            }
+            continue;
+        }
+        if (ret == Z_BUF_ERROR || (ret == Z_OK && zs.avail_in == 0 && zs.avail_out != 0)) {
+            break; // input ended inside a member
+        }
+        if (ret != Z_OK) {
+            inflateEnd(&zs);
+            output.clear();
+            return false;
+        }
+    }
+
+    output.resize(committed);
+    inflateEnd(&zs);
+    return true;
+#else
+    (void)input; (void)output;
+    return false;
+#endif
+}
+
 /// \brief Compress a string with zstd.
 /// \param input Uncompressed data.
 /// \param[out] output Compressed result (valid only on success).
@@ -183,6 +249,55 @@ inline bool decompress_string_zstd(const std::string& input, std::string& output
 #endif
 }
 
+/// \brief Decompress a zstd stream made of one or more concatenated frames.
+/// \details Every frame must carry its content size, as produced by
+/// compress_string_zstd(). A truncated trailing frame is ignored.
+/// \param input Compressed data.
+/// \param[out] output Decompressed result (valid only on success).
+/// \return true on success, false if zstd is unavailable or the data is corrupt.
+inline bool decompress_string_zstd_frames(const std::string& input, std::string& output) {
+#if defined(LOGIT_HAS_ZSTD)
+    static const unsigned char magic[4] = {0x28, 0xB5, 0x2F, 0xFD};
+    output.clear();
+
+    std::size_t pos = 0;
+    while (pos < input.size()) {
+        const char* src = input.data() + pos;
+        const std::size_t remaining = input.size() - pos;
+        const std::size_t frame_size = ZSTD_findFrameCompressedSize(src, remaining);
+        if (ZSTD_isError(frame_size)) {
+            const bool is_truncated = remaining >= sizeof(magic) &&
+                std::memcmp(src, magic, sizeof(magic)) == 0;
+            if (is_truncated) break;
+            output.clear();
+            return false;
+        }
+
+        const unsigned long long content_size = ZSTD_getFrameContentSize(src, frame_size);
+        if (content_size == ZSTD_CONTENTSIZE_ERROR || content_size == ZSTD_CONTENTSIZE_UNKNOWN) {
+            output.clear();
+            return false;
+        }
+
+        const std::size_t offset = output.size();
+        output.resize(offset + static_cast<std::size_t>(content_size));
+        const std::size_t result = ZSTD_decompress(
+            content_size ? &output[offset] : nullptr, static_cast<std::size_t>(content_size),
+            src, frame_size);
+        if (ZSTD_isError(result)) {
+            output.clear();
+            return false;
+        }
+        output.resize(offset + result);
+        pos += frame_size;
+    }
+    return true;
+#else
+    (void)input; (void)output;
+    return false;
+#endif
+}
+
 } // namespace detail
 } // namespace logit
 
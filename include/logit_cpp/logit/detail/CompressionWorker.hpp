@@ -3,11 +3,20 @@
 #define _LOGIT_COMPRESSION_WORKER_HPP_INCLUDED
 
 /// \file CompressionWorker.hpp
-/// \brief Background worker that compresses rotated log files.
-
+/// \brief Background worker pool that compresses rotated log files.
+///
+/// Built-in gzip/zstd compression writes independent frames followed by a seek
+/// table (see SeekableArchive.hpp), so rotated archives support the same ranged
+/// and time-range reads as stream-compressed files.
+
+#include "CompressionUtils.hpp"
+#include "SeekableArchive.hpp"
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <queue>
 #include <thread>
+#include <cstddef>
 #include <mutex>
 #include <condition_variable>
 #include <fstream>
@@ -23,6 +32,32 @@
 
 namespace logit { namespace detail {
 
+    static const std::size_t ARCHIVE_FRAME_SIZE = 1024 * 1024; ///< Target uncompressed size of one frame of a rotated archive.
+
+    /// \struct CompressionContext
+    /// \brief Per-thread state reused across compressed files.
+    /// \details Holds the frame buffers and, with zstd, the compression context, so
+    /// a worker does not reallocate them for every rotated file.
+    struct CompressionContext {
+        std::string frame;             ///< Uncompressed frame.
+        std::string packed;            ///< Compressed frame.
+        std::string carry;             ///< Bytes read past the end of the previous frame.
+        int zstd_workers = 0;          ///< zstd worker threads per file (`ZSTD_c_nbWorkers`).
+#       if defined(LOGIT_HAS_ZSTD)
+        ZSTD_CCtx* zstd_cctx = nullptr; ///< Reused zstd context, created on first use.
+#       endif
+
+        CompressionContext() = default;
+        CompressionContext(const CompressionContext&) = delete;
+        CompressionContext& operator=(const CompressionContext&) = delete;
+
+        ~CompressionContext() {
+#           if defined(LOGIT_HAS_ZSTD)
+            if (zstd_cctx) ZSTD_freeCCtx(zstd_cctx);
+#           endif
+        }
+    };
+
     /// \brief Compress a file using the specified compression type.
     /// \param type Compression algorithm to use.
     /// \param src Path to the source file.
@@ -34,19 +69,39 @@ namespace logit { namespace detail {
                        int level,
                        const std::string& external_cmd);
 
+    /// \brief Compress a file reusing the buffers and contexts of `ctx`.
+    bool compress_file(CompressType type,
+                       const std::string& src,
+                       int level,
+                       const std::string& external_cmd,
+                       CompressionContext& ctx);
+
     /// \class CompressionWorker
-    /// \brief Background worker performing asynchronous compression.
+    /// \brief Background worker pool performing asynchronous compression.
+    ///
+    /// Files are taken from one queue by `threads` workers. When a fast level is
+    /// set, each file's level is chosen from the backlog: `level` while the queue
+    /// is empty, dropping linearly to `fast_level` once `backlog_threshold` files
+    /// are waiting, so a burst of rotations is drained before the disk fills up.
     class CompressionWorker {
     public:
-        /// \brief Create worker thread.
+        /// \brief Create worker threads.
         /// \param type Compression algorithm.
-        /// \param level Compression level.
+        /// \param level Compression level used when idle.
         /// \param external_cmd External command template.
+        /// \param threads Number of worker threads (at least 1).
+        /// \param zstd_workers zstd worker threads per file (0 = single-threaded).
+        /// \param fast_level Level used at the backlog threshold (0 = always `level`).
+        /// \param backlog_threshold Queued files at which `fast_level` is reached.
         CompressionWorker(CompressType type,
                            int level,
-                           std::string external_cmd);
+                           std::string external_cmd,
+                           std::size_t threads = 1,
+                           int zstd_workers = 0,
+                           int fast_level = 0,
+                           std::size_t backlog_threshold = 4);
 
-        /// \brief Stop worker thread and finish pending tasks.
+        /// \brief Stop worker threads and finish pending tasks.
         ~CompressionWorker();
 
         /// \brief Enqueue a file for compression.
@@ -56,6 +111,12 @@ namespace logit { namespace detail {
         /// \brief Wait until all queued files are processed.
         void wait();
 
+        /// \brief Number of files queued or being compressed.
+        std::size_t backlog() const;
+
+        /// \brief Level selected for the next file given the current backlog.
+        int select_level(std::size_t queued) const;
+
     private:
         /// \brief Worker loop processing queued files.
         void run();
@@ -63,13 +124,16 @@ namespace logit { namespace detail {
         CompressType m_type;
         int m_level;
         std::string m_external_cmd;
+        int m_zstd_workers;
+        int m_fast_level;
+        std::size_t m_backlog_threshold;
         std::queue<std::string> m_q;
-        std::thread m_thread;
-        std::mutex m_mx;
+        std::vector<std::thread> m_threads;
+        mutable std::mutex m_mx;
         std::condition_variable m_cv;
         std::condition_variable m_cv_idle;
         bool m_stop = false;
-        bool m_busy = false;
+        std::size_t m_busy = 0;
     };
 
     /// \brief Clamp value to inclusive range.
@@ -83,6 +147,143 @@ namespace logit { namespace detail {
         return v;
     }
 
+    /// \brief Plans the frames of a rotated file from its `.idx` time index sidecar.
+    /// \details Consecutive index blocks are merged up to ARCHIVE_FRAME_SIZE, so each
+    /// frame starts at a line and carries the timestamp range of its blocks.
+    /// \param src Rotated plain-text file.
+    /// \param file_size Size of `src`.
+    /// \param[out] frames Frames with uncompressed offsets and sizes.
+    /// \return false when the sidecar is missing or does not describe the whole file.
+    inline bool plan_indexed_frames(const std::string& src, uint64_t file_size, std::vector<SeekFrameEntry>& frames) {
+        frames.clear();
+        std::vector<SeekFrameEntry> blocks;
+        if (!read_time_index_file(src + ".idx", blocks) || blocks.empty()) return false;
+        uint64_t offset = 0;
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            if (blocks[i].offset != offset || blocks[i].size == 0) return false;
+            offset += blocks[i].size;
+            if (!frames.empty() &&
+                static_cast<uint64_t>(frames.back().size) + blocks[i].size <= ARCHIVE_FRAME_SIZE) {
+                SeekFrameEntry& frame = frames.back();
+                frame.size += blocks[i].size;
+                frame.first_ts_ms = (std::min)(frame.first_ts_ms, blocks[i].first_ts_ms);
+                frame.last_ts_ms = (std::max)(frame.last_ts_ms, blocks[i].last_ts_ms);
+            } else {
+                frames.push_back(blocks[i]);
+            }
+        }
+        return offset == file_size;
+    }
+
+    /// \brief Reads the next frame of a file without a time index.
+    /// \details Frames are ARCHIVE_FRAME_SIZE bytes cut back to the last line end, so
+    /// a record is never split across frames unless it is longer than a frame.
+    /// \return false at the end of the file.
+    inline bool read_unindexed_frame(std::ifstream& in, CompressionContext& ctx) {
+        ctx.frame.swap(ctx.carry);
+        ctx.carry.clear();
+        const std::size_t have = ctx.frame.size();
+        ctx.frame.resize(ARCHIVE_FRAME_SIZE);
+        in.read(&ctx.frame[have], static_cast<std::streamsize>(ARCHIVE_FRAME_SIZE - have));
+        ctx.frame.resize(have + static_cast<std::size_t>(in.gcount()));
+        if (ctx.frame.empty()) return false;
+        if (ctx.frame.size() == ARCHIVE_FRAME_SIZE) {
+            const std::size_t cut = ctx.frame.rfind('\n');
+            if (cut != std::string::npos && cut + 1 < ctx.frame.size()) {
+                ctx.carry.assign(ctx.frame, cut + 1, std::string::npos);
+                ctx.frame.resize(cut + 1);
+            }
+        }
+        return true;
+    }
+
+    /// \brief Compresses one frame into `ctx.packed`.
+    inline bool compress_archive_frame(CompressType type, int level, CompressionContext& ctx) {
+        if (type == CompressType::GZIP) {
+            return compress_string_gzip(ctx.frame, ctx.packed, level);
+        }
+#       if defined(LOGIT_HAS_ZSTD)
+        ctx.packed.resize(ZSTD_compressBound(ctx.frame.size()));
+        const size_t size = ZSTD_compress2(ctx.zstd_cctx, &ctx.packed[0], ctx.packed.size(),
+                                           ctx.frame.data(), ctx.frame.size());
+        if (ZSTD_isError(size)) return false;
+        ctx.packed.resize(size);
+        return true;
+#       else
+        (void)level;
+        return false;
+#       endif
+    }
+
+    /// \brief Compresses a rotated file into independent frames followed by a seek table.
+    /// \details Frames follow the `.idx` sidecar when there is one; otherwise they are
+    /// cut every ARCHIVE_FRAME_SIZE bytes and span the whole timestamp range.
+    /// \param type GZIP or ZSTD.
+    /// \param src Source path.
+    /// \param dst_tmp Temporary output path.
+    /// \param level Compression level.
+    /// \return true on success.
+    inline bool compress_file_framed(CompressType type,
+                                     const std::string& src,
+                                     const std::string& dst_tmp,
+                                     int level,
+                                     CompressionContext& ctx) {
+        std::ifstream in(src.c_str(), std::ios::binary);
+        std::ofstream out(dst_tmp.c_str(), std::ios::binary | std::ios::trunc);
+        if (!in || !out) return false;
+        in.seekg(0, std::ios::end);
+        const uint64_t file_size = static_cast<uint64_t>(in.tellg());
+        in.seekg(0);
+
+#       if defined(LOGIT_HAS_ZSTD)
+        if (type == CompressType::ZSTD) {
+            if (!ctx.zstd_cctx) {
+                ctx.zstd_cctx = ZSTD_createCCtx();
+                if (!ctx.zstd_cctx) return false;
+            } else {
+                ZSTD_CCtx_reset(ctx.zstd_cctx, ZSTD_reset_session_and_parameters);
+            }
+            ZSTD_CCtx_setParameter(ctx.zstd_cctx, ZSTD_c_compressionLevel, clamp_level(level, 1, 19));
+            if (ctx.zstd_workers > 0) {
+                // Fails without ZSTD_MULTITHREAD; compression then stays single-threaded.
+                ZSTD_CCtx_setParameter(ctx.zstd_cctx, ZSTD_c_nbWorkers, ctx.zstd_workers);
+            }
+        }
+#       endif
+
+        std::vector<SeekFrameEntry> frames;
+        const bool is_indexed = plan_indexed_frames(src, file_size, frames);
+        ctx.carry.clear();
+        uint64_t out_offset = 0;
+        for (std::size_t i = 0;; ++i) {
+            if (is_indexed) {
+                if (i == frames.size()) break;
+                ctx.frame.resize(frames[i].size);
+                if (!in.read(&ctx.frame[0], static_cast<std::streamsize>(ctx.frame.size()))) return false;
+            } else {
+                // An empty file still gets one empty frame, so it stays a valid archive.
+                if (!read_unindexed_frame(in, ctx) && i > 0) break;
+                SeekFrameEntry entry;
+                entry.size = static_cast<uint32_t>(ctx.frame.size());
+                entry.first_ts_ms = (std::numeric_limits<int64_t>::min)();
+                entry.last_ts_ms = (std::numeric_limits<int64_t>::max)();
+                frames.push_back(entry);
+            }
+            if (!compress_archive_frame(type, level, ctx)) return false;
+            out.write(ctx.packed.data(), static_cast<std::streamsize>(ctx.packed.size()));
+            if (!out) return false;
+            frames[i].offset = out_offset;
+            frames[i].compressed_size = static_cast<uint32_t>(ctx.packed.size());
+            out_offset += ctx.packed.size();
+        }
+
+        std::string trailer;
+        if (!make_seek_table_trailer(type == CompressType::GZIP, frames, trailer)) return false;
+        out.write(trailer.data(), static_cast<std::streamsize>(trailer.size()));
+        out.flush();
+        return out.good();
+    }
+
     /// \brief Compress file using gzip.
     /// \param src Source path.
     /// \param dst_tmp Temporary output path.
@@ -90,32 +291,22 @@ namespace logit { namespace detail {
     /// \return true on success.
     inline bool compress_file_gzip(const std::string& src,
                                    const std::string& dst_tmp,
-                                   int level) {
+                                   int level,
+                                   CompressionContext& ctx) {
 #       if defined(LOGIT_HAS_ZLIB)
-        std::ifstream in(src.c_str(), std::ios::binary);
-        if (!in) return false;
-
-        char mode[8] = "wb6";
-        mode[2] = char('0' + clamp_level(level, 1, 9));
-        gzFile out = gzopen(dst_tmp.c_str(), mode);
-        if (!out) return false;
-        gzbuffer(out, 256 * 1024);
-
-        std::vector<char> buf(256 * 1024);
-        while (in) {
-            in.read(&buf[0], buf.size());
-            std::streamsize got = in.gcount();
-            if (got > 0) {
-                int written = gzwrite(out, &buf[0], static_cast<unsigned>(got));
-                if (written == 0) { gzclose(out); return false; }
-            }
-        }
-        return gzclose(out) == Z_OK;
+        return compress_file_framed(CompressType::GZIP, src, dst_tmp, level, ctx);
 #       else
-        (void)src; (void)dst_tmp; (void)level; return false;
+        (void)src; (void)dst_tmp; (void)level; (void)ctx; return false;
 #       endif
     }
 
+    inline bool compress_file_gzip(const std::string& src,
+                                   const std::string& dst_tmp,
+                                   int level) {
+        CompressionContext ctx;
+        return compress_file_gzip(src, dst_tmp, level, ctx);
+    }
+
     /// \brief Compress file using Zstandard.
     /// \param src Source path.
     /// \param dst_tmp Temporary output path.
@@ -123,47 +314,22 @@ namespace logit { namespace detail {
     /// \return true on success.
     inline bool compress_file_zstd(const std::string& src,
                                    const std::string& dst_tmp,
-                                   int level) {
+                                   int level,
+                                   CompressionContext& ctx) {
 #       if defined(LOGIT_HAS_ZSTD)
-        std::ifstream in(src.c_str(), std::ios::binary);
-        std::ofstream out(dst_tmp.c_str(), std::ios::binary | std::ios::trunc);
-        if (!in || !out) return false;
-
-        ZSTD_CCtx* cctx = ZSTD_createCCtx();
-        if (!cctx) return false;
-        ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, clamp_level(level, 1, 19));
-
-        const size_t inChunk  = ZSTD_CStreamInSize();
-        const size_t outChunk = ZSTD_CStreamOutSize();
-        std::vector<char> inBuf(inChunk), outBuf(outChunk);
-
-        for (;;) {
-            in.read(&inBuf[0], inBuf.size());
-            size_t rd = static_cast<size_t>(in.gcount());
-            ZSTD_inBuffer zin  = { &inBuf[0], rd, 0 };
-            const int last = in.eof() ? 1 : 0;
-
-            while (zin.pos < zin.size || last) {
-                ZSTD_outBuffer zout = { &outBuf[0], outBuf.size(), 0 };
-                size_t ret = last
-                    ? ZSTD_compressStream2(cctx, &zout, &zin, ZSTD_e_end)
-                    : ZSTD_compressStream2(cctx, &zout, &zin, ZSTD_e_continue);
-                if (ZSTD_isError(ret)) { ZSTD_freeCCtx(cctx); return false; }
-                out.write(&outBuf[0], static_cast<std::streamsize>(zout.pos));
-                if (!out) { ZSTD_freeCCtx(cctx); return false; }
-                if (last && ret == 0 && zin.pos == zin.size) {
-                    ZSTD_freeCCtx(cctx);
-                    out.flush();
-                    return out.good();
-                }
-                if (!last && zin.pos == zin.size) break;
-            }
-        }
+        return compress_file_framed(CompressType::ZSTD, src, dst_tmp, level, ctx);
 #       else
-        (void)src; (void)dst_tmp; (void)level; return false;
+        (void)src; (void)dst_tmp; (void)level; (void)ctx; return false;
 #       endif
     }
 
+    inline bool compress_file_zstd(const std::string& src,
+                                   const std::string& dst_tmp,
+                                   int level) {
+        CompressionContext ctx;
+        return compress_file_zstd(src, dst_tmp, level, ctx);
+    }
+
     /// \brief Compress file using external command.
     /// \param src Source path.
     /// \param cmd_tpl Command template containing {file} and {level}.
@@ -184,7 +350,8 @@ namespace logit { namespace detail {
     inline bool compress_file(CompressType type,
                               const std::string& src,
                               int level,
-                              const std::string& external_cmd) {
+                              const std::string& external_cmd,
+                              CompressionContext& ctx) {
         if (type == CompressType::NONE) return true;
         if (type == CompressType::EXTERNAL_CMD) {
             return compress_file_external(src, external_cmd, level);
@@ -192,20 +359,37 @@ namespace logit { namespace detail {
         std::string dst = src + (type == CompressType::GZIP ? ".gz" : ".zst");
         std::string tmp = dst + ".tmp";
         bool ok = false;
-        if (type == CompressType::GZIP) ok = compress_file_gzip(src, tmp, level);
-        else ok = compress_file_zstd(src, tmp, level);
+        if (type == CompressType::GZIP) ok = compress_file_gzip(src, tmp, level, ctx);
+        else ok = compress_file_zstd(src, tmp, level, ctx);
         if (!ok) { std::remove(tmp.c_str()); return false; }
         if (std::rename(tmp.c_str(), dst.c_str()) != 0) { std::remove(tmp.c_str()); return false; }
         std::remove(src.c_str());
         return true;
     }
 
+    inline bool compress_file(CompressType type,
+                              const std::string& src,
+                              int level,
+                              const std::string& external_cmd) {
+        CompressionContext ctx;
+        return compress_file(type, src, level, external_cmd, ctx);
+    }
+
     inline CompressionWorker::CompressionWorker(CompressType type,
                                                 int level,
-                                                std::string external_cmd)
-        : m_type(type), m_level(level), m_external_cmd(std::move(external_cmd)) {
+                                                std::string external_cmd,
+                                                std::size_t threads,
+                                                int zstd_workers,
+                                                int fast_level,
+                                                std::size_t backlog_threshold)
+        : m_type(type), m_level(level), m_external_cmd(std::move(external_cmd)),
+          m_zstd_workers(zstd_workers), m_fast_level(fast_level),
+          m_backlog_threshold(backlog_threshold > 0 ? backlog_threshold : 1) {
         if (m_type != CompressType::NONE) {
-            m_thread = std::thread(&CompressionWorker::run, this);
+            const std::size_t count = threads > 0 ? threads : 1;
+            for (std::size_t i = 0; i < count; ++i) {
+                m_threads.push_back(std::thread(&CompressionWorker::run, this));
+            }
         }
     }
 
@@ -215,7 +399,9 @@ namespace logit { namespace detail {
             m_stop = true;
             m_cv.notify_all();
         }
-        if (m_thread.joinable()) m_thread.join();
+        for (std::size_t i = 0; i < m_threads.size(); ++i) {
+            if (m_threads[i].joinable()) m_threads[i].join();
+        }
     }
 
     inline void CompressionWorker::enqueue(std::string path) {
@@ -226,27 +412,43 @@ namespace logit { namespace detail {
 
     inline void CompressionWorker::wait() {
         std::unique_lock<std::mutex> lk(m_mx);
-        m_cv_idle.wait(lk, [this]{ return m_q.empty() && !m_busy; });
+        m_cv_idle.wait(lk, [this]{ return m_q.empty() && m_busy == 0; });
+    }
+
+    inline std::size_t CompressionWorker::backlog() const {
+        std::lock_guard<std::mutex> lk(m_mx);
+        return m_q.size() + m_busy;
+    }
+
+    inline int CompressionWorker::select_level(std::size_t queued) const {
+        if (m_fast_level <= 0 || m_fast_level >= m_level) return m_level;
+        if (queued >= m_backlog_threshold) return m_fast_level;
+        const std::size_t range = static_cast<std::size_t>(m_level - m_fast_level);
+        return m_level - static_cast<int>(range * queued / m_backlog_threshold);
     }
 
     inline void CompressionWorker::run() {
+        CompressionContext ctx;
+        ctx.zstd_workers = m_zstd_workers;
         for (;;) {
             std::string src;
+            int level = m_level;
             {
                 std::unique_lock<std::mutex> lk(m_mx);
                 m_cv.wait(lk, [this]{ return m_stop || !m_q.empty(); });
                 if (m_stop && m_q.empty()) break;
                 src = std::move(m_q.front());
                 m_q.pop();
-                m_busy = true;
+                level = select_level(m_q.size());
+                ++m_busy;
             }
 
-            compress_file(m_type, src, m_level, m_external_cmd);
+            compress_file(m_type, src, level, m_external_cmd, ctx);
 
             {
                 std::lock_guard<std::mutex> lk(m_mx);
-                m_busy = false;
-                if (m_q.empty()) m_cv_idle.notify_all();
+                --m_busy;
+                if (m_q.empty() && m_busy == 0) m_cv_idle.notify_all();
             }
         }
     }
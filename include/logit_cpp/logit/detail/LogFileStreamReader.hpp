@@ -0,0 +1,423 @@
+#pragma once
+#ifndef _LOGIT_DETAIL_LOG_FILE_STREAM_READER_HPP_INCLUDED
+#define _LOGIT_DETAIL_LOG_FILE_STREAM_READER_HPP_INCLUDED
+
+/// \file LogFileStreamReader.hpp
+/// \brief Bounded-memory readers shared by file-based backends.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(LOGIT_HAS_ZLIB)
+#   include <zlib.h>
+#endif
+#if defined(LOGIT_HAS_ZSTD)
+#   include <zstd.h>
+#endif
+
+namespace logit {
+namespace detail {
+
+/// \class ReverseLineSplitter
+/// \brief Splits text fed from the end of a file towards its start into lines.
+/// \details Blocks must be fed in reverse file order. Only the unfinished first
+/// line of the latest block is kept between calls.
+class ReverseLineSplitter {
+public:
+    using Callback = std::function<bool(const std::string&)>;
+
+    /// \brief Feeds the block that precedes all previously fed data.
+    /// \return False when the callback stopped the iteration.
+    bool feed(const char* data, std::size_t size, const Callback& callback) {
+        std::string block(data, size);
+        block += m_pending;
+        m_pending.clear();
+
+        std::size_t end = block.size();
+        if (!m_has_data) {
+            if (end == 0) return true;
+            m_has_data = true;
+            if (block[end - 1] == '\n') --end; // no empty line after the final terminator
+        }
+        while (end > 0) {
+            const std::size_t pos = block.rfind('\n', end - 1);
+            if (pos == std::string::npos) break;
+            if (!emit(block.substr(pos + 1, end - pos - 1), callback)) return false;
+            end = pos;
+        }
+        m_pending.assign(block, 0, end);
+        return true;
+    }
+
+    /// \brief Emits the first line of the file.
+    /// \return False when the callback stopped the iteration.
+    bool finish(const Callback& callback) {
+        if (!m_has_data) return true;
+        m_has_data = false;
+        std::string line;
+        line.swap(m_pending);
+        return emit(line, callback);
+    }
+
+private:
+    static bool emit(std::string line, const Callback& callback) {
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+        return callback(line);
+    }
+
+    std::string m_pending;    ///< Start of a line whose beginning was not fed yet.
+    bool        m_has_data = false; ///< True once non-empty data was fed.
+};
+
+/// \brief Gets the size of a file.
+/// \param native_path Path in the native encoding.
+/// \param[out] size File size in bytes.
+/// \return True when the file could be opened.
+inline bool get_file_size(const std::string& native_path, uint64_t& size) {
+    std::ifstream in(native_path.c_str(), std::ios_base::binary | std::ios_base::ate);
+    if (!in.is_open()) return false;
+    size = static_cast<uint64_t>(in.tellg());
+    return true;
+}
+
+/// \brief Reads up to `capacity` bytes of a plain file at `offset`.
+/// \param native_path Path in the native encoding.
+/// \param offset Offset of the first byte to read.
+/// \param buffer Destination buffer.
+/// \param capacity Size of `buffer`.
+/// \param[out] size Number of bytes read.
+/// \param[out] file_size File size at the time of the read.
+/// \return True on success.
+inline bool read_file_chunk(
+        const std::string& native_path,
+        uint64_t offset,
+        char* buffer,
+        std::size_t capacity,
+        std::size_t& size,
+        uint64_t& file_size) {
+    size = 0;
+    std::ifstream in(native_path.c_str(), std::ios_base::binary | std::ios_base::ate);
+    if (!in.is_open()) return false;
+    file_size = static_cast<uint64_t>(in.tellg());
+    if (offset >= file_size || capacity == 0) return true;
+    const uint64_t available = file_size - offset;
+    const std::size_t wanted = available < capacity ? static_cast<std::size_t>(available) : capacity;
+    in.seekg(static_cast<std::streamoff>(offset));
+    in.read(buffer, static_cast<std::streamsize>(wanted));
+    size = static_cast<std::size_t>(in.gcount());
+    return !in.bad();
+}
+
+/// \brief Iterates over the lines of a plain file from the last one backwards.
+/// \param native_path Path in the native encoding.
+/// \param callback Receives each line; return false to stop.
+/// \param block_size Size of the blocks read from the end of the file.
+/// \return True when the file could be read.
+inline bool for_each_file_line_reverse(
+        const std::string& native_path,
+        const ReverseLineSplitter::Callback& callback,
+        std::size_t block_size = 64 * 1024) {
+    std::ifstream in(native_path.c_str(), std::ios_base::binary | std::ios_base::ate);
+    if (!in.is_open()) return false;
+    uint64_t remaining = static_cast<uint64_t>(in.tellg());
+    std::vector<char> block(block_size);
+    ReverseLineSplitter splitter;
+    while (remaining > 0) {
+        const std::size_t size = remaining < block_size ? static_cast<std::size_t>(remaining) : block_size;
+        remaining -= size;
+        in.seekg(static_cast<std::streamoff>(remaining));
+        if (!in.read(&block[0], static_cast<std::streamsize>(size))) return false;
+        if (!splitter.feed(&block[0], size, callback)) return true;
+    }
+    splitter.finish(callback);
+    return true;
+}
+
+/// \class CompressedFileCursor
+/// \brief Forward-only decoder of a gzip or zstd file that resumes where the last read stopped.
+/// \details Used for compressed files without a seek table. Sequential chunk reads
+/// continue the decoder instead of decompressing the file again, and a file that
+/// grew by appended members or frames is decoded from where the previous pass ended.
+/// Memory stays bounded by the input buffer and the decoder window. Unlike the
+/// whole-file readers, a truncated trailing member contributes the bytes decoded so far.
+class CompressedFileCursor {
+public:
+    CompressedFileCursor() = default;
+    CompressedFileCursor(const CompressedFileCursor&) = delete;
+    CompressedFileCursor& operator=(const CompressedFileCursor&) = delete;
+
+    ~CompressedFileCursor() {
+        close();
+    }
+
+    /// \brief Makes the cursor follow `native_path` and picks up appended data.
+    /// \details Reopens the file when the cursor is on another file or the file shrank.
+    /// \return False when the file cannot be opened or decoded.
+    bool sync(const std::string& native_path, bool is_gzip) {
+        uint64_t file_size = 0;
+        if (!get_file_size(native_path, file_size)) return false;
+        if (!m_is_open || m_path != native_path || m_is_gzip != is_gzip || file_size < m_file_size) {
+            if (!open(native_path, is_gzip)) return false;
+        } else if (file_size > m_file_size) {
+            m_is_eof = false;
+        }
+        m_file_size = file_size;
+        return true;
+    }
+
+    /// \brief Restarts decoding from the beginning of the file.
+    bool rewind() {
+        return m_is_open && open(m_path, m_is_gzip);
+    }
+
+    /// \brief Decodes up to `capacity` bytes at the current position.
+    /// \param[out] size Number of bytes decoded; less than `capacity` only at the end of the data.
+    /// \return False on I/O or format errors.
+    bool read(char* buffer, std::size_t capacity, std::size_t& size) {
+        size = 0;
+        if (!m_is_open) return false;
+        while (size < capacity) {
+            std::size_t consumed = 0;
+            std::size_t produced = 0;
+            if (!decode(buffer + size, capacity - size, consumed, produced)) return false;
+            size += produced;
+            if (consumed == 0 && produced == 0) {
+                if (!fill()) {
+                    m_is_eof = true;
+                    break;
+                }
+            }
+        }
+        m_position += size;
+        return true;
+    }
+
+    /// \brief Discards up to `count` decoded bytes.
+    /// \return False on I/O or format errors.
+    bool skip(uint64_t count) {
+        char scratch[16 * 1024];
+        while (count > 0 && !m_is_eof) {
+            const std::size_t wanted = count < sizeof(scratch) ? static_cast<std::size_t>(count) : sizeof(scratch);
+            std::size_t size = 0;
+            if (!read(scratch, wanted, size)) return false;
+            count -= size;
+        }
+        return true;
+    }
+
+    uint64_t position() const { return m_position; } ///< Uncompressed offset of the next byte.
+    bool is_eof() const { return m_is_eof; } ///< True once all data available at the last sync() was decoded.
+
+    void close() {
+#       if defined(LOGIT_HAS_ZLIB)
+        if (m_is_zlib_init) inflateEnd(&m_zs);
+        m_is_zlib_init = false;
+#       endif
+#       if defined(LOGIT_HAS_ZSTD)
+        if (m_zds) ZSTD_freeDStream(m_zds);
+        m_zds = nullptr;
+#       endif
+        if (m_in.is_open()) m_in.close();
+        m_is_open = false;
+    }
+
+private:
+    bool open(const std::string& native_path, bool is_gzip) {
+        close();
+        m_path = native_path;
+        m_is_gzip = is_gzip;
+        m_position = 0;
+        m_file_size = 0;
+        m_in_pos = 0;
+        m_in_len = 0;
+        m_is_eof = false;
+        m_is_member_done = false;
+        if (is_gzip) {
+#           if defined(LOGIT_HAS_ZLIB)
+            std::memset(&m_zs, 0, sizeof(m_zs));
+            if (inflateInit2(&m_zs, 15 + 16) != Z_OK) return false;
+            m_is_zlib_init = true;
+#           else
+            return false;
+#           endif
+        } else {
+#           if defined(LOGIT_HAS_ZSTD)
+            m_zds = ZSTD_createDStream();
+            if (!m_zds || ZSTD_isError(ZSTD_initDStream(m_zds))) return false;
+#           else
+            return false;
+#           endif
+        }
+        m_in.open(native_path.c_str(), std::ios_base::binary);
+        if (!m_in.is_open()) {
+            close();
+            return false;
+        }
+        m_in_buf.resize(64 * 1024);
+        m_is_open = true;
+        return true;
+    }
+
+    /// \brief Reads the next input block; false when no more input is available yet.
+    bool fill() {
+        m_in.clear();
+        m_in.read(&m_in_buf[0], static_cast<std::streamsize>(m_in_buf.size()));
+        m_in_len = static_cast<std::size_t>(m_in.gcount());
+        m_in_pos = 0;
+        if (m_in.bad()) return false;
+        m_in.clear(); // data appended later stays readable
+        return m_in_len > 0;
+    }
+
+    bool decode(char* out, std::size_t capacity, std::size_t& consumed, std::size_t& produced) {
+        consumed = 0;
+        produced = 0;
+        if (m_is_gzip) {
+#           if defined(LOGIT_HAS_ZLIB)
+            if (m_is_member_done) {
+                if (m_in_pos == m_in_len) return true;
+                inflateReset(&m_zs);
+                m_is_member_done = false;
+            }
+            m_zs.next_in = reinterpret_cast<Bytef*>(&m_in_buf[0] + m_in_pos);
+            m_zs.avail_in = static_cast<uInt>(m_in_len - m_in_pos);
+            m_zs.next_out = reinterpret_cast<Bytef*>(out);
+            m_zs.avail_out = static_cast<uInt>(capacity);
+            const int ret = inflate(&m_zs, Z_NO_FLUSH);
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) return false;
+            consumed = (m_in_len - m_in_pos) - m_zs.avail_in;
+            produced = capacity - m_zs.avail_out;
+            m_in_pos += consumed;
+            if (ret == Z_STREAM_END) {
+                m_is_member_done = true;
+                // An empty member (e.g. the seek table) still counts as progress.
+                if (consumed == 0 && produced == 0) consumed = 1;
+            }
+            return true;
+#           else
+            (void)out; (void)capacity;
+            return false;
+#           endif
+        }
+#       if defined(LOGIT_HAS_ZSTD)
+        ZSTD_inBuffer in = { &m_in_buf[0] + m_in_pos, m_in_len - m_in_pos, 0 };
+        ZSTD_outBuffer zout = { out, capacity, 0 };
+        const size_t ret = ZSTD_decompressStream(m_zds, &zout, &in);
+        if (ZSTD_isError(ret)) return false;
+        consumed = in.pos;
+        produced = zout.pos;
+        m_in_pos += consumed;
+        return true;
+#       else
+        (void)out; (void)capacity;
+        return false;
+#       endif
+    }
+
+    std::ifstream     m_in;             ///< Compressed input.
+    std::vector<char> m_in_buf;         ///< Compressed input block.
+    std::size_t       m_in_pos = 0;     ///< Next unread byte of m_in_buf.
+    std::size_t       m_in_len = 0;     ///< Valid bytes in m_in_buf.
+    std::string       m_path;           ///< Native path of the decoded file.
+    uint64_t          m_file_size = 0;  ///< Compressed size seen by the last sync().
+    uint64_t          m_position = 0;   ///< Uncompressed offset of the next byte.
+    bool              m_is_gzip = true;
+    bool              m_is_open = false;
+    bool              m_is_eof = false;
+    bool              m_is_member_done = false; ///< The gzip member ended; the next byte starts a new one.
+#   if defined(LOGIT_HAS_ZLIB)
+    z_stream          m_zs;
+    bool              m_is_zlib_init = false;
+#   endif
+#   if defined(LOGIT_HAS_ZSTD)
+    ZSTD_DStream*     m_zds = nullptr;
+#   endif
+};
+
+/// \brief Iterates over the lines of a compressed file without a seek table from the last one backwards.
+/// \details The content is decompressed once into an anonymous temporary file that is
+/// then read from the end, so memory stays bounded by `block_size`.
+/// \param native_path Path in the native encoding.
+/// \param is_gzip True for gzip files, false for zstd files.
+/// \param callback Receives each line; return false to stop.
+/// \param block_size Size of the decoded blocks.
+/// \return True when the file could be read.
+inline bool for_each_compressed_file_line_reverse(
+        const std::string& native_path,
+        bool is_gzip,
+        const ReverseLineSplitter::Callback& callback,
+        std::size_t block_size = 64 * 1024) {
+    CompressedFileCursor cursor;
+    if (!cursor.sync(native_path, is_gzip)) return false;
+    std::FILE* spool = std::tmpfile();
+    if (!spool) return false;
+    std::vector<char> block(block_size);
+    bool is_ok = true;
+    for (;;) {
+        std::size_t size = 0;
+        if (!cursor.read(&block[0], block.size(), size) ||
+            std::fwrite(&block[0], 1, size, spool) != size) {
+            is_ok = false;
+            break;
+        }
+        if (size < block.size()) break;
+    }
+
+    uint64_t remaining = cursor.position();
+    ReverseLineSplitter splitter;
+    while (is_ok && remaining > 0) {
+        const std::size_t size = remaining < block_size ? static_cast<std::size_t>(remaining) : block_size;
+        remaining -= size;
+#       if defined(_WIN32)
+        is_ok = _fseeki64(spool, static_cast<__int64>(remaining), SEEK_SET) == 0;
+#       else
+        is_ok = fseeko(spool, static_cast<off_t>(remaining), SEEK_SET) == 0;
+#       endif
+        is_ok = is_ok && std::fread(&block[0], 1, size, spool) == size;
+        if (is_ok && !splitter.feed(&block[0], size, callback)) {
+            std::fclose(spool);
+            return true;
+        }
+    }
+    std::fclose(spool);
+    if (is_ok) splitter.finish(callback);
+    return is_ok;
+}
+
+/// \brief Iterates over the lines of in-memory content from the last one backwards.
+/// \param content Text to split.
+/// \param callback Receives each line; return false to stop.
+inline void for_each_line_reverse(const std::string& content, const ReverseLineSplitter::Callback& callback) {
+    ReverseLineSplitter splitter;
+    if (splitter.feed(content.data(), content.size(), callback)) {
+        splitter.finish(callback);
+    }
+}
+
+/// \brief Copies a window of in-memory content into a caller buffer.
+/// \param content Full content.
+/// \param offset Offset of the first byte to copy.
+/// \param buffer Destination buffer.
+/// \param capacity Size of `buffer`.
+/// \return Number of bytes copied.
+inline std::size_t copy_content_chunk(const std::string& content, uint64_t offset, char* buffer, std::size_t capacity) {
+    if (offset >= content.size()) return 0;
+    const std::size_t size = (std::min)(capacity, content.size() - static_cast<std::size_t>(offset));
+    if (size > 0) {
+        std::memcpy(buffer, content.data() + offset, size);
+    }
+    return size;
+}
+
+} // namespace detail
+} // namespace logit
+
+#endif // _LOGIT_DETAIL_LOG_FILE_STREAM_READER_HPP_INCLUDED
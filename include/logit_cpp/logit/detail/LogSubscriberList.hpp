@@ -0,0 +1,287 @@
+#pragma once
+#ifndef _LOGIT_DETAIL_LOG_SUBSCRIBER_LIST_HPP_INCLUDED
+#define _LOGIT_DETAIL_LOG_SUBSCRIBER_LIST_HPP_INCLUDED
+
+/// \file LogSubscriberList.hpp
+/// \brief Copy-on-write callback registry with optional asynchronous delivery.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace logit { namespace detail {
+
+    /// \class LogSubscriberList
+    /// \brief Callback registry shared by ILogSubscriber backends.
+    /// \details The list of callbacks is an immutable vector published through
+    /// an atomic `shared_ptr`. Writers copy it under a mutex, while the logging
+    /// path only loads the current pointer, so dispatch never copies callbacks.
+    /// `empty()` is a single relaxed load and lets backends skip building
+    /// snapshots entirely when nobody is subscribed.
+    ///
+    /// Asynchronous callbacks get a bounded per-callback queue drained by one
+    /// dispatcher thread, started with the first asynchronous callback. When a
+    /// queue is full the newest snapshot is dropped and the callback's drop
+    /// counter is incremented, so a slow subscriber never blocks the writer.
+    class LogSubscriberList {
+    public:
+        using Callback = std::function<void(const LogRecordSnapshot&)>;
+        using ErrorHandler = std::function<void(const std::string&)>;
+
+        LogSubscriberList() = default;
+
+        LogSubscriberList(const LogSubscriberList&) = delete;
+        LogSubscriberList& operator=(const LogSubscriberList&) = delete;
+
+        ~LogSubscriberList() {
+            {
+                std::lock_guard<std::mutex> lock(m_queue_mutex);
+                m_is_stopping = true;
+            }
+            m_queue_cv.notify_all();
+            if (m_dispatcher.joinable()) {
+                m_dispatcher.join();
+            }
+        }
+
+        /// \brief Sets the handler that receives callback exceptions.
+        /// \details Must be called before the first callback is registered.
+        void set_error_handler(ErrorHandler handler) {
+            m_error_handler = std::move(handler);
+        }
+
+        /// \brief Registers a callback.
+        /// \return Stable callback id.
+        uint64_t add(Callback callback, const LogCallbackOptions& options) {
+            std::shared_ptr<Subscriber> subscriber = std::make_shared<Subscriber>();
+            subscriber->id = m_next_id.fetch_add(1, std::memory_order_relaxed);
+            subscriber->callback = std::move(callback);
+            subscriber->is_async = options.async;
+            subscriber->queue_capacity = options.queue_capacity > 0 ? options.queue_capacity : 1;
+
+            std::lock_guard<std::mutex> lock(m_write_mutex);
+            if (subscriber->is_async) {
+                std::lock_guard<std::mutex> queue_lock(m_queue_mutex);
+                m_async_subscribers.push_back(subscriber);
+                if (!m_dispatcher.joinable()) {
+                    m_dispatcher = std::thread(&LogSubscriberList::dispatcher_loop, this);
+                    m_dispatcher_id = m_dispatcher.get_id();
+                }
+            }
+            std::shared_ptr<List> list = std::make_shared<List>(*load_list());
+            list->push_back(subscriber);
+            publish_list(list);
+            return subscriber->id;
+        }
+
+        /// \brief Unregisters a callback.
+        /// \details A synchronous dispatch already in progress may still call it;
+        /// queued asynchronous snapshots are discarded.
+        /// \return True if the callback existed.
+        bool remove(uint64_t id) {
+            std::lock_guard<std::mutex> lock(m_write_mutex);
+            std::shared_ptr<const List> current = load_list();
+            std::shared_ptr<List> list = std::make_shared<List>();
+            list->reserve(current->size());
+            std::shared_ptr<Subscriber> removed;
+            for (size_t i = 0; i < current->size(); ++i) {
+                if ((*current)[i]->id == id) {
+                    removed = (*current)[i];
+                } else {
+                    list->push_back((*current)[i]);
+                }
+            }
+            if (!removed) return false;
+            removed->is_removed.store(true, std::memory_order_release);
+            if (removed->is_async) {
+                std::lock_guard<std::mutex> queue_lock(m_queue_mutex);
+                m_queued -= removed->queue.size();
+                removed->queue.clear();
+                for (size_t i = 0; i < m_async_subscribers.size(); ++i) {
+                    if (m_async_subscribers[i] == removed) {
+                        m_async_subscribers.erase(m_async_subscribers.begin() + i);
+                        break;
+                    }
+                }
+            }
+            publish_list(list);
+            m_queue_cv.notify_all();
+            return true;
+        }
+
+        /// \brief Returns true when no callback is registered.
+        bool empty() const {
+            return m_count.load(std::memory_order_relaxed) == 0;
+        }
+
+        /// \brief Number of snapshots dropped for an asynchronous callback.
+        uint64_t dropped(uint64_t id) const {
+            std::shared_ptr<const List> list = load_list();
+            for (size_t i = 0; i < list->size(); ++i) {
+                if ((*list)[i]->id == id) {
+                    return (*list)[i]->dropped.load(std::memory_order_relaxed);
+                }
+            }
+            return 0;
+        }
+
+        /// \brief Delivers one snapshot to every callback.
+        void publish(const LogRecordSnapshot& snapshot) const {
+            if (empty()) return;
+            std::shared_ptr<const List> list = load_list();
+            std::shared_ptr<const LogRecordSnapshot> shared;
+            deliver(*list, snapshot, shared);
+            if (shared) m_queue_cv.notify_one();
+        }
+
+        /// \brief Delivers a batch of snapshots to every callback, in order.
+        void publish(const std::vector<LogRecordSnapshot>& snapshots) const {
+            if (empty() || snapshots.empty()) return;
+            std::shared_ptr<const List> list = load_list();
+            bool is_queued = false;
+            for (size_t i = 0; i < snapshots.size(); ++i) {
+                std::shared_ptr<const LogRecordSnapshot> shared;
+                deliver(*list, snapshots[i], shared);
+                is_queued = is_queued || shared;
+            }
+            if (is_queued) m_queue_cv.notify_one();
+        }
+
+        /// \brief Waits until queued asynchronous snapshots have been delivered.
+        /// \details Returns immediately when called from an asynchronous callback.
+        void flush() const {
+            std::unique_lock<std::mutex> lock(m_queue_mutex);
+            if (std::this_thread::get_id() == m_dispatcher_id) return;
+            m_idle_cv.wait(lock, [this]() {
+                return m_is_stopping || (m_queued == 0 && !m_is_delivering);
+            });
+        }
+
+    private:
+        struct Subscriber {
+            uint64_t              id = 0;
+            Callback              callback;
+            bool                  is_async = false;
+            std::size_t           queue_capacity = 0;
+            std::deque<std::shared_ptr<const LogRecordSnapshot> > queue; ///< Guarded by m_queue_mutex.
+            std::atomic<uint64_t> dropped{0};
+            std::atomic<bool>     is_removed{false};
+        };
+
+        typedef std::vector<std::shared_ptr<Subscriber> > List;
+
+        std::shared_ptr<const List> load_list() const {
+            std::shared_ptr<const List> list = std::atomic_load(&m_list);
+            return list ? list : empty_list();
+        }
+
+        void publish_list(const std::shared_ptr<List>& list) {
+            m_count.store(list->size(), std::memory_order_relaxed);
+            std::atomic_store(&m_list, std::shared_ptr<const List>(list));
+        }
+
+        static std::shared_ptr<const List> empty_list() {
+            static const std::shared_ptr<const List> list = std::make_shared<List>();
+            return list;
+        }
+
+        void deliver(
+                const List& list,
+                const LogRecordSnapshot& snapshot,
+                std::shared_ptr<const LogRecordSnapshot>& shared) const {
+            for (size_t i = 0; i < list.size(); ++i) {
+                Subscriber& subscriber = *list[i];
+                if (!subscriber.is_async) {
+                    invoke(subscriber, snapshot);
+                    continue;
+                }
+                if (!shared) {
+                    shared = std::make_shared<LogRecordSnapshot>(snapshot);
+                }
+                std::lock_guard<std::mutex> lock(m_queue_mutex);
+                if (subscriber.is_removed.load(std::memory_order_acquire)) continue;
+                if (subscriber.queue.size() >= subscriber.queue_capacity) {
+                    subscriber.dropped.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                subscriber.queue.push_back(shared);
+                ++m_queued;
+            }
+        }
+
+        void invoke(const Subscriber& subscriber, const LogRecordSnapshot& snapshot) const {
+            try {
+                subscriber.callback(snapshot);
+            } catch (const std::exception& e) {
+                if (m_error_handler) {
+                    m_error_handler(std::string("callback error: ") + e.what());
+                }
+            } catch (...) {
+                if (m_error_handler) {
+                    m_error_handler("callback error");
+                }
+            }
+        }
+
+        /// \brief Drains the asynchronous queues one snapshot per callback per round.
+        void dispatcher_loop() {
+            std::vector<std::pair<std::shared_ptr<Subscriber>, std::shared_ptr<const LogRecordSnapshot> > > round;
+            std::unique_lock<std::mutex> lock(m_queue_mutex);
+            for (;;) {
+                m_queue_cv.wait(lock, [this]() { return m_is_stopping || m_queued > 0; });
+                if (m_is_stopping) break;
+
+                round.clear();
+                for (size_t i = 0; i < m_async_subscribers.size(); ++i) {
+                    Subscriber& subscriber = *m_async_subscribers[i];
+                    if (subscriber.queue.empty()) continue;
+                    round.push_back(std::make_pair(m_async_subscribers[i], subscriber.queue.front()));
+                    subscriber.queue.pop_front();
+                    --m_queued;
+                }
+                m_is_delivering = true;
+                lock.unlock();
+                for (size_t i = 0; i < round.size(); ++i) {
+                    if (!round[i].first->is_removed.load(std::memory_order_acquire)) {
+                        invoke(*round[i].first, *round[i].second);
+                    }
+                }
+                round.clear();
+                lock.lock();
+                m_is_delivering = false;
+                if (m_queued == 0) {
+                    m_idle_cv.notify_all();
+                }
+            }
+            m_idle_cv.notify_all();
+        }
+
+        std::shared_ptr<const List> m_list;              ///< Published callback list (atomic access only).
+        std::atomic<std::size_t>    m_count{0};          ///< Size of the published list.
+        std::atomic<uint64_t>       m_next_id{1};        ///< Next callback id.
+        std::mutex                  m_write_mutex;       ///< Serializes add/remove.
+        ErrorHandler                m_error_handler;     ///< Receives callback exceptions.
+
+        mutable std::mutex              m_queue_mutex;   ///< Guards async queues and dispatcher state.
+        mutable std::condition_variable m_queue_cv;      ///< Wakes the dispatcher.
+        mutable std::condition_variable m_idle_cv;       ///< Signals drained queues to flush().
+        std::vector<std::shared_ptr<Subscriber> > m_async_subscribers; ///< Asynchronous callbacks in registration order.
+        mutable std::size_t         m_queued = 0;        ///< Snapshots queued across all callbacks.
+        bool                        m_is_delivering = false; ///< True while the dispatcher runs callbacks.
+        bool                        m_is_stopping = false;   ///< Set by the destructor.
+        std::thread                 m_dispatcher;        ///< Dispatcher thread, started lazily.
+        std::thread::id             m_dispatcher_id;     ///< Id of the dispatcher thread (guarded by m_queue_mutex).
+    };
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_DETAIL_LOG_SUBSCRIBER_LIST_HPP_INCLUDED
@@ -45,6 +45,26 @@ public:
         m_out.insert(m_out.end(), value.begin(), value.end());
     }
 
+    /// \brief Writes an unsigned LEB128 varint (1 byte for values below 128).
+    void write_varint(uint64_t value) {
+        while (value >= 0x80u) {
+            m_out.push_back(static_cast<uint8_t>((value & 0x7Fu) | 0x80u));
+            value >>= 7;
+        }
+        m_out.push_back(static_cast<uint8_t>(value));
+    }
+
+    /// \brief Writes a zigzag-encoded signed varint.
+    void write_svarint(int64_t value) {
+        write_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    /// \brief Writes a varint length followed by the bytes.
+    void write_varstring(const std::string& value) {
+        write_varint(static_cast<uint64_t>(value.size()));
+        m_out.insert(m_out.end(), value.begin(), value.end());
+    }
+
     const std::vector<uint8_t>& bytes() const {
         return m_out;
     }
@@ -69,6 +89,12 @@ public:
         return *m_cur++;
     }
 
+    /// \brief Returns the next byte without consuming it.
+    uint8_t peek_u8() const {
+        require(1);
+        return *m_cur;
+    }
+
     uint32_t read_u32() {
         require(4);
         uint32_t value = 0;
@@ -102,6 +128,32 @@ public:
         return std::string(begin, size);
     }
 
+    uint64_t read_varint() {
+        const int max_shift = 63;
+        uint64_t value = 0;
+        for (int shift = 0; shift <= max_shift; shift += 7) {
+            const uint8_t byte = read_u8();
+            value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+            if ((byte & 0x80u) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("MdbxLogger: varint is too long");
+    }
+
+    int64_t read_svarint() {
+        const uint64_t value = read_varint();
+        return static_cast<int64_t>((value >> 1) ^ (~(value & 1u) + 1u));
+    }
+
+    std::string read_varstring() {
+        const uint64_t size = read_varint();
+        require(size);
+        const char* begin = reinterpret_cast<const char*>(m_cur);
+        m_cur += size;
+        return std::string(begin, static_cast<size_t>(size));
+    }
+
     void finish() const {
         if (m_cur != m_end) {
             throw std::runtime_error("MdbxLogger: trailing bytes in serialized value");
@@ -112,8 +164,8 @@ private:
     const uint8_t* m_cur;
     const uint8_t* m_end;
 
-    void require(size_t size) const {
-        if (static_cast<size_t>(m_end - m_cur) < size) {
+    void require(uint64_t size) const {
+        if (static_cast<uint64_t>(m_end - m_cur) < size) {
             throw std::runtime_error("MdbxLogger: corrupted serialized value");
         }
     }
@@ -1,7 +1,7 @@
 #pragma once
 
 /// \file MdbxKeyUtils.hpp
-/// \brief Key encoding helpers for MdbxLogger record ordering.
+/// \brief Key encoding helpers for MdbxLogger record ordering and secondary indexes.
 
 #include <cstdint>
 #include <string>
@@ -22,13 +22,150 @@ inline void mdbx_write_record_sequence_be(std::string& key, uint32_t value, size
     }
 }
 
+const size_t MDBX_RECORD_KEY_SIZE = 12; ///< Bytes in a `timestamp+sequence` record key.
+const size_t MDBX_LEVEL_INDEX_PREFIX_SIZE = 1; ///< Level byte in front of a level index key.
+const size_t MDBX_U64_INDEX_PREFIX_SIZE = 8;   ///< Big-endian id in front of a file/session index key.
+
+/// \brief Maps a timestamp to the unsigned, order-preserving value stored in record keys.
+inline uint64_t mdbx_sortable_timestamp(int64_t timestamp_ms) {
+    return static_cast<uint64_t>(timestamp_ms) ^ 0x8000000000000000ULL;
+}
+
 inline std::string make_mdbx_record_key(int64_t timestamp_ms, uint32_t sequence) {
-    std::string key(12, '\0');
-    const uint64_t sortable_ts = static_cast<uint64_t>(timestamp_ms) ^ 0x8000000000000000ULL;
-    mdbx_write_record_key_be(key, sortable_ts, 0);
+    std::string key(MDBX_RECORD_KEY_SIZE, '\0');
+    mdbx_write_record_key_be(key, mdbx_sortable_timestamp(timestamp_ms), 0);
     mdbx_write_record_sequence_be(key, sequence, 8);
     return key;
 }
 
+/// \brief Decodes the timestamp and sequence of a record key.
+/// \return False when `key` is not a record key.
+inline bool parse_mdbx_record_key(const std::string& key, int64_t& timestamp_ms, uint32_t& sequence) {
+    if (key.size() != MDBX_RECORD_KEY_SIZE) {
+        return false;
+    }
+    uint64_t sortable_ts = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        sortable_ts = (sortable_ts << 8) | static_cast<unsigned char>(key[i]);
+    }
+    sequence = 0;
+    for (size_t i = 8; i < MDBX_RECORD_KEY_SIZE; ++i) {
+        sequence = (sequence << 8) | static_cast<unsigned char>(key[i]);
+    }
+    timestamp_ms = static_cast<int64_t>(sortable_ts ^ 0x8000000000000000ULL);
+    return true;
+}
+
+/// \brief Returns the record key that directly follows `key`.
+/// \return False when `key` is already the largest record key.
+inline bool next_mdbx_record_key(std::string& key) {
+    for (size_t i = key.size(); i > 0; --i) {
+        unsigned char byte = static_cast<unsigned char>(key[i - 1]);
+        if (byte != 0xFFu) {
+            key[i - 1] = static_cast<char>(byte + 1);
+            return true;
+        }
+        key[i - 1] = '\0';
+    }
+    return false;
+}
+
+/// \brief Returns the record key that directly precedes `key`.
+/// \return False when `key` is already the smallest record key.
+inline bool prev_mdbx_record_key(std::string& key) {
+    for (size_t i = key.size(); i > 0; --i) {
+        unsigned char byte = static_cast<unsigned char>(key[i - 1]);
+        if (byte != 0u) {
+            key[i - 1] = static_cast<char>(byte - 1);
+            return true;
+        }
+        key[i - 1] = static_cast<char>(0xFFu);
+    }
+    return false;
+}
+
+/// \brief Index key: one level byte followed by the record key.
+inline std::string make_mdbx_level_index_key(uint8_t level, const std::string& record_key) {
+    std::string key(MDBX_LEVEL_INDEX_PREFIX_SIZE, static_cast<char>(level));
+    key += record_key;
+    return key;
+}
+
+/// \brief Index key: a big-endian 64-bit id followed by the record key.
+inline std::string make_mdbx_u64_index_key(uint64_t id, const std::string& record_key) {
+    std::string key(MDBX_U64_INDEX_PREFIX_SIZE, '\0');
+    mdbx_write_record_key_be(key, id, 0);
+    key += record_key;
+    return key;
+}
+
+const size_t MDBX_ROLLUP_KEY_SIZE = 9;       ///< Bucket start and level byte of a level rollup key.
+const size_t MDBX_FILE_ROLLUP_KEY_SIZE = 17; ///< File hash, bucket start and level byte of a file rollup key.
+
+/// \brief Start of the `bucket_ms` bucket holding `timestamp_ms`; buckets are aligned to the epoch.
+inline int64_t mdbx_bucket_start(int64_t timestamp_ms, int64_t bucket_ms) {
+    int64_t bucket = timestamp_ms / bucket_ms;
+    if (timestamp_ms % bucket_ms < 0) {
+        --bucket;
+    }
+    // The first bucket would start below the smallest timestamp.
+    const int64_t first_bucket = (std::numeric_limits<int64_t>::min)() / bucket_ms;
+    return (bucket < first_bucket ? first_bucket : bucket) * bucket_ms;
+}
+
+/// \brief Level rollup key: bucket start followed by the level byte.
+inline std::string make_mdbx_rollup_key(int64_t bucket_start_ms, uint8_t level) {
+    std::string key(MDBX_ROLLUP_KEY_SIZE, static_cast<char>(level));
+    mdbx_write_record_key_be(key, mdbx_sortable_timestamp(bucket_start_ms), 0);
+    return key;
+}
+
+/// \brief File rollup key: file hash, bucket start and level byte, so one file's buckets are contiguous.
+inline std::string make_mdbx_file_rollup_key(uint64_t file_hash, int64_t bucket_start_ms, uint8_t level) {
+    std::string key(MDBX_FILE_ROLLUP_KEY_SIZE, static_cast<char>(level));
+    mdbx_write_record_key_be(key, file_hash, 0);
+    mdbx_write_record_key_be(key, mdbx_sortable_timestamp(bucket_start_ms), 8);
+    return key;
+}
+
+/// \brief Decodes the bucket start and level of a level or file rollup key.
+/// \return False when `key` is neither.
+inline bool parse_mdbx_rollup_key(const std::string& key, int64_t& bucket_start_ms, uint8_t& level) {
+    if (key.size() != MDBX_ROLLUP_KEY_SIZE && key.size() != MDBX_FILE_ROLLUP_KEY_SIZE) {
+        return false;
+    }
+    const size_t offset = key.size() - MDBX_ROLLUP_KEY_SIZE;
+    uint64_t sortable_ts = 0;
+    for (size_t i = offset; i < offset + 8; ++i) {
+        sortable_ts = (sortable_ts << 8) | static_cast<unsigned char>(key[i]);
+    }
+    bucket_start_ms = static_cast<int64_t>(sortable_ts ^ 0x8000000000000000ULL);
+    level = static_cast<uint8_t>(key[key.size() - 1]);
+    return true;
+}
+
+const size_t MDBX_TEXT_TRIGRAM_SIZE = 3; ///< Bytes of a trigram in front of a text posting key.
+
+/// \brief Text posting key: three trigram bytes followed by the batch key.
+/// \param batch_key Newest then oldest record key of the indexing batch.
+inline std::string make_mdbx_text_posting_key(uint32_t trigram, const std::string& batch_key) {
+    std::string key(MDBX_TEXT_TRIGRAM_SIZE, '\0');
+    key[0] = static_cast<char>((trigram >> 16) & 0xFFu);
+    key[1] = static_cast<char>((trigram >> 8) & 0xFFu);
+    key[2] = static_cast<char>(trigram & 0xFFu);
+    key += batch_key;
+    return key;
+}
+
+/// \brief 64-bit FNV-1a hash of a source file name used by the file index.
+inline uint64_t mdbx_file_index_hash(const std::string& file) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < file.size(); ++i) {
+        hash ^= static_cast<unsigned char>(file[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
 } // namespace detail
 } // namespace logit
@@ -0,0 +1,287 @@
+#pragma once
+#ifndef _LOGIT_DETAIL_MEMORY_ARENA_RING_HPP_INCLUDED
+#define _LOGIT_DETAIL_MEMORY_ARENA_RING_HPP_INCLUDED
+
+/// \file MemoryArenaRing.hpp
+/// \brief Fixed-capacity, mutex-free record ring backed by a contiguous byte arena.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace logit { namespace detail {
+
+    const std::size_t MEMORY_RING_DEFAULT_SLOTS = 65536;             ///< Slot count used when max_records is 0.
+    const std::size_t MEMORY_RING_DEFAULT_ARENA_BYTES = 16 * 1024 * 1024; ///< Message budget used when max_bytes is 0.
+
+    /// \struct MemoryLogEntry
+    /// \brief Compact record kept by in-memory buffers.
+    /// \details File and function names are interned handles, so each record
+    /// owns only its formatted message.
+    struct MemoryLogEntry {
+        LogLevel          level = LogLevel::LOG_LVL_TRACE; ///< Severity of the log entry.
+        int64_t           timestamp_ms = 0;                ///< Wall-clock timestamp in milliseconds.
+        InternedStringRef file;                            ///< Source file path or leaf name.
+        int               line = 0;                        ///< Source line number.
+        InternedStringRef function;                        ///< Function name captured at the call site.
+        std::string       message;                         ///< Formatted message text.
+
+        /// \brief Returns a view of this record.
+        LogEntryView view() const {
+            return LogEntryView(level, timestamp_ms, file.str(), line, function.str(), message);
+        }
+
+        /// \brief Copies this record into the public DTO.
+        BufferedLogEntry to_entry() const {
+            return view().to_entry();
+        }
+    };
+
+    /// \class MemoryArenaRing
+    /// \brief Multi-producer ring of variable-length records for in-memory buffers.
+    /// \details Messages are copied into one pre-sized byte arena; file and
+    /// function names are interned and stored in the slot as pointers.
+    /// Producers reserve a record index and an arena range with `fetch_add`
+    /// and never take a lock. Readers copy records out and
+    /// validate each one seqlock-style: a record is accepted only when its slot
+    /// sequence is unchanged after the copy and no producer has reserved arena
+    /// space over its bytes in the meantime.
+    ///
+    /// Progress: readers never delay producers and finish in a bounded number
+    /// of steps. Producers are not lock-free in the strict sense: a producer
+    /// whose slot is still being filled by a producer one full lap behind
+    /// yields until that write completes, so a producer preempted mid-write can
+    /// stall the one that laps it. With the slot count above the number of
+    /// concurrent producers this only happens when the ring wraps during a
+    /// single write.
+    ///
+    /// The arena is an array of 64-bit atomic words and payloads are copied a
+    /// word at a time with relaxed stores and loads, so a reader racing with a
+    /// producer that overwrites the bytes is not a data race; the copy is
+    /// simply discarded by the validation. Records are packed without padding:
+    /// a word shared with a neighbouring record is updated with masked
+    /// `fetch_and`/`fetch_or`, which leaves the neighbour's bytes untouched.
+    ///
+    /// Retention follows the MemoryLogger limits: the slot count bounds the
+    /// number of records, a running message-byte counter bounds the retained
+    /// message bytes, and readers skip records older than the age cutoff.
+    class MemoryArenaRing {
+    public:
+        /// \brief Creates a ring.
+        /// \param max_records Number of record slots (0 = 65536).
+        /// \param max_bytes Retained formatted-message bytes (0 = unlimited).
+        /// \param arena_bytes Arena size (0 = max_bytes, or 16 MiB when max_bytes is 0).
+        MemoryArenaRing(std::size_t max_records, std::size_t max_bytes, std::size_t arena_bytes) :
+                m_slot_count(max_records > 0 ? max_records : MEMORY_RING_DEFAULT_SLOTS),
+                m_max_bytes(max_bytes),
+                m_arena_size(arena_bytes > 0 ? arena_bytes : default_arena_size(max_bytes)),
+                m_slots(new Slot[m_slot_count]),
+                m_arena(new std::atomic<uint64_t>[(m_arena_size + ARENA_WORD_BYTES - 1) / ARENA_WORD_BYTES]()) {
+            for (std::size_t i = 0; i < m_slot_count; ++i) {
+                m_slots[i].seq.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        MemoryArenaRing(const MemoryArenaRing&) = delete;
+        MemoryArenaRing& operator=(const MemoryArenaRing&) = delete;
+
+        /// \brief Appends a record.
+        /// \return False when the payload exceeds the arena or the retained-byte
+        /// budget (it could never be read back), or when the slot was lapped by
+        /// newer records before it could be claimed.
+        bool push(
+                LogLevel level,
+                int64_t timestamp_ms,
+                const InternedStringRef& file,
+                int line,
+                const InternedStringRef& function,
+                const std::string& message) {
+            if (message.size() > m_arena_size) return false;
+            if (m_max_bytes > 0 && message.size() > m_max_bytes) return false;
+
+            const uint64_t index = m_next_index.fetch_add(1, std::memory_order_relaxed);
+            Slot& slot = m_slots[index % m_slot_count];
+            const uint64_t writing_seq = 2 * index + 1;
+            uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+            for (;;) {
+                if (seq >= writing_seq) return false;
+                if (seq & 1) {
+                    // A producer one lap behind is still filling this slot.
+                    std::this_thread::yield();
+                    seq = slot.seq.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (slot.seq.compare_exchange_weak(seq, writing_seq, std::memory_order_acq_rel)) break;
+            }
+
+            const uint64_t position = m_arena_head.fetch_add(message.size(), std::memory_order_relaxed);
+            // Orders the slot claim and arena reservation before the payload
+            // writes that readers validate against them.
+            std::atomic_thread_fence(std::memory_order_release);
+            write_arena(position, message.data(), message.size());
+
+            slot.position.store(position, std::memory_order_relaxed);
+            slot.timestamp_ms.store(timestamp_ms, std::memory_order_relaxed);
+            slot.file.store(file.entry(), std::memory_order_relaxed);
+            slot.function.store(function.entry(), std::memory_order_relaxed);
+            slot.message_size.store(message.size(), std::memory_order_relaxed);
+            slot.line.store(line, std::memory_order_relaxed);
+            slot.level.store(static_cast<int>(level), std::memory_order_relaxed);
+            slot.seq.store(writing_seq + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// \brief Copies the retained records, oldest first.
+        /// \param min_timestamp_ms Records older than this are skipped.
+        /// \param[out] out Receives the records.
+        void snapshot(int64_t min_timestamp_ms, std::vector<MemoryLogEntry>& out) const {
+            out.clear();
+            const uint64_t end = m_next_index.load(std::memory_order_acquire);
+            const uint64_t message_total = m_arena_head.load(std::memory_order_acquire);
+            uint64_t begin = end > m_slot_count ? end - m_slot_count : 0;
+            begin = (std::max)(begin, m_clear_index.load(std::memory_order_acquire));
+            out.reserve(static_cast<std::size_t>(end - begin));
+
+            MemoryLogEntry entry;
+            for (uint64_t index = begin; index < end; ++index) {
+                if (read_slot(index, min_timestamp_ms, message_total, entry)) {
+                    out.push_back(entry);
+                }
+            }
+        }
+
+        /// \brief Drops every record written so far.
+        /// \param min_timestamp_ms Age cutoff used to count the retained records.
+        /// \return Number of records that were retained before the call.
+        std::size_t clear(int64_t min_timestamp_ms) {
+            std::vector<MemoryLogEntry> entries;
+            snapshot(min_timestamp_ms, entries);
+            const uint64_t end = m_next_index.load(std::memory_order_acquire);
+            uint64_t current = m_clear_index.load(std::memory_order_relaxed);
+            while (current < end &&
+                   !m_clear_index.compare_exchange_weak(current, end, std::memory_order_acq_rel)) {
+            }
+            return entries.size();
+        }
+
+        /// \brief Arena size in bytes.
+        std::size_t arena_size() const { return m_arena_size; }
+
+    private:
+        static const std::size_t ARENA_WORD_BYTES = sizeof(uint64_t); ///< Bytes per arena word.
+
+        /// \brief Record descriptor; fields are valid while `seq` is even and unchanged.
+        struct Slot {
+            std::atomic<uint64_t> seq;           ///< 0 = empty, 2*i+1 = writing record i, 2*i+2 = record i committed.
+            std::atomic<uint64_t> position;      ///< Arena position of the message (message bytes written before it).
+            std::atomic<int64_t>  timestamp_ms;  ///< Record timestamp.
+            std::atomic<uint64_t> message_size;  ///< Message length.
+            std::atomic<const InternedString*> file;     ///< Interned file name.
+            std::atomic<const InternedString*> function; ///< Interned function name.
+            std::atomic<int>      line;          ///< Source line.
+            std::atomic<int>      level;         ///< Log level.
+        };
+
+        static std::size_t default_arena_size(std::size_t max_bytes) {
+            return max_bytes > 0 ? max_bytes : MEMORY_RING_DEFAULT_ARENA_BYTES;
+        }
+
+        bool read_slot(uint64_t index, int64_t min_timestamp_ms, uint64_t message_total, MemoryLogEntry& entry) const {
+            const Slot& slot = m_slots[index % m_slot_count];
+            const uint64_t committed_seq = 2 * index + 2;
+            if (slot.seq.load(std::memory_order_acquire) != committed_seq) return false;
+
+            const uint64_t position = slot.position.load(std::memory_order_relaxed);
+            const int64_t timestamp_ms = slot.timestamp_ms.load(std::memory_order_relaxed);
+            const uint64_t message_size = slot.message_size.load(std::memory_order_relaxed);
+            if (timestamp_ms < min_timestamp_ms) return false;
+            if (m_max_bytes > 0 && message_total - position > m_max_bytes) return false;
+            if (message_size > m_arena_size) return false;
+
+            entry.level = static_cast<LogLevel>(slot.level.load(std::memory_order_relaxed));
+            entry.timestamp_ms = timestamp_ms;
+            entry.line = slot.line.load(std::memory_order_relaxed);
+            entry.file = InternedStringRef(slot.file.load(std::memory_order_relaxed));
+            entry.function = InternedStringRef(slot.function.load(std::memory_order_relaxed));
+            read_arena(position, static_cast<std::size_t>(message_size), entry.message);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != committed_seq) return false;
+            return m_arena_head.load(std::memory_order_relaxed) <= position + m_arena_size;
+        }
+
+        void write_arena(uint64_t position, const char* data, std::size_t size) {
+            if (size == 0) return;
+            const std::size_t offset = static_cast<std::size_t>(position % m_arena_size);
+            const std::size_t first = (std::min)(size, m_arena_size - offset);
+            store_bytes(offset, data, first);
+            if (first < size) {
+                store_bytes(0, data + first, size - first);
+            }
+        }
+
+        void read_arena(uint64_t position, std::size_t size, std::string& out) const {
+            out.resize(size);
+            if (size == 0) return;
+            const std::size_t offset = static_cast<std::size_t>(position % m_arena_size);
+            const std::size_t first = (std::min)(size, m_arena_size - offset);
+            load_bytes(&out[0], offset, first);
+            if (first < size) {
+                load_bytes(&out[first], 0, size - first);
+            }
+        }
+
+        /// \brief Copies `size` bytes to arena byte `offset`, one word at a time.
+        void store_bytes(std::size_t offset, const char* src, std::size_t size) {
+            while (size > 0) {
+                std::atomic<uint64_t>& word = m_arena[offset / ARENA_WORD_BYTES];
+                const std::size_t shift = offset % ARENA_WORD_BYTES;
+                const std::size_t count = (std::min)(size, ARENA_WORD_BYTES - shift);
+                uint64_t bits = 0;
+                std::memcpy(reinterpret_cast<unsigned char*>(&bits) + shift, src, count);
+                if (count == ARENA_WORD_BYTES) {
+                    word.store(bits, std::memory_order_relaxed);
+                } else {
+                    uint64_t mask = 0;
+                    std::memset(reinterpret_cast<unsigned char*>(&mask) + shift, 0xFF, count);
+                    word.fetch_and(~mask, std::memory_order_relaxed);
+                    word.fetch_or(bits, std::memory_order_relaxed);
+                }
+                offset += count;
+                src += count;
+                size -= count;
+            }
+        }
+
+        /// \brief Copies `size` bytes from arena byte `offset`, one word at a time.
+        void load_bytes(char* dst, std::size_t offset, std::size_t size) const {
+            while (size > 0) {
+                const uint64_t bits = m_arena[offset / ARENA_WORD_BYTES].load(std::memory_order_relaxed);
+                const std::size_t shift = offset % ARENA_WORD_BYTES;
+                const std::size_t count = (std::min)(size, ARENA_WORD_BYTES - shift);
+                std::memcpy(dst, reinterpret_cast<const unsigned char*>(&bits) + shift, count);
+                offset += count;
+                dst += count;
+                size -= count;
+            }
+        }
+
+        const std::size_t           m_slot_count;  ///< Number of record slots.
+        const std::size_t           m_max_bytes;   ///< Retained message-byte budget (0 = unlimited).
+        const std::size_t           m_arena_size;  ///< Size of the payload arena.
+        std::unique_ptr<Slot[]>     m_slots;       ///< Record descriptors.
+        std::unique_ptr<std::atomic<uint64_t>[]> m_arena; ///< Payload words, accessed with relaxed atomics.
+        std::atomic<uint64_t>       m_next_index{0};    ///< Index of the next record.
+        std::atomic<uint64_t>       m_arena_head{0};    ///< Total message bytes reserved.
+        std::atomic<uint64_t>       m_clear_index{0};   ///< Records below this index were cleared.
+    };
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_DETAIL_MEMORY_ARENA_RING_HPP_INCLUDED
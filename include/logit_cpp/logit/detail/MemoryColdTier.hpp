@@ -0,0 +1,208 @@
+#pragma once
+#ifndef _LOGIT_DETAIL_MEMORY_COLD_TIER_HPP_INCLUDED
+#define _LOGIT_DETAIL_MEMORY_COLD_TIER_HPP_INCLUDED
+
+/// \file MemoryColdTier.hpp
+/// \brief Compressed blocks of older in-memory log records.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace logit { namespace detail {
+
+    /// \class MemoryColdTier
+    /// \brief Sealed, compressed record blocks kept behind the MemoryLogger hot buffer.
+    /// \details Each block stores a run of records in insertion order, encoded
+    /// as fixed-width headers (level, timestamp, line, interned file and
+    /// function ids, message length) followed by the message bytes, and then
+    /// compressed with gzip or zstd. The block keeps its record count and
+    /// min/max timestamps uncompressed, so range queries decompress only the
+    /// blocks that overlap the requested window. Blocks are immutable and
+    /// shared, so a reader can pin them and decode outside the owner's lock,
+    /// and a writer can compress a block outside the lock before appending it.
+    /// Other calls are not thread-safe; the owner serializes them.
+    class MemoryColdTier {
+    public:
+        /// \struct Block
+        /// \brief One sealed block.
+        struct Block {
+            int64_t     min_timestamp_ms = 0; ///< Oldest record timestamp.
+            int64_t     max_timestamp_ms = 0; ///< Newest record timestamp.
+            std::size_t records = 0;          ///< Number of records.
+            bool        is_time_sorted = true; ///< True when timestamps never decrease.
+            std::string data;                 ///< Compressed encoded records.
+        };
+
+        /// \brief Creates a tier.
+        /// \param type GZIP or ZSTD; any other value disables the tier.
+        /// \param level Compression level.
+        MemoryColdTier(CompressType type, int level) :
+                m_type(type),
+                m_level(level) {}
+
+        /// \brief True when the configured codec can be used.
+        /// \details Turns false after the first compression failure, e.g. when
+        /// the codec library is not linked, so callers fall back to eviction.
+        bool is_enabled() const {
+            return !m_is_failed && (m_type == CompressType::GZIP || m_type == CompressType::ZSTD);
+        }
+
+        /// \brief Compresses the first `count` records of `entries` into a new block.
+        /// \details Does not modify the tier, so it is safe to call concurrently
+        /// with the owner's other calls; the result is stored by append().
+        /// \return The block, or null when compression failed.
+        template <class Container>
+        std::shared_ptr<const Block> compress(const Container& entries, std::size_t count) const {
+            std::shared_ptr<Block> sealed = std::make_shared<Block>();
+            Block& block = *sealed;
+            std::string raw;
+            for (std::size_t i = 0; i < count; ++i) {
+                const MemoryLogEntry& entry = entries[i];
+                if (block.records == 0) {
+                    block.min_timestamp_ms = entry.timestamp_ms;
+                    block.max_timestamp_ms = entry.timestamp_ms;
+                } else {
+                    if (entry.timestamp_ms < block.max_timestamp_ms) block.is_time_sorted = false;
+                    if (entry.timestamp_ms < block.min_timestamp_ms) block.min_timestamp_ms = entry.timestamp_ms;
+                    if (entry.timestamp_ms > block.max_timestamp_ms) block.max_timestamp_ms = entry.timestamp_ms;
+                }
+                ++block.records;
+                append(raw, static_cast<int32_t>(entry.level));
+                append(raw, entry.timestamp_ms);
+                append(raw, static_cast<int32_t>(entry.line));
+                append(raw, entry.file.id());
+                append(raw, entry.function.id());
+                append(raw, static_cast<uint32_t>(entry.message.size()));
+                raw.append(entry.message);
+            }
+            const bool is_compressed = m_type == CompressType::ZSTD
+                ? compress_string_zstd(raw, block.data, m_level)
+                : compress_string_gzip(raw, block.data, m_level);
+            if (!is_compressed) return std::shared_ptr<const Block>();
+            return sealed;
+        }
+
+        /// \brief Stores a block made by compress() as the newest one.
+        /// \param block Block to store; null records a compression failure.
+        /// \return False when the block is null; the tier is then disabled.
+        bool append(std::shared_ptr<const Block> block) {
+            if (!block) {
+                m_is_failed = true;
+                return false;
+            }
+            m_bytes += block->data.size();
+            m_records += block->records;
+            m_blocks.push_back(std::move(block));
+            return true;
+        }
+
+        /// \brief Decompresses a block.
+        /// \details Safe to call concurrently with the owner's other calls.
+        /// \param block Block to decode.
+        /// \param[out] out Receives the records in insertion order.
+        /// \return False when the block cannot be decoded.
+        bool decode(const Block& block, std::vector<MemoryLogEntry>& out) const {
+            out.clear();
+            std::string raw;
+            const bool is_decompressed = m_type == CompressType::ZSTD
+                ? decompress_string_zstd(block.data, raw)
+                : decompress_string_gzip(block.data, raw);
+            if (!is_decompressed) return false;
+
+            out.reserve(block.records);
+            const StringInterner& interner = StringInterner::instance();
+            std::size_t offset = 0;
+            while (offset < raw.size()) {
+                int32_t level = 0;
+                int32_t line = 0;
+                uint32_t file_id = 0;
+                uint32_t function_id = 0;
+                uint32_t message_size = 0;
+                MemoryLogEntry entry;
+                if (!read(raw, offset, level) ||
+                    !read(raw, offset, entry.timestamp_ms) ||
+                    !read(raw, offset, line) ||
+                    !read(raw, offset, file_id) ||
+                    !read(raw, offset, function_id) ||
+                    !read(raw, offset, message_size) ||
+                    raw.size() - offset < message_size) {
+                    return false;
+                }
+                entry.level = static_cast<LogLevel>(level);
+                entry.line = line;
+                entry.file = InternedStringRef(interner.find(file_id));
+                entry.function = InternedStringRef(interner.find(function_id));
+                entry.message.assign(raw, offset, message_size);
+                offset += message_size;
+                out.push_back(std::move(entry));
+            }
+            return true;
+        }
+
+        /// \brief Sealed blocks, oldest first.
+        const std::deque<std::shared_ptr<const Block> >& blocks() const { return m_blocks; }
+
+        /// \brief Drops the oldest block.
+        void pop_front() {
+            if (m_blocks.empty()) return;
+            m_bytes -= m_blocks.front()->data.size();
+            m_records -= m_blocks.front()->records;
+            m_blocks.pop_front();
+        }
+
+        /// \brief Drops leading blocks whose newest record is older than `cutoff_ms`.
+        void evict_expired(int64_t cutoff_ms) {
+            while (!m_blocks.empty() && m_blocks.front()->max_timestamp_ms < cutoff_ms) {
+                pop_front();
+            }
+        }
+
+        /// \brief Drops every block.
+        void clear() {
+            m_blocks.clear();
+            m_bytes = 0;
+            m_records = 0;
+        }
+
+        /// \brief True when no block is stored.
+        bool empty() const { return m_blocks.empty(); }
+
+        /// \brief Compressed bytes held by all blocks.
+        std::size_t bytes() const { return m_bytes; }
+
+        /// \brief Records held by all blocks.
+        std::size_t records() const { return m_records; }
+
+    private:
+        template <class T>
+        static void append(std::string& out, T value) {
+            char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            out.append(bytes, sizeof(T));
+        }
+
+        template <class T>
+        static bool read(const std::string& in, std::size_t& offset, T& value) {
+            if (in.size() - offset < sizeof(T)) return false;
+            std::memcpy(&value, in.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+
+        const CompressType m_type;       ///< Block codec.
+        const int         m_level;       ///< Compression level.
+        bool              m_is_failed = false; ///< Set after a compression failure.
+        std::deque<std::shared_ptr<const Block> > m_blocks; ///< Sealed blocks, oldest first.
+        std::size_t       m_bytes = 0;   ///< Sum of compressed block sizes.
+        std::size_t       m_records = 0; ///< Sum of block record counts.
+    };
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_DETAIL_MEMORY_COLD_TIER_HPP_INCLUDED
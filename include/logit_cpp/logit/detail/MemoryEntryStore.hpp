@@ -0,0 +1,148 @@
+#pragma once
+#ifndef _LOGIT_DETAIL_MEMORY_ENTRY_STORE_HPP_INCLUDED
+#define _LOGIT_DETAIL_MEMORY_ENTRY_STORE_HPP_INCLUDED
+
+/// \file MemoryEntryStore.hpp
+/// \brief Chunked FIFO of in-memory log records that readers can pin.
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace logit { namespace detail {
+
+    const std::size_t MEMORY_STORE_CHUNK_ENTRIES = 128; ///< Records per chunk.
+
+    /// \class MemoryEntryStore
+    /// \brief FIFO of MemoryLogEntry records kept in fixed-size, shared chunks.
+    /// \details A record is constructed once in its chunk slot and never moved
+    /// or modified afterwards. Chunks are reference counted, so `snapshot()`
+    /// pins the current records by copying one `shared_ptr` per chunk. Readers
+    /// can then walk the pinned records without the owner's lock while
+    /// producers keep appending to new slots and evicting from the front;
+    /// evicted records are destroyed when the last pin on their chunk goes
+    /// away. Mutating calls and `snapshot()` must be serialized by the owner.
+    class MemoryEntryStore {
+    private:
+        /// \brief Fixed-capacity block of records.
+        struct Chunk {
+            Chunk() : count(0) {}
+
+            ~Chunk() {
+                for (std::size_t i = 0; i < count; ++i) {
+                    at(i)->~MemoryLogEntry();
+                }
+            }
+
+            Chunk(const Chunk&) = delete;
+            Chunk& operator=(const Chunk&) = delete;
+
+            MemoryLogEntry* at(std::size_t i) {
+                return reinterpret_cast<MemoryLogEntry*>(&storage[i]);
+            }
+
+            const MemoryLogEntry* at(std::size_t i) const {
+                return reinterpret_cast<const MemoryLogEntry*>(&storage[i]);
+            }
+
+            typename std::aligned_storage<sizeof(MemoryLogEntry), alignof(MemoryLogEntry)>::type
+                storage[MEMORY_STORE_CHUNK_ENTRIES]; ///< Record slots.
+            std::size_t count; ///< Constructed slots; written only by the owner.
+        };
+
+    public:
+        /// \class Snapshot
+        /// \brief Pinned, immutable range of records.
+        class Snapshot {
+        public:
+            Snapshot() : m_begin(0), m_size(0) {}
+
+            std::size_t size() const { return m_size; }
+
+            bool empty() const { return m_size == 0; }
+
+            const MemoryLogEntry& operator[](std::size_t i) const {
+                const std::size_t position = m_begin + i;
+                return *m_chunks[position / MEMORY_STORE_CHUNK_ENTRIES]->at(position % MEMORY_STORE_CHUNK_ENTRIES);
+            }
+
+        private:
+            friend class MemoryEntryStore;
+
+            std::vector<std::shared_ptr<const Chunk> > m_chunks; ///< Pinned chunks.
+            std::size_t m_begin; ///< Offset of the first record in the first chunk.
+            std::size_t m_size;  ///< Number of pinned records.
+        };
+
+        MemoryEntryStore() = default;
+
+        MemoryEntryStore(const MemoryEntryStore&) = delete;
+        MemoryEntryStore& operator=(const MemoryEntryStore&) = delete;
+
+        /// \brief Appends a record.
+        void push_back(MemoryLogEntry&& entry) {
+            if (m_chunks.empty() || m_chunks.back()->count == MEMORY_STORE_CHUNK_ENTRIES) {
+                m_chunks.push_back(std::make_shared<Chunk>());
+            }
+            Chunk& chunk = *m_chunks.back();
+            new (chunk.at(chunk.count)) MemoryLogEntry(std::move(entry));
+            ++chunk.count;
+            ++m_size;
+        }
+
+        /// \brief Evicts the oldest record.
+        void pop_front() {
+            if (m_size == 0) return;
+            --m_size;
+            if (m_size == 0) {
+                clear();
+                return;
+            }
+            if (++m_begin == MEMORY_STORE_CHUNK_ENTRIES) {
+                m_chunks.pop_front();
+                m_begin = 0;
+            }
+        }
+
+        /// \brief Evicts every record.
+        void clear() {
+            m_chunks.clear();
+            m_begin = 0;
+            m_size = 0;
+        }
+
+        const MemoryLogEntry& operator[](std::size_t i) const {
+            const std::size_t position = m_begin + i;
+            return *m_chunks[position / MEMORY_STORE_CHUNK_ENTRIES]->at(position % MEMORY_STORE_CHUNK_ENTRIES);
+        }
+
+        const MemoryLogEntry& front() const { return (*this)[0]; }
+
+        const MemoryLogEntry& back() const { return (*this)[m_size - 1]; }
+
+        std::size_t size() const { return m_size; }
+
+        bool empty() const { return m_size == 0; }
+
+        /// \brief Pins the current records.
+        Snapshot snapshot() const {
+            Snapshot snapshot;
+            snapshot.m_chunks.assign(m_chunks.begin(), m_chunks.end());
+            snapshot.m_begin = m_begin;
+            snapshot.m_size = m_size;
+            return snapshot;
+        }
+
+    private:
+        std::deque<std::shared_ptr<Chunk> > m_chunks; ///< Chunks, oldest first.
+        std::size_t m_begin = 0; ///< Offset of the oldest record in the first chunk.
+        std::size_t m_size = 0;  ///< Number of live records.
+    };
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_DETAIL_MEMORY_ENTRY_STORE_HPP_INCLUDED
@@ -0,0 +1,310 @@
+#pragma once
+#ifndef _LOGIT_DETAIL_SEEKABLE_ARCHIVE_HPP_INCLUDED
+#define _LOGIT_DETAIL_SEEKABLE_ARCHIVE_HPP_INCLUDED
+
+/// \file SeekableArchive.hpp
+/// \brief Seek table for log files made of independent gzip members or zstd frames.
+///
+/// The table lists every compressed frame with its offset, sizes and the
+/// timestamp range of the records it holds. It is appended to the file as an
+/// item that standard decoders skip:
+/// - zstd: a skippable frame (magic 0x184D2A5B);
+/// - gzip: empty members whose FEXTRA fields carry the table; a table larger
+///   than one FEXTRA field is split over several members.
+///
+/// Table layout (little-endian):
+/// `u32 version, u32 count, count * {u64 offset, u32 compressed_size,
+/// u32 size, i64 first_ts_ms, i64 last_ts_ms}, u32 table_size, "LOGITSEK"`.
+///
+/// Plain-text log files use the same table as a `.idx` time index sidecar;
+/// there each entry is a block of lines and both size fields hold its length.
+/// Frames of archives compressed without a time index span the whole int64
+/// timestamp range.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace logit {
+namespace detail {
+
+/// \brief Describes one independently decompressible frame of a seekable log file.
+struct SeekFrameEntry {
+    uint64_t offset = 0;          ///< Offset of the compressed frame in the file.
+    uint32_t compressed_size = 0; ///< Size of the compressed frame.
+    uint32_t size = 0;            ///< Size of the uncompressed frame content.
+    int64_t  first_ts_ms = 0;     ///< Smallest record timestamp in the frame.
+    int64_t  last_ts_ms = 0;      ///< Largest record timestamp in the frame.
+};
+
+static const char     SEEK_TABLE_MAGIC[8] = {'L', 'O', 'G', 'I', 'T', 'S', 'E', 'K'};
+static const uint32_t SEEK_TABLE_VERSION = 1;
+static const uint32_t SEEK_TABLE_ZSTD_SKIPPABLE_MAGIC = 0x184D2A5Bu;
+static const size_t   SEEK_TABLE_ENTRY_SIZE = 32;
+static const size_t   SEEK_TABLE_FOOTER_SIZE = 12;
+static const size_t   SEEK_TABLE_GZIP_TAIL_SIZE = 10;
+static const size_t   SEEK_TABLE_GZIP_MAX_SIZE = 65535 - 4; ///< Table bytes carried by one gzip member.
+static const size_t   SEEK_TABLE_GZIP_HEADER_SIZE = 16;
+
+inline void seek_table_put_u32(std::string& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFFu));
+    }
+}
+
+inline void seek_table_put_u64(std::string& out, uint64_t value) {
+    for (int shift = 0; shift < 64; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFFu));
+    }
+}
+
+inline uint32_t seek_table_get_u32(const char* data) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; --i) {
+        value = (value << 8) | static_cast<uint8_t>(data[i]);
+    }
+    return value;
+}
+
+inline uint64_t seek_table_get_u64(const char* data) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | static_cast<uint8_t>(data[i]);
+    }
+    return value;
+}
+
+/// \brief Serializes the seek table body shared by both containers.
+/// \param entries Frames in file order.
+/// \return Encoded table including its footer.
+inline std::string encode_seek_table(const std::vector<SeekFrameEntry>& entries) {
+    std::string out;
+    out.reserve(8 + entries.size() * SEEK_TABLE_ENTRY_SIZE + SEEK_TABLE_FOOTER_SIZE);
+    seek_table_put_u32(out, SEEK_TABLE_VERSION);
+    seek_table_put_u32(out, static_cast<uint32_t>(entries.size()));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        seek_table_put_u64(out, entries[i].offset);
+        seek_table_put_u32(out, entries[i].compressed_size);
+        seek_table_put_u32(out, entries[i].size);
+        seek_table_put_u64(out, static_cast<uint64_t>(entries[i].first_ts_ms));
+        seek_table_put_u64(out, static_cast<uint64_t>(entries[i].last_ts_ms));
+    }
+    seek_table_put_u32(out, static_cast<uint32_t>(out.size() + SEEK_TABLE_FOOTER_SIZE));
+    out.append(SEEK_TABLE_MAGIC, sizeof(SEEK_TABLE_MAGIC));
+    return out;
+}
+
+/// \brief Parses a seek table produced by encode_seek_table().
+/// \param data Encoded table including its footer.
+/// \param[out] entries Parsed frames.
+/// \return true when the table is well-formed.
+inline bool decode_seek_table(const std::string& data, std::vector<SeekFrameEntry>& entries) {
+    entries.clear();
+    if (data.size() < 8 + SEEK_TABLE_FOOTER_SIZE) return false;
+    if (seek_table_get_u32(data.data()) != SEEK_TABLE_VERSION) return false;
+    const uint32_t count = seek_table_get_u32(data.data() + 4);
+    if (data.size() != 8 + static_cast<size_t>(count) * SEEK_TABLE_ENTRY_SIZE + SEEK_TABLE_FOOTER_SIZE) {
+        return false;
+    }
+    entries.resize(count);
+    const char* cur = data.data() + 8;
+    for (uint32_t i = 0; i < count; ++i, cur += SEEK_TABLE_ENTRY_SIZE) {
+        entries[i].offset = seek_table_get_u64(cur);
+        entries[i].compressed_size = seek_table_get_u32(cur + 8);
+        entries[i].size = seek_table_get_u32(cur + 12);
+        entries[i].first_ts_ms = static_cast<int64_t>(seek_table_get_u64(cur + 16));
+        entries[i].last_ts_ms = static_cast<int64_t>(seek_table_get_u64(cur + 24));
+    }
+    return true;
+}
+
+/// \brief Appends an empty gzip member whose FEXTRA field carries `size` table bytes.
+inline void append_seek_table_gzip_member(std::string& out, const char* data, size_t size) {
+    static const unsigned char header[10] = {0x1f, 0x8b, 0x08, 0x04, 0, 0, 0, 0, 0, 0xff};
+    out.append(reinterpret_cast<const char*>(header), sizeof(header));
+    const uint16_t xlen = static_cast<uint16_t>(size + 4);
+    out.push_back(static_cast<char>(xlen & 0xFFu));
+    out.push_back(static_cast<char>((xlen >> 8) & 0xFFu));
+    out.push_back('L');
+    out.push_back('S');
+    out.push_back(static_cast<char>(size & 0xFFu));
+    out.push_back(static_cast<char>((size >> 8) & 0xFFu));
+    out.append(data, size);
+    static const unsigned char empty_deflate_and_trailer[SEEK_TABLE_GZIP_TAIL_SIZE] = {0x03, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    out.append(reinterpret_cast<const char*>(empty_deflate_and_trailer), sizeof(empty_deflate_and_trailer));
+}
+
+/// \brief Wraps the seek table into items that gzip/zstd decoders skip.
+/// \details A gzip table larger than SEEK_TABLE_GZIP_MAX_SIZE is split over several
+/// members; all but the first carry exactly SEEK_TABLE_GZIP_MAX_SIZE bytes, so
+/// read_seek_table() can walk them back from the end of the file.
+/// \param is_gzip True for gzip files, false for zstd files.
+/// \param entries Frames in file order.
+/// \param[out] out Bytes to append to the file.
+/// \return false when there are no frames to describe.
+inline bool make_seek_table_trailer(bool is_gzip, const std::vector<SeekFrameEntry>& entries, std::string& out) {
+    out.clear();
+    if (entries.empty()) return false;
+    const std::string table = encode_seek_table(entries);
+    if (!is_gzip) {
+        seek_table_put_u32(out, SEEK_TABLE_ZSTD_SKIPPABLE_MAGIC);
+        seek_table_put_u32(out, static_cast<uint32_t>(table.size()));
+        out += table;
+        return true;
+    }
+    const size_t members = (table.size() + SEEK_TABLE_GZIP_MAX_SIZE - 1) / SEEK_TABLE_GZIP_MAX_SIZE;
+    out.reserve(table.size() + members * (SEEK_TABLE_GZIP_HEADER_SIZE + SEEK_TABLE_GZIP_TAIL_SIZE));
+    const size_t first_size = table.size() - (members - 1) * SEEK_TABLE_GZIP_MAX_SIZE;
+    append_seek_table_gzip_member(out, table.data(), first_size);
+    for (size_t pos = first_size; pos < table.size(); pos += SEEK_TABLE_GZIP_MAX_SIZE) {
+        append_seek_table_gzip_member(out, table.data() + pos, SEEK_TABLE_GZIP_MAX_SIZE);
+    }
+    return true;
+}
+
+/// \brief Reads the seek table stored at the end of a file.
+/// \param path File path in the native encoding.
+/// \param is_gzip True for gzip files, false for zstd files.
+/// \param[out] entries Parsed frames.
+/// \param[out] table_offset Offset where the trailer item starts.
+/// \return true when the file ends with a valid seek table.
+inline bool read_seek_table(const std::string& path, bool is_gzip, std::vector<SeekFrameEntry>& entries, uint64_t& table_offset) {
+    entries.clear();
+    std::ifstream in(path.c_str(), std::ios_base::binary);
+    if (!in.is_open()) return false;
+    in.seekg(0, std::ios::end);
+    const std::streamoff file_size = in.tellg();
+    std::streamoff tail = file_size - static_cast<std::streamoff>(is_gzip ? SEEK_TABLE_GZIP_TAIL_SIZE : 0);
+    if (tail < static_cast<std::streamoff>(SEEK_TABLE_FOOTER_SIZE)) return false;
+
+    char footer[SEEK_TABLE_FOOTER_SIZE];
+    in.seekg(tail - static_cast<std::streamoff>(SEEK_TABLE_FOOTER_SIZE));
+    if (!in.read(footer, sizeof(footer))) return false;
+    if (std::memcmp(footer + 4, SEEK_TABLE_MAGIC, sizeof(SEEK_TABLE_MAGIC)) != 0) return false;
+    const uint32_t table_size = seek_table_get_u32(footer);
+    if (table_size < 8 + SEEK_TABLE_FOOTER_SIZE) return false;
+
+    std::string table(table_size, '\0');
+    if (!is_gzip) {
+        if (static_cast<std::streamoff>(table_size) + 8 > tail) return false;
+        const std::streamoff table_start = tail - static_cast<std::streamoff>(table_size);
+        in.seekg(table_start);
+        if (!in.read(&table[0], static_cast<std::streamsize>(table.size()))) return false;
+        table_offset = static_cast<uint64_t>(table_start) - 8;
+        return decode_seek_table(table, entries);
+    }
+
+    // Walks the table members back from the end of the file.
+    size_t remaining = table_size;
+    while (remaining > 0) {
+        const size_t part = (std::min)(remaining, SEEK_TABLE_GZIP_MAX_SIZE);
+        const std::streamoff part_start = tail - static_cast<std::streamoff>(part);
+        if (part_start < static_cast<std::streamoff>(SEEK_TABLE_GZIP_HEADER_SIZE)) return false;
+        char header[SEEK_TABLE_GZIP_HEADER_SIZE];
+        in.seekg(part_start - static_cast<std::streamoff>(SEEK_TABLE_GZIP_HEADER_SIZE));
+        if (!in.read(header, sizeof(header))) return false;
+        const size_t stored = static_cast<uint8_t>(header[14]) | (static_cast<size_t>(static_cast<uint8_t>(header[15])) << 8);
+        if (static_cast<uint8_t>(header[0]) != 0x1f || static_cast<uint8_t>(header[1]) != 0x8b ||
+            header[12] != 'L' || header[13] != 'S' || stored != part) {
+            return false;
+        }
+        remaining -= part;
+        in.seekg(part_start);
+        if (!in.read(&table[remaining], static_cast<std::streamsize>(part))) return false;
+        tail = part_start - static_cast<std::streamoff>(SEEK_TABLE_GZIP_HEADER_SIZE);
+        if (remaining > 0) tail -= static_cast<std::streamoff>(SEEK_TABLE_GZIP_TAIL_SIZE);
+    }
+    table_offset = static_cast<uint64_t>(tail);
+    return decode_seek_table(table, entries);
+}
+
+/// \brief Reads one compressed frame from a file.
+/// \param in Open binary stream.
+/// \param entry Frame to read.
+/// \param[out] out Compressed frame bytes.
+/// \return true on success.
+inline bool read_seek_frame(std::ifstream& in, const SeekFrameEntry& entry, std::string& out) {
+    out.resize(entry.compressed_size);
+    in.clear();
+    in.seekg(static_cast<std::streamoff>(entry.offset));
+    if (entry.compressed_size == 0) return true;
+    return static_cast<bool>(in.read(&out[0], static_cast<std::streamsize>(out.size())));
+}
+
+/// \brief Finds the frames that may hold records in `[from_ms, to_ms]`.
+/// \details Frames are appended in write order, so their timestamp ranges usually
+/// grow and two binary searches bound the range. Records written out of timestamp
+/// order break that assumption; such tables are scanned linearly instead.
+/// \param entries Frames in file order.
+/// \param from_ms Start of the requested time range.
+/// \param to_ms End of the requested time range, inclusive.
+/// \return Half-open index range of candidate frames; each still needs an overlap check.
+inline std::pair<size_t, size_t> find_seek_frame_range(
+        const std::vector<SeekFrameEntry>& entries,
+        int64_t from_ms,
+        int64_t to_ms) {
+    bool is_ordered = true;
+    for (size_t i = 1; i < entries.size() && is_ordered; ++i) {
+        is_ordered = entries[i - 1].first_ts_ms <= entries[i].first_ts_ms &&
+                     entries[i - 1].last_ts_ms <= entries[i].last_ts_ms;
+    }
+    if (is_ordered) {
+        const std::vector<SeekFrameEntry>::const_iterator first = std::partition_point(
+            entries.begin(), entries.end(),
+            [from_ms](const SeekFrameEntry& entry) { return entry.last_ts_ms < from_ms; });
+        const std::vector<SeekFrameEntry>::const_iterator last = std::partition_point(
+            first, entries.end(),
+            [to_ms](const SeekFrameEntry& entry) { return entry.first_ts_ms <= to_ms; });
+        return std::make_pair(static_cast<size_t>(first - entries.begin()),
+                              static_cast<size_t>(last - entries.begin()));
+    }
+    size_t first = entries.size();
+    size_t last = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].last_ts_ms < from_ms || entries[i].first_ts_ms > to_ms) continue;
+        if (first == entries.size()) first = i;
+        last = i + 1;
+    }
+    return first < last ? std::make_pair(first, last) : std::make_pair(entries.size(), entries.size());
+}
+
+/// \brief Writes the time index sidecar of a plain-text log file.
+/// \param path Sidecar path in the native encoding.
+/// \param entries Blocks in file order.
+/// \return true on success.
+inline bool write_time_index_file(const std::string& path, const std::vector<SeekFrameEntry>& entries) {
+    const std::string table = encode_seek_table(entries);
+    std::ofstream out(path.c_str(), std::ios_base::binary | std::ios_base::trunc);
+    if (!out.is_open()) return false;
+    out.write(table.data(), static_cast<std::streamsize>(table.size()));
+    return static_cast<bool>(out.flush());
+}
+
+/// \brief Reads the time index sidecar of a plain-text log file.
+/// \param path Sidecar path in the native encoding.
+/// \param[out] entries Parsed blocks.
+/// \return true when the sidecar exists and is well-formed.
+inline bool read_time_index_file(const std::string& path, std::vector<SeekFrameEntry>& entries) {
+    entries.clear();
+    std::ifstream in(path.c_str(), std::ios_base::binary | std::ios_base::ate);
+    if (!in.is_open()) return false;
+    const std::streamoff size = in.tellg();
+    if (size <= 0) return false;
+    std::string table(static_cast<size_t>(size), '\0');
+    in.seekg(0);
+    if (!in.read(&table[0], static_cast<std::streamsize>(table.size()))) return false;
+    if (table.size() < SEEK_TABLE_FOOTER_SIZE ||
+        std::memcmp(table.data() + table.size() - sizeof(SEEK_TABLE_MAGIC), SEEK_TABLE_MAGIC, sizeof(SEEK_TABLE_MAGIC)) != 0) {
+        return false;
+    }
+    return decode_seek_table(table, entries);
+}
+
+} // namespace detail
+} // namespace logit
+
+#endif // _LOGIT_DETAIL_SEEKABLE_ARCHIVE_HPP_INCLUDED
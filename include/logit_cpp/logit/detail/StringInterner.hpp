@@ -0,0 +1,243 @@
+#pragma once
+#ifndef _LOGIT_DETAIL_STRING_INTERNER_HPP_INCLUDED
+#define _LOGIT_DETAIL_STRING_INTERNER_HPP_INCLUDED
+
+/// \file StringInterner.hpp
+/// \brief Process-wide intern table for source file and function names.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace logit { namespace detail {
+
+    /// \struct InternedString
+    /// \brief Immutable intern table entry; lives until the process exits.
+    struct InternedString {
+        std::string value;    ///< Interned text.
+        uint32_t    id = 0;   ///< Dense id, 0 is the empty string.
+        uint64_t    hash = 0; ///< FNV-1a hash of `value`.
+    };
+
+    /// \class StringInterner
+    /// \brief Thread-safe, append-only string table.
+    /// \details Lookups of strings that are already interned are lock-free:
+    /// they probe an open-addressing table of atomic entry pointers. Only the
+    /// first occurrence of a string takes the mutex to append it. Entries and
+    /// superseded tables are never freed, so returned pointers stay valid for
+    /// the life of the process.
+    ///
+    /// The table is meant for values with a small, bounded set of distinct
+    /// strings such as `__FILE__` and `__func__`; it never shrinks.
+    class StringInterner {
+    public:
+        /// \brief Returns the process-wide instance.
+        /// \details The instance is intentionally leaked so that loggers
+        /// destroyed during static destruction can still resolve entries.
+        static StringInterner& instance() {
+            static StringInterner* interner = new StringInterner();
+            return *interner;
+        }
+
+        StringInterner() :
+                m_table(nullptr),
+                m_ids(nullptr) {
+            m_tables.emplace_back(new Table(INITIAL_CAPACITY));
+            m_table.store(m_tables.back().get(), std::memory_order_relaxed);
+            m_id_tables.emplace_back(new IdTable(INITIAL_CAPACITY));
+            m_ids.store(m_id_tables.back().get(), std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            insert_locked("", 0, hash_bytes("", 0));
+        }
+
+        StringInterner(const StringInterner&) = delete;
+        StringInterner& operator=(const StringInterner&) = delete;
+
+        /// \brief Returns the entry for a string, adding it on first use.
+        const InternedString* intern(const char* data, std::size_t size) {
+            const uint64_t hash = hash_bytes(data, size);
+            const InternedString* entry = find_in(*m_table.load(std::memory_order_acquire), data, size, hash);
+            if (entry) return entry;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            entry = find_in(*m_table.load(std::memory_order_relaxed), data, size, hash);
+            return entry ? entry : insert_locked(data, size, hash);
+        }
+
+        /// \brief Returns the entry for a string, adding it on first use.
+        const InternedString* intern(const std::string& value) {
+            return intern(value.data(), value.size());
+        }
+
+        /// \brief Returns the entry for an id, or nullptr if the id is unknown.
+        const InternedString* find(uint32_t id) const {
+            const IdTable* ids = m_ids.load(std::memory_order_acquire);
+            if (id >= ids->capacity) return nullptr;
+            return ids->cells[id].load(std::memory_order_acquire);
+        }
+
+        /// \brief Returns the entry of the empty string.
+        const InternedString* empty() const {
+            return find(0);
+        }
+
+        /// \brief Number of interned strings, including the empty string.
+        std::size_t size() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+    private:
+        static const std::size_t INITIAL_CAPACITY = 1024; ///< Initial hash and id table capacity.
+
+        /// \brief Open-addressing hash table; capacity is a power of two.
+        struct Table {
+            explicit Table(std::size_t capacity) :
+                    mask(capacity - 1),
+                    cells(new std::atomic<const InternedString*>[capacity]) {
+                for (std::size_t i = 0; i < capacity; ++i) {
+                    cells[i].store(nullptr, std::memory_order_relaxed);
+                }
+            }
+
+            const std::size_t mask; ///< Capacity minus one.
+            std::unique_ptr<std::atomic<const InternedString*>[]> cells; ///< Entry pointers, null = free.
+        };
+
+        /// \brief Id-indexed entry pointers.
+        struct IdTable {
+            explicit IdTable(std::size_t capacity) :
+                    capacity(capacity),
+                    cells(new std::atomic<const InternedString*>[capacity]) {
+                for (std::size_t i = 0; i < capacity; ++i) {
+                    cells[i].store(nullptr, std::memory_order_relaxed);
+                }
+            }
+
+            const std::size_t capacity; ///< Number of cells.
+            std::unique_ptr<std::atomic<const InternedString*>[]> cells; ///< Entry for each id.
+        };
+
+        static uint64_t hash_bytes(const char* data, std::size_t size) {
+            uint64_t hash = 14695981039346656037ULL;
+            for (std::size_t i = 0; i < size; ++i) {
+                hash ^= static_cast<unsigned char>(data[i]);
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        static const InternedString* find_in(
+                const Table& table,
+                const char* data,
+                std::size_t size,
+                uint64_t hash) {
+            for (std::size_t i = static_cast<std::size_t>(hash) & table.mask;; i = (i + 1) & table.mask) {
+                const InternedString* entry = table.cells[i].load(std::memory_order_acquire);
+                if (!entry) return nullptr;
+                if (entry->hash == hash && entry->value.size() == size &&
+                    (size == 0 || std::memcmp(entry->value.data(), data, size) == 0)) {
+                    return entry;
+                }
+            }
+        }
+
+        static void place(Table& table, const InternedString* entry) {
+            std::size_t i = static_cast<std::size_t>(entry->hash) & table.mask;
+            while (table.cells[i].load(std::memory_order_relaxed)) {
+                i = (i + 1) & table.mask;
+            }
+            table.cells[i].store(entry, std::memory_order_release);
+        }
+
+        const InternedString* insert_locked(const char* data, std::size_t size, uint64_t hash) {
+            m_entries.push_back(InternedString());
+            InternedString& entry = m_entries.back();
+            entry.value.assign(data, size);
+            entry.id = static_cast<uint32_t>(m_entries.size() - 1);
+            entry.hash = hash;
+
+            IdTable* ids = m_id_tables.back().get();
+            if (entry.id >= ids->capacity) {
+                std::unique_ptr<IdTable> grown(new IdTable(ids->capacity * 2));
+                for (std::size_t i = 0; i < ids->capacity; ++i) {
+                    grown->cells[i].store(ids->cells[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+                ids = grown.get();
+                m_id_tables.push_back(std::move(grown));
+            }
+            ids->cells[entry.id].store(&entry, std::memory_order_release);
+            m_ids.store(ids, std::memory_order_release);
+
+            Table* table = m_tables.back().get();
+            // Keep the load factor at or below one half so probes stay short.
+            if (m_entries.size() * 2 > table->mask + 1) {
+                std::unique_ptr<Table> grown(new Table((table->mask + 1) * 2));
+                for (std::size_t i = 0; i < m_entries.size(); ++i) {
+                    place(*grown, &m_entries[i]);
+                }
+                m_tables.push_back(std::move(grown));
+                m_table.store(m_tables.back().get(), std::memory_order_release);
+            } else {
+                place(*table, &entry);
+            }
+            return &entry;
+        }
+
+        mutable std::mutex                     m_mutex;     ///< Serializes inserts.
+        std::deque<InternedString>             m_entries;   ///< Entries in id order (stable addresses).
+        std::vector<std::unique_ptr<Table> >   m_tables;    ///< Current and superseded hash tables.
+        std::vector<std::unique_ptr<IdTable> > m_id_tables; ///< Current and superseded id tables.
+        std::atomic<const Table*>              m_table;     ///< Published hash table.
+        std::atomic<const IdTable*>            m_ids;       ///< Published id table.
+    };
+
+    /// \class InternedStringRef
+    /// \brief Pointer-sized handle to an interned string.
+    /// \details Assigning a string interns it in \ref StringInterner::instance().
+    /// The handle converts implicitly to `const std::string&`, so records can
+    /// swap owned `std::string` fields for handles without changing readers.
+    class InternedStringRef {
+    public:
+        InternedStringRef() :
+                m_entry(StringInterner::instance().empty()) {}
+
+        InternedStringRef(const std::string& value) :
+                m_entry(StringInterner::instance().intern(value)) {}
+
+        InternedStringRef(const char* value) :
+                m_entry(StringInterner::instance().intern(value, std::strlen(value))) {}
+
+        explicit InternedStringRef(const InternedString* entry) :
+                m_entry(entry ? entry : StringInterner::instance().empty()) {}
+
+        /// \brief Interned text.
+        const std::string& str() const { return m_entry->value; }
+
+        /// \brief Interned id.
+        uint32_t id() const { return m_entry->id; }
+
+        /// \brief Underlying table entry.
+        const InternedString* entry() const { return m_entry; }
+
+        operator const std::string&() const { return m_entry->value; }
+
+        bool empty() const { return m_entry->value.empty(); }
+
+        /// \brief Handles are equal exactly when their strings are equal.
+        bool operator==(const InternedStringRef& other) const { return m_entry == other.m_entry; }
+        bool operator!=(const InternedStringRef& other) const { return m_entry != other.m_entry; }
+
+    private:
+        const InternedString* m_entry; ///< Never null.
+    };
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_DETAIL_STRING_INTERNER_HPP_INCLUDED
@@ -0,0 +1,201 @@
+#pragma once
+#ifndef _LOGIT_DETAIL_ZSTD_DICTIONARY_HPP_INCLUDED
+#define _LOGIT_DETAIL_ZSTD_DICTIONARY_HPP_INCLUDED
+
+/// \file ZstdDictionary.hpp
+/// \brief Trained zstd dictionaries and reusable zstd contexts.
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(LOGIT_HAS_ZSTD)
+#   include <zstd.h>
+#   include <zdict.h>
+#endif
+
+namespace logit {
+namespace detail {
+
+/// \brief Trains a zstd dictionary from sample strings.
+/// \param samples Sample inputs, e.g. recent payloads.
+/// \param capacity Maximum dictionary size in bytes.
+/// \param[out] dictionary Trained dictionary (valid only on success).
+/// \return true on success, false if zstd is unavailable or training fails,
+/// typically because the samples are too few or too small.
+inline bool train_zstd_dictionary(
+        const std::vector<std::string>& samples,
+        std::size_t capacity,
+        std::string& dictionary) {
+#if defined(LOGIT_HAS_ZSTD)
+    if (samples.empty() || capacity == 0) {
+        return false;
+    }
+    std::string joined;
+    std::vector<std::size_t> sizes;
+    sizes.reserve(samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        joined += samples[i];
+        sizes.push_back(samples[i].size());
+    }
+    dictionary.resize(capacity);
+    const std::size_t result = ZDICT_trainFromBuffer(
+        &dictionary[0], dictionary.size(),
+        joined.data(), &sizes[0], static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(result)) {
+        dictionary.clear();
+        return false;
+    }
+    dictionary.resize(result);
+    return true;
+#else
+    (void)samples; (void)capacity; (void)dictionary;
+    return false;
+#endif
+}
+
+/// \class ZstdDictionaryCodec
+/// \brief zstd compression with one current dictionary and decompression with any loaded one.
+/// \details The compression and decompression contexts are created once and
+/// reused, and each dictionary is digested once into a `ZSTD_CDict` /
+/// `ZSTD_DDict`. Without a current dictionary `compress()` produces plain
+/// zstd frames. Not thread-safe; the owner serializes calls.
+class ZstdDictionaryCodec {
+public:
+    ZstdDictionaryCodec() = default;
+
+    ~ZstdDictionaryCodec() {
+#if defined(LOGIT_HAS_ZSTD)
+        if (m_cdict) ZSTD_freeCDict(m_cdict);
+        for (std::map<uint32_t, ZSTD_DDict*>::iterator it = m_ddicts.begin(); it != m_ddicts.end(); ++it) {
+            ZSTD_freeDDict(it->second);
+        }
+        if (m_cctx) ZSTD_freeCCtx(m_cctx);
+        if (m_dctx) ZSTD_freeDCtx(m_dctx);
+#endif
+    }
+
+    ZstdDictionaryCodec(const ZstdDictionaryCodec&) = delete;
+    ZstdDictionaryCodec& operator=(const ZstdDictionaryCodec&) = delete;
+
+    /// \brief Loads a dictionary for decompression.
+    /// \return false if zstd is unavailable or the dictionary is rejected.
+    bool add(uint32_t id, const std::string& dictionary) {
+#if defined(LOGIT_HAS_ZSTD)
+        if (id == 0 || dictionary.empty()) return false;
+        if (m_ddicts.count(id) != 0) return true;
+        ZSTD_DDict* ddict = ZSTD_createDDict(dictionary.data(), dictionary.size());
+        if (!ddict) return false;
+        m_ddicts[id] = ddict;
+        return true;
+#else
+        (void)id; (void)dictionary;
+        return false;
+#endif
+    }
+
+    /// \brief Loads a dictionary and compresses with it from now on.
+    bool set_current(uint32_t id, const std::string& dictionary, int level) {
+#if defined(LOGIT_HAS_ZSTD)
+        if (!add(id, dictionary)) return false;
+        ZSTD_CDict* cdict = ZSTD_createCDict(dictionary.data(), dictionary.size(), clamp_level(level));
+        if (!cdict) return false;
+        if (m_cdict) ZSTD_freeCDict(m_cdict);
+        m_cdict = cdict;
+        m_current_id = id;
+        return true;
+#else
+        (void)id; (void)dictionary; (void)level;
+        return false;
+#endif
+    }
+
+    /// \brief True when dictionary `id` is loaded.
+    bool has(uint32_t id) const {
+#if defined(LOGIT_HAS_ZSTD)
+        return m_ddicts.count(id) != 0;
+#else
+        (void)id;
+        return false;
+#endif
+    }
+
+    /// \brief Id of the compression dictionary, or 0 when there is none.
+    uint32_t current_id() const {
+        return m_current_id;
+    }
+
+    /// \brief Compresses `input`, with the current dictionary when one is set.
+    /// \param[out] dictionary_id Dictionary used, or 0 for a plain zstd frame.
+    /// \param level Level for plain frames; dictionary frames use the level given to set_current().
+    bool compress(const std::string& input, std::string& output, uint32_t& dictionary_id, int level) {
+#if defined(LOGIT_HAS_ZSTD)
+        if (!m_cctx) {
+            m_cctx = ZSTD_createCCtx();
+            if (!m_cctx) return false;
+        }
+        output.resize(ZSTD_compressBound(input.size()));
+        const std::size_t result = m_cdict
+            ? ZSTD_compress_usingCDict(m_cctx, &output[0], output.size(), input.data(), input.size(), m_cdict)
+            : ZSTD_compressCCtx(m_cctx, &output[0], output.size(), input.data(), input.size(), clamp_level(level));
+        if (ZSTD_isError(result)) {
+            output.clear();
+            return false;
+        }
+        output.resize(result);
+        dictionary_id = m_cdict ? m_current_id : 0;
+        return true;
+#else
+        (void)input; (void)output; (void)dictionary_id; (void)level;
+        return false;
+#endif
+    }
+
+    /// \brief Decompresses a frame produced with dictionary `id`, which must be loaded.
+    bool decompress(uint32_t id, const std::string& input, std::string& output) {
+#if defined(LOGIT_HAS_ZSTD)
+        std::map<uint32_t, ZSTD_DDict*>::const_iterator it = m_ddicts.find(id);
+        if (it == m_ddicts.end()) return false;
+        if (!m_dctx) {
+            m_dctx = ZSTD_createDCtx();
+            if (!m_dctx) return false;
+        }
+        const unsigned long long size = ZSTD_getFrameContentSize(input.data(), input.size());
+        if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN) {
+            return false;
+        }
+        output.resize(static_cast<std::size_t>(size));
+        const std::size_t result = ZSTD_decompress_usingDDict(
+            m_dctx, output.empty() ? nullptr : &output[0], output.size(), input.data(), input.size(), it->second);
+        if (ZSTD_isError(result)) {
+            output.clear();
+            return false;
+        }
+        output.resize(result);
+        return true;
+#else
+        (void)id; (void)input; (void)output;
+        return false;
+#endif
+    }
+
+private:
+    static int clamp_level(int level) {
+        return level < 1 ? 1 : (level > 19 ? 19 : level);
+    }
+
+    uint32_t m_current_id = 0; ///< Compression dictionary id, 0 when none.
+#if defined(LOGIT_HAS_ZSTD)
+    ZSTD_CCtx* m_cctx = nullptr;  ///< Reused compression context.
+    ZSTD_DCtx* m_dctx = nullptr;  ///< Reused decompression context.
+    ZSTD_CDict* m_cdict = nullptr; ///< Digested current dictionary.
+    std::map<uint32_t, ZSTD_DDict*> m_ddicts; ///< Digested dictionaries by id.
+#endif
+};
+
+} // namespace detail
+} // namespace logit
+
+#endif // _LOGIT_DETAIL_ZSTD_DICTIONARY_HPP_INCLUDED
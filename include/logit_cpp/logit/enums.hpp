@@ -50,7 +50,8 @@ namespace logit {
         LastLogTimestamp,      ///< The timestamp of the last log.
         TimeSinceLastLog,      ///< The time elapsed since the last log in seconds.
         DroppedLogCount,       ///< Number of log records dropped by the backend.
-        FailedExportCount      ///< Number of failed export attempts reported by the backend.
+        FailedExportCount,     ///< Number of failed export attempts reported by the backend.
+        CompressionBacklog     ///< Number of rotated files waiting for or undergoing background compression.
     };
 
     /// \enum CompressType
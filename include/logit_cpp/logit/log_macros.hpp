@@ -2845,6 +2845,50 @@ static_assert(LOGIT_LEVEL_FATAL == static_cast<int>(logit::LogLevel::LOG_LVL_FAT
 #define LOGIT_READ_LOG_FILES(logger_index, paths) \
     logit::Logger::get_instance().read_log_files(logger_index, paths)
 
+/// \brief Reads a chunk of a persisted log file into a caller-provided buffer.
+/// \param logger_index Index of logger.
+/// \param path Full path returned by `LOGIT_LIST_LOG_FILES`.
+/// \param offset Offset of the first byte to read.
+/// \param buffer Destination buffer.
+/// \param capacity Size of the buffer in bytes.
+/// \return Chunk result; pass `next_offset` to continue the iteration.
+#define LOGIT_READ_LOG_FILE_CHUNK(logger_index, path, offset, buffer, capacity) \
+    logit::Logger::get_instance().read_log_file_chunk(logger_index, path, offset, buffer, capacity)
+
+/// \brief Reads a byte range of a persisted log file.
+/// \param logger_index Index of logger.
+/// \param path Full path returned by `LOGIT_LIST_LOG_FILES`.
+/// \param offset Offset in the uncompressed content.
+/// \param length Maximum number of bytes to read.
+/// \return Read result with metadata, content and success flag.
+#define LOGIT_READ_LOG_FILE_RANGE(logger_index, path, offset, length) \
+    logit::Logger::get_instance().read_log_file_range(logger_index, path, offset, length)
+
+/// \brief Iterates over the lines of a persisted log file from the last one backwards.
+/// \param logger_index Index of logger.
+/// \param path Full path returned by `LOGIT_LIST_LOG_FILES`.
+/// \param callback Callable receiving each line; return false to stop.
+/// \return True when the file was read.
+#define LOGIT_FOR_EACH_LOG_FILE_LINE_REVERSE(logger_index, path, callback) \
+    logit::Logger::get_instance().for_each_log_file_line_reverse(logger_index, path, callback)
+
+/// \brief Waits until a persisted log file has readable content beyond an offset.
+/// \param logger_index Index of logger.
+/// \param path Full path returned by `LOGIT_LIST_LOG_FILES`.
+/// \param offset Content size already consumed by the caller.
+/// \param timeout_ms Maximum time to wait in milliseconds.
+/// \return True when new data is readable, false on timeout.
+#define LOGIT_WAIT_LOG_FILE_DATA(logger_index, path, offset, timeout_ms) \
+    logit::Logger::get_instance().wait_log_file_data(logger_index, path, offset, timeout_ms)
+
+/// \brief Reads the persisted log content written in a time range.
+/// \param logger_index Index of logger.
+/// \param from_ms Start of the range in milliseconds (inclusive).
+/// \param to_ms End of the range in milliseconds (inclusive).
+/// \return Per-file read results ordered from the oldest file.
+#define LOGIT_READ_LOG_RANGE(logger_index, from_ms, to_ms) \
+    logit::Logger::get_instance().read_log_range(logger_index, from_ms, to_ms)
+
 /// \brief Clears logger-owned records for a specific logger.
 /// \param logger_index Index of logger.
 /// \return Cleanup result for the selected logger.
@@ -3032,6 +3076,28 @@ static_assert(LOGIT_LEVEL_FATAL == static_cast<int>(logit::LogLevel::LOG_LVL_FAT
 #define LOGIT_READ_RECENT_DESC(logger_index, limit, period_ms) \
     LOGIT_READ_RECENT((logger_index), (limit), (period_ms), ::logit::LogReadOrder::Descending)
 
+/// \brief Reads records matching a LogQuery from a backend that supports ILogReader.
+/// \param logger_index Index of logger.
+/// \param log_query    LogQuery with time window, filters, limit and order.
+/// \return Matching records, or empty vector if backend does not support reading.
+#define LOGIT_QUERY_LOGS(logger_index, log_query) \
+    ([](int _idx, const ::logit::LogQuery& _query) { \
+        auto* _reader = LOGIT_GET_LOG_READER(_idx); \
+        return _reader \
+            ? _reader->query(_query) \
+            : std::vector<::logit::LogRecordSnapshot>{}; \
+    }((logger_index), (log_query)))
+
+/// \brief Counts records matching a LogQuery without returning them.
+/// \param logger_index Index of logger.
+/// \param log_query    LogQuery with time window and filters.
+/// \return Number of matches, or 0 if backend does not support reading.
+#define LOGIT_COUNT_LOGS(logger_index, log_query) \
+    ([](int _idx, const ::logit::LogQuery& _query) -> std::size_t { \
+        auto* _reader = LOGIT_GET_LOG_READER(_idx); \
+        return _reader ? _reader->count(_query) : 0; \
+    }((logger_index), (log_query)))
+
 /// \brief Retrieves a live-subscription interface from a logger by index.
 /// \param logger_index Index of logger.
 /// \return Pointer to ILogSubscriber, or nullptr if the backend does not implement it.
@@ -3054,6 +3120,30 @@ static_assert(LOGIT_LEVEL_FATAL == static_cast<int>(logit::LogLevel::LOG_LVL_FAT
         return _subscriber ? _subscriber->add_log_callback(std::move(_cb)) : 0; \
     }((logger_index), (callback)))
 
+/// \brief Registers a callback delivered on the backend's dispatcher thread.
+/// \param logger_index   Index of logger.
+/// \param callback       Function invoked with an owning LogRecordSnapshot after each commit.
+/// \param queue_capacity Maximum queued snapshots for this callback; overflow drops the newest.
+/// \return Callback id (0 if the backend does not support subscriptions).
+#define LOGIT_ADD_LOG_CALLBACK_ASYNC(logger_index, callback, queue_capacity) \
+    ([](int _idx, ::logit::ILogSubscriber::Callback _cb, std::size_t _capacity) -> uint64_t { \
+        auto* _subscriber = LOGIT_GET_LOG_SUBSCRIBER(_idx); \
+        ::logit::LogCallbackOptions _options; \
+        _options.async = true; \
+        _options.queue_capacity = _capacity; \
+        return _subscriber ? _subscriber->add_log_callback(std::move(_cb), _options) : 0; \
+    }((logger_index), (callback), (queue_capacity)))
+
+/// \brief Returns the number of snapshots dropped for an asynchronous callback.
+/// \param logger_index Index of logger.
+/// \param callback_id  Id returned by LOGIT_ADD_LOG_CALLBACK_ASYNC.
+/// \return Drop count (0 for synchronous or unknown callbacks).
+#define LOGIT_GET_LOG_CALLBACK_DROPPED(logger_index, callback_id) \
+    ([](int _idx, uint64_t _id) -> uint64_t { \
+        auto* _subscriber = LOGIT_GET_LOG_SUBSCRIBER(_idx); \
+        return _subscriber ? _subscriber->get_log_callback_dropped(_id) : 0; \
+    }((logger_index), (callback_id)))
+
 /// \brief Unregisters a previously added log callback.
 /// \param logger_index Index of logger.
 /// \param callback_id  Id returned by LOGIT_ADD_LOG_CALLBACK.
@@ -13,8 +13,14 @@
 #include "utils.hpp"
 #include "detail/TaskExecutor.hpp"
 #include "detail/SingleThreadExecutor.hpp"
+#include "detail/MemoryArenaRing.hpp"
+#include "detail/MemoryEntryStore.hpp"
+#include "detail/CompressionUtils.hpp"
+#include "detail/MemoryColdTier.hpp"
 #ifndef __EMSCRIPTEN__
 #include "detail/CompressionWorker.hpp"
+#include "detail/SeekableArchive.hpp"
+#include "detail/LogFileStreamReader.hpp"
 #endif
 
 #include <algorithm>
@@ -28,6 +34,7 @@
 
 #include "loggers/ILogReader.hpp"
 #include "loggers/ILogSubscriber.hpp"
+#include "detail/LogSubscriberList.hpp"
 #include "loggers/ILogger.hpp"
 #include "loggers/ConsoleLogger.hpp"
 #include "loggers/MemoryLogger.hpp"
@@ -57,6 +64,8 @@
 #include "detail/MdbxByteIO.hpp"
 #include "detail/MdbxKeyUtils.hpp"
 #include "detail/MdbxProcessId.hpp"
+#include "detail/MpscRingAny.hpp"
+#include "detail/ZstdDictionary.hpp"
 #include "loggers/MdbxLogger.hpp"
 #endif
 
@@ -10,7 +10,11 @@
 #include <fstream>
 #include <mutex>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
 #include <queue>
+#include <set>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -21,7 +25,11 @@
 #include <sstream>
 #include <iomanip>
 #include <regex>
+#include <limits>
 #include <time_shield/time_parser.hpp>
+#if defined(LOGIT_WITH_PROMETHEUS)
+#include "prometheus/PrometheusRegistry.hpp"
+#endif
 
 namespace logit {
 
@@ -38,9 +46,19 @@ namespace logit {
             CompressType compress       = CompressType::NONE;
             int         compress_level  = 1;
             bool        compress_async  = true;
+            std::size_t compress_threads = 1;
+            int         compress_zstd_workers = 0;
+            int         compress_fast_level = 0;
+            std::size_t compress_backlog_threshold = 4;
             std::string external_cmd;
             RotationNaming naming      = RotationNaming::Sequence;
             uint32_t    seq_width       = 3;
+            int64_t     rotation_interval_ms = 0;
+            bool        background_rotation = false;
+            CompressType stream_compress = CompressType::NONE;
+            uint64_t    stream_frame_bytes = 64 * 1024;
+            int64_t     stream_flush_interval_ms = 1000;
+            uint64_t    time_index_interval_bytes = 64 * 1024;
             bool        use_dedicated_executor = false;
             std::size_t queue_capacity = 0;
             detail::QueuePolicy queue_policy = detail::QueuePolicy::Block;
@@ -85,6 +103,9 @@ namespace logit {
     ///
     /// **Key Features:**
     /// - Date-based file rotation.
+    /// - Optional size-based and time-interval rotation.
+    /// - Optional background rotation that keeps close/compression/retention off the write path.
+    /// - Optional streaming gzip/zstd output for the active file.
     /// - Automatic cleanup of old files.
     /// - Synchronous or asynchronous operation.
     class FileLogger : public ILogger {
@@ -100,10 +121,20 @@ namespace logit {
             uint32_t    max_rotated_files   = 0;   ///< Number of rotated files to keep (0 = unlimited).
             CompressType compress       = CompressType::NONE; ///< Compression algorithm for rotated files.
             int         compress_level  = 1;       ///< Compression level.
-            bool        compress_async  = true;    ///< Run compression in background thread.
+            bool        compress_async  = true;    ///< Run compression in background threads.
+            std::size_t compress_threads = 1;      ///< Number of background compression threads.
+            int         compress_zstd_workers = 0; ///< zstd worker threads per file (`ZSTD_c_nbWorkers`, 0 = single-threaded).
+            int         compress_fast_level = 0;   ///< Level used once the backlog reaches `compress_backlog_threshold` (0 = always `compress_level`).
+            std::size_t compress_backlog_threshold = 4; ///< Queued files at which background compression switches to `compress_fast_level`.
             std::string external_cmd;             ///< External command template.
             RotationNaming naming      = RotationNaming::Sequence; ///< Naming policy for rotated files.
             uint32_t    seq_width       = 3;       ///< Width of sequence index.
+            int64_t     rotation_interval_ms = 0;  ///< Time-based rotation interval aligned to UTC, e.g. 3600000 for hourly (0 = daily only).
+            bool        background_rotation = false; ///< Pre-open the next file and finish close/compression/retention on a helper thread.
+            CompressType stream_compress = CompressType::NONE; ///< Write the active file as a gzip/zstd frame stream (`.log.gz`/`.log.zst`); GZIP or ZSTD only.
+            uint64_t    stream_frame_bytes = 64 * 1024; ///< Uncompressed bytes buffered before a compressed frame is appended.
+            int64_t     stream_flush_interval_ms = 1000; ///< Max age of buffered records before a frame is appended, also when no further records arrive (0 = size/flush only).
+            uint64_t    time_index_interval_bytes = 64 * 1024; ///< Record a time index block in a `<file>.idx` sidecar every N bytes of plain-text output (0 = off, so range reads load whole files).
             bool        use_dedicated_executor = false; ///< Use a dedicated executor instead of the global TaskExecutor; native builds create one worker thread per logger.
             std::size_t queue_capacity = 0;       ///< Maximum queue size for the dedicated executor (0 = unlimited).
             detail::QueuePolicy queue_policy = detail::QueuePolicy::Block; ///< Overflow policy for the dedicated executor.
@@ -328,6 +359,7 @@ namespace logit {
             case LoggerParam::LastFilePath: return get_last_log_file_path();
             case LoggerParam::LastLogTimestamp: return std::to_string(get_last_log_ts());
             case LoggerParam::TimeSinceLastLog: return std::to_string(get_time_since_last_log());
+            case LoggerParam::CompressionBacklog: return std::to_string(get_compression_backlog());
             default:
                 break;
             };
@@ -341,6 +373,7 @@ namespace logit {
             switch (param) {
             case LoggerParam::LastLogTimestamp: return get_last_log_ts();
             case LoggerParam::TimeSinceLastLog: return get_time_since_last_log();
+            case LoggerParam::CompressionBacklog: return static_cast<int64_t>(get_compression_backlog());
             default:
                 break;
             };
@@ -356,12 +389,29 @@ namespace logit {
                 return static_cast<double>(get_last_log_ts()) / 1000.0;
             case LoggerParam::TimeSinceLastLog:
                 return static_cast<double>(get_time_since_last_log()) / 1000.0;
+            case LoggerParam::CompressionBacklog:
+                return static_cast<double>(get_compression_backlog());
             default:
                 break;
             };
             return 0.0;
         }
 
+#       if defined(LOGIT_WITH_PROMETHEUS)
+        /// \brief Registers the `logit_compression_backlog` gauge of this logger.
+        /// \details The gauge reads the backlog on each collection, so the logger must
+        /// outlive the registry. Collect the registry from a Prometheus logger's `on_collect`.
+        /// \param registry Registry receiving the gauge.
+        /// \param logger_name Value of the `logger` label; distinguishes several file loggers.
+        void register_prometheus_metrics(PrometheusRegistry& registry, const std::string& logger_name = "file") const {
+            registry.set_gauge(
+                "logit_compression_backlog",
+                "Rotated log files waiting for or undergoing background compression",
+                [this]() { return static_cast<double>(get_compression_backlog()); },
+                {{"logger", logger_name}});
+        }
+#       endif
+
         /// \brief Sets the minimal log level for this logger.
         void set_log_level(LogLevel level) override {
             m_log_level = static_cast<int>(level);
@@ -419,7 +469,7 @@ namespace logit {
         /// \details This API reads only the already persisted file contents and
         /// does not wait for pending async writes.
         /// \param path Full path returned by `list_log_files()`.
-        /// \return Read result. Compressed files are listed but unreadable in v1.
+        /// \return Read result. Compressed files are decompressed when gzip/zstd support is built in.
         LogFileReadResult read_log_file(const std::string& path) const override {
             const std::vector<LogFileInfo> files = list_log_files();
             for (size_t i = 0; i < files.size(); ++i) {
@@ -465,6 +515,203 @@ namespace logit {
             return results;
         }
 
+        /// \brief Reads a chunk of a log file into a caller-provided buffer.
+        /// \details Plain files are read in place. Files with a seek table decompress only
+        /// the frames covering the chunk. Other compressed files are decoded by a cursor
+        /// that resumes where the previous chunk ended, so a sequential pass decompresses
+        /// the file once; for them `file_size` counts the content decoded so far until
+        /// the end of the file is reached.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Offset in the uncompressed content.
+        /// \param buffer Destination buffer.
+        /// \param capacity Size of `buffer` in bytes.
+        /// \return Chunk result with the next offset of the iteration.
+        LogFileChunkResult read_log_file_chunk(
+                const std::string& path,
+                uint64_t offset,
+                char* buffer,
+                std::size_t capacity) const override {
+            LogFileChunkResult result;
+            result.offset = offset;
+            result.next_offset = offset;
+            if (!find_log_file_info(path, result.file)) {
+                result.file.path = path;
+                result.file.name = get_file_name(path);
+                return result;
+            }
+
+            const LogFileInfo& info = result.file;
+            std::vector<detail::SeekFrameEntry> frames;
+            if (!info.is_compressed) {
+                flush_current_file(info);
+                result.ok = detail::read_file_chunk(
+                    to_native_path(info.path), offset, buffer, capacity, result.size, result.file_size);
+            } else if (get_seek_frames(info, frames)) {
+                for (size_t i = 0; i < frames.size(); ++i) {
+                    result.file_size += frames[i].size;
+                }
+                std::string content;
+                const uint64_t end = offset + capacity;
+                result.ok = read_frames_range(info, frames, offset, end, content);
+                result.size = detail::copy_content_chunk(content, 0, buffer, capacity);
+            } else {
+                result.ok = read_compressed_range(info, offset, buffer, capacity, result.size, result.is_eof);
+                if (result.ok) {
+                    result.next_offset = offset + result.size;
+                    result.file_size = result.next_offset;
+                    return result;
+                }
+            }
+            if (!result.ok) {
+                result.size = 0;
+                return result;
+            }
+            result.next_offset = offset + result.size;
+            result.is_eof = result.next_offset >= result.file_size;
+            return result;
+        }
+
+        /// \brief Reads a byte range of the uncompressed content of a log file.
+        /// \details Files with a seek table decompress only the frames covering the range;
+        /// other compressed files are decoded from the start, or from where the previous
+        /// read of the same file stopped.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Offset in the uncompressed content.
+        /// \param length Number of bytes to read.
+        /// \return Read result holding at most `length` bytes.
+        LogFileReadResult read_log_file_range(const std::string& path, uint64_t offset, uint64_t length) const override {
+            LogFileInfo info;
+            if (find_log_file_info(path, info)) {
+                return read_byte_range_from_info(info, offset, length);
+            }
+
+            LogFileReadResult result;
+            result.file.path = path;
+            result.file.name = get_file_name(path);
+            result.ok = false;
+            return result;
+        }
+
+        /// \brief Reads the parts of a log file that overlap a time range.
+        /// \details Requires a seek table (files written with `stream_compress`) or a
+        /// time index sidecar (plain-text files written with `time_index_interval_bytes`).
+        /// The result holds whole frames or blocks, so it may include records just outside the range.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param from_ms Start of the range in milliseconds (inclusive).
+        /// \param to_ms End of the range in milliseconds (inclusive).
+        /// \return Read result; `ok` is false when the file has neither a seek table nor a time index.
+        LogFileReadResult read_log_file_time_range(const std::string& path, int64_t from_ms, int64_t to_ms) const {
+            LogFileInfo info;
+            if (find_log_file_info(path, info)) {
+                return read_time_range_from_info(info, from_ms, to_ms);
+            }
+
+            LogFileReadResult result;
+            result.file.path = path;
+            result.file.name = get_file_name(path);
+            result.ok = false;
+            return result;
+        }
+
+        /// \brief Reads the log content written in a time range across all log files.
+        /// \details Only files whose day overlaps the range are opened. Indexed files
+        /// contribute just the frames or blocks that overlap the range. Plain-text files
+        /// are indexed by default; files without an index (`time_index_interval_bytes = 0`,
+        /// external archives) are returned whole.
+        /// \param from_ms Start of the range in milliseconds (inclusive).
+        /// \param to_ms End of the range in milliseconds (inclusive).
+        /// \return Per-file slices ordered from the oldest file; files without matching content are omitted.
+        std::vector<LogFileReadResult> read_log_range(int64_t from_ms, int64_t to_ms) const override {
+            std::vector<LogFileInfo> files = list_log_files();
+            std::reverse(files.begin(), files.end());
+            const int64_t day_ms = time_shield::sec_to_ms(time_shield::SEC_PER_DAY);
+            std::vector<LogFileReadResult> results;
+            for (size_t i = 0; i < files.size(); ++i) {
+                if (files[i].day_start_ms > to_ms || files[i].day_start_ms + day_ms <= from_ms) continue;
+                LogFileReadResult result = read_time_range_from_info(files[i], from_ms, to_ms);
+                if (!result.ok) {
+                    result = read_log_file_from_info(files[i]);
+                }
+                if (!result.ok || !result.content.empty()) {
+                    results.push_back(result);
+                }
+            }
+            return results;
+        }
+
+        /// \brief Iterates over the lines of a log file from the last one backwards.
+        /// \details Plain files are read in blocks from the end; files with a seek
+        /// table are decompressed frame by frame starting from the last frame. Other
+        /// compressed files are decompressed once into a temporary file read from the end.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param callback Receives each line; return false to stop.
+        /// \return True when the file was read.
+        bool for_each_log_file_line_reverse(
+                const std::string& path,
+                const std::function<bool(const std::string&)>& callback) const override {
+            LogFileInfo info;
+            if (!find_log_file_info(path, info)) return false;
+            if (!info.is_compressed) {
+                flush_current_file(info);
+                return detail::for_each_file_line_reverse(to_native_path(info.path), callback);
+            }
+
+            std::vector<detail::SeekFrameEntry> frames;
+            if (get_seek_frames(info, frames)) {
+                std::ifstream in(to_native_path(info.path).c_str(), std::ios_base::binary);
+                if (!in.is_open()) return false;
+                detail::ReverseLineSplitter splitter;
+                std::string frame;
+                std::string content;
+                for (size_t i = frames.size(); i > 0; --i) {
+                    if (!detail::read_seek_frame(in, frames[i - 1], frame) ||
+                        !decompress_log_frame(info.path, frame, content)) {
+                        return false;
+                    }
+                    if (!splitter.feed(content.data(), content.size(), callback)) return true;
+                }
+                splitter.finish(callback);
+                return true;
+            }
+
+            flush_current_file(info);
+            return detail::for_each_compressed_file_line_reverse(
+                to_native_path(info.path), ends_with(info.path, ".gz"), callback);
+        }
+
+        /// \brief Waits until a log file has readable content beyond `offset`.
+        /// \details Writers wake waiting readers after each record, so followers of the
+        /// active file react without polling. Returns as soon as the readable size
+        /// differs from `offset`, which also covers rotation and cleanup.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Content size the caller has already consumed.
+        /// \param timeout_ms Maximum time to wait in milliseconds.
+        /// \return True when new data is readable, false on timeout.
+        bool wait_log_file_data(const std::string& path, uint64_t offset, int64_t timeout_ms) const override {
+            const std::chrono::steady_clock::time_point deadline =
+                std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms > 0 ? timeout_ms : 0);
+            bool has_data = false;
+            m_update_waiters.fetch_add(1);
+            for (;;) {
+                const uint64_t generation = m_update_generation.load();
+                LogFileInfo info;
+                uint64_t size = 0;
+                if (!find_log_file_info(path, info)) break;
+                if (!get_readable_size(info, size)) size = 0;
+                if (size != offset) {
+                    has_data = true;
+                    break;
+                }
+                std::unique_lock<std::mutex> lock(m_update_mutex);
+                const bool is_updated = m_update_cv.wait_until(lock, deadline, [this, generation]() {
+                    return m_update_generation.load() != generation;
+                });
+                if (!is_updated) break;
+            }
+            m_update_waiters.fetch_sub(1);
+            return has_data;
+        }
+
         /// \brief Clears managed log files and reopens the current log file.
         LogClearResult clear_logs(const LogClearOptions& options = LogClearOptions()) override {
             (void)options;
@@ -482,6 +729,7 @@ namespace logit {
             try {
                 std::lock_guard<std::mutex> lock(m_mutex);
                 const std::vector<LogFileInfo> files = list_log_files();
+                m_stream_buffer.clear();
                 if (m_file.is_open()) {
                     m_file.flush();
                     m_file.close();
@@ -490,11 +738,19 @@ namespace logit {
                     if (remove_file_path(files[i].path)) {
                         ++result.cleared_records;
                     }
+                    remove_time_index_file(files[i].path);
                 }
                 m_current_file_size = 0;
+                {
+                    std::lock_guard<std::mutex> state_lock(m_rotation_state_mutex);
+                    m_rotation_base.clear();
+                    // Every listed file is gone; open_log_file() tracks the new one.
+                    m_dated_files.clear();
+                }
                 m_last_log_ts.store(0, std::memory_order_release);
                 m_last_log_mono_ts.store(0, std::memory_order_release);
                 open_log_file(get_current_utc_date_ts());
+                notify_file_update();
                 result.ok = true;
                 result.status = LogClearStatus::Cleared;
                 result.message = "cleared";
@@ -511,15 +767,25 @@ namespace logit {
         }
 
         /// \brief Waits for all asynchronous tasks to complete.
+        /// \details Also waits until background rotations have renamed and handed off rotated files.
         void wait() override {
             std::lock_guard<std::mutex> lifecycle_lock(m_lifecycle_mutex);
-            if (!m_config.async) return;
+            if (!m_config.async) {
+                if (m_rotation_executor) m_rotation_executor->wait();
+                if (is_stream_compressed()) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    flush_stream_frame();
+                }
+                return;
+            }
             if (m_executor) {
                 m_executor->wait();
             } else {
                 detail::TaskExecutor::get_instance().wait();
             }
+            if (m_rotation_executor) m_rotation_executor->wait();
             std::lock_guard<std::mutex> lock(m_mutex);
+            flush_stream_frame();
             if (m_file.is_open()) m_file.flush();
         }
 
@@ -532,13 +798,40 @@ namespace logit {
             if (m_executor) {
                 m_executor->shutdown();
                 std::lock_guard<std::mutex> lock(m_mutex);
+                flush_stream_frame();
                 if (m_file.is_open()) m_file.flush();
             } else if (m_config.async) {
                 wait();
             }
+            if (m_rotation_executor) m_rotation_executor->wait();
+            // Final scan also catches expired files created behind the logger's back.
+            std::lock_guard<std::mutex> lock(m_mutex);
+            try {
+                remove_old_logs();
+            } catch (const std::exception& e) {
+                std::cerr << "Log retention error: " << e.what() << std::endl;
+            }
         }
 
     private:
+        typedef std::pair<std::pair<int64_t, int>, std::string> RotatedFile; ///< Sort key from the rotated name, and the file path.
+
+        /// \brief Previous active file handed over to the rotation helper by a swap.
+        struct RetiredFile {
+            std::ofstream file;        ///< Stream of the previous file, still open.
+            std::string   path;        ///< Path of the previous file before the rotation.
+            std::string   next_path;   ///< Final path of the swapped-in spare file.
+            int64_t       date_ts = 0; ///< Date of the file that became active.
+            bool          is_rotation = false; ///< True to move the previous file to a rotated name; false on day change.
+            uint64_t      size = 0;    ///< Bytes written to the previous file.
+            std::string   stream_buffer; ///< Records not yet appended as a stream frame.
+            int64_t       stream_min_ts_ms = 0; ///< Smallest timestamp in stream_buffer.
+            int64_t       stream_max_ts_ms = 0; ///< Largest timestamp in stream_buffer.
+            std::vector<detail::SeekFrameEntry> seek_frames; ///< Frames of a stream-compressed file.
+            bool          is_seek_table_valid = true; ///< False when frames are missing from seek_frames.
+            std::vector<detail::SeekFrameEntry> time_index; ///< Time index of a plain-text file, empty when incomplete.
+        };
+
         mutable std::mutex m_mutex;    ///< Mutex to protect file operations.
         std::mutex         m_lifecycle_mutex; ///< Serializes direct log() calls with shutdown().
         Config             m_config;   ///< Configuration for the file logger.
@@ -547,9 +840,43 @@ namespace logit {
         std::string        m_file_path; ///< Path of the currently open log file.
         std::string        m_file_name; ///< Name of the currently open log file.
         int64_t            m_current_date_ts = 0; ///< Timestamp of the current log file's date.
+        int64_t            m_current_day_start_ms = 0; ///< Start of the current file's day in milliseconds.
+        int64_t            m_current_day_end_ms = 0;   ///< End (exclusive) of the current file's day in milliseconds.
         uint64_t           m_current_file_size = 0; ///< Current size of the log file.
-        std::unique_ptr<detail::CompressionWorker> m_compressor; ///< Background compressor.
+        int64_t            m_current_interval_start_ms = (std::numeric_limits<int64_t>::min)(); ///< Start of the active time-based rotation interval.
+        std::unique_ptr<detail::CompressionWorker> m_compressor; ///< Background compression pool (null = compress inline).
         std::unique_ptr<detail::SingleThreadExecutor> m_executor; ///< Dedicated executor (null = use global).
+        std::unique_ptr<detail::SingleThreadExecutor> m_rotation_executor; ///< Rotation helper (null = rotate inline).
+        mutable std::mutex m_spare_mutex; ///< Protects the pre-opened spare file handed over by the rotation helper.
+        std::unique_ptr<std::ofstream> m_spare_file; ///< Pre-opened empty file swapped in on the next rotation.
+        mutable std::condition_variable m_swap_cv; ///< Signals that the helper published a swapped file; waits on m_spare_mutex.
+        bool               m_is_swap_pending = false; ///< True until the helper renamed a swapped file; guarded by m_spare_mutex.
+        std::string        m_stream_buffer; ///< Uncompressed records waiting for the next stream frame.
+        std::string        m_stream_frame;  ///< Reusable buffer for the compressed frame.
+        int64_t            m_stream_buffer_ts_ms = 0; ///< Timestamp of the first buffered record.
+        int64_t            m_stream_buffer_mono_ms = 0; ///< Monotonic time the first buffered record arrived.
+        std::thread        m_stream_flush_thread; ///< Appends frames whose records outlived stream_flush_interval_ms.
+        std::condition_variable m_stream_flush_cv; ///< Wakes the flush thread; waits on m_mutex.
+        bool               m_is_stream_flush_stopping = false; ///< Stops the flush thread; guarded by m_mutex.
+        int64_t            m_stream_min_ts_ms = 0; ///< Smallest timestamp in the stream buffer.
+        int64_t            m_stream_max_ts_ms = 0; ///< Largest timestamp in the stream buffer.
+        std::vector<detail::SeekFrameEntry> m_seek_frames; ///< Frames of the active stream-compressed file.
+        bool               m_is_seek_table_valid = true; ///< False when the active file has frames missing from m_seek_frames.
+        std::vector<detail::SeekFrameEntry> m_time_index; ///< Closed time index blocks of the active plain-text file.
+        detail::SeekFrameEntry m_time_index_block; ///< Time index block receiving the current records.
+        bool               m_is_time_index_valid = true; ///< False when the active file has lines missing from m_time_index.
+        std::mutex         m_rotation_state_mutex; ///< Guards the cached rotation state; rotations may run on the helper thread.
+        std::string        m_rotation_base; ///< Day (`YYYY-MM-DD`) the cached rotation state belongs to.
+        uint32_t           m_rotation_seq = 0; ///< Highest `.N` sequence used for m_rotation_base.
+        std::set<RotatedFile> m_rotated_files; ///< Rotated files of m_rotation_base in name order, oldest first.
+        std::set<std::pair<int64_t, std::string> > m_dated_files; ///< Known log files by day, oldest first; guarded by m_rotation_state_mutex.
+        mutable std::mutex m_update_mutex; ///< Guards waits of follow readers.
+        mutable std::condition_variable m_update_cv; ///< Signals follow readers after writes.
+        std::atomic<uint64_t> m_update_generation{0}; ///< Incremented after each write to the active file.
+        mutable std::atomic<int> m_update_waiters{0}; ///< Number of readers blocked in wait_log_file_data().
+        mutable std::mutex m_cursor_mutex; ///< Guards the decoders of compressed files without a seek table.
+        mutable detail::CompressedFileCursor m_chunk_cursor; ///< Resumes chunk and range reads.
+        mutable detail::CompressedFileCursor m_size_cursor;  ///< Resumes readable size checks of growing files.
         std::atomic<int64_t> m_last_log_ts = ATOMIC_VAR_INIT(0); ///< Timestamp of the last log.
         std::atomic<int64_t> m_last_log_mono_ts = ATOMIC_VAR_INIT(0); ///< Timestamp of the last log.
         std::atomic<int>   m_log_level = ATOMIC_VAR_INIT(static_cast<int>(LogLevel::LOG_LVL_TRACE));
@@ -587,6 +914,19 @@ namespace logit {
                 initialize_directory();
                 open_log_file(get_current_utc_date_ts());
                 remove_old_logs();
+                if (m_config.compress != CompressType::NONE && m_config.compress_async && !is_stream_compressed()) {
+                    m_compressor.reset(new detail::CompressionWorker(
+                        m_config.compress, m_config.compress_level, m_config.external_cmd,
+                        m_config.compress_threads, m_config.compress_zstd_workers,
+                        m_config.compress_fast_level, m_config.compress_backlog_threshold));
+                }
+                if (use_background_rotation()) {
+                    m_rotation_executor.reset(new detail::SingleThreadExecutor());
+                    m_rotation_executor->add_task([this]() { prepare_spare_file(); });
+                }
+                if (is_stream_compressed() && m_config.stream_flush_interval_ms > 0) {
+                    m_stream_flush_thread = std::thread([this]() { run_stream_flush(); });
+                }
             } catch (const std::exception& e) {
                 std::cerr << "Initialization error: " << e.what() << std::endl;
             }
@@ -595,10 +935,38 @@ namespace logit {
         /// \brief Stops the logging process by closing the file and waiting for tasks.
         void stop_logging() {
             wait();
-            std::lock_guard<std::mutex> lock(m_mutex);
-            if (m_file.is_open()) {
-                m_file.close();
+            if (m_stream_flush_thread.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_is_stream_flush_stopping = true;
+                }
+                m_stream_flush_cv.notify_one();
+                m_stream_flush_thread.join();
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                wait_for_swap();
+                finish_stream_file();
+                if (m_file.is_open()) {
+                    m_file.close();
+                    write_time_index(m_file_path, take_time_index());
+                }
             }
+            if (m_rotation_executor) {
+                m_rotation_executor->shutdown();
+                release_spare_file();
+            }
+        }
+
+        /// \brief Checks whether rotations are finished on the helper thread.
+        /// \details Windows cannot rename files that are still open through std::ofstream,
+        /// so rotation stays inline there.
+        bool use_background_rotation() const {
+#           if defined(_WIN32)
+            return false;
+#           else
+            return m_config.background_rotation;
+#           endif
         }
 
         /// \brief Initializes the logging directory.
@@ -620,23 +988,36 @@ namespace logit {
         /// \param date_ts The timestamp representing the date for the log file.
         void open_log_file(const int64_t& date_ts) {
             if (m_file.is_open()) {
+                finish_stream_file();
                 m_file.close();
+                write_time_index(m_file_path, take_time_index());
             }
-            m_current_date_ts = date_ts;
+            set_current_date(date_ts);
             std::unique_lock<std::mutex> lock(m_file_path_mutex);
             m_file_path = create_file_path(date_ts);
             m_file_name = get_file_name(m_file_path);
             lock.unlock();
 #           if defined(_WIN32)
-            m_file.open(utf8_to_ansi(m_file_path), std::ios_base::app);
+            m_file.open(utf8_to_ansi(m_file_path), get_file_open_mode());
 #           else
-            m_file.open(m_file_path, std::ios_base::app);
+            m_file.open(m_file_path, get_file_open_mode());
 #           endif
             if (!m_file.is_open()) {
                 throw std::runtime_error("Failed to open log file: " + m_file_path);
             }
             m_file.seekp(0, std::ios::end);
             m_current_file_size = static_cast<uint64_t>(m_file.tellp());
+            track_log_file(date_ts, m_file_path);
+            load_seek_table();
+            load_time_index();
+        }
+
+        /// \brief Sets the date of the active file and caches its day window for write_log().
+        /// \param date_ts The timestamp representing the date for the log file.
+        void set_current_date(int64_t date_ts) {
+            m_current_date_ts = date_ts;
+            m_current_day_start_ms = time_shield::sec_to_ms(date_ts);
+            m_current_day_end_ms = m_current_day_start_ms + time_shield::sec_to_ms(time_shield::SEC_PER_DAY);
         }
 
         /// \brief Creates a file path for the log file based on the date timestamp.
@@ -644,7 +1025,614 @@ namespace logit {
         /// \return The path to the log file.
         std::string create_file_path(int64_t date_ts) const {
             std::string date_str = time_shield::to_iso8601_date(date_ts);
-            return get_directory_path() + "/" + date_str + ".log";
+            return get_directory_path() + "/" + date_str + get_log_file_extension();
+        }
+
+        /// \brief Gets the extension of files written by this logger.
+        /// \return `.log`, or `.log.gz`/`.log.zst` when the active file is stream-compressed.
+        std::string get_log_file_extension() const {
+            switch (get_stream_compress_type()) {
+            case CompressType::GZIP: return ".log.gz";
+            case CompressType::ZSTD: return ".log.zst";
+            default:
+                break;
+            };
+            return ".log";
+        }
+
+        /// \brief Gets the stream compression actually available in this build.
+        /// \return Configured stream compression, or NONE when its library is not linked.
+        CompressType get_stream_compress_type() const {
+            switch (m_config.stream_compress) {
+#           if defined(LOGIT_HAS_ZLIB)
+            case CompressType::GZIP: return CompressType::GZIP;
+#           endif
+#           if defined(LOGIT_HAS_ZSTD)
+            case CompressType::ZSTD: return CompressType::ZSTD;
+#           endif
+            default:
+                break;
+            };
+            return CompressType::NONE;
+        }
+
+        bool is_stream_compressed() const {
+            return get_stream_compress_type() != CompressType::NONE;
+        }
+
+        std::ios_base::openmode get_file_open_mode() const {
+            return is_stream_compressed()
+                ? (std::ios_base::app | std::ios_base::binary)
+                : std::ios_base::app;
+        }
+
+        /// \brief Buffers a record for the compressed stream and appends a frame when due.
+        /// \param message Formatted log message.
+        /// \param timestamp_ms Timestamp of the record.
+        void write_stream_record(const std::string& message, int64_t timestamp_ms) {
+            if (m_stream_buffer.empty()) {
+                m_stream_buffer_ts_ms = timestamp_ms;
+                m_stream_buffer_mono_ms = LOGIT_MONOTONIC_MS();
+                m_stream_min_ts_ms = timestamp_ms;
+                m_stream_max_ts_ms = timestamp_ms;
+                // Arms the deadline of the new frame.
+                m_stream_flush_cv.notify_one();
+            } else {
+                m_stream_min_ts_ms = (std::min)(m_stream_min_ts_ms, timestamp_ms);
+                m_stream_max_ts_ms = (std::max)(m_stream_max_ts_ms, timestamp_ms);
+            }
+            m_stream_buffer.append(message);
+            m_stream_buffer.push_back('\n');
+            const bool is_frame_full = m_stream_buffer.size() >= m_config.stream_frame_bytes;
+            const bool is_frame_due = m_config.stream_flush_interval_ms > 0 &&
+                timestamp_ms - m_stream_buffer_ts_ms >= m_config.stream_flush_interval_ms;
+            if (is_frame_full || is_frame_due) {
+                flush_stream_frame();
+            } else {
+                flush_due_stream_frame();
+            }
+        }
+
+        /// \brief Appends buffered records once they are older than `stream_flush_interval_ms`.
+        /// \details Runs on its own thread so a quiet logger does not keep the last
+        /// records in memory, invisible to readers and lost on a crash.
+        void run_stream_flush() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_is_stream_flush_stopping) {
+                if (m_stream_buffer.empty()) {
+                    m_stream_flush_cv.wait(lock);
+                    continue;
+                }
+                const int64_t due_ms = m_stream_buffer_mono_ms + m_config.stream_flush_interval_ms;
+                const int64_t now_ms = LOGIT_MONOTONIC_MS();
+                if (now_ms < due_ms) {
+                    m_stream_flush_cv.wait_for(lock, std::chrono::milliseconds(due_ms - now_ms));
+                    continue;
+                }
+                flush_stream_frame();
+                notify_file_update();
+            }
+        }
+
+        /// \brief Appends the stream buffer when its flush deadline has passed.
+        /// \details Catches records timestamped in the past, whose deadline in
+        /// write_stream_record() never elapses. Readers never compress; they see buffered
+        /// records once the writer or the flush thread appended them. Must be called with
+        /// m_mutex held.
+        void flush_due_stream_frame() {
+            if (m_stream_buffer.empty() || m_config.stream_flush_interval_ms <= 0 ||
+                LOGIT_MONOTONIC_MS() - m_stream_buffer_mono_ms < m_config.stream_flush_interval_ms) {
+                return;
+            }
+            flush_stream_frame();
+        }
+
+        /// \brief Compresses buffered records into one independent frame and appends it.
+        /// \details Each gzip member or zstd frame is self-contained, so the file stays
+        /// readable up to the last appended frame.
+        void flush_stream_frame() {
+            if (m_stream_buffer.empty()) return;
+            append_stream_frame(
+                m_file, m_file_path, m_stream_buffer, m_stream_min_ts_ms, m_stream_max_ts_ms,
+                m_stream_frame, m_current_file_size, m_is_seek_table_valid ? &m_seek_frames : nullptr);
+            m_stream_buffer.clear();
+        }
+
+        /// \brief Compresses `records` into one frame and appends it to `file`.
+        /// \details Shared by the active file and files retired by a background rotation.
+        /// \param frame Reusable buffer for the compressed frame.
+        /// \param[in,out] file_size Offset of the frame; advanced by the appended bytes.
+        /// \param frames Seek table receiving the frame, or null when the table is incomplete.
+        void append_stream_frame(
+                std::ofstream& file,
+                const std::string& path,
+                const std::string& records,
+                int64_t first_ts_ms,
+                int64_t last_ts_ms,
+                std::string& frame,
+                uint64_t& file_size,
+                std::vector<detail::SeekFrameEntry>* frames) const {
+            bool is_compressed = false;
+            if (get_stream_compress_type() == CompressType::GZIP) {
+                is_compressed = detail::compress_string_gzip(records, frame, m_config.compress_level);
+            } else {
+                is_compressed = detail::compress_string_zstd(records, frame, m_config.compress_level);
+            }
+            if (!is_compressed) {
+                std::cerr << "Failed to compress log frame: " << path << std::endl;
+                return;
+            }
+            if (!file.is_open()) return;
+            file.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+            file.flush();
+            if (frames) {
+                detail::SeekFrameEntry entry;
+                entry.offset = file_size;
+                entry.compressed_size = static_cast<uint32_t>(frame.size());
+                entry.size = static_cast<uint32_t>(records.size());
+                entry.first_ts_ms = first_ts_ms;
+                entry.last_ts_ms = last_ts_ms;
+                frames->push_back(entry);
+            }
+            file_size += static_cast<uint64_t>(frame.size());
+        }
+
+        /// \brief Appends the seek table trailer of a finished stream-compressed file.
+        void append_seek_table(
+                std::ofstream& file,
+                const std::string& path,
+                const std::vector<detail::SeekFrameEntry>& frames,
+                uint64_t& file_size) const {
+            if (frames.empty() || !file.is_open()) return;
+            std::string trailer;
+            const bool is_gzip = get_stream_compress_type() == CompressType::GZIP;
+            if (!detail::make_seek_table_trailer(is_gzip, frames, trailer)) {
+                std::cerr << "Failed to write seek table: " << path << std::endl;
+                return;
+            }
+            file.write(trailer.data(), static_cast<std::streamsize>(trailer.size()));
+            file.flush();
+            file_size += static_cast<uint64_t>(trailer.size());
+        }
+
+        /// \brief Appends the pending frame and the seek table before the active file is closed.
+        /// \details The table is skipped when earlier frames of the file are not known, e.g.
+        /// after an unclean shutdown left the file without a trailing table.
+        void finish_stream_file() {
+            if (!is_stream_compressed()) return;
+            flush_stream_frame();
+            if (m_is_seek_table_valid) {
+                append_seek_table(m_file, m_file_path, m_seek_frames, m_current_file_size);
+            }
+            m_seek_frames.clear();
+            m_is_seek_table_valid = true;
+        }
+
+        /// \brief Appends the pending frame and the seek table of a retired file.
+        /// \param path Path of the retired file, used in error messages.
+        void finish_retired_stream(RetiredFile& retired, const std::string& path) const {
+            if (!is_stream_compressed()) return;
+            if (!retired.stream_buffer.empty()) {
+                std::string frame;
+                append_stream_frame(
+                    retired.file, path, retired.stream_buffer, retired.stream_min_ts_ms, retired.stream_max_ts_ms,
+                    frame, retired.size, retired.is_seek_table_valid ? &retired.seek_frames : nullptr);
+                retired.stream_buffer.clear();
+            }
+            if (retired.is_seek_table_valid) {
+                append_seek_table(retired.file, path, retired.seek_frames, retired.size);
+            }
+        }
+
+        /// \brief Restores the seek table of a reopened stream-compressed file.
+        void load_seek_table() {
+            m_seek_frames.clear();
+            m_is_seek_table_valid = true;
+            if (!is_stream_compressed() || m_current_file_size == 0) return;
+            uint64_t table_offset = 0;
+            m_is_seek_table_valid = read_seek_table(m_file_path, m_seek_frames, table_offset);
+            if (!m_is_seek_table_valid) m_seek_frames.clear();
+        }
+
+        bool use_time_index() const {
+            return m_config.time_index_interval_bytes > 0 && !is_stream_compressed();
+        }
+
+        /// \brief Gets the time index sidecar path of a log file.
+        /// \details A rotated file compressed afterwards keeps the sidecar written for its
+        /// plain-text original, since the index refers to uncompressed offsets.
+        std::string get_time_index_path(const std::string& file_path) const {
+            return strip_compression_suffix(file_path) + ".idx";
+        }
+
+        /// \brief Accounts a plain-text line in the open time index block.
+        /// \param timestamp_ms Timestamp of the record.
+        /// \param size Size of the line, including its terminator.
+        void add_time_index_record(int64_t timestamp_ms, uint64_t size) {
+            if (!use_time_index()) return;
+            if (m_time_index_block.size > 0 &&
+                m_time_index_block.size + size > (std::numeric_limits<uint32_t>::max)()) {
+                close_time_index_block();
+            }
+            detail::SeekFrameEntry& block = m_time_index_block;
+            if (block.size == 0) {
+                block.offset = m_current_file_size;
+                block.first_ts_ms = timestamp_ms;
+                block.last_ts_ms = timestamp_ms;
+            } else {
+                block.first_ts_ms = (std::min)(block.first_ts_ms, timestamp_ms);
+                block.last_ts_ms = (std::max)(block.last_ts_ms, timestamp_ms);
+            }
+            block.size += static_cast<uint32_t>(size);
+            block.compressed_size = block.size;
+            if (block.size >= m_config.time_index_interval_bytes) {
+                close_time_index_block();
+            }
+        }
+
+        void close_time_index_block() {
+            if (m_time_index_block.size == 0) return;
+            if (m_is_time_index_valid) {
+                m_time_index.push_back(m_time_index_block);
+            }
+            m_time_index_block = detail::SeekFrameEntry();
+        }
+
+        /// \brief Moves the time index of the active file out, including the open block.
+        /// \return Blocks of the active file, or an empty vector when the index is incomplete.
+        std::vector<detail::SeekFrameEntry> take_time_index() {
+            close_time_index_block();
+            std::vector<detail::SeekFrameEntry> entries;
+            if (m_is_time_index_valid) {
+                entries.swap(m_time_index);
+            }
+            m_time_index.clear();
+            m_is_time_index_valid = true;
+            return entries;
+        }
+
+        /// \brief Writes the time index sidecar of a finished file.
+        void write_time_index(const std::string& file_path, const std::vector<detail::SeekFrameEntry>& entries) const {
+            if (entries.empty()) return;
+            if (!detail::write_time_index_file(to_native_path(get_time_index_path(file_path)), entries)) {
+                std::cerr << "Failed to write time index: " << get_time_index_path(file_path) << std::endl;
+            }
+        }
+
+        void remove_time_index_file(const std::string& file_path) const {
+            remove_file_path(get_time_index_path(file_path));
+        }
+
+        /// \brief Restores the time index of a reopened plain-text file.
+        /// \details The sidecar is trusted only when its blocks end exactly at the end
+        /// of the file; otherwise it is stale and removed.
+        void load_time_index() {
+            m_time_index.clear();
+            m_time_index_block = detail::SeekFrameEntry();
+            m_is_time_index_valid = true;
+            if (!use_time_index()) return;
+            if (m_current_file_size == 0) {
+                remove_time_index_file(m_file_path);
+                return;
+            }
+            m_is_time_index_valid =
+                detail::read_time_index_file(to_native_path(get_time_index_path(m_file_path)), m_time_index) &&
+                !m_time_index.empty() &&
+                m_time_index.back().offset + m_time_index.back().size == m_current_file_size;
+            if (!m_is_time_index_valid) {
+                m_time_index.clear();
+                remove_time_index_file(m_file_path);
+            }
+        }
+
+        /// \brief Gets the time index of a listed plain-text file.
+        /// \details The active file uses the in-memory index, rotated files their sidecar.
+        bool get_time_index(const LogFileInfo& info, std::vector<detail::SeekFrameEntry>& entries) const {
+            if (info.is_current && use_time_index()) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_file.is_open()) m_file.flush();
+                entries = m_time_index;
+                if (m_time_index_block.size > 0) {
+                    entries.push_back(m_time_index_block);
+                }
+                return m_is_time_index_valid;
+            }
+            return detail::read_time_index_file(to_native_path(get_time_index_path(info.path)), entries);
+        }
+
+        bool read_seek_table(
+                const std::string& file_path,
+                std::vector<detail::SeekFrameEntry>& entries,
+                uint64_t& table_offset) const {
+            const bool is_gzip = ends_with(file_path, ".gz");
+            if (!is_gzip && !ends_with(file_path, ".zst")) return false;
+            return detail::read_seek_table(to_native_path(file_path), is_gzip, entries, table_offset);
+        }
+
+        /// \brief Gets the seek table of a listed file.
+        /// \details The active file uses the in-memory table, rotated files their trailing table.
+        bool get_seek_frames(const LogFileInfo& info, std::vector<detail::SeekFrameEntry>& entries) const {
+            if (!info.is_compressed) return false;
+            if (info.is_current && is_stream_compressed()) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_file.is_open()) m_file.flush();
+                entries = m_seek_frames;
+                return m_is_seek_table_valid;
+            }
+            uint64_t table_offset = 0;
+            return read_seek_table(info.path, entries, table_offset);
+        }
+
+        bool decompress_log_frame(const std::string& file_path, const std::string& frame, std::string& out) const {
+            if (ends_with(file_path, ".gz")) {
+                return detail::decompress_string_gzip_members(frame, out);
+            }
+            return detail::decompress_string_zstd_frames(frame, out);
+        }
+
+        LogFileReadResult read_byte_range_from_info(const LogFileInfo& info, uint64_t offset, uint64_t length) const {
+            LogFileReadResult result;
+            result.file = info;
+            const uint64_t end = length > (std::numeric_limits<uint64_t>::max)() - offset
+                ? (std::numeric_limits<uint64_t>::max)()
+                : offset + length;
+
+            std::vector<detail::SeekFrameEntry> frames;
+            if (get_seek_frames(info, frames)) {
+                result.ok = read_frames_range(info, frames, offset, end, result.content);
+                return result;
+            }
+
+            if (!info.is_compressed) {
+                result.ok = read_plain_file_range(info, offset, end, result.content);
+                return result;
+            }
+
+            std::vector<char> block(64 * 1024);
+            uint64_t position = offset;
+            bool is_eof = false;
+            while (position < end && !is_eof) {
+                const size_t wanted = static_cast<size_t>((std::min<uint64_t>)(end - position, block.size()));
+                size_t size = 0;
+                if (!read_compressed_range(info, position, &block[0], wanted, size, is_eof)) {
+                    result.content.clear();
+                    return result;
+                }
+                result.content.append(&block[0], size);
+                position += size;
+            }
+            result.ok = true;
+            return result;
+        }
+
+        /// \brief Reads part of a compressed file without a seek table.
+        /// \details Reuses the chunk cursor when it is at or before `offset`, so sequential
+        /// reads decode each byte once; reading backwards restarts from the file start.
+        /// \param[out] is_eof True when the read reached the end of the decoded content.
+        bool read_compressed_range(
+                const LogFileInfo& info,
+                uint64_t offset,
+                char* buffer,
+                size_t capacity,
+                size_t& size,
+                bool& is_eof) const {
+            size = 0;
+            std::lock_guard<std::mutex> lock(m_cursor_mutex);
+            if (!sync_compressed_cursor(info, m_chunk_cursor)) return false;
+            if (m_chunk_cursor.position() > offset && !m_chunk_cursor.rewind()) return false;
+            if (!m_chunk_cursor.skip(offset - m_chunk_cursor.position()) ||
+                !m_chunk_cursor.read(buffer, capacity, size)) {
+                m_chunk_cursor.close();
+                return false;
+            }
+            is_eof = m_chunk_cursor.is_eof();
+            return true;
+        }
+
+        /// \brief Points `cursor` at a compressed file, keeping its position when the file only grew.
+        bool sync_compressed_cursor(const LogFileInfo& info, detail::CompressedFileCursor& cursor) const {
+            flush_current_file(info);
+            return cursor.sync(to_native_path(info.path), ends_with(info.path, ".gz"));
+        }
+
+        /// \brief Decompresses only the frames that cover `[offset, end)`.
+        bool read_frames_range(
+                const LogFileInfo& info,
+                const std::vector<detail::SeekFrameEntry>& frames,
+                uint64_t offset,
+                uint64_t end,
+                std::string& out) const {
+            out.clear();
+            std::ifstream in(to_native_path(info.path).c_str(), std::ios_base::binary);
+            if (!in.is_open()) return false;
+            uint64_t frame_start = 0;
+            std::string frame;
+            std::string content;
+            for (size_t i = 0; i < frames.size() && frame_start < end; ++i) {
+                const uint64_t frame_end = frame_start + frames[i].size;
+                if (frame_end > offset) {
+                    if (!detail::read_seek_frame(in, frames[i], frame) ||
+                        !decompress_log_frame(info.path, frame, content)) {
+                        out.clear();
+                        return false;
+                    }
+                    const uint64_t from = offset > frame_start ? offset - frame_start : 0;
+                    const uint64_t to = (std::min)(end, frame_end) - frame_start;
+                    if (from < content.size()) {
+                        out.append(content, static_cast<size_t>(from),
+                                   static_cast<size_t>((std::min<uint64_t>)(to, content.size()) - from));
+                    }
+                }
+                frame_start = frame_end;
+            }
+            return true;
+        }
+
+        bool read_plain_file_range(const LogFileInfo& info, uint64_t offset, uint64_t end, std::string& out) const {
+            flush_current_file(info);
+            std::ifstream in(to_native_path(info.path).c_str(), std::ios_base::binary);
+            out.clear();
+            if (!in.is_open()) return false;
+            in.seekg(0, std::ios::end);
+            const uint64_t file_size = static_cast<uint64_t>(in.tellg());
+            if (offset >= file_size) return true;
+            out.resize(static_cast<size_t>((std::min)(end, file_size) - offset));
+            in.seekg(static_cast<std::streamoff>(offset));
+            in.read(&out[0], static_cast<std::streamsize>(out.size()));
+            out.resize(static_cast<size_t>(in.gcount()));
+            return !in.bad();
+        }
+
+        /// \brief Gets the size of the uncompressed content readers can see.
+        bool get_readable_size(const LogFileInfo& info, uint64_t& size) const {
+            size = 0;
+            std::vector<detail::SeekFrameEntry> frames;
+            if (get_seek_frames(info, frames)) {
+                for (size_t i = 0; i < frames.size(); ++i) {
+                    size += frames[i].size;
+                }
+                return true;
+            }
+            if (info.is_compressed) {
+                // Resumes from the last measured end, so a follower polling a growing
+                // file decodes only the data appended since.
+                std::lock_guard<std::mutex> lock(m_cursor_mutex);
+                if (!sync_compressed_cursor(info, m_size_cursor) ||
+                    !m_size_cursor.skip((std::numeric_limits<uint64_t>::max)())) {
+                    m_size_cursor.close();
+                    return false;
+                }
+                size = m_size_cursor.position();
+                return true;
+            }
+            flush_current_file(info);
+            return detail::get_file_size(to_native_path(info.path), size);
+        }
+
+        /// \brief Resolves a path to file metadata without listing the directory.
+        bool find_log_file_info(const std::string& path, LogFileInfo& info) const {
+            return try_make_log_file_info(path, get_last_log_file_path(), info);
+        }
+
+        void flush_current_file(const LogFileInfo& info) const {
+            if (!info.is_current) return;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_file.is_open()) m_file.flush();
+        }
+
+        std::string to_native_path(const std::string& path) const {
+#           if defined(_WIN32)
+            return utf8_to_ansi(path);
+#           else
+            return path;
+#           endif
+        }
+
+        /// \brief Wakes follow readers after the active file changed.
+        void notify_file_update() {
+            m_update_generation.fetch_add(1);
+            if (m_update_waiters.load() > 0) {
+                std::lock_guard<std::mutex> lock(m_update_mutex);
+                m_update_cv.notify_all();
+            }
+        }
+
+        LogFileReadResult read_time_range_from_info(const LogFileInfo& info, int64_t from_ms, int64_t to_ms) const {
+            LogFileReadResult result;
+            result.file = info;
+            std::vector<detail::SeekFrameEntry> frames;
+            if (get_seek_frames(info, frames)) {
+                result.ok = read_frames_time_range(info, frames, from_ms, to_ms, result.content);
+            } else if (get_time_index(info, frames)) {
+                result.ok = read_time_index_range(info, frames, from_ms, to_ms, result.content);
+            }
+            return result;
+        }
+
+        bool read_frames_time_range(
+                const LogFileInfo& info,
+                const std::vector<detail::SeekFrameEntry>& frames,
+                int64_t from_ms,
+                int64_t to_ms,
+                std::string& out) const {
+            out.clear();
+            std::ifstream in(to_native_path(info.path).c_str(), std::ios_base::binary);
+            if (!in.is_open()) return false;
+            std::string frame;
+            std::string content;
+            const std::pair<size_t, size_t> range = detail::find_seek_frame_range(frames, from_ms, to_ms);
+            for (size_t i = range.first; i < range.second; ++i) {
+                if (frames[i].last_ts_ms < from_ms || frames[i].first_ts_ms > to_ms) continue;
+                if (!detail::read_seek_frame(in, frames[i], frame) ||
+                    !decompress_log_frame(info.path, frame, content)) {
+                    out.clear();
+                    return false;
+                }
+                out += content;
+            }
+            return true;
+        }
+
+        /// \brief Reads the time index blocks of a plain-text file that overlap a time range.
+        /// \details Adjacent blocks are read as one byte range. Rotated files that were
+        /// compressed afterwards are decompressed once and sliced.
+        bool read_time_index_range(
+                const LogFileInfo& info,
+                const std::vector<detail::SeekFrameEntry>& blocks,
+                int64_t from_ms,
+                int64_t to_ms,
+                std::string& out) const {
+            out.clear();
+            std::string full;
+            uint64_t file_size = 0;
+            if (info.is_compressed) {
+                if (!read_compressed_file(info.path, full)) return false;
+                file_size = full.size();
+            } else if (!detail::get_file_size(to_native_path(info.path), file_size)) {
+                return false;
+            }
+            // The active file may already hold lines written after the index snapshot.
+            const uint64_t indexed_size = blocks.empty() ? 0 : blocks.back().offset + blocks.back().size;
+            if (blocks.empty() || (info.is_current ? indexed_size > file_size : indexed_size != file_size)) {
+                return false;
+            }
+
+            std::vector<std::pair<uint64_t, uint64_t> > ranges;
+            const std::pair<size_t, size_t> candidates = detail::find_seek_frame_range(blocks, from_ms, to_ms);
+            for (size_t i = candidates.first; i < candidates.second; ++i) {
+                if (blocks[i].last_ts_ms < from_ms || blocks[i].first_ts_ms > to_ms) continue;
+                const uint64_t block_end = blocks[i].offset + blocks[i].size;
+                if (!ranges.empty() && ranges.back().second == blocks[i].offset) {
+                    ranges.back().second = block_end;
+                } else {
+                    ranges.push_back(std::make_pair(blocks[i].offset, block_end));
+                }
+            }
+
+            std::string chunk;
+            for (size_t i = 0; i < ranges.size(); ++i) {
+                if (info.is_compressed) {
+                    out.append(full, static_cast<size_t>(ranges[i].first),
+                               static_cast<size_t>(ranges[i].second - ranges[i].first));
+                    continue;
+                }
+                if (!read_plain_file_range(info, ranges[i].first, ranges[i].second, chunk)) {
+                    out.clear();
+                    return false;
+                }
+                out += chunk;
+            }
+            return true;
+        }
+
+        /// \brief Checks whether the next record exceeds the size limit.
+        /// \details Stream-compressed files are measured by the compressed bytes on disk.
+        /// \param add Uncompressed size of the next record.
+        bool is_file_size_limit_reached(uint64_t add) const {
+            if (is_stream_compressed()) {
+                return m_current_file_size >= m_config.max_file_size_bytes;
+            }
+            return m_current_file_size + add > m_config.max_file_size_bytes;
         }
 
         bool try_make_log_file_info(
@@ -672,22 +1660,35 @@ namespace logit {
             LogFileReadResult result;
             result.file = info;
 
+            flush_current_file(info);
+
             if (info.is_compressed) {
-                result.ok = false;
+                result.ok = read_compressed_file(info.path, result.content);
                 return result;
             }
 
-            if (info.is_current) {
-                std::lock_guard<std::mutex> lock(m_mutex);
-                if (m_file.is_open()) {
-                    m_file.flush();
-                }
-            }
-
             result.ok = read_plain_file(info.path, result.content);
             return result;
         }
 
+        /// \brief Reads and decompresses a gzip or zstd log file.
+        /// \details Stream-compressed files are read up to the last complete frame.
+        bool read_compressed_file(const std::string& file_path, std::string& out) const {
+            std::string raw;
+            if (!read_plain_file(file_path, raw)) {
+                out.clear();
+                return false;
+            }
+            bool is_ok = false;
+            if (ends_with(file_path, ".gz")) {
+                is_ok = detail::decompress_string_gzip_members(raw, out);
+            } else if (ends_with(file_path, ".zst")) {
+                is_ok = detail::decompress_string_zstd_frames(raw, out);
+            }
+            if (!is_ok) out.clear();
+            return is_ok;
+        }
+
         bool read_plain_file(const std::string& file_path, std::string& out) const {
 #           if defined(_WIN32)
             std::ifstream in(utf8_to_ansi(file_path).c_str(), std::ios_base::binary);
@@ -845,35 +1846,300 @@ namespace logit {
         /// \param message The log message to write.
         /// \param timestamp_ms The timestamp of the log message in milliseconds.
         void write_log(const std::string& message, const int64_t& timestamp_ms) {
-            const int64_t message_date_ts = time_shield::start_of_day(time_shield::ms_to_sec(timestamp_ms));
-            if (message_date_ts != m_current_date_ts) {
-                open_log_file(message_date_ts);
-            }
-            if (m_config.max_file_size_bytes > 0) {
-                const uint64_t add = static_cast<uint64_t>(message.size() + 1);
-                if (m_current_file_size + add > m_config.max_file_size_bytes) {
-                    rotate_current_file();
+            if (timestamp_ms < m_current_day_start_ms || timestamp_ms >= m_current_day_end_ms) {
+                const int64_t message_date_ts = time_shield::start_of_day(time_shield::ms_to_sec(timestamp_ms));
+                if (!swap_to_spare_file(message_date_ts, false)) {
+                    open_log_file(message_date_ts);
+                    enforce_day_retention(message_date_ts);
                 }
             }
-            if (m_file.is_open()) {
+            if (is_rotation_interval_elapsed(timestamp_ms)) {
+                rotate_current_file();
+            }
+            if (m_config.max_file_size_bytes > 0 &&
+                is_file_size_limit_reached(static_cast<uint64_t>(message.size() + 1))) {
+                rotate_current_file();
+            }
+            if (is_stream_compressed()) {
+                write_stream_record(message, timestamp_ms);
+            } else if (m_file.is_open()) {
                 m_file << message << '\n';
+                add_time_index_record(timestamp_ms, static_cast<uint64_t>(message.size() + 1));
                 m_current_file_size += static_cast<uint64_t>(message.size() + 1);
             }
-            remove_old_logs();
+            notify_file_update();
+        }
+
+        /// \brief Advances the time-based rotation interval.
+        /// \param timestamp_ms Timestamp of the message being written.
+        /// \return True when a new interval started and the current file already has data.
+        bool is_rotation_interval_elapsed(int64_t timestamp_ms) {
+            if (m_config.rotation_interval_ms <= 0) return false;
+            int64_t offset_ms = timestamp_ms % m_config.rotation_interval_ms;
+            if (offset_ms < 0) offset_ms += m_config.rotation_interval_ms;
+            const int64_t interval_start_ms = timestamp_ms - offset_ms;
+            if (interval_start_ms <= m_current_interval_start_ms) return false;
+            const bool has_previous_interval =
+                m_current_interval_start_ms != (std::numeric_limits<int64_t>::min)();
+            m_current_interval_start_ms = interval_start_ms;
+            return has_previous_interval && m_current_file_size > 0;
+        }
+
+        /// \brief Swaps the active stream with the pre-opened spare file.
+        /// \details Only exchanges the streams and the in-memory file state. The renames,
+        /// the seek table and time index of the old file, closing, compression and retention
+        /// all run on the rotation helper. Never waits for a spare: when none is ready yet
+        /// the caller rotates inline.
+        /// \param date_ts Date of the file that becomes active after the swap.
+        /// \param rotate_current True to move the active file to its rotated name; false on day change.
+        /// \return True when the helper took over the old file.
+        bool swap_to_spare_file(int64_t date_ts, bool rotate_current) {
+            if (!m_rotation_executor) return false;
+            // The previous swap must name the active file before it is rotated again.
+            wait_for_swap();
+            const std::string active_path = create_file_path(date_ts);
+            // An existing file of the new day is reopened inline.
+            if (!rotate_current && is_known_log_file(date_ts, active_path)) return false;
+
+            std::unique_ptr<std::ofstream> spare_file;
+            if (!take_spare_file(spare_file, true)) return false;
+
+            std::shared_ptr<RetiredFile> retired(new RetiredFile());
+            retired->file = std::move(m_file);
+            retired->path = m_file_path;
+            retired->next_path = active_path;
+            retired->date_ts = date_ts;
+            retired->is_rotation = rotate_current;
+            retired->size = m_current_file_size;
+            retired->stream_buffer.swap(m_stream_buffer);
+            retired->stream_min_ts_ms = m_stream_min_ts_ms;
+            retired->stream_max_ts_ms = m_stream_max_ts_ms;
+            retired->seek_frames.swap(m_seek_frames);
+            retired->is_seek_table_valid = m_is_seek_table_valid;
+            retired->time_index = take_time_index();
+
+            m_file = std::move(*spare_file);
+            set_current_date(date_ts);
+            m_current_file_size = 0;
+            m_seek_frames.clear();
+            m_is_seek_table_valid = true;
+
+            m_rotation_executor->add_task([this, retired]() {
+                finish_background_rotation(*retired);
+            });
+            return true;
+        }
+
+        /// \brief Completes a swapped rotation on the helper thread.
+        /// \details Finishes the old file, renames both files and publishes the new path
+        /// before the writer may rotate again; compression and retention follow.
+        void finish_background_rotation(RetiredFile& retired) {
+            const std::string base = time_shield::to_iso8601_date(retired.date_ts);
+            std::string finished_path = retired.path;
+            bool is_renamed = false;
+            try {
+                finish_retired_stream(retired, retired.path);
+            } catch (const std::exception& e) {
+                std::cerr << "Log rotation error: " << e.what() << std::endl;
+            }
+            if (retired.file.is_open()) {
+                retired.file.close();
+            }
+            try {
+                is_renamed = rename_swapped_files(retired, finished_path);
+                write_time_index(finished_path, retired.time_index);
+            } catch (const std::exception& e) {
+                std::cerr << "Log rotation error: " << e.what() << std::endl;
+            }
+            end_swap();
+            if (!is_renamed) {
+                // The writer keeps the spare path; no new spare may be opened over it.
+                return;
+            }
+            try {
+                if (retired.is_rotation) {
+                    compress_rotated_file(finished_path);
+                    if (m_config.max_rotated_files > 0) {
+                        enforce_rotation_retention(base, m_config.max_rotated_files, get_directory_path());
+                    }
+                } else {
+                    enforce_day_retention(retired.date_ts);
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Log rotation error: " << e.what() << std::endl;
+            }
+            prepare_spare_file();
+        }
+
+        /// \brief Moves the old file to its rotated name and the spare to the active name.
+        /// \details Runs on the helper; the writer already appends to the spare stream.
+        /// A file of the new day created behind the logger's back is kept as a rotated file.
+        /// \param[out] finished_path Final path of the old file.
+        /// \return False when the spare could not be renamed and stays the active file.
+        bool rename_swapped_files(const RetiredFile& retired, std::string& finished_path) {
+            const std::string base = time_shield::to_iso8601_date(retired.date_ts);
+            const std::string dir = get_directory_path();
+            const std::string rotated = retired.is_rotation ? make_rotated_name(base, dir) : std::string();
+            const std::string displaced = !retired.is_rotation && file_exists(retired.next_path)
+                ? make_rotated_name(base, dir)
+                : std::string();
+            std::string active_path = retired.next_path;
+            bool is_displaced = false;
+            {
+                std::lock_guard<std::mutex> lock(m_file_path_mutex);
+                if (retired.is_rotation && rename_file_path(retired.path, rotated)) {
+                    finished_path = rotated;
+                }
+                if (!displaced.empty()) {
+                    is_displaced = rename_file_path(retired.next_path, displaced);
+                    if (!is_displaced) active_path.clear();
+                }
+                if (finished_path == retired.path && retired.is_rotation) {
+                    // The old file still holds the active name.
+                    active_path.clear();
+                }
+                if (active_path.empty() || !rename_file_path(get_spare_file_path(), active_path)) {
+                    active_path = get_spare_file_path();
+                }
+                m_file_path = active_path;
+                m_file_name = get_file_name(active_path);
+            }
+            if (finished_path != retired.path) {
+                register_rotated_file(base, finished_path);
+            }
+            if (is_displaced) {
+                register_rotated_file(base, displaced);
+            }
+            if (active_path == get_spare_file_path()) {
+                std::cerr << "Failed to rename log file: " << retired.next_path << std::endl;
+                return false;
+            }
+            remove_time_index_file(active_path);
+            track_log_file(retired.date_ts, active_path);
+            return true;
+        }
+
+        /// \brief Opens the empty spare file used by the next background rotation.
+        /// \details A non-empty spare is left over from a crash; it is recovered as a
+        /// rotated file of the current day instead of being prepended to the next file.
+        void prepare_spare_file() {
+            const std::string spare_path = get_spare_file_path();
+            uint64_t leftover_size = 0;
+            if (detail::get_file_size(to_native_path(spare_path), leftover_size) && leftover_size > 0) {
+                const std::string base = time_shield::to_iso8601_date(get_current_utc_date_ts());
+                const std::string recovered = make_rotated_name(base, get_directory_path());
+                if (!rename_file_path(spare_path, recovered)) {
+                    std::cerr << "Failed to recover leftover log file: " << spare_path << std::endl;
+                    return;
+                }
+                std::cerr << "Recovered leftover log file as " << recovered << std::endl;
+                register_rotated_file(base, recovered);
+            }
+            std::unique_ptr<std::ofstream> spare_file(
+                new std::ofstream(to_native_path(spare_path).c_str(), get_file_open_mode()));
+            if (!spare_file->is_open()) {
+                std::cerr << "Failed to pre-open log file: " << spare_path << std::endl;
+                return;
+            }
+            put_spare_file(std::move(spare_file));
+        }
+
+        void put_spare_file(std::unique_ptr<std::ofstream> spare_file) {
+            std::lock_guard<std::mutex> lock(m_spare_mutex);
+            m_spare_file = std::move(spare_file);
+        }
+
+        /// \brief Takes the spare file.
+        /// \param is_swap True to mark a swap pending until the helper calls end_swap().
+        bool take_spare_file(std::unique_ptr<std::ofstream>& spare_file, bool is_swap = false) {
+            std::lock_guard<std::mutex> lock(m_spare_mutex);
+            if (!m_spare_file) return false;
+            spare_file = std::move(m_spare_file);
+            if (is_swap) m_is_swap_pending = true;
+            return true;
+        }
+
+        /// \brief Waits until the helper published the file of the last swap.
+        /// \details The helper never takes m_mutex before end_swap(), so the writer may
+        /// wait here while holding it.
+        void wait_for_swap() const {
+            std::unique_lock<std::mutex> lock(m_spare_mutex);
+            m_swap_cv.wait(lock, [this]() { return !m_is_swap_pending; });
+        }
+
+        void end_swap() {
+            {
+                std::lock_guard<std::mutex> lock(m_spare_mutex);
+                m_is_swap_pending = false;
+            }
+            m_swap_cv.notify_all();
+        }
+
+        /// \brief Checks the retention list for a log file, without touching the disk.
+        /// \details m_dated_files holds every file found at startup or opened since;
+        /// files created behind the logger's back are handled by rename_swapped_files().
+        bool is_known_log_file(int64_t date_ts, const std::string& path) {
+            std::lock_guard<std::mutex> lock(m_rotation_state_mutex);
+            return m_dated_files.count(std::make_pair(date_ts, path)) > 0 ||
+                   m_dated_files.count(std::make_pair(date_ts, strip_compression_suffix(path))) > 0;
+        }
+
+        /// \brief Closes and removes the unused spare file.
+        void release_spare_file() {
+            std::unique_ptr<std::ofstream> spare_file;
+            if (!take_spare_file(spare_file)) return;
+            spare_file->close();
+            remove_file_path(get_spare_file_path());
+        }
+
+        /// \brief Gets the staging path of the spare file.
+        /// \details The leading dot keeps it out of `list_log_files()` and retention.
+        std::string get_spare_file_path() const {
+            return get_directory_path() + "/.logit-next.log";
+        }
+
+        bool rename_file_path(const std::string& from, const std::string& to) const {
+#           if defined(_WIN32)
+            return std::rename(utf8_to_ansi(from).c_str(), utf8_to_ansi(to).c_str()) == 0;
+#           else
+            return std::rename(from.c_str(), to.c_str()) == 0;
+#           endif
+        }
+
+        bool file_exists(const std::string& path) const {
+#           if __cplusplus >= 201703L
+#               if defined(_WIN32)
+            return fs::exists(fs::u8path(path));
+#               else
+            return fs::exists(fs::path(path));
+#               endif
+#           else
+#               if defined(_WIN32)
+            std::ifstream f(utf8_to_ansi(path).c_str());
+#               else
+            std::ifstream f(path.c_str());
+#               endif
+            return f.good();
+#           endif
         }
 
         void rotate_current_file() {
-            if (m_file.is_open()) m_file.close();
+            if (swap_to_spare_file(m_current_date_ts, true)) return;
+            if (m_file.is_open()) {
+                finish_stream_file();
+                m_file.close();
+            }
+            const std::vector<detail::SeekFrameEntry> rotated_index = take_time_index();
 
             const std::string base = time_shield::to_iso8601_date(m_current_date_ts);
             const std::string dir  = get_directory_path();
             std::string rotated_str;
 #           if __cplusplus >= 201703L
 #               if defined(_WIN32)
-            fs::path cur = (fs::u8path(dir) / (base + ".log")).lexically_normal();
+            fs::path cur = (fs::u8path(dir) / (base + get_log_file_extension())).lexically_normal();
             fs::path rotated = fs::u8path(make_rotated_name(base, dir)).lexically_normal();
 #               else
-            fs::path cur = (fs::path(dir) / (base + ".log")).lexically_normal();
+            fs::path cur = (fs::path(dir) / (base + get_log_file_extension())).lexically_normal();
             fs::path rotated = fs::path(make_rotated_name(base, dir)).lexically_normal();
 #               endif
             std::error_code ec;
@@ -888,9 +2154,9 @@ namespace logit {
 #               endif
 #           else
 #               if defined(_WIN32)
-            const std::string cur  = dir + "\\" + base + ".log";
+            const std::string cur  = dir + "\\" + base + get_log_file_extension();
 #               else
-            const std::string cur  = dir + "/" + base + ".log";
+            const std::string cur  = dir + "/" + base + get_log_file_extension();
 #               endif
             rotated_str = make_rotated_name(base, dir);
 #               if defined(_WIN32)
@@ -902,109 +2168,137 @@ namespace logit {
             }
 #           endif
 
+            register_rotated_file(base, rotated_str);
+            write_time_index(rotated_str, rotated_index);
             open_log_file(m_current_date_ts);
             m_current_file_size = 0;
 
-            if (m_config.compress != CompressType::NONE) {
-                if (m_config.compress_async) {
-                    if (!m_compressor) {
-                        m_compressor.reset(new detail::CompressionWorker(
-                            m_config.compress, m_config.compress_level, m_config.external_cmd));
-                    }
-                    m_compressor->enqueue(rotated_str);
-                } else {
-                    detail::compress_file(m_config.compress, rotated_str, m_config.compress_level, m_config.external_cmd);
-                }
-            }
+            compress_rotated_file(rotated_str);
 
             if (m_config.max_rotated_files > 0) {
                 enforce_rotation_retention(base, m_config.max_rotated_files, dir);
             }
         }
 
+        /// \brief Compresses a rotated file according to the configured policy.
+        /// \param rotated Path of the rotated file.
+        void compress_rotated_file(const std::string& rotated) {
+            if (m_config.compress == CompressType::NONE || is_stream_compressed()) return;
+            if (m_compressor) {
+                m_compressor->enqueue(rotated);
+            } else {
+                detail::compress_file(m_config.compress, rotated, m_config.compress_level, m_config.external_cmd);
+            }
+        }
+
+        /// \brief Removes the oldest rotated files of a day beyond `max_files`.
+        /// \details Works from the in-memory list of rotated files; the directory is
+        /// only listed when the day changes.
         void enforce_rotation_retention(const std::string& base, uint32_t max_files, const std::string& dir) {
-#           if __cplusplus >= 201703L
-            std::vector<fs::path> files;
-            for (const auto& entry : fs::directory_iterator(dir)) {
-                if (!fs::is_regular_file(entry.status())) continue;
-                std::string name = entry.path().filename().string();
-                if (name.rfind(base, 0) == 0 && name != base + ".log") {
-                    files.emplace_back(entry.path());
+            std::vector<std::string> expired;
+            {
+                std::lock_guard<std::mutex> lock(m_rotation_state_mutex);
+                if (m_config.compress == CompressType::EXTERNAL_CMD) {
+                    // External commands may pick any suffix, so only a fresh listing is reliable.
+                    m_rotation_base.clear();
                 }
-            }
-            if (files.size() <= max_files) return;
-            // Extract timestamp and optional index for chronological sorting
-            auto extract = [&base](const std::string& name) {
-                int64_t ts = 0;
-                int      idx = 0;
-                std::string rest = name.substr(base.size());
-                if (!rest.empty() && (rest[0] == '_' || rest[0] == '.')) {
-                    rest = rest.substr(1);
-                    size_t dot = rest.find('.');
-                    ts = std::strtoll(rest.substr(0, dot).c_str(), nullptr, 10);
-                    if (dot != std::string::npos) {
-                        size_t dot2 = rest.find('.', dot + 1);
-                        if (dot2 != std::string::npos) {
-                            idx = std::atoi(rest.substr(dot + 1, dot2 - dot - 1).c_str());
-                        }
-                    }
+                load_rotation_state(base, dir);
+                while (m_rotated_files.size() > max_files) {
+                    expired.push_back(m_rotated_files.begin()->second);
+                    m_rotated_files.erase(m_rotated_files.begin());
                 }
-                return std::make_pair(ts, idx);
-            };
-            std::sort(files.begin(), files.end(), [&](const fs::path& a, const fs::path& b) {
-                auto pa = extract(a.filename().string());
-                auto pb = extract(b.filename().string());
-                return (pa.first == pb.first) ? (pa.second < pb.second) : (pa.first < pb.first);
-            });
-            size_t to_remove = files.size() - max_files;
-            for (size_t i = 0; i < to_remove; ++i) {
-                fs::remove(files[i]);
             }
-#           else
-            std::vector<std::string> files;
-            std::vector<std::string> file_list = get_list_files(dir);
-            for (const auto& path : file_list) {
-                std::string name = path.substr(path.find_last_of("/\\") + 1);
-                if (name.rfind(base, 0) == 0 && name != base + ".log") {
-                    files.emplace_back(path);
-                }
+            for (size_t i = 0; i < expired.size(); ++i) {
+                remove_rotated_file(expired[i]);
             }
-            if (files.size() <= max_files) return;
-            // Extract timestamp and optional index for chronological sorting
-            auto extract = [&base](const std::string& name) {
-                int64_t ts = 0;
-                int      idx = 0;
-                std::string rest = name.substr(base.size());
-                if (!rest.empty() && (rest[0] == '_' || rest[0] == '.')) {
-                    rest = rest.substr(1);
-                    size_t dot = rest.find('.');
-                    ts = std::strtoll(rest.substr(0, dot).c_str(), nullptr, 10);
-                    if (dot != std::string::npos) {
-                        size_t dot2 = rest.find('.', dot + 1);
-                        if (dot2 != std::string::npos) {
-                            idx = std::atoi(rest.substr(dot + 1, dot2 - dot - 1).c_str());
-                        }
-                    }
-                }
-                return std::make_pair(ts, idx);
-            };
-            std::sort(files.begin(), files.end(), [&](const std::string& a, const std::string& b) {
-                auto pa = extract(a.substr(a.find_last_of("/\\") + 1));
-                auto pb = extract(b.substr(b.find_last_of("/\\") + 1));
-                return (pa.first == pb.first) ? (pa.second < pb.second) : (pa.first < pb.first);
-            });
-            size_t to_remove = files.size() - max_files;
-            for (size_t i = 0; i < to_remove; ++i) {
+        }
+
+        /// \brief Records a file that was just moved to its rotated name.
+        void register_rotated_file(const std::string& base, const std::string& rotated) {
+            std::lock_guard<std::mutex> lock(m_rotation_state_mutex);
+            m_dated_files.insert(std::make_pair(get_date_ts_from_filename(base), rotated));
+            if (m_rotation_base == base) {
+                m_rotated_files.insert(RotatedFile(parse_rotated_name(base, get_file_name(rotated)), rotated));
+            }
+        }
+
+        /// \brief Removes a rotated file together with its compressed copy and time index.
+        /// \details Compression may still be running, so both names are tried.
+        void remove_rotated_file(const std::string& rotated) const {
+            remove_file_path(rotated);
+            if (!is_compressed_log_filename(rotated)) {
+                remove_file_path(rotated + ".gz");
+                remove_file_path(rotated + ".zst");
+            }
+            remove_time_index_file(rotated);
+        }
+
+        /// \brief Recovers the rotation sequence and rotated files of a day from the directory.
+        /// \details Runs once per day; later rotations update the cached state in memory.
+        /// Must be called with m_rotation_state_mutex held.
+        void load_rotation_state(const std::string& base, const std::string& dir) {
+            if (m_rotation_base == base) return;
+            m_rotation_base = base;
+            m_rotation_seq = 0;
+            m_rotated_files.clear();
+
+            const std::string active_name = base + get_log_file_extension();
+            std::vector<std::string> files;
+#           if __cplusplus >= 201703L
 #               if defined(_WIN32)
-                remove(utf8_to_ansi(files[i]).c_str());
+            const fs::path dir_path = fs::u8path(dir);
 #               else
-                remove(files[i].c_str());
+            const fs::path dir_path(dir);
+#               endif
+            std::error_code ec;
+            for (fs::directory_iterator it(dir_path, ec), last; !ec && it != last; it.increment(ec)) {
+                if (!fs::is_regular_file(it->status())) continue;
+#               if defined(_WIN32)
+                files.push_back(it->path().u8string());
+#               else
+                files.push_back(it->path().string());
 #               endif
             }
+#           else
+            files = get_list_files(dir);
 #           endif
+
+            for (size_t i = 0; i < files.size(); ++i) {
+                const std::string name = get_file_name(files[i]);
+                if (name.rfind(base, 0) != 0 || name == active_name ||
+                    ends_with(name, ".idx") || ends_with(name, ".tmp")) {
+                    continue;
+                }
+                const std::pair<int64_t, int> key = parse_rotated_name(base, name);
+                if (name[base.size()] == '.' && key.first > m_rotation_seq) {
+                    m_rotation_seq = static_cast<uint32_t>(key.first);
+                }
+                // A rotated file and its compressed copy count as one file.
+                m_rotated_files.insert(RotatedFile(key, dir + "/" + strip_compression_suffix(name)));
+            }
         }
 
-        std::string make_rotated_name(const std::string& base, const std::string& dir) const {
+        /// \brief Extracts the chronological sort key of a rotated file name.
+        /// \return Sequence number or HHMMSS[mmm] time, and the collision index.
+        static std::pair<int64_t, int> parse_rotated_name(const std::string& base, const std::string& name) {
+            int64_t ts = 0;
+            int      idx = 0;
+            std::string rest = name.substr(base.size());
+            if (!rest.empty() && (rest[0] == '_' || rest[0] == '.')) {
+                rest = rest.substr(1);
+                size_t dot = rest.find('.');
+                ts = std::strtoll(rest.substr(0, dot).c_str(), nullptr, 10);
+                if (dot != std::string::npos) {
+                    size_t dot2 = rest.find('.', dot + 1);
+                    if (dot2 != std::string::npos) {
+                        idx = std::atoi(rest.substr(dot + 1, dot2 - dot - 1).c_str());
+                    }
+                }
+            }
+            return std::make_pair(ts, idx);
+        }
+
+        std::string make_rotated_name(const std::string& base, const std::string& dir) {
             switch (m_config.naming) {
             case RotationNaming::Sequence:
                 return make_sequence_name(base, dir);
@@ -1015,35 +2309,24 @@ namespace logit {
             return make_sequence_name(base, dir);
         }
 
-        std::string make_sequence_name(const std::string& base, const std::string& dir) const {
-            uint32_t idx = 1;
-            std::string rotated;
-#           if __cplusplus >= 201703L
-            for (;; ++idx) {
+        /// \brief Builds the next `.N` rotated name from the cached sequence.
+        /// \details The existence check normally succeeds on the first try; it only
+        /// guards against files created behind the logger's back.
+        std::string make_sequence_name(const std::string& base, const std::string& dir) {
+            const std::string extension = get_log_file_extension();
+            std::lock_guard<std::mutex> lock(m_rotation_state_mutex);
+            load_rotation_state(base, dir);
+            for (;;) {
                 std::ostringstream oss;
                 oss << dir << "/" << base << '.' << std::setw(m_config.seq_width)
-                    << std::setfill('0') << idx << ".log";
-                rotated = oss.str();
-                if (!fs::exists(rotated)) break;
-            }
-#           else
-            auto file_exists = [](const std::string& path) {
-#               if defined(_WIN32)
-                std::ifstream f(utf8_to_ansi(path).c_str());
-#               else
-                std::ifstream f(path.c_str());
-#               endif
-                return f.good();
-            };
-            for (;; ++idx) {
-                std::ostringstream oss;
-                oss << dir << "/" << base << '.' << std::setw(m_config.seq_width)
-                    << std::setfill('0') << idx << ".log";
-                rotated = oss.str();
-                if (!file_exists(rotated)) break;
+                    << std::setfill('0') << ++m_rotation_seq << extension;
+                const std::string rotated = oss.str();
+                if (!file_exists(rotated) &&
+                    (is_stream_compressed() || m_config.compress == CompressType::NONE ||
+                     (!file_exists(rotated + ".gz") && !file_exists(rotated + ".zst")))) {
+                    return rotated;
+                }
             }
-#           endif
-            return rotated;
         }
 
         std::string make_timestamp_name(const std::string& base, const std::string& dir) const {
@@ -1063,12 +2346,14 @@ namespace logit {
                 std::snprintf(msbuf, sizeof(msbuf), "%03d", static_cast<int>(ts_ms % 1000));
                 timepart += msbuf;
             }
-            std::string rotated = dir + "/" + base + "_" + timepart + ".log";
+            const std::string extension = get_log_file_extension();
+            std::string rotated = dir + "/" + base + "_" + timepart + extension;
+            const std::string stem = rotated.substr(0, rotated.size() - extension.size());
 #           if __cplusplus >= 201703L
             if (!fs::exists(rotated)) return rotated;
             uint32_t idx = 1;
             for (;; ++idx) {
-                std::string candidate = rotated.substr(0, rotated.size() - 4) + "." + std::to_string(idx) + ".log";
+                std::string candidate = stem + "." + std::to_string(idx) + extension;
                 if (!fs::exists(candidate)) return candidate;
             }
 #           else
@@ -1084,16 +2369,55 @@ namespace logit {
             uint32_t idx = 1;
             for (;; ++idx) {
                 std::ostringstream oss;
-                oss << rotated.substr(0, rotated.size() - 4) << '.' << idx << ".log";
+                oss << stem << '.' << idx << extension;
                 std::string candidate = oss.str();
                 if (!file_exists(candidate)) return candidate;
             }
 #           endif
         }
 
+        /// \brief Records a log file for day-based retention.
+        void track_log_file(int64_t date_ts, const std::string& path) {
+            std::lock_guard<std::mutex> lock(m_rotation_state_mutex);
+            m_dated_files.insert(std::make_pair(date_ts, path));
+        }
+
+        /// \brief Removes the known log files older than the retention window ending at `date_ts`.
+        /// \details Runs when the active day changes. Works from m_dated_files, filled by
+        /// the startup scan and by every opened or rotated file, so it never lists the
+        /// directory. External compression commands may pick any suffix, so that mode
+        /// falls back to a directory scan.
+        void enforce_day_retention(int64_t date_ts) {
+            if (m_config.compress == CompressType::EXTERNAL_CMD) {
+                remove_old_logs(date_ts);
+                return;
+            }
+            const int64_t threshold_ts = date_ts - (time_shield::SEC_PER_DAY * m_config.auto_delete_days);
+            std::vector<std::string> expired;
+            {
+                std::lock_guard<std::mutex> lock(m_rotation_state_mutex);
+                while (!m_dated_files.empty() && m_dated_files.begin()->first < threshold_ts) {
+                    expired.push_back(m_dated_files.begin()->second);
+                    m_dated_files.erase(m_dated_files.begin());
+                }
+            }
+            for (size_t i = 0; i < expired.size(); ++i) {
+                remove_rotated_file(expired[i]);
+            }
+        }
+
         /// \brief Removes old log files based on the auto-delete days configuration.
         void remove_old_logs() {
-            const int64_t threshold_ts = m_current_date_ts - (time_shield::SEC_PER_DAY * m_config.auto_delete_days);
+            remove_old_logs(m_current_date_ts);
+        }
+
+        /// \brief Removes log files older than the retention window ending at the given date.
+        /// \details Lists the directory and rebuilds m_dated_files from the files that remain.
+        /// Used at startup and shutdown; day changes use enforce_day_retention().
+        /// \param date_ts Date timestamp of the active log file.
+        void remove_old_logs(int64_t date_ts) {
+            const int64_t threshold_ts = date_ts - (time_shield::SEC_PER_DAY * m_config.auto_delete_days);
+            std::set<std::pair<int64_t, std::string> > dated_files;
 #           if __cplusplus >= 201703L
 #           ifdef _WIN32
             fs::path dir_path = fs::u8path(get_directory_path());
@@ -1109,10 +2433,17 @@ namespace logit {
             for (const auto& entry : fs::directory_iterator(dir_path)) {
                 if (!fs::is_regular_file(entry.status())) continue;
                 std::string filename = entry.path().filename().string();
-                if (is_valid_log_filename(filename)) {
+                if (is_valid_log_filename(filename) || is_time_index_filename(filename)) {
                     const int64_t file_date_ts = get_date_ts_from_filename(filename);
                     if (file_date_ts < threshold_ts) {
                         fs::remove(entry.path());
+                    } else if (is_valid_log_filename(filename)) {
+#                       ifdef _WIN32
+                        const std::string path = entry.path().u8string();
+#                       else
+                        const std::string path = entry.path().string();
+#                       endif
+                        dated_files.insert(std::make_pair(file_date_ts, strip_compression_suffix(path)));
                     }
                 }
             }
@@ -1121,7 +2452,7 @@ namespace logit {
             for (const auto& file_path : file_list) {
                 // Extract the file name
                 std::string filename = file_path.substr(file_path.find_last_of("/\\") + 1);
-                if (is_valid_log_filename(filename)) {
+                if (is_valid_log_filename(filename) || is_time_index_filename(filename)) {
                     const int64_t file_date_ts = get_date_ts_from_filename(filename);
                     if (file_date_ts < threshold_ts) {
 #                       if defined(_WIN32)
@@ -1129,10 +2460,14 @@ namespace logit {
 #                       else
                         remove(file_path.c_str());
 #                       endif
+                    } else if (is_valid_log_filename(filename)) {
+                        dated_files.insert(std::make_pair(file_date_ts, strip_compression_suffix(file_path)));
                     }
                 }
             }
 #           endif
+            std::lock_guard<std::mutex> lock(m_rotation_state_mutex);
+            m_dated_files.swap(dated_files);
         }
 
         /// \brief Checks if the filename matches the log file naming pattern.
@@ -1148,6 +2483,12 @@ namespace logit {
                    std::regex_match(plain_name, timestamp_pattern);
         }
 
+        /// \brief Checks if the filename is the time index sidecar of a log file.
+        bool is_time_index_filename(const std::string& filename) const {
+            return ends_with(filename, ".idx") &&
+                   is_valid_log_filename(filename.substr(0, filename.size() - 4));
+        }
+
         /// \brief Extracts the date timestamp from the log filename.
         /// \param filename The filename to extract the date from.
         /// \return The date timestamp.
@@ -1170,6 +2511,7 @@ namespace logit {
         /// \brief Retrieves the last log file path.
         /// \return The last log file path.
         std::string get_last_log_file_path() const {
+            wait_for_swap();
             std::lock_guard<std::mutex> lock(m_file_path_mutex);
             return m_file_path;
         }
@@ -1177,10 +2519,16 @@ namespace logit {
         /// \brief Retrieves the last log file name.
         /// \return The last log file name.
         std::string get_last_log_file_name() const {
+            wait_for_swap();
             std::lock_guard<std::mutex> lock(m_file_path_mutex);
             return m_file_name;
         }
 
+        /// \brief Gets the number of rotated files queued for or undergoing background compression.
+        std::size_t get_compression_backlog() const {
+            return m_compressor ? m_compressor->backlog() : 0;
+        }
+
         /// \brief Retrieves the timestamp of the last log.
         /// \return The last log timestamp.
         int64_t get_last_log_ts() const {
@@ -6,8 +6,10 @@
 /// \brief Optional read-only interface for log backends that support querying stored records.
 
 #include "../enums.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <string>
 #include <vector>
 #if __cplusplus >= 201703L
@@ -40,6 +42,56 @@ namespace logit {
         Descending   ///< Newest first.
     };
 
+    /// \enum LogMatchMode
+    /// \brief How LogQuery compares source file and function names.
+    enum class LogMatchMode {
+        Exact,  ///< The whole value must be equal.
+        Prefix  ///< The value must start with the pattern.
+    };
+
+    /// \struct LogQuery
+    /// \brief Filter for ILogReader::query().
+    /// \details Empty string filters match everything. `limit` counts matches
+    /// in the requested order, so a descending query with a limit returns the
+    /// newest matches.
+    struct LogQuery {
+        int64_t      from_ms = (std::numeric_limits<int64_t>::min)(); ///< Inclusive start timestamp.
+        int64_t      to_ms   = (std::numeric_limits<int64_t>::max)(); ///< Exclusive end timestamp.
+        LogLevel     min_level = LogLevel::LOG_LVL_TRACE; ///< Minimum severity.
+        std::string  file;                                ///< Source file filter.
+        LogMatchMode file_match = LogMatchMode::Exact;    ///< Comparison used for `file`.
+        std::string  function;                            ///< Function name filter.
+        LogMatchMode function_match = LogMatchMode::Exact; ///< Comparison used for `function`.
+        std::string  message_contains;                    ///< Required message substring.
+        std::size_t  limit = 0;                           ///< Maximum number of matches (0 = unlimited).
+        LogReadOrder order = LogReadOrder::Ascending;     ///< Result order.
+
+        /// \brief Checks the non-time filters against a record.
+        /// \tparam Entry Any type with `level`, `file`, `function` and `message` fields.
+        template <class Entry>
+        bool matches_fields(const Entry& entry) const {
+            return static_cast<int>(entry.level) >= static_cast<int>(min_level) &&
+                   matches_text(entry.file, file, file_match) &&
+                   matches_text(entry.function, function, function_match) &&
+                   (message_contains.empty() || entry.message.find(message_contains) != std::string::npos);
+        }
+
+        /// \brief Checks all filters against a record.
+        template <class Entry>
+        bool matches(const Entry& entry) const {
+            return entry.timestamp_ms >= from_ms && entry.timestamp_ms < to_ms && matches_fields(entry);
+        }
+
+        /// \brief Compares a value with a pattern using the given mode.
+        static bool matches_text(const std::string& value, const std::string& pattern, LogMatchMode mode) {
+            if (pattern.empty()) return true;
+            if (mode == LogMatchMode::Prefix) {
+                return value.compare(0, pattern.size(), pattern) == 0;
+            }
+            return value == pattern;
+        }
+    };
+
 #if __cplusplus >= 201703L
     /// \enum LogReadError
     /// \brief Result status for log read APIs that preserve failure details.
@@ -115,6 +167,33 @@ namespace logit {
             return result;
         }
 #endif
+
+        /// \brief Reads records matching a query.
+        /// \details The default implementation filters `read_range()`; backends
+        /// with indexes override it.
+        /// \param log_query Filter, limit and order.
+        /// \return Matching records in the requested order.
+        virtual std::vector<LogRecordSnapshot> query(const LogQuery& log_query) const {
+            std::vector<LogRecordSnapshot> out;
+            if (log_query.to_ms <= log_query.from_ms) return out;
+            std::vector<LogRecordSnapshot> records = read_range(log_query.from_ms, log_query.to_ms, 0);
+            if (log_query.order == LogReadOrder::Descending) {
+                std::reverse(records.begin(), records.end());
+            }
+            for (size_t i = 0; i < records.size(); ++i) {
+                if (!log_query.matches_fields(records[i])) continue;
+                out.push_back(records[i]);
+                if (log_query.limit > 0 && out.size() >= log_query.limit) break;
+            }
+            return out;
+        }
+
+        /// \brief Counts records matching a query.
+        /// \param log_query Filter; `limit` caps the count and `order` is ignored.
+        /// \return Number of matching records.
+        virtual std::size_t count(const LogQuery& log_query) const {
+            return query(log_query).size();
+        }
     };
 
 } // namespace logit
@@ -6,11 +6,20 @@
 /// \brief Optional live-subscription interface for log backends that can push newly written records.
 
 #include "ILogReader.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <utility>
 
 namespace logit {
 
+    /// \struct LogCallbackOptions
+    /// \brief Delivery options for a log callback.
+    struct LogCallbackOptions {
+        bool        async = false;         ///< Deliver on the backend's dispatcher thread instead of the writer thread.
+        std::size_t queue_capacity = 1024; ///< Maximum snapshots queued for an async callback; overflow drops the newest.
+    };
+
     /// \class ILogSubscriber
     /// \brief Optional interface for backends that can notify callers when a record is successfully written.
     ///
@@ -29,6 +38,26 @@ namespace logit {
         /// \return Stable callback id that can be passed to remove_log_callback.
         virtual uint64_t add_log_callback(Callback callback) = 0;
 
+        /// \brief Registers a callback with delivery options.
+        /// \details Asynchronous callbacks run on a dispatcher thread with a bounded
+        /// queue per callback, so a slow subscriber cannot stall logging. Backends
+        /// without a dispatcher ignore the options and deliver synchronously.
+        /// \param callback Function called with the written LogRecordSnapshot.
+        /// \param options Delivery options.
+        /// \return Stable callback id that can be passed to remove_log_callback.
+        virtual uint64_t add_log_callback(Callback callback, const LogCallbackOptions& options) {
+            (void)options;
+            return add_log_callback(std::move(callback));
+        }
+
+        /// \brief Number of snapshots dropped because an async callback's queue was full.
+        /// \param callback_id Id returned by add_log_callback.
+        /// \return Drop count, or 0 for unknown or synchronous callbacks.
+        virtual uint64_t get_log_callback_dropped(uint64_t callback_id) const {
+            (void)callback_id;
+            return 0;
+        }
+
         /// \brief Unregisters a previously added callback.
         ///
         /// Removal prevents future dispatch snapshots from including the callback, but cannot
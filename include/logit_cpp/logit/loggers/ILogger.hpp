@@ -9,6 +9,8 @@
 /// \{
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -134,6 +136,89 @@ namespace logit {
             return results;
         }
 
+        /// \brief Reads a chunk of a persisted log file into a caller-provided buffer.
+        /// \details Call repeatedly with `next_offset` to stream a file without loading
+        /// it into memory. Offsets refer to the uncompressed content.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Offset of the first byte to read.
+        /// \param buffer Destination buffer.
+        /// \param capacity Size of `buffer` in bytes.
+        /// \return Chunk result. `ok` is false when unsupported or unavailable.
+        virtual LogFileChunkResult read_log_file_chunk(
+                const std::string& path,
+                uint64_t offset,
+                char* buffer,
+                std::size_t capacity) const {
+            (void)buffer;
+            (void)capacity;
+            LogFileChunkResult result;
+            result.file.path = path;
+            result.offset = offset;
+            result.next_offset = offset;
+            result.ok = false;
+            return result;
+        }
+
+        /// \brief Reads a byte range of a persisted log file.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Offset in the uncompressed content.
+        /// \param length Maximum number of bytes to read.
+        /// \return Read result. `ok` is false when unsupported or unavailable.
+        virtual LogFileReadResult read_log_file_range(
+                const std::string& path,
+                uint64_t offset,
+                uint64_t length) const {
+            (void)offset;
+            (void)length;
+            LogFileReadResult result;
+            result.file.path = path;
+            result.ok = false;
+            return result;
+        }
+
+        /// \brief Iterates over the lines of a persisted log file from the last one backwards.
+        /// \details Useful for "last N lines" views: return false from the callback
+        /// to stop once enough lines were collected.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param callback Receives each line without its line terminator.
+        /// \return True when the file was read, false when unsupported or unavailable.
+        virtual bool for_each_log_file_line_reverse(
+                const std::string& path,
+                const std::function<bool(const std::string&)>& callback) const {
+            (void)path;
+            (void)callback;
+            return false;
+        }
+
+        /// \brief Waits until a persisted log file has readable content beyond `offset`.
+        /// \details Intended for follow/tail readers. A file that became smaller than
+        /// `offset`, e.g. after rotation or cleanup, also ends the wait.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Content size the caller has already consumed.
+        /// \param timeout_ms Maximum time to wait in milliseconds.
+        /// \return True when the readable size differs from `offset`, false on timeout or when unsupported.
+        virtual bool wait_log_file_data(
+                const std::string& path,
+                uint64_t offset,
+                int64_t timeout_ms) const {
+            (void)path;
+            (void)offset;
+            (void)timeout_ms;
+            return false;
+        }
+
+        /// \brief Reads the persisted log content written in a time range.
+        /// \details Backends may return whole blocks around the range boundaries,
+        /// so results can include records just outside `[from_ms, to_ms]`.
+        /// \param from_ms Start of the range in milliseconds (inclusive).
+        /// \param to_ms End of the range in milliseconds (inclusive).
+        /// \return Per-file slices ordered from the oldest file, or an empty vector if unsupported.
+        virtual std::vector<LogFileReadResult> read_log_range(int64_t from_ms, int64_t to_ms) const {
+            (void)from_ms;
+            (void)to_ms;
+            return std::vector<LogFileReadResult>();
+        }
+
         /// \brief Clears logger-owned buffered or persisted records when supported.
         /// \param options Data categories to clear.
         /// \return Cleanup result. Default reports unsupported.
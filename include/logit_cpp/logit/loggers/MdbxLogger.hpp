@@ -7,7 +7,11 @@
 
 #include <mdbx_containers/KeyValueTable.hpp>
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstring>
+#include <deque>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <memory>
@@ -23,7 +27,8 @@ namespace logit {
     enum class MdbxPayloadCompression {
         None = 0, ///< Store payload bytes as-is.
         Gzip = 1, ///< Store gzip-compressed payload bytes.
-        Zstd = 2  ///< Store zstd-compressed payload bytes.
+        Zstd = 2, ///< Store zstd-compressed payload bytes.
+        ZstdDictionary = 3 ///< Store zstd payload bytes compressed against a trained dictionary.
     };
 
     namespace detail {
@@ -45,6 +50,19 @@ namespace logit {
     /// \brief Stores formatted logs in MDBX tables with optional async batching.
     class MdbxLogger final : public ILogger, public ILogReader, public ILogSubscriber {
     public:
+        /// \struct RetentionPolicy
+        /// \brief Limits enforced by deleting the oldest records in bounded transactions.
+        /// \details All limits are off by default. A record is deleted when any
+        /// enabled limit is exceeded; its payload and index entries go with it.
+        struct RetentionPolicy {
+            int64_t max_age_ms = 0;       ///< Delete records older than this; 0 = no age limit.
+            std::size_t max_records = 0;  ///< Keep at most this many records; 0 = unlimited.
+            uint64_t max_db_bytes = 0;    ///< Delete records while the tables use more pages than this; 0 = unlimited.
+            std::size_t max_sessions = 0; ///< Keep the newest N sessions; older ones lose their records from the oldest end, then their metadata. 0 = unlimited.
+            std::size_t batch_size = 512; ///< Records deleted per write transaction.
+            int interval_ms = 1000;       ///< Pause between passes once the limits are met.
+        };
+
         /// \struct Config
         /// \brief Configuration for the MDBX logger backend.
         struct Config {
@@ -53,14 +71,31 @@ namespace logit {
             uint64_t session_id = 0;        ///< Existing session id, or 0 to auto-create.
             bool async = true;              ///< Queue records and write them from a worker thread.
             bool drop_on_overflow = true;   ///< Drop newest record when the async queue is full.
-            std::size_t max_queue_size = 8192; ///< Maximum async queue size; 0 means unlimited.
+            std::size_t max_queue_size = 8192; ///< Capacity of the lock-free async queue, allocated up front; 0 = unlimited (a 16384-slot ring, then a locked overflow queue).
             std::size_t max_batch_size = 256;  ///< Maximum records per write transaction.
+            bool adaptive_batching = true;     ///< Size write transactions from observed commit cost and latency; false always allows max_batch_size.
+            int target_write_latency_ms = 100; ///< p99 log()-to-commit latency the adaptive batching aims for.
             int flush_interval_ms = 100;       ///< Worker wake interval.
             std::size_t large_payload_threshold = 4096; ///< Spill messages larger than this.
             std::size_t payload_preview_size = 512;     ///< Bytes kept inline when a message spills.
             bool store_large_payloads_separately = true;///< Store large messages in `log_payloads`.
             MdbxPayloadCompression payload_compression = MdbxPayloadCompression::None; ///< Payload compression.
             int payload_compression_level = 6; ///< Compression level for gzip/zstd.
+            std::size_t zstd_dictionary_size = 32 * 1024;          ///< Capacity of trained dictionaries for ZstdDictionary compression.
+            std::size_t zstd_dictionary_sample_bytes = 1024 * 1024; ///< Payload bytes sampled before a dictionary is trained.
+            std::size_t zstd_dictionary_retrain_payloads = 0;       ///< Train a new dictionary after this many payloads; 0 trains only while none is stored.
+            bool index_by_level = false;   ///< Maintain `log_index_level` for queries with `min_level`.
+            bool index_by_file = false;    ///< Maintain `log_index_file` for exact source-file queries.
+            bool index_by_session = false; ///< Maintain `log_index_session` for query_session().
+            bool rollup_by_level = false;  ///< Maintain `log_rollup_level` counts per bucket and level for read_histogram().
+            bool rollup_by_file = false;   ///< Maintain `log_rollup_file` counts per file, bucket and level for read_histogram().
+            int64_t rollup_bucket_ms = 60 * 1000; ///< Rollup bucket size; changing it rebuilds the rollups.
+            bool index_by_text = false;    ///< Maintain a trigram index of message text in the background for search_text().
+            std::size_t text_index_batch_size = 1024; ///< Records added to the trigram index per background step.
+            RetentionPolicy retention;          ///< Age, count, size and session limits enforced by the worker.
+            int64_t db_growth_step = 16 * 1024 * 1024; ///< Database file growth step in bytes; -1 = MDBX default.
+            int64_t db_shrink_threshold = -1;          ///< Free tail that triggers a file shrink; 0 = never shrink, -1 = MDBX default.
+            uint32_t record_schema_version = 2; ///< Row format of new records: 2 = compact rows with dictionary ids, 1 = full strings readable by older releases.
             std::function<void(const std::string&)> on_error; ///< Optional callback invoked on initialization and write errors instead of stderr.
         };
 
@@ -74,23 +109,63 @@ namespace logit {
             uint32_t schema_version = 1;///< Storage schema version.
         };
 
+        /// \struct QueryPage
+        /// \brief One page of a paginated query.
+        struct QueryPage {
+            std::vector<LogRecordSnapshot> records; ///< Matches in query order; spilled messages hold only their preview.
+            std::string next_token; ///< Continuation for the next read_page() call; empty once the query is exhausted.
+        };
+
+        /// \struct WriteStats
+        /// \brief Write transaction counters of the async worker.
+        struct WriteStats {
+            uint64_t transactions = 0;            ///< Write transactions since the logger opened.
+            uint64_t records = 0;                 ///< Records written by them.
+            double transactions_per_second = 0.0; ///< Commit rate over the last measurement window.
+            double average_batch_size = 0.0;      ///< Records per transaction over the last measurement window.
+            std::size_t batch_limit = 0;          ///< Current adaptive limit of records per transaction.
+            int64_t linger_us = 0;                ///< Current wait for more records before a small batch commits.
+            int64_t p99_write_latency_us = 0;     ///< log()-to-commit latency of recent batches.
+        };
+
+        /// \struct HistogramBucket
+        /// \brief Record counts of one time bucket.
+        struct HistogramBucket {
+            int64_t start_ms = 0; ///< Bucket start, a multiple of the bucket size.
+            std::array<uint64_t, static_cast<std::size_t>(LogLevel::LOG_LVL_FATAL) + 1> counts{}; ///< Records per level, indexed by `LogLevel`.
+            uint64_t bytes = 0; ///< Stored message bytes: inline text plus payload rows.
+        };
+
         /// \struct PayloadView
         /// \brief Public read-only view of a large payload.
         struct PayloadView {
             uint64_t payload_id = 0; ///< Stable payload id.
             MdbxPayloadCompression compression = MdbxPayloadCompression::None; ///< Stored compression.
+            uint32_t dictionary_id = 0; ///< `log_zstd_dicts` id for ZstdDictionary payloads.
             std::string data;       ///< Stored payload bytes.
         };
 
         MdbxLogger() : MdbxLogger(Config()) {}
 
         explicit MdbxLogger(const Config& config)
-            : m_config(config) {
+            : m_config(config),
+              m_ring(!config.async ? 2 : (config.max_queue_size > 0 ? config.max_queue_size : UNBOUNDED_QUEUE_CAPACITY)) {
+            m_subscribers.set_error_handler([this](const std::string& message) {
+                if (m_config.on_error) {
+                    m_config.on_error("MdbxLogger " + message);
+                }
+            });
             try {
                 normalize_config();
                 validate_compression_config();
+                validate_record_schema_version();
                 open_storage();
                 m_session_id = open_session();
+                m_batch_limit = m_config.adaptive_batching
+                    ? (std::min)(INITIAL_BATCH_LIMIT, m_config.max_batch_size)
+                    : m_config.max_batch_size;
+                m_stats.batch_limit = m_batch_limit;
+                m_stats_window_start_us = monotonic_us();
                 if (m_config.async) {
                     m_worker = std::thread(&MdbxLogger::worker_loop, this);
                 }
@@ -105,6 +180,7 @@ namespace logit {
 
         ~MdbxLogger() override {
             shutdown();
+            join_dictionary_trainer();
         }
 
         MdbxLogger(const MdbxLogger&) = delete;
@@ -121,61 +197,65 @@ namespace logit {
             item.message = message;
 
             if (!m_config.async) {
-                {
-                    std::lock_guard<std::mutex> lock(m_mutex);
-                    if (m_stopping) {
-                        ++m_dropped;
-                        return;
-                    }
+                if (m_is_stopping.load(std::memory_order_acquire)) {
+                    ++m_dropped;
+                    return;
                 }
                 mark_last_log(record.timestamp_ms);
                 std::vector<MdbxLogItem> batch;
                 batch.push_back(std::move(item));
                 write_batch(batch);
+                maybe_enforce_retention();
+                maybe_update_text_index(false);
                 return;
             }
 
-            std::unique_lock<std::mutex> lock(m_mutex);
-            if (m_stopping) {
+            // The worker exits only after every registered producer has left.
+            m_active_producers.fetch_add(1, std::memory_order_seq_cst);
+            if (m_is_stopping.load(std::memory_order_seq_cst)) {
+                m_active_producers.fetch_sub(1, std::memory_order_seq_cst);
                 ++m_dropped;
                 return;
             }
 
             mark_last_log(record.timestamp_ms);
-
-            if (m_config.max_queue_size > 0 && m_queue.size() >= m_config.max_queue_size) {
-                if (m_config.drop_on_overflow) {
-                    ++m_dropped;
-                    return;
-                }
-
-                m_space_cv.wait(lock, [this]() {
-                    return m_stopping ||
-                           m_config.max_queue_size == 0 ||
-                           m_queue.size() < m_config.max_queue_size;
-                });
-
-                if (m_stopping) {
-                    ++m_dropped;
-                    return;
-                }
+            item.enqueued_us = monotonic_us();
+            // Counted before the push so wait() never sees the worker ahead of the producers.
+            m_enqueued.fetch_add(1, std::memory_order_acq_rel);
+            if (m_config.max_queue_size == 0) {
+                push_unbounded(item);
+            } else if (!push_bounded(item)) {
+                m_completed.fetch_add(1, std::memory_order_acq_rel);
+                m_active_producers.fetch_sub(1, std::memory_order_seq_cst);
+                ++m_dropped;
+                return;
             }
+            m_active_producers.fetch_sub(1, std::memory_order_seq_cst);
 
-            m_queue.push_back(std::move(item));
-            lock.unlock();
-            m_cv.notify_one();
+            // Producers take the mutex only to wake a sleeping worker.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_is_worker_sleeping.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_cv.notify_one();
+            }
         }
 
         /// \brief Waits until accepted async records are written.
         void wait() override {
             if (!m_config.async) {
+                m_subscribers.flush();
                 return;
             }
 
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_cv.wait(lock, [this]() {
-                return m_queue.empty() && m_idle;
-            });
+            const uint64_t accepted = m_enqueued.load(std::memory_order_acquire);
+            {
+                // Dropped items complete without a notification, hence the timed wait.
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while (m_completed.load(std::memory_order_acquire) < accepted && !m_is_worker_done) {
+                    m_written_cv.wait_for(lock, std::chrono::milliseconds(m_config.flush_interval_ms));
+                }
+            }
+            m_subscribers.flush();
         }
 
         /// \brief Stops the worker after draining accepted records.
@@ -187,7 +267,7 @@ namespace logit {
 
             {
                 std::lock_guard<std::mutex> lock(m_mutex);
-                m_stopping = true;
+                m_is_stopping.store(true, std::memory_order_seq_cst);
             }
             m_cv.notify_all();
             m_space_cv.notify_all();
@@ -195,6 +275,7 @@ namespace logit {
             if (m_worker.joinable()) {
                 m_worker.join();
             }
+            join_dictionary_trainer();
 
             try {
                 update_session_end();
@@ -235,11 +316,16 @@ namespace logit {
                     (std::numeric_limits<uint32_t>::max)());
 
                 std::lock_guard<std::mutex> db_lock(m_db_mutex);
-                m_records->for_each_range(from_key, to_key,
-                    [&result, limit](const std::string&, const Record& record) -> bool {
-                        result.value->push_back(to_log_record_snapshot(record));
-                        return limit == 0 || result.value->size() < limit;
-                    });
+                run_with_dictionary_locked([&]() {
+                    result.value->clear();
+                    m_records->for_each_range(from_key, to_key,
+                        [this, &result, limit](const std::string& key, const Record& stored) -> bool {
+                            Record record = stored;
+                            complete_record_locked(key, record);
+                            result.value->push_back(to_log_record_snapshot(std::move(record)));
+                            return limit == 0 || result.value->size() < limit;
+                        });
+                });
             } catch (const detail::MdbxReadException& e) {
                 result.value.reset();
                 result.error = e.error();
@@ -281,17 +367,405 @@ namespace logit {
                 LogReadOrder order = LogReadOrder::Ascending) const override {
             const int64_t now_ms = LOGIT_CURRENT_TIMESTAMP_MS();
             const int64_t from_ms = (period_ms > 0) ? (now_ms - period_ms) : 0;
-            auto result = read_range_result(from_ms, now_ms + 1, 0);
-            if (!result.value) {
+            if (limit == 0) {
+                auto result = read_range_result(from_ms, now_ms + 1, 0);
+                if (result.value && order == LogReadOrder::Descending) {
+                    std::reverse(result.value->begin(), result.value->end());
+                }
+                return result;
+            }
+
+            // The newest `limit` records form one descending page; older records are not read.
+            LogQuery log_query;
+            log_query.from_ms = from_ms;
+            log_query.to_ms = now_ms + 1;
+            log_query.order = LogReadOrder::Descending;
+            auto page = read_page(log_query, limit);
+            LogReadResult<std::vector<LogRecordSnapshot>> result;
+            result.error = page.error;
+            result.message = page.message;
+            if (page.value) {
+                result.value = std::move(page.value->records);
+                if (order == LogReadOrder::Ascending) {
+                    std::reverse(result.value->begin(), result.value->end());
+                }
+            }
+            return result;
+        }
+
+        /// \brief Reads records matching a query.
+        /// \details Uses the session, file or level index when one is enabled
+        /// and applies to the filters; otherwise scans the time window.
+        std::vector<LogRecordSnapshot> query(const LogQuery& log_query) const override {
+            auto result = query_result(log_query);
+            return result.value ? *result.value : std::vector<LogRecordSnapshot>();
+        }
+
+        /// \brief Reads records matching a query and preserves storage/decode errors.
+        LogReadResult<std::vector<LogRecordSnapshot>> query_result(const LogQuery& log_query) const {
+            return run_query(log_query, 0);
+        }
+
+        /// \brief Reads records of one session that match a query.
+        /// \param session_id Session to read; 0 returns no records.
+        /// \param log_query  Additional filters, limit and order.
+        std::vector<LogRecordSnapshot> query_session(
+                uint64_t session_id,
+                const LogQuery& log_query = LogQuery()) const {
+            auto result = query_session_result(session_id, log_query);
+            return result.value ? *result.value : std::vector<LogRecordSnapshot>();
+        }
+
+        /// \brief Reads records of one session and preserves storage/decode errors.
+        LogReadResult<std::vector<LogRecordSnapshot>> query_session_result(
+                uint64_t session_id,
+                const LogQuery& log_query = LogQuery()) const {
+            if (session_id == 0) {
+                LogReadResult<std::vector<LogRecordSnapshot>> result;
+                result.value.emplace();
+                return result;
+            }
+            return run_query(log_query, session_id);
+        }
+
+        /// \brief Reads one page of records matching a query.
+        /// \details Each call runs one bounded range scan and holds no
+        /// transaction afterwards, so paging through a large range costs
+        /// O(page) per call rather than O(range). Time bounds become key bounds,
+        /// and level, session and source names are checked on the row header
+        /// before the message is decoded. Payloads are not read; fetch them
+        /// with read_payload_data() when needed. `log_query.limit` is ignored.
+        /// \param log_query  Filters and order; pass the same query for every page.
+        /// \param page_size  Maximum records per page; 0 returns an empty page.
+        /// \param token      `next_token` of the previous page, or empty for the first page.
+        /// \param session_id Session to read, or 0 for all sessions.
+        LogReadResult<QueryPage> read_page(
+                const LogQuery& log_query,
+                std::size_t page_size,
+                const std::string& token = std::string(),
+                uint64_t session_id = 0) const {
+            LogReadResult<QueryPage> result;
+            result.value.emplace();
+            if (log_query.to_ms <= log_query.from_ms || page_size == 0) {
+                return result;
+            }
+
+            std::string start_key;
+            if (!token.empty() && !decode_page_token(token, log_query.order, start_key)) {
+                result.value.reset();
+                result.error = LogReadError::DecodeError;
+                result.message = "MdbxLogger: invalid page token";
+                return result;
+            }
+
+            try {
+                std::lock_guard<std::mutex> db_lock(m_db_mutex);
+                QueryPage& page = *result.value;
+                run_with_dictionary_locked([&]() {
+                    page.records.clear();
+                    page.next_token.clear();
+                    if (log_query.order == LogReadOrder::Ascending) {
+                        read_ascending_page_locked(log_query, session_id, page_size, start_key, page);
+                    } else {
+                        read_descending_page_locked(log_query, session_id, page_size, start_key, page);
+                    }
+                });
+            } catch (const detail::MdbxReadException& e) {
+                result.value.reset();
+                result.error = e.error();
+                result.message = e.what();
+            } catch (const mdbxc::MdbxException& e) {
+                result.value.reset();
+                result.error = LogReadError::StorageError;
+                result.message = e.what();
+            } catch (const std::exception& e) {
+                result.value.reset();
+                result.error = LogReadError::DecodeError;
+                result.message = e.what();
+            } catch (...) {
+                result.value.reset();
+                result.error = LogReadError::DecodeError;
+                result.message = "MdbxLogger: unknown page read error";
+            }
+            return result;
+        }
+
+        /// \brief Visits records matching a query page by page.
+        /// \details At most one page of records is held in memory. The visitor
+        /// runs outside the storage lock, so it may log to this backend.
+        /// Views stay valid only for the duration of the visitor call. A read
+        /// error ends the visit.
+        /// \param log_query Filter, limit and order.
+        /// \param visitor Receives each match; return false to stop.
+        void for_each_query(
+                const LogQuery& log_query,
+                const std::function<bool(const LogEntryView&)>& visitor) const {
+            std::string token;
+            std::size_t visited = 0;
+            do {
+                auto page = read_page(log_query, VISIT_PAGE_SIZE, token);
+                if (!page.value) {
+                    return;
+                }
+                const std::vector<LogRecordSnapshot>& records = page.value->records;
+                for (size_t i = 0; i < records.size(); ++i) {
+                    const LogRecordSnapshot& r = records[i];
+                    if (!visitor(LogEntryView(r.level, r.timestamp_ms, r.file, r.line, r.function, r.message))) {
+                        return;
+                    }
+                    if (log_query.limit > 0 && ++visited >= log_query.limit) {
+                        return;
+                    }
+                }
+                token = std::move(page.value->next_token);
+            } while (!token.empty());
+        }
+
+        /// \brief Counts records matching a query.
+        /// \details When an index covers every filter, only index keys are
+        /// counted and no record is decoded.
+        /// \return Number of matches capped by `limit`, or 0 on read errors.
+        std::size_t count(const LogQuery& log_query) const override {
+            if (log_query.to_ms <= log_query.from_ms) {
+                return 0;
+            }
+            try {
+                std::lock_guard<std::mutex> db_lock(m_db_mutex);
+                std::size_t matches = 0;
+                run_with_dictionary_locked([&]() {
+                    matches = 0;
+                    std::vector<std::string> keys;
+                    const IndexPlan plan = plan_query_locked(log_query, 0, keys);
+                    if (is_plan_covering(plan, log_query, 0)) {
+                        matches = log_query.limit > 0 ? (std::min)(keys.size(), log_query.limit) : keys.size();
+                        return;
+                    }
+                    visit_matches_locked(log_query, 0, plan, keys, [&matches, &log_query](Record&) -> bool {
+                        ++matches;
+                        return log_query.limit == 0 || matches < log_query.limit;
+                    });
+                });
+                return matches;
+            } catch (...) {
+                return 0;
+            }
+        }
+
+        /// \brief Counts records per time bucket and level.
+        /// \details Served from `log_rollup_file` when `file` is given and
+        /// from `log_rollup_level` otherwise, without reading any record, when
+        /// that rollup is enabled; otherwise the time window is scanned.
+        /// Buckets are aligned to the epoch, `bucket_ms` is rounded up to a
+        /// multiple of `rollup_bucket_ms`, and the first and last buckets are
+        /// counted whole even where they extend past `[from_ms, to_ms)`, so
+        /// both paths return the same counts. Empty buckets are omitted.
+        /// \param bucket_ms Bucket size; 0 uses `rollup_bucket_ms`.
+        /// \param file      Exact source file to count, or empty for all files.
+        /// \return Non-empty buckets in ascending order.
+        LogReadResult<std::vector<HistogramBucket>> read_histogram(
+                int64_t from_ms,
+                int64_t to_ms,
+                int64_t bucket_ms = 0,
+                const std::string& file = std::string()) const {
+            LogReadResult<std::vector<HistogramBucket>> result;
+            result.value.emplace();
+            if (to_ms <= from_ms) {
                 return result;
             }
-            if (limit > 0 && result.value->size() > limit) {
-                result.value->erase(
-                    result.value->begin(),
-                    result.value->begin() + static_cast<std::ptrdiff_t>(result.value->size() - limit));
+
+            const int64_t max_ms = (std::numeric_limits<int64_t>::max)();
+            const int64_t base_ms = m_config.rollup_bucket_ms;
+            int64_t step_ms = base_ms;
+            if (bucket_ms > base_ms) {
+                const int64_t multiple = bucket_ms / base_ms + (bucket_ms % base_ms != 0 ? 1 : 0);
+                step_ms = (multiple > max_ms / base_ms ? max_ms / base_ms : multiple) * base_ms;
+            }
+            // Stored buckets from the first to the last one inside the outer histogram buckets.
+            const int64_t first_ms = detail::mdbx_bucket_start(from_ms, step_ms);
+            const int64_t last_step_ms = detail::mdbx_bucket_start(to_ms - 1, step_ms);
+            const int64_t last_ms = last_step_ms > max_ms - (step_ms - base_ms)
+                ? detail::mdbx_bucket_start(max_ms, base_ms)
+                : last_step_ms + (step_ms - base_ms);
+
+            try {
+                std::lock_guard<std::mutex> db_lock(m_db_mutex);
+                std::map<int64_t, HistogramBucket> buckets;
+                const auto add = [&buckets, step_ms](int64_t timestamp_ms, uint8_t level, uint64_t count, uint64_t bytes) {
+                    const int64_t start_ms = detail::mdbx_bucket_start(timestamp_ms, step_ms);
+                    HistogramBucket& bucket = buckets[start_ms];
+                    bucket.start_ms = start_ms;
+                    if (level < bucket.counts.size()) {
+                        bucket.counts[level] += count;
+                    }
+                    bucket.bytes += bytes;
+                };
+                const auto add_rollup = [&add](const std::string& key, const std::string& value) -> bool {
+                    int64_t bucket_start_ms = 0;
+                    uint8_t level = 0;
+                    uint64_t count = 0;
+                    uint64_t bytes = 0;
+                    if (detail::parse_mdbx_rollup_key(key, bucket_start_ms, level) &&
+                        decode_rollup_value(value, count, bytes)) {
+                        add(bucket_start_ms, level, count, bytes);
+                    }
+                    return true;
+                };
+
+                if (file.empty() && m_level_rollup) {
+                    m_level_rollup->for_each_range(
+                        detail::make_mdbx_rollup_key(first_ms, 0),
+                        detail::make_mdbx_rollup_key(last_ms, 0xFFu),
+                        add_rollup);
+                } else if (!file.empty() && m_file_rollup) {
+                    const uint64_t file_hash = detail::mdbx_file_index_hash(file);
+                    m_file_rollup->for_each_range(
+                        detail::make_mdbx_file_rollup_key(file_hash, first_ms, 0),
+                        detail::make_mdbx_file_rollup_key(file_hash, last_ms, 0xFFu),
+                        add_rollup);
+                } else {
+                    LogQuery log_query;
+                    log_query.file = file;
+                    log_query.file_match = LogMatchMode::Exact;
+                    const int64_t end_ms = last_ms > max_ms - (base_ms - 1) ? max_ms : last_ms + (base_ms - 1);
+                    // Payload sizes are read after the scan; no lookup runs inside the cursor.
+                    std::vector<std::pair<int64_t, uint64_t>> payloads;
+                    run_with_dictionary_locked([&]() {
+                        buckets.clear();
+                        payloads.clear();
+                        scan_rows_locked(log_query, 0,
+                            detail::make_mdbx_record_key(first_ms, 0),
+                            detail::make_mdbx_record_key(end_ms, (std::numeric_limits<uint32_t>::max)()),
+                            [&add, &payloads](const std::string&, Record& record) -> bool {
+                                add(record.timestamp_ms, static_cast<uint8_t>(record.level), 1, record.message.size());
+                                if (record.payload_id != 0) {
+                                    payloads.emplace_back(record.timestamp_ms, record.payload_id);
+                                }
+                                return true;
+                            });
+                    });
+                    for (size_t i = 0; i < payloads.size(); ++i) {
+#if __cplusplus >= 201703L
+                        auto payload = m_payloads->find(payloads[i].second);
+                        if (payload) add(payloads[i].first, 0xFFu, 0, payload->data.size());
+#else
+                        std::pair<bool, Payload> payload = m_payloads->find(payloads[i].second);
+                        if (payload.first) add(payloads[i].first, 0xFFu, 0, payload.second.data.size());
+#endif
+                    }
+                }
+
+                result.value->reserve(buckets.size());
+                for (std::map<int64_t, HistogramBucket>::const_iterator it = buckets.begin(); it != buckets.end(); ++it) {
+                    result.value->push_back(it->second);
+                }
+            } catch (const detail::MdbxReadException& e) {
+                result.value.reset();
+                result.error = e.error();
+                result.message = e.what();
+            } catch (const mdbxc::MdbxException& e) {
+                result.value.reset();
+                result.error = LogReadError::StorageError;
+                result.message = e.what();
+            } catch (const std::exception& e) {
+                result.value.reset();
+                result.error = LogReadError::DecodeError;
+                result.message = e.what();
+            } catch (...) {
+                result.value.reset();
+                result.error = LogReadError::DecodeError;
+                result.message = "MdbxLogger: unknown histogram read error";
+            }
+            return result;
+        }
+
+        /// \brief Reads records whose message contains `text`, spilled payloads included.
+        /// \details With `index_by_text` the candidates are the records found in
+        /// the posting lists of every trigram of `text`, plus the records the
+        /// background indexer has not reached yet. Each candidate is verified
+        /// against its stored text, so results do not depend on indexing lag.
+        /// Posting rows of batches older than `from_ms` are skipped by key.
+        /// Without the index, or for texts shorter than three bytes, the time
+        /// window is scanned. The other filters, the limit and the order of
+        /// `log_query` apply as in query(); `message_contains` still matches
+        /// only the inline text.
+        LogReadResult<std::vector<LogRecordSnapshot>> search_text(
+                const std::string& text,
+                const LogQuery& log_query = LogQuery()) const {
+            LogReadResult<std::vector<LogRecordSnapshot>> result;
+            result.value.emplace();
+            if (log_query.to_ms <= log_query.from_ms) {
+                return result;
             }
-            if (order == LogReadOrder::Descending && !result.value->empty()) {
-                std::reverse(result.value->begin(), result.value->end());
+
+            try {
+                const std::string from_key = detail::make_mdbx_record_key(log_query.from_ms, 0);
+                const std::string to_key = detail::make_mdbx_record_key(
+                    log_query.to_ms - 1,
+                    (std::numeric_limits<uint32_t>::max)());
+                const bool is_descending = log_query.order == LogReadOrder::Descending;
+                std::lock_guard<std::mutex> db_lock(m_db_mutex);
+                run_with_dictionary_locked([&]() {
+                    std::vector<LogRecordSnapshot>& records = *result.value;
+                    records.clear();
+                    std::string payload;
+                    const auto contains_text = [this, &text, &payload](const Record& record) {
+                        if (record.payload_id != 0 && payload_text_locked(record.payload_id, payload)) {
+                            return payload.find(text) != std::string::npos;
+                        }
+                        return record.message.find(text) != std::string::npos;
+                    };
+
+                    if ((m_index_mask & INDEX_TEXT) && text.size() >= detail::MDBX_TEXT_TRIGRAM_SIZE) {
+                        std::vector<std::string> keys;
+                        collect_text_candidates_locked(text, from_key, to_key, keys);
+                        if (is_descending) {
+                            std::reverse(keys.begin(), keys.end());
+                        }
+                        Record record;
+                        for (size_t i = 0; i < keys.size(); ++i) {
+                            if (!find_record_locked(keys[i], record)) continue;
+                            complete_record_locked(keys[i], record);
+                            if (!matches_record(log_query, 0, record) || !contains_text(record)) continue;
+                            records.push_back(to_log_record_snapshot(std::move(record)));
+                            if (log_query.limit > 0 && records.size() >= log_query.limit) return;
+                        }
+                        return;
+                    }
+
+                    // Spilled rows are checked after the scan; no payload is read inside the cursor.
+                    std::vector<Record> matches;
+                    scan_rows_locked(log_query, 0, from_key, to_key,
+                        [&matches, &text](const std::string&, Record& record) -> bool {
+                            if (record.payload_id != 0 || record.message.find(text) != std::string::npos) {
+                                matches.push_back(std::move(record));
+                            }
+                            return true;
+                        });
+                    if (is_descending) {
+                        std::reverse(matches.begin(), matches.end());
+                    }
+                    for (size_t i = 0; i < matches.size(); ++i) {
+                        if (matches[i].payload_id != 0 && !contains_text(matches[i])) continue;
+                        records.push_back(to_log_record_snapshot(std::move(matches[i])));
+                        if (log_query.limit > 0 && records.size() >= log_query.limit) return;
+                    }
+                });
+            } catch (const detail::MdbxReadException& e) {
+                result.value.reset();
+                result.error = e.error();
+                result.message = e.what();
+            } catch (const mdbxc::MdbxException& e) {
+                result.value.reset();
+                result.error = LogReadError::StorageError;
+                result.message = e.what();
+            } catch (const std::exception& e) {
+                result.value.reset();
+                result.error = LogReadError::DecodeError;
+                result.message = e.what();
+            } catch (...) {
+                result.value.reset();
+                result.error = LogReadError::DecodeError;
+                result.message = "MdbxLogger: unknown text search error";
             }
             return result;
         }
@@ -362,6 +836,8 @@ namespace logit {
                 ok = detail::decompress_string_gzip(view.value->data, output);
             } else if (view.value->compression == MdbxPayloadCompression::Zstd) {
                 ok = detail::decompress_string_zstd(view.value->data, output);
+            } else if (view.value->compression == MdbxPayloadCompression::ZstdDictionary) {
+                ok = decompress_with_dictionary(view.value->dictionary_id, view.value->data, output);
             }
             if (ok) {
                 result.value = std::move(output);
@@ -472,6 +948,12 @@ namespace logit {
                     if (options.include_persistent_records) {
                         result.cleared_records = m_records->count(txn);
                         m_records->clear(txn);
+                        m_has_last_record_key = false;
+                        for (uint32_t bit = INDEX_LEVEL; bit <= INDEX_LAST; bit <<= 1) {
+                            if (m_index_mask & bit) {
+                                clear_index_locked(bit, txn);
+                            }
+                        }
                     }
                     if (options.include_payloads) {
                         m_payloads->clear(txn);
@@ -483,17 +965,13 @@ namespace logit {
                         session.start_time_ms = LOGIT_CURRENT_TIMESTAMP_MS();
                         session.end_time_ms = 0;
                         session.process_id = detail::current_process_id();
-                        session.schema_version = 1;
+                        session.schema_version = m_config.record_schema_version;
                         m_session_id = make_unique_id();
                         m_sessions->insert_or_assign(m_session_id, session, txn);
                     }
                     txn.commit();
                 }
 
-                {
-                    std::lock_guard<std::mutex> lock(m_mutex);
-                    m_next_sequence_by_timestamp.clear();
-                }
                 m_last_log_ts.store(0, std::memory_order_release);
                 m_last_log_mono_ts.store(0, std::memory_order_release);
 
@@ -520,26 +998,84 @@ namespace logit {
             return m_failed_writes.load(std::memory_order_acquire);
         }
 
+        /// \brief Runs retention steps until every configured limit is met.
+        /// \details The worker does this in the background one step at a time;
+        /// call it to trim the database at a chosen moment.
+        /// \return Number of records deleted.
+        std::size_t enforce_retention() {
+            std::size_t deleted = 0;
+            if (!is_retention_enabled()) {
+                return deleted;
+            }
+            while (try_retention_step(deleted)) {
+            }
+            m_next_retention_mono_ms.store(LOGIT_MONOTONIC_MS() + m_config.retention.interval_ms, std::memory_order_release);
+            return deleted;
+        }
+
+        /// \brief Commit rate, batch sizes and latency of the async worker.
+        WriteStats write_stats() const {
+            std::lock_guard<std::mutex> lock(m_stats_mutex);
+            return m_stats;
+        }
+
+        /// \brief Records deleted by retention.
+        uint64_t retention_deleted_count() const {
+            return m_retention_deleted_records.load(std::memory_order_acquire);
+        }
+
+        /// \brief Payloads deleted together with their records by retention.
+        uint64_t retention_deleted_payload_count() const {
+            return m_retention_deleted_payloads.load(std::memory_order_acquire);
+        }
+
+        /// \brief How long retention has been behind its limits, in milliseconds.
+        /// \return 0 when the last step met every limit.
+        int64_t retention_lag_ms() const {
+            const int64_t since = m_retention_behind_since_mono_ms.load(std::memory_order_acquire);
+            if (since <= 0) {
+                return 0;
+            }
+            const int64_t now = LOGIT_MONOTONIC_MS();
+            return now > since ? now - since : 0;
+        }
+
+        /// \brief Adds every pending record to the trigram index.
+        /// \details The worker does this in the background between write
+        /// batches; call it to catch up at a chosen moment.
+        /// \return Number of pending records processed.
+        std::size_t update_text_index() {
+            std::size_t indexed = 0;
+            while (try_text_index_step(indexed)) {
+            }
+            return indexed;
+        }
+
         uint64_t add_log_callback(Callback callback) override {
-            std::lock_guard<std::mutex> lock(m_callbacks_mutex);
-            const uint64_t id = m_next_callback_id.fetch_add(1, std::memory_order_relaxed);
-            m_callbacks.emplace(id, std::move(callback));
-            return id;
+            return m_subscribers.add(std::move(callback), LogCallbackOptions());
+        }
+
+        uint64_t add_log_callback(Callback callback, const LogCallbackOptions& options) override {
+            return m_subscribers.add(std::move(callback), options);
         }
 
         bool remove_log_callback(uint64_t callback_id) override {
-            std::lock_guard<std::mutex> lock(m_callbacks_mutex);
-            return m_callbacks.erase(callback_id) > 0;
+            return m_subscribers.remove(callback_id);
+        }
+
+        uint64_t get_log_callback_dropped(uint64_t callback_id) const override {
+            return m_subscribers.dropped(callback_id);
         }
 
     private:
         struct MdbxLogItem {
             LogLevel level = LogLevel::LOG_LVL_TRACE;
             int64_t timestamp_ms = 0;
-            std::string file;
-            std::string function;
+            detail::InternedStringRef file;     ///< Interned; queued items own only the message.
+            detail::InternedStringRef function; ///< Interned function name.
             int line = 0;
             std::string message;
+            int64_t enqueued_us = 0; ///< Monotonic time log() queued the item.
         };
 
         struct Session {
@@ -554,6 +1090,7 @@ namespace logit {
         };
 
         struct Record {
+            uint32_t version = RECORD_VERSION_COMPACT; ///< Row format the record was or will be stored in.
             uint64_t session_id = 0;
             int64_t timestamp_ms = 0;
             uint32_t sequence = 0;
@@ -562,6 +1099,8 @@ namespace logit {
             uint64_t payload_id = 0;
             std::string file;
             std::string function;
+            uint64_t file_id = 0;     ///< `log_strings` id of `file` in compact rows; 0 = empty.
+            uint64_t function_id = 0; ///< `log_strings` id of `function` in compact rows; 0 = empty.
             int line = 0;
 
             std::vector<uint8_t> to_bytes() const;
@@ -571,6 +1110,7 @@ namespace logit {
         struct Payload {
             uint64_t payload_id = 0;
             MdbxPayloadCompression compression = MdbxPayloadCompression::None;
+            uint32_t dictionary_id = 0; ///< Stored only for ZstdDictionary payloads.
             std::string data;
 
             std::vector<uint8_t> to_bytes() const;
@@ -580,25 +1120,130 @@ namespace logit {
         typedef mdbxc::KeyValueTable<uint64_t, Session> SessionTable;
         typedef mdbxc::KeyValueTable<std::string, Record> RecordTable;
         typedef mdbxc::KeyValueTable<uint64_t, Payload> PayloadTable;
+        typedef mdbxc::KeyValueTable<uint64_t, std::string> IdStringTable;
+        typedef mdbxc::KeyValueTable<std::string, uint64_t> StringIdTable;
+        typedef mdbxc::KeyValueTable<std::string, std::string> StringTable;
+
+        static constexpr uint32_t RECORD_VERSION_LEGACY = 1;  ///< Record row with full strings and fixed-width integers.
+        static constexpr uint32_t RECORD_VERSION_COMPACT = 2; ///< Record row with dictionary ids and varints.
+
+        /// \brief Index chosen for a query.
+        enum class IndexPlan {
+            TimeScan, ///< No index applies; scan the time window.
+            Level,    ///< Union of `log_index_level` ranges for levels >= min_level.
+            File,     ///< `log_index_file` range of the exact file.
+            Session   ///< `log_index_session` range of the session.
+        };
+
+        static constexpr uint32_t INDEX_LEVEL = 1u;   ///< `log_index_level` bit.
+        static constexpr uint32_t INDEX_FILE = 2u;    ///< `log_index_file` bit.
+        static constexpr uint32_t INDEX_SESSION = 4u; ///< `log_index_session` bit.
+        static constexpr uint32_t INDEX_ROLLUP_LEVEL = 8u; ///< `log_rollup_level` bit.
+        static constexpr uint32_t INDEX_ROLLUP_FILE = 16u; ///< `log_rollup_file` bit.
+        static constexpr uint32_t INDEX_TEXT = 32u; ///< `log_text_pending` bit; the trigram tables go with it.
+        static constexpr uint32_t INDEX_LAST = INDEX_TEXT; ///< Highest index bit.
+        static constexpr uint32_t INDEX_ROLLUPS = INDEX_ROLLUP_LEVEL | INDEX_ROLLUP_FILE; ///< Rollup bits.
+        static constexpr std::size_t INDEX_REBUILD_BATCH_SIZE = 4096; ///< Records per index rebuild transaction.
+        static constexpr const char* INDEX_MASK_KEY = "index_mask"; ///< `log_meta` key of the maintained index bits.
+        static constexpr const char* ROLLUP_BUCKET_KEY = "rollup_bucket_ms"; ///< `log_meta` key of the stored rollup bucket size.
+        static constexpr const char* TEXT_POSTINGS_TABLE = "log_text_postings"; ///< Trigram + batch key range -> record keys.
+        static constexpr const char* TEXT_BATCHES_TABLE = "log_text_batches";   ///< Batch key range -> trigrams, for trimming.
+        static constexpr std::size_t TEXT_TRIM_BATCHES = 16; ///< Stale trigram batches removed per background step.
+        static constexpr std::size_t VISIT_PAGE_SIZE = 256; ///< Records per page in for_each_query().
+        static constexpr int64_t DESCENDING_WINDOW_MS = 1000; ///< First time window of a descending page; doubles until the page fills.
+        static constexpr char PAGE_TOKEN_ASCENDING = 'a';  ///< Page token prefix for ascending queries.
+        static constexpr char PAGE_TOKEN_DESCENDING = 'd'; ///< Page token prefix for descending queries.
+        static constexpr std::size_t UNBOUNDED_QUEUE_CAPACITY = 16384; ///< Ring capacity when max_queue_size is 0; further records go to m_overflow.
+        static constexpr std::size_t INITIAL_BATCH_LIMIT = 32;  ///< First adaptive batch limit.
+        static constexpr std::size_t LATENCY_WINDOW = 128;      ///< Batches in the p99 latency window.
+        static constexpr int64_t STATS_WINDOW_US = 1000000;     ///< Measurement window of transactions_per_second.
+
+        /// \brief Oldest record read by a retention step.
+        struct RetentionCandidate {
+            std::string key;
+            std::size_t bytes = 0;   ///< Key and row size.
+            bool is_decoded = false; ///< False for undecodable rows; only the row is deleted.
+            Record record;
+        };
 
         Config m_config;
         std::shared_ptr<mdbxc::Connection> m_connection;
         std::unique_ptr<SessionTable> m_sessions;
         std::unique_ptr<RecordTable> m_records;
+        std::unique_ptr<StringTable> m_record_rows; ///< Raw view of `log_records_by_time` for retention.
         std::unique_ptr<PayloadTable> m_payloads;
+        std::unique_ptr<StringTable> m_meta;          ///< Storage metadata (`log_meta`).
+        std::unique_ptr<StringTable> m_level_index;   ///< Level byte + record key, when enabled.
+        std::unique_ptr<StringTable> m_file_index;    ///< File hash + record key, when enabled.
+        std::unique_ptr<StringTable> m_session_index; ///< Session id + record key, when enabled.
+        std::unique_ptr<StringTable> m_level_rollup;  ///< Bucket + level -> counts, when enabled.
+        std::unique_ptr<StringTable> m_file_rollup;   ///< File hash + bucket + level -> counts, when enabled.
+        uint32_t m_index_mask = 0; ///< Indexes and rollups maintained by the write path.
+        std::map<std::string, std::pair<int64_t, int64_t>> m_pending_level_rollups; ///< Count/byte deltas of the open write transaction.
+        std::map<std::string, std::pair<int64_t, int64_t>> m_pending_file_rollups;  ///< Same for `log_rollup_file`.
+        std::unique_ptr<StringTable> m_text_pending;  ///< Record keys not yet in the trigram index, when enabled.
+        std::unique_ptr<StringTable> m_text_postings; ///< Trigram posting lists, one row per trigram and indexing batch.
+        std::unique_ptr<StringTable> m_text_batches;  ///< Trigrams of each indexing batch.
+        std::unique_ptr<IdStringTable> m_strings;    ///< Dictionary id -> file/function text (`log_strings`).
+        std::unique_ptr<StringIdTable> m_string_ids; ///< File/function text -> dictionary id (`log_string_ids`).
+        std::unique_ptr<IdStringTable> m_zstd_dictionaries; ///< Versioned zstd dictionaries (`log_zstd_dicts`).
 
         mutable std::mutex m_db_mutex;
 
-        std::mutex m_mutex;
-        std::condition_variable m_cv;
-        std::condition_variable m_space_cv;
-        std::deque<MdbxLogItem> m_queue;
-        bool m_stopping = false;
-        bool m_idle = true;
+        std::mutex m_mutex;                  ///< Guards only the worker sleep and the waits below.
+        std::condition_variable m_cv;        ///< Wakes the sleeping worker.
+        std::condition_variable m_space_cv;  ///< Wakes producers waiting for ring space.
+        std::condition_variable m_written_cv;///< Wakes wait() after each committed batch.
+        uint64_t m_space_epoch = 0;          ///< Bumped under m_mutex when the worker frees ring slots.
+        detail::MpscRingAny<MdbxLogItem> m_ring; ///< Async queue; producers push without locks.
+        std::mutex m_overflow_mutex;         ///< Guards m_overflow.
+        std::deque<MdbxLogItem> m_overflow;  ///< Records queued behind a full ring when max_queue_size is 0.
+        std::atomic<bool> m_has_overflow = ATOMIC_VAR_INIT(false); ///< True while m_overflow holds records.
+        bool m_is_worker_done = false;       ///< Set under m_mutex when the worker exits.
+        std::atomic<bool> m_is_stopping = ATOMIC_VAR_INIT(false);
+        std::atomic<bool> m_is_worker_sleeping = ATOMIC_VAR_INIT(false);
+        std::atomic<int> m_active_producers = ATOMIC_VAR_INIT(0);  ///< log() calls between the stop check and the push.
+        std::atomic<int> m_blocked_producers = ATOMIC_VAR_INIT(0); ///< log() calls waiting for ring space.
+        std::atomic<uint64_t> m_enqueued = ATOMIC_VAR_INIT(0);     ///< Items pushed into the ring.
+        std::atomic<uint64_t> m_completed = ATOMIC_VAR_INIT(0);    ///< Items the worker has written or given up on.
         std::thread m_worker;
 
+        // Group commit controller; used only by the worker.
+        std::size_t m_batch_limit = 0;           ///< Records the next transaction may take.
+        int64_t m_linger_us = 0;                 ///< Wait for more records before committing a small batch.
+        double m_commit_ewma_us = 0.0;           ///< Smoothed cost of one write transaction.
+        std::vector<int64_t> m_latency_samples;  ///< Oldest-item latency of recent batches.
+        std::size_t m_latency_next = 0;          ///< Slot overwritten by the next sample.
+
+        // Write statistics; guarded by m_stats_mutex.
+        mutable std::mutex m_stats_mutex;
+        WriteStats m_stats;
+        int64_t m_stats_window_start_us = 0;
+        uint64_t m_window_transactions = 0;
+        uint64_t m_window_records = 0;
+
         uint64_t m_session_id = 0;
-        std::unordered_map<int64_t, uint32_t> m_next_sequence_by_timestamp;
+        bool m_has_last_record_key = false; ///< True once the record key cursor points at a stored key.
+        int64_t m_last_record_ts = 0;       ///< Timestamp of the newest allocated record key.
+        uint32_t m_last_record_sequence = 0;///< Sequence of the newest allocated record key.
+        uint64_t m_last_payload_id = 0;     ///< Largest allocated payload id.
+
+        // Dictionary state; guarded by m_db_mutex.
+        mutable std::unordered_map<uint64_t, detail::InternedStringRef> m_strings_by_id; ///< Mirror of `log_strings`.
+        mutable uint64_t m_last_string_id = 0;     ///< Largest id in the mirror; every smaller id is loaded.
+        mutable bool m_has_unresolved_ids = false; ///< Set when a read met an id missing from the mirror.
+        std::vector<uint64_t> m_string_ids_by_intern_id; ///< Write cache: interner id -> dictionary id.
+        std::vector<uint32_t> m_pending_intern_ids;      ///< Cache entries added by the open write transaction.
+
+        // zstd state; guarded by m_db_mutex.
+        mutable detail::ZstdDictionaryCodec m_zstd_codec; ///< Reused contexts and loaded dictionaries.
+        uint32_t m_last_dictionary_id = 0;          ///< Largest stored dictionary id.
+        std::vector<std::string> m_dictionary_samples; ///< Payloads collected for the next training.
+        std::size_t m_dictionary_sample_bytes = 0;  ///< Total size of m_dictionary_samples.
+        std::size_t m_payloads_since_dictionary = 0;///< Payloads compressed with the current dictionary.
+        bool m_is_training_dictionary = false;      ///< True while m_dictionary_trainer runs.
+        bool m_is_dictionary_training_closed = false;///< Set at shutdown; no trainer starts afterwards.
+        std::thread m_dictionary_trainer;           ///< Background dictionary training.
 
         std::atomic<int> m_log_level = ATOMIC_VAR_INIT(static_cast<int>(LogLevel::LOG_LVL_TRACE));
         std::atomic<int64_t> m_last_log_ts = ATOMIC_VAR_INIT(0);
@@ -606,10 +1251,14 @@ namespace logit {
         std::atomic<uint64_t> m_dropped = ATOMIC_VAR_INIT(0);
         std::atomic<uint64_t> m_failed_writes = ATOMIC_VAR_INIT(0);
         std::atomic<bool> m_shutdown = ATOMIC_VAR_INIT(false);
+        std::atomic<uint64_t> m_retention_deleted_records = ATOMIC_VAR_INIT(0);
+        std::atomic<uint64_t> m_retention_deleted_payloads = ATOMIC_VAR_INIT(0);
+        std::atomic<int64_t> m_next_retention_mono_ms = ATOMIC_VAR_INIT(0);        ///< Earliest time of the next retention step.
+        std::atomic<int64_t> m_retention_behind_since_mono_ms = ATOMIC_VAR_INIT(0); ///< Start of the current backlog, 0 when caught up.
+        std::atomic<bool> m_has_text_index_work = ATOMIC_VAR_INIT(true); ///< A full batch of pending records or stale batches may exist.
+        std::atomic<std::size_t> m_text_written_since_step = ATOMIC_VAR_INIT(0); ///< Records queued for the text index since the last step.
 
-        mutable std::mutex m_callbacks_mutex;
-        std::map<uint64_t, Callback> m_callbacks;
-        std::atomic<uint64_t> m_next_callback_id{1};
+        detail::LogSubscriberList m_subscribers; ///< Registered callbacks.
 
         template <typename T>
         static LogReadResult<T> make_not_found_result(const std::string& message) {
@@ -619,30 +1268,18 @@ namespace logit {
             return result;
         }
 
-        void notify_callbacks(const std::vector<LogRecordSnapshot>& snapshots) const {
-            std::vector<Callback> callbacks_copy;
-            {
-                std::lock_guard<std::mutex> lock(m_callbacks_mutex);
-                callbacks_copy.reserve(m_callbacks.size());
-                for (const auto& kv : m_callbacks) {
-                    callbacks_copy.push_back(kv.second);
-                }
-            }
-            for (const auto& snapshot : snapshots) {
-                for (const auto& cb : callbacks_copy) {
-                    try {
-                        cb(snapshot);
-                    } catch (const std::exception& e) {
-                        if (m_config.on_error) {
-                            m_config.on_error(std::string("MdbxLogger callback error: ") + e.what());
-                        }
-                    } catch (...) {
-                        if (m_config.on_error) {
-                            m_config.on_error("MdbxLogger callback error");
-                        }
-                    }
-                }
-            }
+        static LogRecordSnapshot to_log_record_snapshot(Record&& r) {
+            LogRecordSnapshot snapshot;
+            snapshot.session_id = r.session_id;
+            snapshot.timestamp_ms = r.timestamp_ms;
+            snapshot.sequence = r.sequence;
+            snapshot.level = r.level;
+            snapshot.message = std::move(r.message);
+            snapshot.payload_id = r.payload_id;
+            snapshot.file = std::move(r.file);
+            snapshot.function = std::move(r.function);
+            snapshot.line = r.line;
+            return snapshot;
         }
 
         static LogRecordSnapshot to_log_record_snapshot(const Record& r) {
@@ -673,6 +1310,7 @@ namespace logit {
             PayloadView v;
             v.payload_id = p.payload_id;
             v.compression = p.compression;
+            v.dictionary_id = p.dictionary_id;
             v.data = p.data;
             return v;
         }
@@ -706,9 +1344,26 @@ namespace logit {
             return s;
         }
 
+        /// \brief Encodes a record row.
+        /// \details Compact rows start with a single version byte and store
+        /// integers as varints and file/function as `log_strings` ids. The
+        /// timestamp and sequence are left out because the row key holds
+        /// them. Legacy rows start with a 4-byte big-endian version, so the
+        /// first byte tells the formats apart.
         static std::vector<uint8_t> serialize_record(const Record& r) {
             detail::MdbxByteWriter out;
-            out.write_u32(1);
+            if (r.version == RECORD_VERSION_COMPACT) {
+                out.write_u8(static_cast<uint8_t>(RECORD_VERSION_COMPACT));
+                out.write_varint(r.session_id);
+                out.write_varint(static_cast<uint64_t>(r.level));
+                out.write_varint(r.payload_id);
+                out.write_varint(r.file_id);
+                out.write_varint(r.function_id);
+                out.write_svarint(static_cast<int64_t>(r.line));
+                out.write_varstring(r.message);
+                return out.bytes();
+            }
+            out.write_u32(RECORD_VERSION_LEGACY);
             out.write_u64(r.session_id);
             out.write_i64(r.timestamp_ms);
             out.write_u32(r.sequence);
@@ -721,15 +1376,51 @@ namespace logit {
             return out.bytes();
         }
 
+        /// \brief Decodes a record row.
+        /// \details Compact rows come back with ids only; complete_record_locked()
+        /// fills the timestamp, sequence and strings.
         static Record deserialize_record(const void* data, size_t size) {
             detail::MdbxByteReader in(data, size);
+            Record r;
+            if (read_record_header(in, r)) {
+                read_record_message(in, r);
+            }
+            return r;
+        }
+
+        /// \brief Decodes a record row up to its message.
+        /// \details Compact rows stop before the message so filters can reject
+        /// the row first. Legacy rows keep the message in the middle and are
+        /// decoded completely.
+        /// \return True when read_record_message() must still be called.
+        static bool read_record_header(detail::MdbxByteReader& in, Record& r) {
+            if (in.peek_u8() == RECORD_VERSION_COMPACT) {
+                r.version = in.read_u8();
+                r.session_id = in.read_varint();
+                r.level = static_cast<LogLevel>(in.read_varint());
+                r.payload_id = in.read_varint();
+                r.file_id = in.read_varint();
+                r.function_id = in.read_varint();
+                r.line = static_cast<int>(in.read_svarint());
+                return true;
+            }
+            read_legacy_record(in, r);
+            return false;
+        }
+
+        static void read_record_message(detail::MdbxByteReader& in, Record& r) {
+            r.message = in.read_varstring();
+            in.finish();
+        }
+
+        static void read_legacy_record(detail::MdbxByteReader& in, Record& r) {
             const uint32_t version = in.read_u32();
-            if (version != 1) {
+            if (version != RECORD_VERSION_LEGACY) {
                 throw detail::MdbxReadException(
                     LogReadError::UnsupportedVersion,
                     "MdbxLogger: unsupported record value version");
             }
-            Record r;
+            r.version = RECORD_VERSION_LEGACY;
             r.session_id = in.read_u64();
             r.timestamp_ms = in.read_i64();
             r.sequence = in.read_u32();
@@ -740,7 +1431,6 @@ namespace logit {
             r.function = in.read_string();
             r.line = static_cast<int>(in.read_i64());
             in.finish();
-            return r;
         }
 
         static std::vector<uint8_t> serialize_payload(const Payload& p) {
@@ -748,6 +1438,9 @@ namespace logit {
             out.write_u32(1);
             out.write_u64(p.payload_id);
             out.write_u8(static_cast<uint8_t>(p.compression));
+            if (p.compression == MdbxPayloadCompression::ZstdDictionary) {
+                out.write_u32(p.dictionary_id);
+            }
             out.write_string(p.data);
             return out.bytes();
         }
@@ -760,208 +1453,1947 @@ namespace logit {
                     LogReadError::UnsupportedVersion,
                     "MdbxLogger: unsupported payload value version");
             }
-            Payload p;
-            p.payload_id = in.read_u64();
-            const uint8_t compression = in.read_u8();
-            if (compression > static_cast<uint8_t>(MdbxPayloadCompression::Zstd)) {
-                throw detail::MdbxReadException(
-                    LogReadError::DecodeError,
-                    "MdbxLogger: unsupported payload compression");
+            Payload p;
+            p.payload_id = in.read_u64();
+            const uint8_t compression = in.read_u8();
+            if (compression > static_cast<uint8_t>(MdbxPayloadCompression::ZstdDictionary)) {
+                throw detail::MdbxReadException(
+                    LogReadError::DecodeError,
+                    "MdbxLogger: unsupported payload compression");
+            }
+            p.compression = static_cast<MdbxPayloadCompression>(compression);
+            if (p.compression == MdbxPayloadCompression::ZstdDictionary) {
+                p.dictionary_id = in.read_u32();
+            }
+            p.data = in.read_string();
+            in.finish();
+            return p;
+        }
+
+        void normalize_config() {
+            if (m_config.max_batch_size == 0) {
+                m_config.max_batch_size = 1;
+            }
+            if (m_config.flush_interval_ms <= 0) {
+                m_config.flush_interval_ms = 1;
+            }
+            if (m_config.target_write_latency_ms <= 0) {
+                m_config.target_write_latency_ms = 1;
+            }
+            if (m_config.retention.batch_size == 0) {
+                m_config.retention.batch_size = 1;
+            }
+            if (m_config.retention.interval_ms <= 0) {
+                m_config.retention.interval_ms = 1;
+            }
+            if (m_config.rollup_bucket_ms <= 0) {
+                m_config.rollup_bucket_ms = 1;
+            }
+            if (m_config.text_index_batch_size == 0) {
+                m_config.text_index_batch_size = 1;
+            }
+        }
+
+        void validate_record_schema_version() const {
+            if (m_config.record_schema_version != RECORD_VERSION_LEGACY &&
+                m_config.record_schema_version != RECORD_VERSION_COMPACT) {
+                throw std::invalid_argument("MdbxLogger: unsupported record_schema_version");
+            }
+        }
+
+        void validate_compression_config() const {
+            if (m_config.payload_compression == MdbxPayloadCompression::Gzip) {
+#if !defined(LOGIT_HAS_ZLIB)
+                throw std::runtime_error("MdbxLogger: gzip payload compression requested but LOGIT_WITH_GZIP is not enabled");
+#endif
+            }
+            if (m_config.payload_compression == MdbxPayloadCompression::Zstd ||
+                m_config.payload_compression == MdbxPayloadCompression::ZstdDictionary) {
+#if !defined(LOGIT_HAS_ZSTD)
+                throw std::runtime_error("MdbxLogger: zstd payload compression requested but LOGIT_WITH_ZSTD is not enabled");
+#endif
+            }
+            if (m_config.payload_compression == MdbxPayloadCompression::ZstdDictionary &&
+                (m_config.zstd_dictionary_size == 0 || m_config.zstd_dictionary_sample_bytes == 0)) {
+                throw std::invalid_argument("MdbxLogger: zstd dictionary size and sample budget must be positive");
+            }
+        }
+
+        void open_storage() {
+            mdbxc::Config db_config;
+            db_config.pathname = m_config.path;
+            db_config.max_dbs = 16;
+            db_config.no_subdir = true;
+            db_config.sync_durable = true;
+            // Pages freed by retention go back to MDBX's free list and are reused
+            // by later writes, so the file does not need to shrink to stay bounded.
+            db_config.growth_step = m_config.db_growth_step;
+            db_config.shrink_threshold = m_config.db_shrink_threshold;
+
+            ensure_storage_parent(db_config);
+            m_connection = mdbxc::Connection::create(db_config);
+            m_sessions.reset(new SessionTable(m_connection, "log_sessions"));
+            m_records.reset(new RecordTable(m_connection, "log_records_by_time"));
+            m_record_rows.reset(new StringTable(m_connection, "log_records_by_time"));
+            m_payloads.reset(new PayloadTable(m_connection, "log_payloads"));
+            m_meta.reset(new StringTable(m_connection, "log_meta"));
+            m_strings.reset(new IdStringTable(m_connection, "log_strings"));
+            m_string_ids.reset(new StringIdTable(m_connection, "log_string_ids"));
+            m_zstd_dictionaries.reset(new IdStringTable(m_connection, "log_zstd_dicts"));
+            recover_allocation_cursors();
+            open_indexes();
+            open_zstd_dictionary();
+        }
+
+        /// \brief Finds the largest key at or above `first` with O(log) seeks.
+        /// \param first A key known to exist.
+        /// \param seek  `bool(uint64_t from, uint64_t& found)`: finds the first key >= `from`.
+        template <class Seek>
+        static uint64_t seek_last_key(uint64_t first, Seek seek) {
+            uint64_t low = first;
+            uint64_t high = (std::numeric_limits<uint64_t>::max)();
+            while (low < high) {
+                const uint64_t mid = low + (high - low) / 2 + 1;
+                uint64_t found = 0;
+                if (seek(mid, found)) {
+                    low = found;
+                } else {
+                    high = mid - 1;
+                }
+            }
+            return low;
+        }
+
+        /// \brief Positions the record key cursor and the payload id counter after the stored data.
+        /// \details Runs once at open. Both tables are read through raw
+        /// string views, so undecodable values do not block the logger, and
+        /// the newest key is found by binary search over range seeks instead
+        /// of a full scan.
+        void recover_allocation_cursors() {
+            std::lock_guard<std::mutex> db_lock(m_db_mutex);
+            StringTable record_keys(m_connection, "log_records_by_time");
+            const std::string last_possible_key = detail::make_mdbx_record_key(
+                (std::numeric_limits<int64_t>::max)(),
+                (std::numeric_limits<uint32_t>::max)());
+            const auto seek_record_ms = [&record_keys, &last_possible_key](uint64_t from, uint64_t& found) -> bool {
+                const int64_t from_ms = static_cast<int64_t>(from ^ detail::mdbx_sortable_timestamp(0));
+                bool is_found = false;
+                record_keys.for_each_range(detail::make_mdbx_record_key(from_ms, 0), last_possible_key,
+                    [&found, &is_found](const std::string& key, const std::string&) -> bool {
+                        int64_t timestamp_ms = 0;
+                        uint32_t sequence = 0;
+                        is_found = detail::parse_mdbx_record_key(key, timestamp_ms, sequence);
+                        found = detail::mdbx_sortable_timestamp(timestamp_ms);
+                        return false;
+                    });
+                return is_found;
+            };
+
+            uint64_t first_ms = 0;
+            m_has_last_record_key = seek_record_ms(0, first_ms);
+            if (m_has_last_record_key) {
+                const uint64_t last_ms = seek_last_key(first_ms, seek_record_ms);
+                m_last_record_ts = static_cast<int64_t>(last_ms ^ detail::mdbx_sortable_timestamp(0));
+                m_last_record_sequence = 0;
+                record_keys.for_each_range(
+                    detail::make_mdbx_record_key(m_last_record_ts, 0),
+                    detail::make_mdbx_record_key(m_last_record_ts, (std::numeric_limits<uint32_t>::max)()),
+                    [this](const std::string& key, const std::string&) -> bool {
+                        int64_t timestamp_ms = 0;
+                        detail::parse_mdbx_record_key(key, timestamp_ms, m_last_record_sequence);
+                        return true;
+                    });
+            }
+
+            IdStringTable payload_ids(m_connection, "log_payloads");
+            m_last_payload_id = find_last_id(payload_ids);
+
+            refresh_dictionary_locked();
+        }
+
+        /// \brief Returns the largest key of an id-keyed table, or 0 when it is empty.
+        static uint64_t find_last_id(IdStringTable& table) {
+            const auto seek_id = [&table](uint64_t from, uint64_t& found) -> bool {
+                bool is_found = false;
+                table.for_each_range(from, (std::numeric_limits<uint64_t>::max)(),
+                    [&found, &is_found](const uint64_t& id, const std::string&) -> bool {
+                        found = id;
+                        is_found = true;
+                        return false;
+                    });
+                return is_found;
+            };
+            uint64_t first_id = 0;
+            return seek_id(0, first_id) ? seek_last_key(first_id, seek_id) : 0;
+        }
+
+        /// \brief Makes the newest stored zstd dictionary current.
+        /// \details Older dictionaries are loaded on demand when a payload
+        /// compressed with them is read.
+        void open_zstd_dictionary() {
+            std::lock_guard<std::mutex> db_lock(m_db_mutex);
+            m_last_dictionary_id = static_cast<uint32_t>(find_last_id(*m_zstd_dictionaries));
+            if (m_config.payload_compression != MdbxPayloadCompression::ZstdDictionary ||
+                m_last_dictionary_id == 0) {
+                return;
+            }
+#if __cplusplus >= 201703L
+            auto dictionary = m_zstd_dictionaries->find(m_last_dictionary_id);
+            const bool is_found = static_cast<bool>(dictionary);
+            const std::string value = is_found ? *dictionary : std::string();
+#else
+            std::pair<bool, std::string> dictionary = m_zstd_dictionaries->find(m_last_dictionary_id);
+            const bool is_found = dictionary.first;
+            const std::string value = dictionary.second;
+#endif
+            if (!is_found || !m_zstd_codec.set_current(m_last_dictionary_id, value, m_config.payload_compression_level)) {
+                throw std::runtime_error("MdbxLogger: failed to load zstd dictionary");
+            }
+        }
+
+        /// \brief Loads dictionary entries added since the last refresh.
+        /// \details Ids are allocated in increasing order, so this is a single
+        /// range seek when nothing changed.
+        void refresh_dictionary_locked() const {
+            if (m_last_string_id == (std::numeric_limits<uint64_t>::max)()) {
+                return;
+            }
+            m_strings->for_each_range(m_last_string_id + 1, (std::numeric_limits<uint64_t>::max)(),
+                [this](const uint64_t& id, const std::string& value) -> bool {
+                    m_strings_by_id[id] = detail::InternedStringRef(value);
+                    m_last_string_id = id;
+                    return true;
+                });
+        }
+
+        /// \brief Runs a read against an up-to-date dictionary mirror.
+        /// \details Another process may commit a new dictionary entry and a
+        /// record using it between the refresh and the read; the read is then
+        /// repeated once after a second refresh. `read` must reset its output.
+        template <class Read>
+        void run_with_dictionary_locked(Read read) const {
+            refresh_dictionary_locked();
+            m_has_unresolved_ids = false;
+            read();
+            if (m_has_unresolved_ids) {
+                refresh_dictionary_locked();
+                m_has_unresolved_ids = false;
+                read();
+            }
+        }
+
+        const std::string& lookup_string_locked(uint64_t id) const {
+            static const std::string empty;
+            if (id == 0) {
+                return empty;
+            }
+            std::unordered_map<uint64_t, detail::InternedStringRef>::const_iterator it = m_strings_by_id.find(id);
+            if (it == m_strings_by_id.end()) {
+                m_has_unresolved_ids = true;
+                return empty;
+            }
+            return it->second.str();
+        }
+
+        /// \brief Fills the key-derived fields and dictionary strings of a decoded record.
+        void complete_record_locked(const std::string& key, Record& record) const {
+            detail::parse_mdbx_record_key(key, record.timestamp_ms, record.sequence);
+            if (record.version == RECORD_VERSION_COMPACT) {
+                record.file = lookup_string_locked(record.file_id);
+                record.function = lookup_string_locked(record.function_id);
+            }
+        }
+
+        /// \brief Returns the dictionary id of a file or function name, adding it in `txn` when new.
+        uint64_t string_id_locked(const detail::InternedStringRef& value, mdbxc::Transaction& txn) {
+            const uint32_t intern_id = value.id();
+            if (intern_id == 0) {
+                return 0;
+            }
+            if (intern_id < m_string_ids_by_intern_id.size() && m_string_ids_by_intern_id[intern_id] != 0) {
+                return m_string_ids_by_intern_id[intern_id];
+            }
+
+            uint64_t id = 0;
+#if __cplusplus >= 201703L
+            auto existing = m_string_ids->find(value.str(), txn.handle());
+            if (existing) id = *existing;
+#else
+            std::pair<bool, uint64_t> existing = m_string_ids->find(value.str(), txn.handle());
+            if (existing.first) id = existing.second;
+#endif
+            if (id == 0) {
+                for (;;) {
+                    if (m_last_string_id == (std::numeric_limits<uint64_t>::max)()) {
+                        throw std::runtime_error("MdbxLogger: dictionary ids exhausted");
+                    }
+                    id = m_last_string_id + 1;
+                    m_last_string_id = id;
+                    if (m_strings->insert(id, value.str(), txn)) {
+                        break;
+                    }
+                    // Another writer took the id; keep the mirror complete and move on.
+#if __cplusplus >= 201703L
+                    auto taken = m_strings->find(id, txn.handle());
+                    if (taken) m_strings_by_id[id] = detail::InternedStringRef(*taken);
+#else
+                    std::pair<bool, std::string> taken = m_strings->find(id, txn.handle());
+                    if (taken.first) m_strings_by_id[id] = detail::InternedStringRef(taken.second);
+#endif
+                }
+                m_string_ids->insert(value.str(), id, txn);
+            }
+
+            m_strings_by_id[id] = value;
+            if (m_string_ids_by_intern_id.size() <= intern_id) {
+                m_string_ids_by_intern_id.resize(static_cast<size_t>(intern_id) + 1, 0);
+            }
+            m_string_ids_by_intern_id[intern_id] = id;
+            m_pending_intern_ids.push_back(intern_id);
+            return id;
+        }
+
+        /// \brief Forgets dictionary ids assigned by an aborted write transaction.
+        void rollback_dictionary(uint64_t last_committed_id) {
+            std::lock_guard<std::mutex> db_lock(m_db_mutex);
+            for (size_t i = 0; i < m_pending_intern_ids.size(); ++i) {
+                m_string_ids_by_intern_id[m_pending_intern_ids[i]] = 0;
+            }
+            m_pending_intern_ids.clear();
+            for (std::unordered_map<uint64_t, detail::InternedStringRef>::iterator it = m_strings_by_id.begin();
+                 it != m_strings_by_id.end();) {
+                if (it->first > last_committed_id) {
+                    it = m_strings_by_id.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            m_last_string_id = last_committed_id;
+        }
+
+        static const char* index_table_name(uint32_t bit) {
+            switch (bit) {
+            case INDEX_LEVEL: return "log_index_level";
+            case INDEX_FILE: return "log_index_file";
+            case INDEX_ROLLUP_LEVEL: return "log_rollup_level";
+            case INDEX_ROLLUP_FILE: return "log_rollup_file";
+            case INDEX_TEXT: return "log_text_pending";
+            default: break;
+            }
+            return "log_index_session";
+        }
+
+        std::unique_ptr<StringTable>& index_table(uint32_t bit) {
+            switch (bit) {
+            case INDEX_LEVEL: return m_level_index;
+            case INDEX_FILE: return m_file_index;
+            case INDEX_ROLLUP_LEVEL: return m_level_rollup;
+            case INDEX_ROLLUP_FILE: return m_file_rollup;
+            case INDEX_TEXT: return m_text_pending;
+            default: break;
+            }
+            return m_session_index;
+        }
+
+        /// \brief Clears every table of an index in the caller's transaction.
+        void clear_index_locked(uint32_t bit, mdbxc::Transaction& txn) {
+            index_table(bit)->clear(txn);
+            if (bit == INDEX_TEXT) {
+                m_text_postings->clear(txn);
+                m_text_batches->clear(txn);
+            }
+        }
+
+        /// \brief Opens the configured index tables and brings them up to date.
+        /// \details `log_meta` remembers which indexes were maintained by every
+        /// write so far. An index enabled now but missing from that mask may lack
+        /// records written while it was off, so it is cleared and rebuilt from
+        /// the record table. Disabled indexes are dropped from the mask and
+        /// cleared. A failed rebuild is reported and leaves that index off;
+        /// queries then fall back to time scans. Rollups are handled the same
+        /// way and are also rebuilt when the bucket size changes.
+        void open_indexes() {
+            const uint32_t wanted =
+                (m_config.index_by_level ? INDEX_LEVEL : 0u) |
+                (m_config.index_by_file ? INDEX_FILE : 0u) |
+                (m_config.index_by_session ? INDEX_SESSION : 0u) |
+                (m_config.rollup_by_level ? INDEX_ROLLUP_LEVEL : 0u) |
+                (m_config.rollup_by_file ? INDEX_ROLLUP_FILE : 0u) |
+                (m_config.index_by_text ? INDEX_TEXT : 0u);
+            std::lock_guard<std::mutex> db_lock(m_db_mutex);
+            uint32_t stored = read_index_mask_locked();
+            if ((stored & INDEX_ROLLUPS) != 0 && read_rollup_bucket_locked() != m_config.rollup_bucket_ms) {
+                // Counts of other bucket sizes cannot be split; treat them as missing.
+                stored &= ~(wanted & INDEX_ROLLUPS);
+            }
+            if (wanted == 0 && stored == 0) {
+                return;
+            }
+
+            uint32_t pending = 0;
+            for (uint32_t bit = INDEX_LEVEL; bit <= INDEX_LAST; bit <<= 1) {
+                if (wanted & bit) {
+                    index_table(bit).reset(new StringTable(m_connection, index_table_name(bit)));
+                    if (bit == INDEX_TEXT) {
+                        m_text_postings.reset(new StringTable(m_connection, TEXT_POSTINGS_TABLE));
+                        m_text_batches.reset(new StringTable(m_connection, TEXT_BATCHES_TABLE));
+                    }
+                    if (!(stored & bit)) {
+                        pending |= bit;
+                    }
+                } else if (stored & bit) {
+                    StringTable stale(m_connection, index_table_name(bit));
+                    std::unique_ptr<StringTable> stale_postings;
+                    std::unique_ptr<StringTable> stale_batches;
+                    if (bit == INDEX_TEXT) {
+                        stale_postings.reset(new StringTable(m_connection, TEXT_POSTINGS_TABLE));
+                        stale_batches.reset(new StringTable(m_connection, TEXT_BATCHES_TABLE));
+                    }
+                    auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
+                    stale.clear(txn);
+                    if (stale_postings) {
+                        stale_postings->clear(txn);
+                        stale_batches->clear(txn);
+                    }
+                    txn.commit();
+                }
+            }
+
+            m_index_mask = wanted & ~pending;
+            if (pending != 0) {
+                try {
+                    rebuild_indexes_locked(pending);
+                    m_index_mask |= pending;
+                } catch (const std::exception& e) {
+                    report_init_error(std::string("MdbxLogger index rebuild error: ") + e.what());
+                } catch (...) {
+                    report_init_error("MdbxLogger index rebuild error");
+                }
+                for (uint32_t bit = INDEX_LEVEL; bit <= INDEX_LAST; bit <<= 1) {
+                    if ((pending & bit) && !(m_index_mask & bit)) {
+                        index_table(bit).reset();
+                        if (bit == INDEX_TEXT) {
+                            m_text_postings.reset();
+                            m_text_batches.reset();
+                        }
+                    }
+                }
+            }
+
+            auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
+            m_meta->insert_or_assign(INDEX_MASK_KEY, std::string(1, static_cast<char>(m_index_mask)), txn);
+            if (m_index_mask & INDEX_ROLLUPS) {
+                m_meta->insert_or_assign(ROLLUP_BUCKET_KEY, std::to_string(m_config.rollup_bucket_ms), txn);
+            }
+            txn.commit();
+        }
+
+        int64_t read_rollup_bucket_locked() const {
+#if __cplusplus >= 201703L
+            auto value = m_meta->find(ROLLUP_BUCKET_KEY);
+            if (!value) return 0;
+            const std::string text = *value;
+#else
+            std::pair<bool, std::string> value = m_meta->find(ROLLUP_BUCKET_KEY);
+            if (!value.first) return 0;
+            const std::string text = value.second;
+#endif
+            try {
+                return static_cast<int64_t>(std::stoll(text));
+            } catch (...) {
+                return 0;
+            }
+        }
+
+        uint32_t read_index_mask_locked() const {
+#if __cplusplus >= 201703L
+            auto value = m_meta->find(INDEX_MASK_KEY);
+            if (!value || value->size() != 1) return 0;
+            return static_cast<unsigned char>((*value)[0]);
+#else
+            std::pair<bool, std::string> value = m_meta->find(INDEX_MASK_KEY);
+            if (!value.first || value.second.size() != 1) return 0;
+            return static_cast<unsigned char>(value.second[0]);
+#endif
+        }
+
+        /// \brief Clears the `mask` indexes and refills them from the record table.
+        /// \details Records are read in batches and each batch is indexed in its
+        /// own write transaction, so no read cursor is open while writing.
+        /// Rows deleted between the read and the write are skipped.
+        void rebuild_indexes_locked(uint32_t mask) {
+            {
+                auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
+                for (uint32_t bit = INDEX_LEVEL; bit <= INDEX_LAST; bit <<= 1) {
+                    if (mask & bit) {
+                        clear_index_locked(bit, txn);
+                    }
+                }
+                txn.commit();
+            }
+
+            std::string from_key = detail::make_mdbx_record_key((std::numeric_limits<int64_t>::min)(), 0);
+            const std::string to_key = detail::make_mdbx_record_key(
+                (std::numeric_limits<int64_t>::max)(),
+                (std::numeric_limits<uint32_t>::max)());
+            std::vector<std::pair<std::string, Record>> batch;
+            batch.reserve(INDEX_REBUILD_BATCH_SIZE);
+            for (;;) {
+                batch.clear();
+                m_records->for_each_range(from_key, to_key,
+                    [this, &batch](const std::string& key, const Record& record) -> bool {
+                        batch.emplace_back(key, record);
+                        complete_record_locked(key, batch.back().second);
+                        return batch.size() < INDEX_REBUILD_BATCH_SIZE;
+                    });
+                if (batch.empty()) {
+                    return;
+                }
+
+                auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    if (!m_records->contains(batch[i].first, txn)) {
+                        continue;
+                    }
+                    const Record& record = batch[i].second;
+                    const std::size_t payload_bytes = (mask & INDEX_ROLLUPS) && record.payload_id != 0
+                        ? payload_size_locked(record.payload_id, txn)
+                        : 0;
+                    add_index_entries_locked(mask, batch[i].first, record, payload_bytes, txn);
+                }
+                flush_rollups_locked(txn);
+                txn.commit();
+
+                from_key = batch.back().first;
+                if (batch.size() < INDEX_REBUILD_BATCH_SIZE || !detail::next_mdbx_record_key(from_key)) {
+                    return;
+                }
+            }
+        }
+
+        /// \brief Adds index entries for a stored record in the caller's transaction.
+        /// \details Rollup counts are only accumulated; flush_rollups_locked()
+        /// writes them before the transaction commits.
+        /// \param payload_bytes Stored size of the record's payload row, 0 without one.
+        void add_index_entries_locked(
+                uint32_t mask,
+                const std::string& key,
+                const Record& record,
+                std::size_t payload_bytes,
+                mdbxc::Transaction& txn) {
+            if (mask & INDEX_LEVEL) {
+                m_level_index->insert_or_assign(
+                    detail::make_mdbx_level_index_key(static_cast<uint8_t>(record.level), key),
+                    std::string(), txn);
+            }
+            if (mask & INDEX_FILE) {
+                m_file_index->insert_or_assign(
+                    detail::make_mdbx_u64_index_key(detail::mdbx_file_index_hash(record.file), key),
+                    std::string(), txn);
+            }
+            if (mask & INDEX_SESSION) {
+                m_session_index->insert_or_assign(
+                    detail::make_mdbx_u64_index_key(record.session_id, key),
+                    std::string(), txn);
+            }
+            if (mask & INDEX_ROLLUPS) {
+                add_rollup_delta_locked(mask, record, 1, static_cast<int64_t>(record.message.size() + payload_bytes));
+            }
+            if (mask & INDEX_TEXT) {
+                // Trigrams are extracted later by the worker; see run_text_index_step().
+                m_text_pending->insert_or_assign(key, std::string(), txn);
+            }
+        }
+
+        /// \brief Adds a count and byte delta for the record's bucket to the pending rollups.
+        void add_rollup_delta_locked(uint32_t mask, const Record& record, int64_t count, int64_t bytes) {
+            const int64_t bucket_start_ms = detail::mdbx_bucket_start(record.timestamp_ms, m_config.rollup_bucket_ms);
+            const uint8_t level = static_cast<uint8_t>(record.level);
+            if (mask & INDEX_ROLLUP_LEVEL) {
+                std::pair<int64_t, int64_t>& delta =
+                    m_pending_level_rollups[detail::make_mdbx_rollup_key(bucket_start_ms, level)];
+                delta.first += count;
+                delta.second += bytes;
+            }
+            if (mask & INDEX_ROLLUP_FILE) {
+                std::pair<int64_t, int64_t>& delta = m_pending_file_rollups[detail::make_mdbx_file_rollup_key(
+                    detail::mdbx_file_index_hash(record.file), bucket_start_ms, level)];
+                delta.first += count;
+                delta.second += bytes;
+            }
+        }
+
+        /// \brief Applies the pending rollup deltas in the caller's transaction.
+        /// \details A batch touches a few buckets, so each rollup row is read
+        /// and written once per transaction rather than once per record. Rows
+        /// whose count drops to zero are erased.
+        void flush_rollups_locked(mdbxc::Transaction& txn) {
+            flush_rollup_table_locked(m_level_rollup.get(), m_pending_level_rollups, txn);
+            flush_rollup_table_locked(m_file_rollup.get(), m_pending_file_rollups, txn);
+        }
+
+        static void flush_rollup_table_locked(
+                StringTable* table,
+                std::map<std::string, std::pair<int64_t, int64_t>>& pending,
+                mdbxc::Transaction& txn) {
+            if (table == nullptr) {
+                pending.clear();
+                return;
+            }
+            for (std::map<std::string, std::pair<int64_t, int64_t>>::const_iterator it = pending.begin();
+                 it != pending.end(); ++it) {
+                uint64_t count = 0;
+                uint64_t bytes = 0;
+#if __cplusplus >= 201703L
+                auto value = table->find(it->first, txn.handle());
+                if (value) decode_rollup_value(*value, count, bytes);
+#else
+                std::pair<bool, std::string> value = table->find(it->first, txn.handle());
+                if (value.first) decode_rollup_value(value.second, count, bytes);
+#endif
+                count = apply_rollup_delta(count, it->second.first);
+                bytes = apply_rollup_delta(bytes, it->second.second);
+                if (count == 0) {
+                    table->erase(it->first, txn);
+                } else {
+                    table->insert_or_assign(it->first, encode_rollup_value(count, bytes), txn);
+                }
+            }
+            pending.clear();
+        }
+
+        static uint64_t apply_rollup_delta(uint64_t value, int64_t delta) {
+            if (delta >= 0) {
+                return value + static_cast<uint64_t>(delta);
+            }
+            const uint64_t decrease = 0 - static_cast<uint64_t>(delta);
+            return value > decrease ? value - decrease : 0;
+        }
+
+        /// \brief Rollup row: big-endian record count and byte total.
+        static std::string encode_rollup_value(uint64_t count, uint64_t bytes) {
+            detail::MdbxByteWriter out;
+            out.write_u64(count);
+            out.write_u64(bytes);
+            return std::string(out.bytes().begin(), out.bytes().end());
+        }
+
+        static bool decode_rollup_value(const std::string& value, uint64_t& count, uint64_t& bytes) {
+            try {
+                detail::MdbxByteReader in(value.data(), value.size());
+                count = in.read_u64();
+                bytes = in.read_u64();
+                in.finish();
+                return true;
+            } catch (...) {
+                count = 0;
+                bytes = 0;
+                return false;
+            }
+        }
+
+        /// \brief Picks an index for the query and collects its record keys in time order.
+        /// \details Keys are collected before any record is read so that record
+        /// lookups never run inside an index cursor callback.
+        IndexPlan plan_query_locked(
+                const LogQuery& log_query,
+                uint64_t session_id,
+                std::vector<std::string>& keys) const {
+            IndexPlan plan = IndexPlan::TimeScan;
+            if (session_id != 0 && m_session_index) {
+                plan = IndexPlan::Session;
+            } else if (!log_query.file.empty() && log_query.file_match == LogMatchMode::Exact && m_file_index) {
+                plan = IndexPlan::File;
+            } else if (log_query.min_level != LogLevel::LOG_LVL_TRACE && m_level_index) {
+                plan = IndexPlan::Level;
+            } else {
+                return plan;
+            }
+
+            // A covering ascending query needs only the first `limit` keys of each range.
+            const std::size_t max_keys =
+                log_query.order == LogReadOrder::Ascending && is_plan_covering(plan, log_query, session_id)
+                ? log_query.limit
+                : 0;
+            const std::string from_key = detail::make_mdbx_record_key(log_query.from_ms, 0);
+            const std::string to_key = detail::make_mdbx_record_key(
+                log_query.to_ms - 1,
+                (std::numeric_limits<uint32_t>::max)());
+
+            if (plan == IndexPlan::Session) {
+                scan_index_locked(*m_session_index,
+                    detail::make_mdbx_u64_index_key(session_id, from_key),
+                    detail::make_mdbx_u64_index_key(session_id, to_key),
+                    detail::MDBX_U64_INDEX_PREFIX_SIZE, max_keys, keys);
+            } else if (plan == IndexPlan::File) {
+                const uint64_t file_hash = detail::mdbx_file_index_hash(log_query.file);
+                scan_index_locked(*m_file_index,
+                    detail::make_mdbx_u64_index_key(file_hash, from_key),
+                    detail::make_mdbx_u64_index_key(file_hash, to_key),
+                    detail::MDBX_U64_INDEX_PREFIX_SIZE, max_keys, keys);
+            } else {
+                std::size_t ranges = 0;
+                for (int level = static_cast<int>(log_query.min_level);
+                     level <= static_cast<int>(LogLevel::LOG_LVL_FATAL);
+                     ++level, ++ranges) {
+                    scan_index_locked(*m_level_index,
+                        detail::make_mdbx_level_index_key(static_cast<uint8_t>(level), from_key),
+                        detail::make_mdbx_level_index_key(static_cast<uint8_t>(level), to_key),
+                        detail::MDBX_LEVEL_INDEX_PREFIX_SIZE, max_keys, keys);
+                }
+                if (ranges > 1) {
+                    std::sort(keys.begin(), keys.end());
+                }
+                if (max_keys > 0 && keys.size() > max_keys) {
+                    keys.resize(max_keys);
+                }
+            }
+            return plan;
+        }
+
+        /// \brief True when index membership alone proves that a record matches.
+        /// \details File index keys carry a hash, so file plans always recheck.
+        static bool is_plan_covering(IndexPlan plan, const LogQuery& log_query, uint64_t session_id) {
+            const bool has_text_filters =
+                !log_query.file.empty() || !log_query.function.empty() || !log_query.message_contains.empty();
+            if (plan == IndexPlan::Level) {
+                return session_id == 0 && !has_text_filters;
+            }
+            if (plan == IndexPlan::Session) {
+                return log_query.min_level == LogLevel::LOG_LVL_TRACE && !has_text_filters;
+            }
+            return false;
+        }
+
+        static void scan_index_locked(
+                StringTable& index,
+                const std::string& from_key,
+                const std::string& to_key,
+                std::size_t prefix_size,
+                std::size_t max_keys,
+                std::vector<std::string>& keys) {
+            std::size_t found = 0;
+            index.for_each_range(from_key, to_key,
+                [&keys, &found, prefix_size, max_keys](const std::string& key, const std::string&) -> bool {
+                    keys.push_back(key.substr(prefix_size));
+                    return max_keys == 0 || ++found < max_keys;
+                });
+        }
+
+        static bool matches_record(const LogQuery& log_query, uint64_t session_id, const Record& record) {
+            return (session_id == 0 || record.session_id == session_id) && log_query.matches(record);
+        }
+
+        bool find_record_locked(const std::string& key, Record& out) const {
+#if __cplusplus >= 201703L
+            auto value = m_records->find(key);
+            if (!value) return false;
+            out = std::move(*value);
+            return true;
+#else
+            std::pair<bool, Record> value = m_records->find(key);
+            if (!value.first) return false;
+            out = std::move(value.second);
+            return true;
+#endif
+        }
+
+        /// \brief Visits matching records in `log_query.order` until `visitor` returns false.
+        /// \param keys Record keys collected by plan_query_locked() for an index plan.
+        template <class Visitor>
+        void visit_matches_locked(
+                const LogQuery& log_query,
+                uint64_t session_id,
+                IndexPlan plan,
+                std::vector<std::string>& keys,
+                Visitor visitor) const {
+            if (plan != IndexPlan::TimeScan) {
+                if (log_query.order == LogReadOrder::Descending) {
+                    std::reverse(keys.begin(), keys.end());
+                }
+                Record record;
+                for (size_t i = 0; i < keys.size(); ++i) {
+                    // Index entries are written with their record, so a miss only
+                    // happens for keys removed behind the index's back.
+                    if (!find_record_locked(keys[i], record)) continue;
+                    complete_record_locked(keys[i], record);
+                    if (!matches_record(log_query, session_id, record)) continue;
+                    if (!visitor(record)) return;
+                }
+                return;
+            }
+
+            const std::string from_key = detail::make_mdbx_record_key(log_query.from_ms, 0);
+            const std::string to_key = detail::make_mdbx_record_key(
+                log_query.to_ms - 1,
+                (std::numeric_limits<uint32_t>::max)());
+            if (log_query.order == LogReadOrder::Ascending) {
+                m_records->for_each_range(from_key, to_key,
+                    [this, &log_query, session_id, &visitor](const std::string& key, const Record& stored) -> bool {
+                        Record record = stored;
+                        complete_record_locked(key, record);
+                        return !matches_record(log_query, session_id, record) || visitor(record);
+                    });
+                return;
+            }
+
+            // The range cursor only walks forward; keep the matches and replay them newest first.
+            std::vector<Record> matches;
+            m_records->for_each_range(from_key, to_key,
+                [this, &log_query, session_id, &matches](const std::string& key, const Record& stored) -> bool {
+                    Record record = stored;
+                    complete_record_locked(key, record);
+                    if (matches_record(log_query, session_id, record)) {
+                        matches.push_back(std::move(record));
+                    }
+                    return true;
+                });
+            for (std::vector<Record>::reverse_iterator it = matches.rbegin(); it != matches.rend(); ++it) {
+                if (!visitor(*it)) return;
+            }
+        }
+
+        LogReadResult<std::vector<LogRecordSnapshot>> run_query(const LogQuery& log_query, uint64_t session_id) const {
+            LogReadResult<std::vector<LogRecordSnapshot>> result;
+            result.value.emplace();
+            if (log_query.to_ms <= log_query.from_ms) {
+                return result;
+            }
+
+            try {
+                std::lock_guard<std::mutex> db_lock(m_db_mutex);
+                std::vector<LogRecordSnapshot>& out = *result.value;
+                run_with_dictionary_locked([&]() {
+                    out.clear();
+                    std::vector<std::string> keys;
+                    const IndexPlan plan = plan_query_locked(log_query, session_id, keys);
+                    visit_matches_locked(log_query, session_id, plan, keys, [&out, &log_query](Record& record) -> bool {
+                        out.push_back(to_log_record_snapshot(std::move(record)));
+                        return log_query.limit == 0 || out.size() < log_query.limit;
+                    });
+                });
+            } catch (const detail::MdbxReadException& e) {
+                result.value.reset();
+                result.error = e.error();
+                result.message = e.what();
+            } catch (const mdbxc::MdbxException& e) {
+                result.value.reset();
+                result.error = LogReadError::StorageError;
+                result.message = e.what();
+            } catch (const std::exception& e) {
+                result.value.reset();
+                result.error = LogReadError::DecodeError;
+                result.message = e.what();
+            } catch (...) {
+                result.value.reset();
+                result.error = LogReadError::DecodeError;
+                result.message = "MdbxLogger: unknown query error";
+            }
+            return result;
+        }
+
+        /// \brief Visits rows in `[from_key, to_key]` that match `log_query`, oldest first.
+        /// \details Session, level, file and function are checked on the row
+        /// header; the message is decoded only for rows that pass them.
+        /// \param sink `bool(const std::string& key, Record& record)`; return false to stop.
+        template <class Sink>
+        void scan_rows_locked(
+                const LogQuery& log_query,
+                uint64_t session_id,
+                const std::string& from_key,
+                const std::string& to_key,
+                Sink sink) const {
+            m_record_rows->for_each_range(from_key, to_key,
+                [this, &log_query, session_id, &sink](const std::string& key, const std::string& value) -> bool {
+                    detail::MdbxByteReader in(value.data(), value.size());
+                    Record record;
+                    const bool has_message = read_record_header(in, record);
+                    if ((session_id != 0 && record.session_id != session_id) ||
+                        static_cast<int>(record.level) < static_cast<int>(log_query.min_level)) {
+                        return true;
+                    }
+                    const bool is_compact = record.version == RECORD_VERSION_COMPACT;
+                    if (!LogQuery::matches_text(is_compact ? lookup_string_locked(record.file_id) : record.file,
+                                                log_query.file, log_query.file_match) ||
+                        !LogQuery::matches_text(is_compact ? lookup_string_locked(record.function_id) : record.function,
+                                                log_query.function, log_query.function_match)) {
+                        return true;
+                    }
+                    if (has_message) {
+                        read_record_message(in, record);
+                    }
+                    if (!log_query.message_contains.empty() &&
+                        record.message.find(log_query.message_contains) == std::string::npos) {
+                        return true;
+                    }
+                    complete_record_locked(key, record);
+                    return sink(key, record);
+                });
+        }
+
+        void read_ascending_page_locked(
+                const LogQuery& log_query,
+                uint64_t session_id,
+                std::size_t page_size,
+                const std::string& token_key,
+                QueryPage& page) const {
+            const std::string from_key = token_key.empty()
+                ? detail::make_mdbx_record_key(log_query.from_ms, 0)
+                : token_key;
+            const std::string to_key = detail::make_mdbx_record_key(
+                log_query.to_ms - 1,
+                (std::numeric_limits<uint32_t>::max)());
+            std::string last_key;
+            scan_rows_locked(log_query, session_id, from_key, to_key,
+                [&page, &last_key, page_size](const std::string& key, Record& record) -> bool {
+                    page.records.push_back(to_log_record_snapshot(std::move(record)));
+                    last_key = key;
+                    return page.records.size() < page_size;
+                });
+            if (page.records.size() == page_size && detail::next_mdbx_record_key(last_key) && last_key <= to_key) {
+                page.next_token = encode_page_token(PAGE_TOKEN_ASCENDING, last_key);
+            }
+        }
+
+        /// \brief Reads the newest `page_size` matches at or before the token key.
+        /// \details The range cursor only walks forward, so time windows ending
+        /// at the token are scanned newest window first, doubling in length
+        /// until the page fills. Each window keeps only its newest matches that
+        /// still fit, so memory stays O(page).
+        void read_descending_page_locked(
+                const LogQuery& log_query,
+                uint64_t session_id,
+                std::size_t page_size,
+                const std::string& token_key,
+                QueryPage& page) const {
+            std::string window_to_key = token_key.empty()
+                ? detail::make_mdbx_record_key(log_query.to_ms - 1, (std::numeric_limits<uint32_t>::max)())
+                : token_key;
+            int64_t window_to_ms = 0;
+            uint32_t sequence = 0;
+            detail::parse_mdbx_record_key(window_to_key, window_to_ms, sequence);
+            if (window_to_ms < log_query.from_ms) {
+                return;
+            }
+
+            uint64_t window_ms = DESCENDING_WINDOW_MS;
+            std::deque<std::pair<std::string, Record>> window;
+            for (;;) {
+                // Unsigned distance: from_ms may be the smallest int64_t.
+                const uint64_t span = static_cast<uint64_t>(window_to_ms) - static_cast<uint64_t>(log_query.from_ms);
+                const bool is_last_window = span < window_ms;
+                const int64_t window_from_ms = is_last_window
+                    ? log_query.from_ms
+                    : static_cast<int64_t>(static_cast<uint64_t>(window_to_ms) - (window_ms - 1));
+
+                const std::size_t wanted = page_size - page.records.size();
+                bool is_truncated = false;
+                window.clear();
+                scan_rows_locked(log_query, session_id,
+                    detail::make_mdbx_record_key(window_from_ms, 0), window_to_key,
+                    [&window, &is_truncated, wanted](const std::string& key, Record& record) -> bool {
+                        window.emplace_back(key, std::move(record));
+                        if (window.size() > wanted) {
+                            window.pop_front();
+                            is_truncated = true;
+                        }
+                        return true;
+                    });
+                for (std::deque<std::pair<std::string, Record>>::reverse_iterator it = window.rbegin();
+                     it != window.rend(); ++it) {
+                    page.records.push_back(to_log_record_snapshot(std::move(it->second)));
+                }
+
+                if (page.records.size() == page_size) {
+                    std::string next_key = window.front().first;
+                    if ((!is_last_window || is_truncated) && detail::prev_mdbx_record_key(next_key)) {
+                        page.next_token = encode_page_token(PAGE_TOKEN_DESCENDING, next_key);
+                    }
+                    return;
+                }
+                if (is_last_window) {
+                    return;
+                }
+                window_to_ms = window_from_ms - 1;
+                window_to_key = detail::make_mdbx_record_key(window_to_ms, (std::numeric_limits<uint32_t>::max)());
+                if (window_ms <= (std::numeric_limits<uint64_t>::max)() / 2) {
+                    window_ms *= 2;
+                }
+            }
+        }
+
+        /// \brief Encodes the next key of a page as printable text.
+        static std::string encode_page_token(char order, const std::string& key) {
+            static const char digits[] = "0123456789abcdef";
+            std::string token(1, order);
+            for (size_t i = 0; i < key.size(); ++i) {
+                const unsigned char byte = static_cast<unsigned char>(key[i]);
+                token.push_back(digits[byte >> 4]);
+                token.push_back(digits[byte & 0x0Fu]);
+            }
+            return token;
+        }
+
+        /// \brief Decodes a page token made by encode_page_token() for the same order.
+        static bool decode_page_token(const std::string& token, LogReadOrder order, std::string& key) {
+            const char expected = order == LogReadOrder::Ascending ? PAGE_TOKEN_ASCENDING : PAGE_TOKEN_DESCENDING;
+            if (token.size() != 1 + 2 * detail::MDBX_RECORD_KEY_SIZE || token[0] != expected) {
+                return false;
+            }
+            key.clear();
+            for (size_t i = 1; i < token.size(); i += 2) {
+                const int high = hex_digit(token[i]);
+                const int low = hex_digit(token[i + 1]);
+                if (high < 0 || low < 0) {
+                    return false;
+                }
+                key.push_back(static_cast<char>((high << 4) | low));
+            }
+            return true;
+        }
+
+        static int hex_digit(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            return -1;
+        }
+
+        void ensure_storage_parent(const mdbxc::Config& db_config) const {
+            if (!db_config.read_only && db_config.no_subdir) {
+                mdbxc::create_directories(db_config.pathname);
+            }
+        }
+
+        void report_init_error(const std::string& message) const noexcept {
+            if (m_config.on_error) {
+                try {
+                    m_config.on_error(message);
+                } catch (...) {
+                }
+            }
+        }
+
+        uint64_t open_session() {
+            std::lock_guard<std::mutex> db_lock(m_db_mutex);
+            auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
+            const int64_t now_ms = LOGIT_CURRENT_TIMESTAMP_MS();
+            const uint64_t pid = detail::current_process_id();
+
+            if (m_config.session_id != 0) {
+                Session session;
+                if (find_session_locked(m_config.session_id, session, txn.handle())) {
+                    if (!m_config.app_name.empty()) {
+                        session.app_name = m_config.app_name;
+                    }
+                    if (session.start_time_ms == 0) {
+                        session.start_time_ms = now_ms;
+                    }
+                    session.end_time_ms = 0;
+                    session.process_id = pid;
+                    session.schema_version = m_config.record_schema_version;
+                } else {
+                    session.app_name = m_config.app_name;
+                    session.start_time_ms = now_ms;
+                    session.end_time_ms = 0;
+                    session.process_id = pid;
+                    session.schema_version = m_config.record_schema_version;
+                }
+                m_sessions->insert_or_assign(m_config.session_id, session, txn);
+                txn.commit();
+                return m_config.session_id;
+            }
+
+            for (int attempt = 0; attempt < 1024; ++attempt) {
+                const uint64_t candidate = make_unique_id();
+                Session session;
+                session.app_name = m_config.app_name;
+                session.start_time_ms = now_ms;
+                session.end_time_ms = 0;
+                session.process_id = pid;
+                session.schema_version = m_config.record_schema_version;
+                if (m_sessions->insert(candidate, session, txn)) {
+                    txn.commit();
+                    return candidate;
+                }
+            }
+
+            throw std::runtime_error("MdbxLogger: failed to allocate unique session id");
+        }
+
+        bool find_session_locked(uint64_t session_id, Session& out, MDBX_txn* txn) const {
+#if __cplusplus >= 201703L
+            auto value = m_sessions->find(session_id, txn);
+            if (!value) return false;
+            out = *value;
+            return true;
+#else
+            std::pair<bool, Session> value = m_sessions->find(session_id, txn);
+            if (!value.first) return false;
+            out = value.second;
+            return true;
+#endif
+        }
+
+        void update_session_end() {
+            std::lock_guard<std::mutex> db_lock(m_db_mutex);
+            auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
+            Session session;
+            if (!find_session_locked(m_session_id, session, txn.handle())) {
+                session.app_name = m_config.app_name;
+                session.start_time_ms = LOGIT_CURRENT_TIMESTAMP_MS();
+                session.process_id = detail::current_process_id();
+                session.schema_version = m_config.record_schema_version;
+            }
+            session.end_time_ms = LOGIT_CURRENT_TIMESTAMP_MS();
+            m_sessions->insert_or_assign(m_session_id, session, txn);
+            txn.commit();
+        }
+
+        void worker_loop() {
+            std::vector<MdbxLogItem> batch;
+            batch.reserve(m_config.max_batch_size);
+            while (true) {
+                batch.clear();
+                drain_ring(batch);
+
+                if (batch.empty()) {
+                    if (m_is_stopping.load(std::memory_order_seq_cst) &&
+                        m_active_producers.load(std::memory_order_seq_cst) == 0 &&
+                        is_queue_empty()) {
+                        break;
+                    }
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_is_worker_sleeping.store(true, std::memory_order_relaxed);
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                        m_cv.wait_for(
+                            lock,
+                            std::chrono::milliseconds(worker_wait_ms()),
+                            [this]() { return m_is_stopping.load(std::memory_order_acquire) || !is_queue_empty(); });
+                        m_is_worker_sleeping.store(false, std::memory_order_relaxed);
+                    }
+                    if (is_queue_empty() && !m_is_stopping.load(std::memory_order_acquire)) {
+                        maybe_enforce_retention();
+                        maybe_update_text_index(true);
+                    }
+                    continue;
+                }
+
+                // A small batch waits briefly for company while commits are cheap relative to the target.
+                if (m_linger_us > 0 && batch.size() < m_batch_limit &&
+                    !m_is_stopping.load(std::memory_order_acquire)) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(m_linger_us));
+                    drain_ring(batch);
+                }
+
+                const int64_t commit_start_us = monotonic_us();
+                write_batch(batch);
+                const int64_t commit_end_us = monotonic_us();
+                update_group_commit(batch, commit_start_us, commit_end_us);
+
+                maybe_enforce_retention();
+                maybe_update_text_index(false);
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_completed.fetch_add(batch.size(), std::memory_order_acq_rel);
+                }
+                m_written_cv.notify_all();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_is_worker_done = true;
+            }
+            m_written_cv.notify_all();
+            m_space_cv.notify_all();
+        }
+
+        /// \brief Moves queued items into `batch` up to the current batch limit.
+        /// \details The overflow queue is read only once the ring is empty;
+        /// producers append there while it is non-empty, so each producer's
+        /// records keep their order.
+        void drain_ring(std::vector<MdbxLogItem>& batch) {
+            const std::size_t initial_size = batch.size();
+            MdbxLogItem item;
+            while (batch.size() < m_batch_limit && m_ring.try_pop(item)) {
+                batch.push_back(std::move(item));
+            }
+            if (batch.size() < m_batch_limit && m_has_overflow.load(std::memory_order_acquire)) {
+                std::lock_guard<std::mutex> lock(m_overflow_mutex);
+                while (batch.size() < m_batch_limit && !m_overflow.empty()) {
+                    batch.push_back(std::move(m_overflow.front()));
+                    m_overflow.pop_front();
+                }
+                if (m_overflow.empty()) {
+                    m_has_overflow.store(false, std::memory_order_release);
+                }
+            }
+            if (batch.size() == initial_size) {
+                return;
+            }
+
+            // Pairs with the fence in push_bounded(): either the producer sees
+            // the freed slots on its retry, or this load sees it registered.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_blocked_producers.load(std::memory_order_seq_cst) > 0) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_space_epoch;
+                m_space_cv.notify_all();
+            }
+        }
+
+        /// \brief True when neither the ring nor the overflow queue holds records.
+        bool is_queue_empty() const {
+            return m_ring.empty() && !m_has_overflow.load(std::memory_order_acquire);
+        }
+
+        /// \brief Queues `item` when `max_queue_size` is 0; never drops or waits.
+        /// \details Records go to the ring until it fills, then to the locked
+        /// overflow queue until the worker has emptied it again.
+        void push_unbounded(MdbxLogItem& item) {
+            if (!m_has_overflow.load(std::memory_order_acquire) && m_ring.try_push(std::move(item))) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(m_overflow_mutex);
+            m_overflow.push_back(std::move(item));
+            m_has_overflow.store(true, std::memory_order_release);
+        }
+
+        /// \brief Queues `item` in the bounded ring, waiting for space when drops are disabled.
+        /// \return False when the record is dropped because the ring is full
+        /// and `drop_on_overflow` is set, or because the logger is stopping.
+        bool push_bounded(MdbxLogItem& item) {
+            while (!m_ring.try_push(std::move(item))) {
+                if (m_config.drop_on_overflow || m_is_stopping.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                std::unique_lock<std::mutex> lock(m_mutex);
+                const uint64_t epoch = m_space_epoch;
+                m_blocked_producers.fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                // Retried once registered, so a drain that ran before the
+                // registration cannot leave this producer waiting on a free ring.
+                const bool is_pushed = m_ring.try_push(std::move(item));
+                if (!is_pushed) {
+                    m_space_cv.wait(lock, [this, epoch]() {
+                        return m_space_epoch != epoch || m_is_stopping.load(std::memory_order_acquire);
+                    });
+                }
+                m_blocked_producers.fetch_sub(1, std::memory_order_seq_cst);
+                if (is_pushed) {
+                    return true;
+                }
+            }
+            return true;
+        }
+
+        /// \brief Feeds one committed batch to the group commit controller and the write statistics.
+        /// \details With `adaptive_batching` the limit doubles while records
+        /// are left in the ring after a drain, i.e. while commits are slower
+        /// than arrivals, and shrinks by a quarter when batches stay under a
+        /// quarter of it. Small batches linger for up to the average commit
+        /// time, so records arriving meanwhile share the transaction, but only
+        /// while the p99 log()-to-commit latency is below half of the target.
+        void update_group_commit(const std::vector<MdbxLogItem>& batch, int64_t commit_start_us, int64_t commit_end_us) {
+            const int64_t commit_us = commit_end_us - commit_start_us;
+            int64_t oldest_us = commit_end_us;
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                oldest_us = (std::min)(oldest_us, batch[i].enqueued_us);
+            }
+
+            if (m_latency_samples.size() < LATENCY_WINDOW) {
+                m_latency_samples.push_back(commit_end_us - oldest_us);
+            } else {
+                m_latency_samples[m_latency_next] = commit_end_us - oldest_us;
+                m_latency_next = (m_latency_next + 1) % LATENCY_WINDOW;
+            }
+            std::vector<int64_t> sorted(m_latency_samples);
+            const std::size_t p99_index = sorted.size() - 1 - sorted.size() / 100;
+            std::nth_element(sorted.begin(), sorted.begin() + p99_index, sorted.end());
+            const int64_t p99_us = sorted[p99_index];
+
+            m_commit_ewma_us = m_commit_ewma_us == 0.0
+                ? static_cast<double>(commit_us)
+                : m_commit_ewma_us * 0.875 + static_cast<double>(commit_us) * 0.125;
+
+            if (m_config.adaptive_batching) {
+                const int64_t target_us = static_cast<int64_t>(m_config.target_write_latency_ms) * 1000;
+                if (batch.size() >= m_batch_limit && !is_queue_empty()) {
+                    m_batch_limit = (std::min)(m_batch_limit * 2, m_config.max_batch_size);
+                } else if (batch.size() < m_batch_limit / 4) {
+                    m_batch_limit = (std::max)(m_batch_limit - m_batch_limit / 4, static_cast<std::size_t>(1));
+                }
+                if (p99_us < target_us / 2 && m_batch_limit > 1) {
+                    m_linger_us = (std::min)(static_cast<int64_t>(m_commit_ewma_us), target_us / 4);
+                } else {
+                    m_linger_us = 0;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(m_stats_mutex);
+            ++m_stats.transactions;
+            m_stats.records += batch.size();
+            m_stats.batch_limit = m_batch_limit;
+            m_stats.linger_us = m_linger_us;
+            m_stats.p99_write_latency_us = p99_us;
+            ++m_window_transactions;
+            m_window_records += batch.size();
+            const int64_t window_us = commit_end_us - m_stats_window_start_us;
+            if (window_us >= STATS_WINDOW_US || m_stats.transactions == m_window_transactions) {
+                // Until the first window closes the figures cover everything so far.
+                const double seconds = static_cast<double>((std::max)(window_us, static_cast<int64_t>(1))) / 1e6;
+                m_stats.transactions_per_second = static_cast<double>(m_window_transactions) / seconds;
+                m_stats.average_batch_size = static_cast<double>(m_window_records) / static_cast<double>(m_window_transactions);
+            }
+            if (window_us >= STATS_WINDOW_US) {
+                m_stats_window_start_us = commit_end_us;
+                m_window_transactions = 0;
+                m_window_records = 0;
+            }
+        }
+
+        static int64_t monotonic_us() {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        /// \brief Idle wait of the worker: the flush interval, cut short when a retention or text index step is due.
+        int64_t worker_wait_ms() const {
+            const int64_t flush_ms = m_config.flush_interval_ms;
+            if (m_has_text_index_work.load(std::memory_order_acquire) && (m_index_mask & INDEX_TEXT)) {
+                return 0;
+            }
+            if (!is_retention_enabled()) {
+                return flush_ms;
+            }
+            const int64_t due_ms = m_next_retention_mono_ms.load(std::memory_order_acquire) - LOGIT_MONOTONIC_MS();
+            return due_ms <= 0 ? 0 : (std::min)(due_ms, flush_ms);
+        }
+
+        bool is_retention_enabled() const {
+            const RetentionPolicy& policy = m_config.retention;
+            return policy.max_age_ms > 0 || policy.max_records > 0 || policy.max_db_bytes > 0 || policy.max_sessions > 0;
+        }
+
+        /// \brief Runs one retention step when it is due.
+        /// \details Called between write batches, so a step delays the next
+        /// batch by at most one `retention.batch_size` delete transaction.
+        void maybe_enforce_retention() {
+            if (!is_retention_enabled()) {
+                return;
+            }
+            const int64_t now = LOGIT_MONOTONIC_MS();
+            if (now < m_next_retention_mono_ms.load(std::memory_order_acquire)) {
+                return;
+            }
+            std::size_t deleted = 0;
+            const bool has_backlog = try_retention_step(deleted);
+            m_next_retention_mono_ms.store(
+                has_backlog ? now : now + m_config.retention.interval_ms,
+                std::memory_order_release);
+        }
+
+        /// \brief Runs one retention step and reports failures through `on_error`.
+        /// \return True when limits are still exceeded; false after an error.
+        bool try_retention_step(std::size_t& deleted) {
+            try {
+                return run_retention_step(deleted);
+            } catch (const std::exception& e) {
+                if (m_config.on_error) {
+                    m_config.on_error(std::string("MdbxLogger retention error: ") + e.what());
+                }
+            } catch (...) {
+                if (m_config.on_error) {
+                    m_config.on_error("MdbxLogger retention error");
+                }
+            }
+            return false;
+        }
+
+        /// \brief Deletes up to `retention.batch_size` of the oldest records that exceed a limit.
+        /// \details Walks the time-ordered key space from the oldest end and
+        /// stops at the first record every limit allows, so a step never scans
+        /// past the records it deletes. Records go together with their payload
+        /// and index entries, and ended sessions whose records are all gone
+        /// lose their metadata row. The walk runs before the write transaction
+        /// opens, so no read cursor is open while writing. When neither the
+        /// oldest record nor any session row is due, the step returns after
+        /// the reads and never takes MDBX's writer lock.
+        /// \param[in,out] deleted Incremented by the number of deleted records.
+        /// \return True when limits are still exceeded.
+        bool run_retention_step(std::size_t& deleted) {
+            const RetentionPolicy& policy = m_config.retention;
+            std::lock_guard<std::mutex> db_lock(m_db_mutex);
+            refresh_dictionary_locked();
+            m_pending_level_rollups.clear();
+            m_pending_file_rollups.clear();
+
+            // for_each_range reads in its own transaction, and MDBX allows one
+            // transaction per thread, so rows are collected before the write
+            // transaction starts. One extra row tells whether the batch
+            // reaches the newest record.
+            std::vector<RetentionCandidate> candidates;
+            m_record_rows->for_each_range(
+                detail::make_mdbx_record_key((std::numeric_limits<int64_t>::min)(), 0),
+                detail::make_mdbx_record_key((std::numeric_limits<int64_t>::max)(), (std::numeric_limits<uint32_t>::max)()),
+                [this, &candidates, &policy](const std::string& key, const std::string& value) -> bool {
+                    candidates.emplace_back();
+                    RetentionCandidate& candidate = candidates.back();
+                    candidate.key = key;
+                    candidate.bytes = key.size() + value.size();
+                    try {
+                        candidate.record = Record::from_bytes(value.data(), value.size());
+                        candidate.is_decoded = true;
+                    } catch (...) {
+                    }
+                    complete_record_locked(key, candidate.record);
+                    return candidates.size() <= policy.batch_size;
+                });
+
+            std::vector<std::pair<uint64_t, Session>> sessions;
+            try {
+                m_sessions->for_each_range(0, (std::numeric_limits<uint64_t>::max)(),
+                    [&sessions](const uint64_t& session_id, const Session& session) -> bool {
+                        sessions.emplace_back(session_id, session);
+                        return true;
+                    });
+            } catch (...) {
+                // Undecodable session rows only disable the session limit and cleanup.
+                sessions.clear();
+            }
+            std::unordered_map<uint64_t, bool> retired_sessions;
+            if (policy.max_sessions > 0 && sessions.size() > policy.max_sessions) {
+                // Newest first; this logger's session always counts as one of the kept ones.
+                std::vector<std::pair<uint64_t, Session>> by_age = sessions;
+                const uint64_t current_id = m_session_id;
+                std::sort(by_age.begin(), by_age.end(),
+                    [current_id](const std::pair<uint64_t, Session>& a, const std::pair<uint64_t, Session>& b) {
+                        if ((a.first == current_id) != (b.first == current_id)) {
+                            return a.first == current_id;
+                        }
+                        return a.second.start_time_ms > b.second.start_time_ms;
+                    });
+                for (size_t i = policy.max_sessions; i < by_age.size(); ++i) {
+                    retired_sessions[by_age[i].first] = true;
+                }
+            }
+
+            const int64_t now_ms = LOGIT_CURRENT_TIMESTAMP_MS();
+            uint64_t excess_records = 0;
+            uint64_t excess_bytes = 0;
+            const auto is_expired = [&](const RetentionCandidate& candidate) -> bool {
+                return (policy.max_age_ms > 0 && candidate.record.timestamp_ms < now_ms - policy.max_age_ms) ||
+                       excess_records > 0 ||
+                       excess_bytes > 0 ||
+                       (candidate.is_decoded && retired_sessions.count(candidate.record.session_id) != 0);
+            };
+            // Records of a session lie within [start, end], so an ended session
+            // older than every remaining record has nothing left.
+            const auto is_session_removable = [&](std::size_t index, int64_t oldest_remaining_ms, bool has_backlog) -> bool {
+                const uint64_t session_id = sessions[index].first;
+                const Session& session = sessions[index].second;
+                if (session_id == m_session_id) {
+                    return false;
+                }
+                const bool is_empty = session.end_time_ms != 0 && session.end_time_ms < oldest_remaining_ms;
+                const bool is_retired = !has_backlog && retired_sessions.count(session_id) != 0;
+                return is_empty || is_retired;
+            };
+
+            // Most steps find nothing to delete; deciding that in a read
+            // transaction keeps them off the single MDBX writer.
+            {
+                auto read_txn = m_connection->transaction(mdbxc::TransactionMode::READ_ONLY);
+                measure_retention_excess_locked(read_txn, excess_records, excess_bytes);
+            }
+            bool has_work = !candidates.empty() && policy.batch_size > 0 && is_expired(candidates[0]);
+            if (!has_work) {
+                const int64_t oldest_ms = candidates.empty()
+                    ? (std::numeric_limits<int64_t>::max)()
+                    : candidates[0].record.timestamp_ms;
+                for (size_t i = 0; i < sessions.size() && !has_work; ++i) {
+                    has_work = is_session_removable(i, oldest_ms, false);
+                }
+            }
+            if (!has_work) {
+                m_retention_behind_since_mono_ms.store(0, std::memory_order_release);
+                return false;
+            }
+
+            auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
+            measure_retention_excess_locked(txn, excess_records, excess_bytes);
+
+            const std::size_t limit = (std::min)(candidates.size(), policy.batch_size);
+            std::size_t removed = 0;
+            uint64_t removed_payloads = 0;
+            for (; removed < limit; ++removed) {
+                RetentionCandidate& candidate = candidates[removed];
+                if (!is_expired(candidate)) {
+                    break;
+                }
+
+                std::size_t freed = candidate.bytes;
+                // A row another process deleted since the read keeps its index and rollup entries as they are.
+                const bool is_erased = m_records->erase(candidate.key, txn);
+                if (is_erased && candidate.is_decoded) {
+                    std::size_t payload_bytes = 0;
+                    if (candidate.record.payload_id != 0) {
+                        payload_bytes = payload_size_locked(candidate.record.payload_id, txn);
+                        freed += payload_bytes;
+                        if (m_payloads->erase(candidate.record.payload_id, txn)) {
+                            ++removed_payloads;
+                        }
+                    }
+                    remove_index_entries_locked(candidate.key, candidate.record, payload_bytes, txn);
+                }
+                if (excess_records > 0) {
+                    --excess_records;
+                }
+                excess_bytes = excess_bytes > freed ? excess_bytes - freed : 0;
+            }
+
+            flush_rollups_locked(txn);
+            if (removed > 0 && (m_index_mask & INDEX_TEXT)) {
+                // Lets the text indexer drop posting batches of deleted records.
+                m_has_text_index_work.store(true, std::memory_order_release);
             }
-            p.compression = static_cast<MdbxPayloadCompression>(compression);
-            p.data = in.read_string();
-            in.finish();
-            return p;
+
+            const bool has_backlog = removed == limit && candidates.size() > policy.batch_size;
+            int64_t oldest_remaining_ms = (std::numeric_limits<int64_t>::max)();
+            if (removed < candidates.size()) {
+                oldest_remaining_ms = candidates[removed].record.timestamp_ms;
+            }
+            for (size_t i = 0; i < sessions.size(); ++i) {
+                if (is_session_removable(i, oldest_remaining_ms, has_backlog)) {
+                    m_sessions->erase(sessions[i].first, txn);
+                }
+            }
+            txn.commit();
+
+            deleted += removed;
+            m_retention_deleted_records.fetch_add(removed, std::memory_order_acq_rel);
+            m_retention_deleted_payloads.fetch_add(removed_payloads, std::memory_order_acq_rel);
+            if (!has_backlog) {
+                m_retention_behind_since_mono_ms.store(0, std::memory_order_release);
+            } else if (m_retention_behind_since_mono_ms.load(std::memory_order_acquire) == 0) {
+                m_retention_behind_since_mono_ms.store(LOGIT_MONOTONIC_MS(), std::memory_order_release);
+            }
+            return has_backlog;
         }
 
-        void normalize_config() {
-            if (m_config.max_batch_size == 0) {
-                m_config.max_batch_size = 1;
+        /// \brief Reads how far the record count and storage size exceed the retention limits.
+        /// \param txn Read or write transaction.
+        /// \param[out] excess_records Records above `max_records` (0 when within or disabled).
+        /// \param[out] excess_bytes Bytes above `max_db_bytes` (0 when within or disabled).
+        void measure_retention_excess_locked(mdbxc::Transaction& txn, uint64_t& excess_records, uint64_t& excess_bytes) const {
+            const RetentionPolicy& policy = m_config.retention;
+            excess_records = 0;
+            if (policy.max_records > 0) {
+                const uint64_t stored = static_cast<uint64_t>(m_records->count(txn));
+                excess_records = stored > policy.max_records ? stored - policy.max_records : 0;
             }
-            if (m_config.flush_interval_ms <= 0) {
-                m_config.flush_interval_ms = 1;
+            excess_bytes = 0;
+            if (policy.max_db_bytes > 0) {
+                const uint64_t used = used_bytes(txn);
+                excess_bytes = used > policy.max_db_bytes ? used - policy.max_db_bytes : 0;
             }
         }
 
-        void validate_compression_config() const {
-            if (m_config.payload_compression == MdbxPayloadCompression::Gzip) {
-#if !defined(LOGIT_HAS_ZLIB)
-                throw std::runtime_error("MdbxLogger: gzip payload compression requested but LOGIT_WITH_GZIP is not enabled");
-#endif
+        /// \brief Bytes of table pages in use, excluding MDBX's free list.
+        static uint64_t used_bytes(mdbxc::Transaction& txn) {
+            MDBX_stat stat;
+            const int rc = mdbx_env_stat_ex(mdbx_txn_env(txn.handle()), txn.handle(), &stat, sizeof(stat));
+            if (rc != MDBX_SUCCESS) {
+                throw std::runtime_error(std::string("MdbxLogger: failed to read storage statistics: ") + mdbx_strerror(rc));
             }
-            if (m_config.payload_compression == MdbxPayloadCompression::Zstd) {
-#if !defined(LOGIT_HAS_ZSTD)
-                throw std::runtime_error("MdbxLogger: zstd payload compression requested but LOGIT_WITH_ZSTD is not enabled");
+            return (static_cast<uint64_t>(stat.ms_branch_pages) +
+                    static_cast<uint64_t>(stat.ms_leaf_pages) +
+                    static_cast<uint64_t>(stat.ms_overflow_pages)) * stat.ms_psize;
+        }
+
+        std::size_t payload_size_locked(uint64_t payload_id, mdbxc::Transaction& txn) const {
+            try {
+#if __cplusplus >= 201703L
+                auto payload = m_payloads->find(payload_id, txn.handle());
+                return payload ? payload->data.size() : 0;
+#else
+                std::pair<bool, Payload> payload = m_payloads->find(payload_id, txn.handle());
+                return payload.first ? payload.second.data.size() : 0;
 #endif
+            } catch (...) {
+                return 0;
             }
         }
 
-        void open_storage() {
-            mdbxc::Config db_config;
-            db_config.pathname = m_config.path;
-            db_config.max_dbs = 4;
-            db_config.no_subdir = true;
-            db_config.sync_durable = true;
+        /// \brief Removes the index entries of a deleted record in the caller's transaction.
+        /// \details Rollup decrements are pending until flush_rollups_locked().
+        /// Undecodable rows leave their counts in place.
+        void remove_index_entries_locked(
+                const std::string& key,
+                const Record& record,
+                std::size_t payload_bytes,
+                mdbxc::Transaction& txn) {
+            if (m_index_mask & INDEX_LEVEL) {
+                m_level_index->erase(detail::make_mdbx_level_index_key(static_cast<uint8_t>(record.level), key), txn);
+            }
+            // An unresolved file id leaves a stale entry; index readers skip missing records.
+            if ((m_index_mask & INDEX_FILE) && (record.version != RECORD_VERSION_COMPACT || record.file_id == 0 ||
+                                                 m_strings_by_id.count(record.file_id) != 0)) {
+                m_file_index->erase(
+                    detail::make_mdbx_u64_index_key(detail::mdbx_file_index_hash(record.file), key), txn);
+            }
+            if (m_index_mask & INDEX_SESSION) {
+                m_session_index->erase(detail::make_mdbx_u64_index_key(record.session_id, key), txn);
+            }
+            if (m_index_mask & INDEX_ROLLUPS) {
+                uint32_t mask = m_index_mask & INDEX_ROLLUP_LEVEL;
+                if (record.version != RECORD_VERSION_COMPACT || record.file_id == 0 ||
+                    m_strings_by_id.count(record.file_id) != 0) {
+                    mask |= m_index_mask & INDEX_ROLLUP_FILE;
+                }
+                add_rollup_delta_locked(mask, record, -1, -static_cast<int64_t>(record.message.size() + payload_bytes));
+            }
+            // Posting lists are trimmed by the text indexer once whole batches are older than every record.
+            if (m_index_mask & INDEX_TEXT) {
+                m_text_pending->erase(key, txn);
+            }
+        }
 
-            ensure_storage_parent(db_config);
-            m_connection = mdbxc::Connection::create(db_config);
-            m_sessions.reset(new SessionTable(m_connection, "log_sessions"));
-            m_records.reset(new RecordTable(m_connection, "log_records_by_time"));
-            m_payloads.reset(new PayloadTable(m_connection, "log_payloads"));
+        /// \brief Runs one text index step when a full batch is pending or stale batches may exist.
+        /// \details Smaller backlogs wait for the worker to go idle, so posting
+        /// rows cover whole batches rather than single writes. Synchronous
+        /// loggers have no idle worker; their remainder waits for the next
+        /// full batch or update_text_index().
+        /// \param is_idle True when called from the idle worker.
+        void maybe_update_text_index(bool is_idle) {
+            if (!(m_index_mask & INDEX_TEXT)) {
+                return;
+            }
+            const std::size_t written = m_text_written_since_step.load(std::memory_order_acquire);
+            if (!m_has_text_index_work.load(std::memory_order_acquire) &&
+                written < m_config.text_index_batch_size &&
+                !(is_idle && written > 0)) {
+                return;
+            }
+            std::size_t indexed = 0;
+            try_text_index_step(indexed);
         }
 
-        void ensure_storage_parent(const mdbxc::Config& db_config) const {
-            if (!db_config.read_only && db_config.no_subdir) {
-                mdbxc::create_directories(db_config.pathname);
+        /// \brief Runs one text index step and reports failures through `on_error`.
+        /// \return True when more work is pending; false after an error.
+        bool try_text_index_step(std::size_t& indexed) {
+            try {
+                return run_text_index_step(indexed);
+            } catch (const std::exception& e) {
+                m_has_text_index_work.store(false, std::memory_order_release);
+                if (m_config.on_error) {
+                    m_config.on_error(std::string("MdbxLogger text index error: ") + e.what());
+                }
+            } catch (...) {
+                m_has_text_index_work.store(false, std::memory_order_release);
+                if (m_config.on_error) {
+                    m_config.on_error("MdbxLogger text index error");
+                }
             }
+            return false;
         }
 
-        void report_init_error(const std::string& message) const noexcept {
-            if (m_config.on_error) {
+        /// \brief Indexes up to `text_index_batch_size` pending records and drops stale batches.
+        /// \details Pending keys are taken in key order and their texts, with
+        /// spilled payloads decompressed, are read before the write
+        /// transaction opens. The batch becomes one posting row per distinct
+        /// trigram, keyed by trigram and the batch's newest and oldest record
+        /// keys, holding varint deltas of the record keys. Its trigram list is
+        /// kept in `log_text_batches`, so once retention has deleted every
+        /// record of a batch its posting rows are found without a table scan.
+        /// \param[in,out] indexed Incremented by the number of pending records processed.
+        /// \return True when more work is pending.
+        bool run_text_index_step(std::size_t& indexed) {
+            std::lock_guard<std::mutex> db_lock(m_db_mutex);
+            const std::size_t batch_size = m_config.text_index_batch_size;
+            const std::string first_key = detail::make_mdbx_record_key((std::numeric_limits<int64_t>::min)(), 0);
+            const std::string last_key = detail::make_mdbx_record_key(
+                (std::numeric_limits<int64_t>::max)(),
+                (std::numeric_limits<uint32_t>::max)());
+
+            // One extra key tells whether more records are pending.
+            std::vector<std::string> keys;
+            m_text_pending->for_each_range(first_key, last_key,
+                [&keys, batch_size](const std::string& key, const std::string&) -> bool {
+                    keys.push_back(key);
+                    return keys.size() <= batch_size;
+                });
+            const bool has_more_pending = keys.size() > batch_size;
+            if (has_more_pending) {
+                keys.pop_back();
+            }
+
+            std::vector<std::string> batch_keys;
+            std::map<uint32_t, std::vector<uint32_t>> postings; ///< Trigram -> indexes into batch_keys.
+            std::vector<uint32_t> trigrams;
+            std::string text;
+            for (size_t i = 0; i < keys.size(); ++i) {
+                Record record;
                 try {
-                    m_config.on_error(message);
+                    if (!find_record_locked(keys[i], record)) continue;
                 } catch (...) {
+                    continue;
+                }
+                if (record.payload_id == 0 || !payload_text_locked(record.payload_id, text)) {
+                    text.swap(record.message);
+                }
+                collect_trigrams(text, trigrams);
+                if (trigrams.empty()) continue;
+                const uint32_t index = static_cast<uint32_t>(batch_keys.size());
+                batch_keys.push_back(keys[i]);
+                for (size_t j = 0; j < trigrams.size(); ++j) {
+                    postings[trigrams[j]].push_back(index);
                 }
             }
-        }
 
-        uint64_t open_session() {
-            std::lock_guard<std::mutex> db_lock(m_db_mutex);
-            auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
-            const int64_t now_ms = LOGIT_CURRENT_TIMESTAMP_MS();
-            const uint64_t pid = detail::current_process_id();
+            // A batch is stale when its newest record is older than every stored record.
+            std::string oldest_key;
+            m_record_rows->for_each_range(first_key, last_key,
+                [&oldest_key](const std::string& key, const std::string&) -> bool {
+                    oldest_key = key;
+                    return false;
+                });
+            std::vector<std::pair<std::string, std::string>> stale;
+            std::string stale_to_key = oldest_key;
+            if (oldest_key.empty() || detail::prev_mdbx_record_key(stale_to_key)) {
+                if (oldest_key.empty()) {
+                    stale_to_key = last_key;
+                }
+                stale_to_key += last_key;
+                m_text_batches->for_each_range(first_key + first_key, stale_to_key,
+                    [&stale](const std::string& key, const std::string& value) -> bool {
+                        stale.emplace_back(key, value);
+                        return stale.size() <= TEXT_TRIM_BATCHES;
+                    });
+            }
+            const bool has_more_stale = stale.size() > TEXT_TRIM_BATCHES;
+            if (has_more_stale) {
+                stale.pop_back();
+            }
 
-            if (m_config.session_id != 0) {
-                Session session;
-                if (find_session_locked(m_config.session_id, session, txn.handle())) {
-                    if (!m_config.app_name.empty()) {
-                        session.app_name = m_config.app_name;
+            if (!keys.empty() || !stale.empty()) {
+                auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
+                if (!batch_keys.empty()) {
+                    const std::string batch_key = batch_keys.back() + batch_keys.front();
+                    std::string batch_trigrams;
+                    batch_trigrams.reserve(postings.size() * detail::MDBX_TEXT_TRIGRAM_SIZE);
+                    for (std::map<uint32_t, std::vector<uint32_t>>::const_iterator it = postings.begin();
+                         it != postings.end(); ++it) {
+                        const std::string posting_key = detail::make_mdbx_text_posting_key(it->first, batch_key);
+                        m_text_postings->insert_or_assign(
+                            posting_key, encode_text_postings(batch_keys, it->second), txn);
+                        batch_trigrams.append(posting_key, 0, detail::MDBX_TEXT_TRIGRAM_SIZE);
                     }
-                    if (session.start_time_ms == 0) {
-                        session.start_time_ms = now_ms;
+                    m_text_batches->insert_or_assign(batch_key, batch_trigrams, txn);
+                }
+                for (size_t i = 0; i < keys.size(); ++i) {
+                    m_text_pending->erase(keys[i], txn);
+                }
+                for (size_t i = 0; i < stale.size(); ++i) {
+                    const std::string& batch_trigrams = stale[i].second;
+                    for (size_t j = 0; j + detail::MDBX_TEXT_TRIGRAM_SIZE <= batch_trigrams.size();
+                         j += detail::MDBX_TEXT_TRIGRAM_SIZE) {
+                        m_text_postings->erase(batch_trigrams.substr(j, detail::MDBX_TEXT_TRIGRAM_SIZE) + stale[i].first, txn);
                     }
-                    session.end_time_ms = 0;
-                    session.process_id = pid;
-                    session.schema_version = 1;
-                } else {
-                    session.app_name = m_config.app_name;
-                    session.start_time_ms = now_ms;
-                    session.end_time_ms = 0;
-                    session.process_id = pid;
-                    session.schema_version = 1;
+                    m_text_batches->erase(stale[i].first, txn);
                 }
-                m_sessions->insert_or_assign(m_config.session_id, session, txn);
                 txn.commit();
-                return m_config.session_id;
             }
 
-            for (int attempt = 0; attempt < 1024; ++attempt) {
-                const uint64_t candidate = make_unique_id();
-                Session session;
-                session.app_name = m_config.app_name;
-                session.start_time_ms = now_ms;
-                session.end_time_ms = 0;
-                session.process_id = pid;
-                session.schema_version = 1;
-                if (m_sessions->insert(candidate, session, txn)) {
-                    txn.commit();
-                    return candidate;
+            indexed += keys.size();
+            const bool has_more = has_more_pending || has_more_stale;
+            m_has_text_index_work.store(has_more, std::memory_order_release);
+            m_text_written_since_step.store(0, std::memory_order_release);
+            return has_more;
+        }
+
+        /// \brief Collects the sorted record keys in `[from_key, to_key]` that may contain `text`.
+        /// \details Intersects the posting lists of the distinct trigrams of
+        /// `text` and adds the keys still waiting for the indexer.
+        void collect_text_candidates_locked(
+                const std::string& text,
+                const std::string& from_key,
+                const std::string& to_key,
+                std::vector<std::string>& keys) const {
+            std::vector<uint32_t> trigrams;
+            collect_trigrams(text, trigrams);
+            const std::string max_batch_key = std::string(2 * detail::MDBX_RECORD_KEY_SIZE, static_cast<char>(0xFF));
+            std::vector<std::string> list;
+            std::vector<std::string> common;
+            for (size_t i = 0; i < trigrams.size(); ++i) {
+                // Rows are ordered by their newest key; those ending before `from_key` are skipped.
+                list.clear();
+                m_text_postings->for_each_range(
+                    detail::make_mdbx_text_posting_key(trigrams[i], from_key + std::string(detail::MDBX_RECORD_KEY_SIZE, '\0')),
+                    detail::make_mdbx_text_posting_key(trigrams[i], max_batch_key),
+                    [&list, &from_key, &to_key](const std::string& key, const std::string& value) -> bool {
+                        if (key.compare(detail::MDBX_TEXT_TRIGRAM_SIZE + detail::MDBX_RECORD_KEY_SIZE,
+                                        detail::MDBX_RECORD_KEY_SIZE, to_key) <= 0) {
+                            decode_text_postings(value, from_key, to_key, list);
+                        }
+                        return true;
+                    });
+                std::sort(list.begin(), list.end());
+                list.erase(std::unique(list.begin(), list.end()), list.end());
+                if (i == 0) {
+                    common.swap(list);
+                } else {
+                    std::vector<std::string> both;
+                    std::set_intersection(common.begin(), common.end(), list.begin(), list.end(),
+                                          std::back_inserter(both));
+                    common.swap(both);
+                }
+                if (common.empty()) {
+                    break;
                 }
             }
 
-            throw std::runtime_error("MdbxLogger: failed to allocate unique session id");
+            keys.swap(common);
+            const std::size_t indexed_count = keys.size();
+            m_text_pending->for_each_range(from_key, to_key,
+                [&keys](const std::string& key, const std::string&) -> bool {
+                    keys.push_back(key);
+                    return true;
+                });
+            if (keys.size() != indexed_count) {
+                std::sort(keys.begin(), keys.end());
+                keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+            }
         }
 
-        bool find_session_locked(uint64_t session_id, Session& out, MDBX_txn* txn) const {
-#if __cplusplus >= 201703L
-            auto value = m_sessions->find(session_id, txn);
-            if (!value) return false;
-            out = *value;
-            return true;
-#else
-            std::pair<bool, Session> value = m_sessions->find(session_id, txn);
-            if (!value.first) return false;
-            out = value.second;
-            return true;
-#endif
+        /// \brief Sorted distinct trigrams of `text`, each packed into the low 24 bits.
+        static void collect_trigrams(const std::string& text, std::vector<uint32_t>& trigrams) {
+            trigrams.clear();
+            if (text.size() < detail::MDBX_TEXT_TRIGRAM_SIZE) {
+                return;
+            }
+            trigrams.reserve(text.size() - 2);
+            for (size_t i = 0; i + 2 < text.size(); ++i) {
+                trigrams.push_back(
+                    (static_cast<uint32_t>(static_cast<unsigned char>(text[i])) << 16) |
+                    (static_cast<uint32_t>(static_cast<unsigned char>(text[i + 1])) << 8) |
+                    static_cast<uint32_t>(static_cast<unsigned char>(text[i + 2])));
+            }
+            std::sort(trigrams.begin(), trigrams.end());
+            trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
         }
 
-        void update_session_end() {
-            std::lock_guard<std::mutex> db_lock(m_db_mutex);
-            auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
-            Session session;
-            if (!find_session_locked(m_session_id, session, txn.handle())) {
-                session.app_name = m_config.app_name;
-                session.start_time_ms = LOGIT_CURRENT_TIMESTAMP_MS();
-                session.process_id = detail::current_process_id();
-                session.schema_version = 1;
+        /// \brief Posting row: key count, then per key the varint timestamp delta and sequence.
+        static std::string encode_text_postings(const std::vector<std::string>& keys, const std::vector<uint32_t>& indexes) {
+            detail::MdbxByteWriter out;
+            out.write_varint(indexes.size());
+            uint64_t previous_ts = 0;
+            for (size_t i = 0; i < indexes.size(); ++i) {
+                int64_t timestamp_ms = 0;
+                uint32_t sequence = 0;
+                detail::parse_mdbx_record_key(keys[indexes[i]], timestamp_ms, sequence);
+                const uint64_t sortable_ts = detail::mdbx_sortable_timestamp(timestamp_ms);
+                out.write_varint(sortable_ts - previous_ts);
+                out.write_varint(sequence);
+                previous_ts = sortable_ts;
             }
-            session.end_time_ms = LOGIT_CURRENT_TIMESTAMP_MS();
-            m_sessions->insert_or_assign(m_session_id, session, txn);
-            txn.commit();
+            return std::string(out.bytes().begin(), out.bytes().end());
         }
 
-        void worker_loop() {
-            while (true) {
-                std::vector<MdbxLogItem> batch;
-                batch.reserve(m_config.max_batch_size);
-
-                {
-                    std::unique_lock<std::mutex> lock(m_mutex);
-                    m_cv.wait_for(
-                        lock,
-                        std::chrono::milliseconds(m_config.flush_interval_ms),
-                        [this]() { return m_stopping || !m_queue.empty(); });
-
-                    if (m_stopping && m_queue.empty()) {
-                        m_idle = true;
-                        m_cv.notify_all();
-                        return;
-                    }
-
-                    if (m_queue.empty()) {
-                        continue;
-                    }
-
-                    m_idle = false;
-                    while (!m_queue.empty() && batch.size() < m_config.max_batch_size) {
-                        batch.push_back(std::move(m_queue.front()));
-                        m_queue.pop_front();
-                    }
-                    m_space_cv.notify_all();
+        /// \brief Appends the record keys of a posting row that lie in `[from_key, to_key]`.
+        static void decode_text_postings(
+                const std::string& value,
+                const std::string& from_key,
+                const std::string& to_key,
+                std::vector<std::string>& keys) {
+            detail::MdbxByteReader in(value.data(), value.size());
+            const uint64_t count = in.read_varint();
+            uint64_t sortable_ts = 0;
+            for (uint64_t i = 0; i < count; ++i) {
+                sortable_ts += in.read_varint();
+                const uint64_t sequence = in.read_varint();
+                const std::string key = detail::make_mdbx_record_key(
+                    static_cast<int64_t>(sortable_ts ^ detail::mdbx_sortable_timestamp(0)),
+                    static_cast<uint32_t>(sequence));
+                if (key > to_key) {
+                    return;
                 }
-
-                write_batch(batch);
-
-                {
-                    std::lock_guard<std::mutex> lock(m_mutex);
-                    m_idle = true;
+                if (key >= from_key) {
+                    keys.push_back(key);
                 }
-                m_cv.notify_all();
             }
         }
 
+        /// \brief Reads and decompresses a payload in the caller's lock.
+        bool payload_text_locked(uint64_t payload_id, std::string& text) const {
+            Payload payload;
+            try {
+#if __cplusplus >= 201703L
+                auto value = m_payloads->find(payload_id);
+                if (!value) return false;
+                payload = std::move(*value);
+#else
+                std::pair<bool, Payload> value = m_payloads->find(payload_id);
+                if (!value.first) return false;
+                payload = std::move(value.second);
+#endif
+            } catch (...) {
+                return false;
+            }
+            switch (payload.compression) {
+            case MdbxPayloadCompression::None:
+                text.swap(payload.data);
+                return true;
+            case MdbxPayloadCompression::Gzip:
+                return detail::decompress_string_gzip(payload.data, text);
+            case MdbxPayloadCompression::Zstd:
+                return detail::decompress_string_zstd(payload.data, text);
+            case MdbxPayloadCompression::ZstdDictionary:
+                return decompress_with_dictionary_locked(payload.dictionary_id, payload.data, text);
+            }
+            return false;
+        }
+
         void write_batch(const std::vector<MdbxLogItem>& batch) {
             if (batch.empty()) {
                 return;
             }
 
+            // Snapshots are only built when someone is subscribed.
+            const bool has_subscribers = !m_subscribers.empty();
             std::vector<LogRecordSnapshot> written_snapshots;
+            uint64_t last_committed_string_id = 0;
             try {
                 std::lock_guard<std::mutex> db_lock(m_db_mutex);
+                last_committed_string_id = m_last_string_id;
+                m_pending_intern_ids.clear();
+                m_pending_level_rollups.clear();
+                m_pending_file_rollups.clear();
                 auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
+                if (has_subscribers) {
+                    written_snapshots.reserve(batch.size());
+                }
                 for (size_t i = 0; i < batch.size(); ++i) {
                     Record record = write_item_locked(batch[i], txn);
-                    written_snapshots.push_back(to_log_record_snapshot(record));
+                    if (has_subscribers) {
+                        written_snapshots.push_back(to_log_record_snapshot(record));
+                    }
                 }
+                flush_rollups_locked(txn);
                 txn.commit();
+                if (m_index_mask & INDEX_TEXT) {
+                    m_text_written_since_step.fetch_add(batch.size(), std::memory_order_acq_rel);
+                }
             } catch (const std::exception& e) {
+                rollback_dictionary(last_committed_string_id);
                 m_failed_writes.fetch_add(1, std::memory_order_acq_rel);
                 if (m_config.on_error) {
                     m_config.on_error(std::string("MdbxLogger write error: ") + e.what());
                 }
                 return;
             } catch (...) {
+                rollback_dictionary(last_committed_string_id);
                 m_failed_writes.fetch_add(1, std::memory_order_acq_rel);
                 if (m_config.on_error) {
                     m_config.on_error("MdbxLogger write error");
@@ -969,34 +3401,43 @@ namespace logit {
                 return;
             }
 
-            notify_callbacks(written_snapshots);
+            m_subscribers.publish(written_snapshots);
         }
 
         Record write_item_locked(const MdbxLogItem& item, mdbxc::Transaction& txn) {
+            std::size_t payload_bytes = 0;
             Record record;
+            record.version = m_config.record_schema_version;
             record.session_id = m_session_id;
             record.timestamp_ms = item.timestamp_ms;
             record.level = item.level;
-            record.file = item.file;
-            record.function = item.function;
+            record.file = item.file.str();
+            record.function = item.function.str();
+            if (record.version == RECORD_VERSION_COMPACT) {
+                record.file_id = string_id_locked(item.file, txn);
+                record.function_id = string_id_locked(item.function, txn);
+            }
             record.line = item.line;
             record.message = item.message;
 
             if (should_spill_payload(item.message)) {
                 Payload payload;
-                payload.payload_id = allocate_payload_id_locked(txn);
                 fill_payload(item.message, payload);
-                m_payloads->insert(payload.payload_id, payload, txn);
+                do {
+                    payload.payload_id = allocate_payload_id_locked();
+                } while (!m_payloads->insert(payload.payload_id, payload, txn));
                 record.payload_id = payload.payload_id;
                 record.message = make_payload_preview(item.message);
+                payload_bytes = payload.data.size();
             }
 
-            for (;;) {
-                const std::string key = next_record_key_locked(record.timestamp_ms, record.sequence, txn);
-                if (m_records->insert(key, record, txn)) {
-                    break;
-                }
-                advance_sequence_after_collision(record.timestamp_ms, record.sequence);
+            // Retries only when another writer shares the database file.
+            std::string key;
+            do {
+                key = next_record_key_locked(record.timestamp_ms, record.sequence, txn);
+            } while (!m_records->insert(key, record, txn));
+            if (m_index_mask != 0) {
+                add_index_entries_locked(m_index_mask, key, record, payload_bytes, txn);
             }
             return record;
         }
@@ -1021,61 +3462,190 @@ namespace logit {
 
             std::string compressed;
             bool ok = false;
+            MdbxPayloadCompression compression = m_config.payload_compression;
             if (m_config.payload_compression == MdbxPayloadCompression::Gzip) {
                 ok = detail::compress_string_gzip(message, compressed, m_config.payload_compression_level);
-            } else if (m_config.payload_compression == MdbxPayloadCompression::Zstd) {
-                ok = detail::compress_string_zstd(message, compressed, m_config.payload_compression_level);
+            } else {
+                // Zstd and ZstdDictionary share the codec's reused contexts.
+                if (m_config.payload_compression == MdbxPayloadCompression::ZstdDictionary) {
+                    sample_dictionary_payload_locked(message);
+                }
+                ok = m_zstd_codec.compress(message, compressed, payload.dictionary_id, m_config.payload_compression_level);
+                if (payload.dictionary_id == 0) {
+                    compression = MdbxPayloadCompression::Zstd;
+                } else {
+                    ++m_payloads_since_dictionary;
+                }
             }
 
             if (ok) {
-                payload.compression = m_config.payload_compression;
+                payload.compression = compression;
                 payload.data = std::move(compressed);
             } else {
+                payload.dictionary_id = 0;
                 m_failed_writes.fetch_add(1, std::memory_order_acq_rel);
             }
         }
 
-        uint64_t allocate_payload_id_locked(mdbxc::Transaction& txn) {
-            for (int attempt = 0; attempt < 1024; ++attempt) {
-                const uint64_t candidate = make_unique_id();
-                if (!m_payloads->contains(candidate, txn)) {
-                    return candidate;
+        /// \brief Collects a payload for dictionary training and starts the trainer when the budget is full.
+        /// \details Samples are taken while no dictionary is stored, or once
+        /// `zstd_dictionary_retrain_payloads` payloads used the current one.
+        void sample_dictionary_payload_locked(const std::string& message) {
+            if (m_is_training_dictionary || m_is_dictionary_training_closed) {
+                return;
+            }
+            const bool is_due = m_zstd_codec.current_id() == 0 ||
+                (m_config.zstd_dictionary_retrain_payloads > 0 &&
+                 m_payloads_since_dictionary >= m_config.zstd_dictionary_retrain_payloads);
+            if (!is_due) {
+                return;
+            }
+            m_dictionary_samples.push_back(message);
+            m_dictionary_sample_bytes += message.size();
+            if (m_dictionary_sample_bytes < m_config.zstd_dictionary_sample_bytes) {
+                return;
+            }
+
+            std::vector<std::string> samples;
+            samples.swap(m_dictionary_samples);
+            m_dictionary_sample_bytes = 0;
+            m_is_training_dictionary = true;
+            // The previous trainer may still be inside on_error, which can log
+            // into this backend and wait for m_db_mutex; the new thread joins
+            // it instead of this caller, which holds the mutex.
+            std::thread previous;
+            previous.swap(m_dictionary_trainer);
+            m_dictionary_trainer = std::thread(
+                &MdbxLogger::train_dictionary, this, std::move(previous), std::move(samples));
+        }
+
+        /// \brief Trains a dictionary outside the lock, then stores it and makes it current.
+        /// \param previous Earlier trainer thread, joined before training starts.
+        /// \param samples Payloads to train on.
+        void train_dictionary(std::thread previous, std::vector<std::string> samples) {
+            if (previous.joinable()) {
+                previous.join();
+            }
+            std::string dictionary;
+            const bool is_trained = detail::train_zstd_dictionary(samples, m_config.zstd_dictionary_size, dictionary);
+            std::vector<std::string>().swap(samples);
+
+            std::string error;
+            {
+                std::lock_guard<std::mutex> db_lock(m_db_mutex);
+                if (!is_trained) {
+                    error = "MdbxLogger: zstd dictionary training failed";
+                } else {
+                    try {
+                        store_dictionary_locked(dictionary);
+                    } catch (const std::exception& e) {
+                        error = std::string("MdbxLogger: failed to store zstd dictionary: ") + e.what();
+                    } catch (...) {
+                        error = "MdbxLogger: failed to store zstd dictionary";
+                    }
+                }
+                m_is_training_dictionary = false;
+            }
+            if (!error.empty() && m_config.on_error) {
+                m_config.on_error(error);
+            }
+        }
+
+        void store_dictionary_locked(const std::string& dictionary) {
+            uint32_t id = m_last_dictionary_id;
+            auto txn = m_connection->transaction(mdbxc::TransactionMode::WRITABLE);
+            // Retries only when another writer shares the database file.
+            do {
+                if (id == (std::numeric_limits<uint32_t>::max)()) {
+                    throw std::runtime_error("MdbxLogger: zstd dictionary ids exhausted");
                 }
+                ++id;
+            } while (!m_zstd_dictionaries->insert(id, dictionary, txn));
+            txn.commit();
+            m_last_dictionary_id = id;
+            if (!m_zstd_codec.set_current(id, dictionary, m_config.payload_compression_level)) {
+                throw std::runtime_error("MdbxLogger: zstd rejected the trained dictionary");
+            }
+            m_payloads_since_dictionary = 0;
+        }
+
+        /// \brief Stops dictionary training; waits for a running trainer.
+        void join_dictionary_trainer() {
+            std::thread trainer;
+            {
+                std::lock_guard<std::mutex> db_lock(m_db_mutex);
+                m_is_dictionary_training_closed = true;
+                trainer.swap(m_dictionary_trainer);
+            }
+            if (trainer.joinable()) {
+                trainer.join();
+            }
+        }
+
+        /// \brief Decompresses a ZstdDictionary payload, loading its dictionary when needed.
+        bool decompress_with_dictionary(uint32_t dictionary_id, const std::string& input, std::string& output) const {
+            std::lock_guard<std::mutex> db_lock(m_db_mutex);
+            return decompress_with_dictionary_locked(dictionary_id, input, output);
+        }
+
+        bool decompress_with_dictionary_locked(uint32_t dictionary_id, const std::string& input, std::string& output) const {
+            try {
+                if (!m_zstd_codec.has(dictionary_id)) {
+#if __cplusplus >= 201703L
+                    auto dictionary = m_zstd_dictionaries->find(dictionary_id);
+                    if (!dictionary || !m_zstd_codec.add(dictionary_id, *dictionary)) return false;
+#else
+                    std::pair<bool, std::string> dictionary = m_zstd_dictionaries->find(dictionary_id);
+                    if (!dictionary.first || !m_zstd_codec.add(dictionary_id, dictionary.second)) return false;
+#endif
+                }
+                return m_zstd_codec.decompress(dictionary_id, input, output);
+            } catch (...) {
+                return false;
+            }
+        }
+
+        uint64_t allocate_payload_id_locked() {
+            if (m_last_payload_id == (std::numeric_limits<uint64_t>::max)()) {
+                throw std::runtime_error("MdbxLogger: payload ids exhausted");
             }
-            throw std::runtime_error("MdbxLogger: failed to allocate unique payload id");
+            return ++m_last_payload_id;
         }
 
+        /// \brief Allocates the key of the next record.
+        /// \details Timestamps at or after the newest key advance a single
+        /// `timestamp+sequence` cursor. An older timestamp, e.g. from a clock
+        /// step back, probes that millisecond for a free sequence and leaves
+        /// the cursor alone.
         std::string next_record_key_locked(
                 int64_t timestamp_ms,
                 uint32_t& sequence,
                 mdbxc::Transaction& txn) {
-            std::unordered_map<int64_t, uint32_t>::iterator it =
-                m_next_sequence_by_timestamp.find(timestamp_ms);
-            uint32_t candidate = it == m_next_sequence_by_timestamp.end() ? 0 : it->second;
+            if (!m_has_last_record_key || timestamp_ms > m_last_record_ts) {
+                m_has_last_record_key = true;
+                m_last_record_ts = timestamp_ms;
+                m_last_record_sequence = 0;
+                sequence = 0;
+                return detail::make_mdbx_record_key(timestamp_ms, sequence);
+            }
+            if (timestamp_ms == m_last_record_ts) {
+                if (m_last_record_sequence == (std::numeric_limits<uint32_t>::max)()) {
+                    throw std::runtime_error("MdbxLogger: sequence exhausted for timestamp");
+                }
+                sequence = ++m_last_record_sequence;
+                return detail::make_mdbx_record_key(timestamp_ms, sequence);
+            }
 
-            for (;;) {
-                const std::string key = detail::make_mdbx_record_key(timestamp_ms, candidate);
+            for (uint32_t candidate = 0;; ++candidate) {
+                std::string key = detail::make_mdbx_record_key(timestamp_ms, candidate);
                 if (!m_records->contains(key, txn)) {
                     sequence = candidate;
-                    if (candidate != (std::numeric_limits<uint32_t>::max)()) {
-                        m_next_sequence_by_timestamp[timestamp_ms] = candidate + 1;
-                    } else {
-                        m_next_sequence_by_timestamp[timestamp_ms] = candidate;
-                    }
                     return key;
                 }
                 if (candidate == (std::numeric_limits<uint32_t>::max)()) {
                     throw std::runtime_error("MdbxLogger: sequence exhausted for timestamp");
                 }
-                ++candidate;
-            }
-        }
-
-        void advance_sequence_after_collision(int64_t timestamp_ms, uint32_t sequence) {
-            if (sequence == (std::numeric_limits<uint32_t>::max)()) {
-                throw std::runtime_error("MdbxLogger: sequence exhausted for timestamp");
             }
-            m_next_sequence_by_timestamp[timestamp_ms] = sequence + 1;
         }
 
         static uint64_t make_unique_id() {
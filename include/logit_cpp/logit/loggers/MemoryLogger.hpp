@@ -9,7 +9,9 @@
 #include "ILogReader.hpp"
 #include "ILogSubscriber.hpp"
 
-#include <map>
+#include <functional>
+#include <limits>
+#include <memory>
 
 namespace logit {
 
@@ -17,8 +19,23 @@ namespace logit {
     /// \ingroup LogBackends
     /// \brief Stores the latest formatted log messages in memory.
     /// \details Snapshots are returned oldest-to-newest. Read operations avoid
-    /// `Logger`-level execution serialization, but still synchronize on this
-    /// backend's own mutex while copying the current buffer.
+    /// `Logger`-level execution serialization. They take this backend's mutex
+    /// only to pin the current records (one reference per chunk of
+    /// \ref detail::MemoryEntryStore and per overlapping cold block), then
+    /// filter and copy without it, so readers do not stall producers.
+    ///
+    /// File and function names are interned (\ref detail::StringInterner), so
+    /// each buffered record owns only its formatted message.
+    ///
+    /// With `Config::cold_compress` set to GZIP or ZSTD the buffer has two
+    /// tiers: the newest `cold_hot_bytes` of messages stay uncompressed, and
+    /// older entries are sealed into compressed \ref detail::MemoryColdTier
+    /// blocks instead of being evicted. `max_bytes` then bounds hot message
+    /// bytes plus compressed block bytes, and `max_records` counts both tiers.
+    ///
+    /// With `Config::use_lock_free_ring` the buffer is a fixed-capacity
+    /// \ref detail::MemoryArenaRing instead: producers append without taking
+    /// the mutex and readers copy a seqlock-validated snapshot.
     class MemoryLogger : public ILogger, public ILogReader, public ILogSubscriber {
     public:
         /// \struct Config
@@ -27,6 +44,12 @@ namespace logit {
             std::size_t max_records = 1000;            ///< Maximum number of buffered entries (0 = unlimited).
             std::size_t max_bytes   = 1024 * 1024;    ///< Maximum buffered formatted-message bytes (0 = unlimited).
             int64_t     max_age_ms  = 24LL * 60 * 60 * 1000; ///< Maximum age of buffered entries (0 = unlimited).
+            bool        use_lock_free_ring = false; ///< Store entries in a pre-sized arena ring written without the mutex (0 records = 65536 slots).
+            std::size_t ring_arena_bytes   = 0;     ///< Arena size for the ring (0 = max_bytes, or 16 MiB when max_bytes is 0).
+            CompressType cold_compress     = CompressType::NONE; ///< Codec for sealed cold blocks (GZIP or ZSTD; NONE = evict old entries). Ignored by the ring.
+            int         cold_compress_level = 1;          ///< Compression level for cold blocks.
+            std::size_t cold_hot_bytes     = 64 * 1024;   ///< Message bytes kept uncompressed before older entries are sealed.
+            std::size_t cold_block_bytes   = 64 * 1024;   ///< Message bytes sealed into one cold block.
 
             Config() {}
 
@@ -40,7 +63,12 @@ namespace logit {
         MemoryLogger() = default;
 
         /// \brief Construct with explicit configuration.
-        explicit MemoryLogger(const Config& config) : m_config(config) {}
+        explicit MemoryLogger(const Config& config) : m_config(config) {
+            if (m_config.use_lock_free_ring) {
+                m_ring.reset(new detail::MemoryArenaRing(
+                    m_config.max_records, m_config.max_bytes, m_config.ring_arena_bytes));
+            }
+        }
 
         /// \brief Construct with explicit count/size/age limits.
         MemoryLogger(std::size_t max_records, std::size_t max_bytes, int64_t max_age_ms) :
@@ -53,31 +81,74 @@ namespace logit {
                 return;
             }
 
-            BufferedLogEntry entry;
+            const detail::InternedStringRef file(record.file);
+            const detail::InternedStringRef function(record.function);
+            if (m_ring) {
+                if (!m_ring->push(record.log_level, record.timestamp_ms, file,
+                                  record.line, function, message)) {
+                    // Not stored (oversized or lapped), so not reported as written.
+                    m_ring_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                m_last_log_ts.store(record.timestamp_ms, std::memory_order_relaxed);
+                m_last_log_mono_ts.store(LOGIT_MONOTONIC_MS(), std::memory_order_relaxed);
+                if (m_subscribers.empty()) return;
+
+                LogRecordSnapshot written_snapshot;
+                written_snapshot.level = record.log_level;
+                written_snapshot.timestamp_ms = record.timestamp_ms;
+                written_snapshot.file = record.file;
+                written_snapshot.line = record.line;
+                written_snapshot.function = record.function;
+                written_snapshot.message = message;
+                m_subscribers.publish(written_snapshot);
+                return;
+            }
+
+            detail::MemoryLogEntry entry;
             entry.level = record.log_level;
             entry.timestamp_ms = record.timestamp_ms;
-            entry.file = record.file;
+            entry.file = file;
             entry.line = record.line;
-            entry.function = record.function;
+            entry.function = function;
             entry.message = message;
 
+            const bool has_subscribers = !m_subscribers.empty();
             LogRecordSnapshot written_snapshot;
+            PendingSeal seal;
+            bool is_sealing = false;
             {
                 std::lock_guard<std::mutex> lock(m_mutex);
                 m_evict_expired_locked(record.timestamp_ms);
 
                 // Capture an owning snapshot before moving the entry; callbacks
                 // are dispatched only after the buffer update finishes.
-                written_snapshot = to_snapshot(entry);
+                if (has_subscribers) {
+                    written_snapshot = to_snapshot(entry.view());
+                }
                 m_total_bytes += m_entry_bytes(entry);
+                if (!m_entries.empty() && entry.timestamp_ms < m_entries.back().timestamp_ms) {
+                    m_is_time_sorted = false;
+                    m_unsorted_prefix = m_entries.size();
+                }
                 m_entries.push_back(std::move(entry));
                 m_last_log_ts.store(record.timestamp_ms, std::memory_order_relaxed);
                 m_last_log_mono_ts.store(LOGIT_MONOTONIC_MS(), std::memory_order_relaxed);
 
-                m_enforce_limits_locked(record.timestamp_ms);
+                // Limits are applied once the block is stored, so sealed bytes
+                // are counted compressed, as if sealing had been immediate.
+                is_sealing = m_begin_seal_locked(seal);
+                if (!is_sealing) {
+                    m_enforce_limits_locked(record.timestamp_ms);
+                }
+            }
+            if (is_sealing) {
+                m_seal_cold(seal, record.timestamp_ms);
             }
 
-            notify_callbacks(written_snapshot);
+            if (has_subscribers) {
+                m_subscribers.publish(written_snapshot);
+            }
         }
 
         /// \brief Retrieve legacy string-based metadata.
@@ -87,6 +158,8 @@ namespace logit {
                 return std::to_string(get_last_log_ts());
             case LoggerParam::TimeSinceLastLog:
                 return std::to_string(get_time_since_last_log());
+            case LoggerParam::DroppedLogCount:
+                return std::to_string(dropped_count());
             default:
                 break;
             }
@@ -100,12 +173,22 @@ namespace logit {
                 return get_last_log_ts();
             case LoggerParam::TimeSinceLastLog:
                 return get_time_since_last_log();
+            case LoggerParam::DroppedLogCount:
+                return static_cast<int64_t>(dropped_count());
             default:
                 break;
             }
             return 0;
         }
 
+        /// \brief Number of records the lock-free ring refused to store.
+        /// \details Counts messages larger than `max_bytes` or the ring arena
+        /// and records whose slot was lapped before it could be claimed.
+        /// Always 0 without `Config::use_lock_free_ring`.
+        uint64_t dropped_count() const {
+            return m_ring_dropped.load(std::memory_order_relaxed);
+        }
+
         /// \brief Retrieve legacy floating-point metadata.
         double get_float_param(const LoggerParam& param) const override {
             switch (param) {
@@ -113,6 +196,8 @@ namespace logit {
                 return static_cast<double>(get_last_log_ts()) / 1000.0;
             case LoggerParam::TimeSinceLastLog:
                 return static_cast<double>(get_time_since_last_log()) / 1000.0;
+            case LoggerParam::DroppedLogCount:
+                return static_cast<double>(dropped_count());
             default:
                 break;
             }
@@ -129,41 +214,55 @@ namespace logit {
             return static_cast<LogLevel>(m_log_level.load(std::memory_order_relaxed));
         }
 
+        /// \brief True when hot records are in timestamp order, so time windows are found by binary search.
+        bool is_time_sorted() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_is_time_sorted;
+        }
+
         /// \brief Return buffered formatted strings in chronological order.
         /// \details Age-based cleanup runs before copying the snapshot.
         std::vector<std::string> get_buffered_strings() const override {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_evict_expired_locked(LOGIT_CURRENT_TIMESTAMP_MS());
-
             std::vector<std::string> snapshot;
-            snapshot.reserve(m_entries.size());
-            for (const auto& entry : m_entries) {
+            m_run_query(LogQuery(), [&snapshot](const LogEntryView& entry) {
                 snapshot.push_back(entry.message);
-            }
+                return true;
+            });
             return snapshot;
         }
 
         /// \brief Return buffered structured entries in chronological order.
         /// \details Age-based cleanup runs before copying the snapshot.
         std::vector<BufferedLogEntry> get_buffered_entries() const override {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_evict_expired_locked(LOGIT_CURRENT_TIMESTAMP_MS());
-            return std::vector<BufferedLogEntry>(m_entries.begin(), m_entries.end());
+            std::vector<BufferedLogEntry> snapshot;
+            m_run_query(LogQuery(), [&snapshot](const LogEntryView& entry) {
+                snapshot.push_back(entry.to_entry());
+                return true;
+            });
+            return snapshot;
         }
 
-        /// \brief Memory logger is synchronous, so no flush step is needed.
-        void wait() override {}
+        /// \brief Waits until asynchronous callbacks have received queued records.
+        /// \details Buffer writes are synchronous, so only async callback
+        /// delivery can be pending.
+        void wait() override {
+            m_subscribers.flush();
+        }
 
         uint64_t add_log_callback(Callback callback) override {
-            std::lock_guard<std::mutex> lock(m_callbacks_mutex);
-            const uint64_t id = m_next_callback_id.fetch_add(1, std::memory_order_relaxed);
-            m_callbacks.emplace(id, std::move(callback));
-            return id;
+            return m_subscribers.add(std::move(callback), LogCallbackOptions());
+        }
+
+        uint64_t add_log_callback(Callback callback, const LogCallbackOptions& options) override {
+            return m_subscribers.add(std::move(callback), options);
         }
 
         bool remove_log_callback(uint64_t callback_id) override {
-            std::lock_guard<std::mutex> lock(m_callbacks_mutex);
-            return m_callbacks.erase(callback_id) > 0;
+            return m_subscribers.remove(callback_id);
+        }
+
+        uint64_t get_log_callback_dropped(uint64_t callback_id) const override {
+            return m_subscribers.dropped(callback_id);
         }
 
         /// \brief Clears buffered entries.
@@ -173,10 +272,16 @@ namespace logit {
             LogClearResult result;
             result.ok = true;
             result.status = LogClearStatus::Cleared;
-            result.cleared_records = m_entries.size();
+            result.cleared_records = m_ring
+                ? m_ring->clear(m_ring_min_timestamp())
+                : m_entries.size() + m_cold.records();
             result.message = "cleared";
+            m_hot_popped += m_entries.size();
             m_entries.clear();
+            m_cold.clear();
             m_total_bytes = 0;
+            m_is_time_sorted = true;
+            m_unsorted_prefix = 0;
             m_last_log_ts.store(0, std::memory_order_relaxed);
             m_last_log_mono_ts.store(0, std::memory_order_relaxed);
             return result;
@@ -191,23 +296,7 @@ namespace logit {
             auto result = read_range_result(from_ms, to_ms, limit);
             return result.value ? *result.value : std::vector<LogRecordSnapshot>();
 #else
-            std::vector<LogRecordSnapshot> out;
-            if (to_ms <= from_ms) {
-                return out;
-            }
-
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_evict_expired_locked(LOGIT_CURRENT_TIMESTAMP_MS());
-
-            for (const auto& entry : m_entries) {
-                if (entry.timestamp_ms >= from_ms && entry.timestamp_ms < to_ms) {
-                    out.push_back(to_snapshot(entry));
-                    if (limit > 0 && out.size() >= limit) {
-                        break;
-                    }
-                }
-            }
-            return out;
+            return query(make_range_query(from_ms, to_ms, limit));
 #endif
         }
 
@@ -218,22 +307,7 @@ namespace logit {
                 int64_t to_ms,
                 std::size_t limit = 0) const override {
             LogReadResult<std::vector<LogRecordSnapshot>> result;
-            result.value.emplace();
-            if (to_ms <= from_ms) {
-                return result;
-            }
-
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_evict_expired_locked(LOGIT_CURRENT_TIMESTAMP_MS());
-
-            for (const auto& entry : m_entries) {
-                if (entry.timestamp_ms >= from_ms && entry.timestamp_ms < to_ms) {
-                    result.value->push_back(to_snapshot(entry));
-                    if (limit > 0 && result.value->size() >= limit) {
-                        break;
-                    }
-                }
-            }
+            result.value = query(make_range_query(from_ms, to_ms, limit));
             return result;
         }
 #endif
@@ -247,22 +321,7 @@ namespace logit {
             auto result = read_recent_result(limit, period_ms, order);
             return result.value ? *result.value : std::vector<LogRecordSnapshot>();
 #else
-            std::vector<LogRecordSnapshot> out;
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_evict_expired_locked(LOGIT_CURRENT_TIMESTAMP_MS());
-
-            const int64_t now_ms = LOGIT_CURRENT_TIMESTAMP_MS();
-            const int64_t from_ms = (period_ms > 0) ? (now_ms - period_ms) : 0;
-
-            for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it) {
-                if (period_ms <= 0 || it->timestamp_ms >= from_ms) {
-                    out.push_back(to_snapshot(*it));
-                    if (limit > 0 && out.size() >= limit) {
-                        break;
-                    }
-                }
-            }
-
+            std::vector<LogRecordSnapshot> out = query(make_recent_query(limit, period_ms));
             if (order == LogReadOrder::Ascending) {
                 std::reverse(out.begin(), out.end());
             }
@@ -277,22 +336,7 @@ namespace logit {
                 int64_t period_ms = 0,
                 LogReadOrder order = LogReadOrder::Ascending) const override {
             LogReadResult<std::vector<LogRecordSnapshot>> result;
-            result.value.emplace();
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_evict_expired_locked(LOGIT_CURRENT_TIMESTAMP_MS());
-
-            const int64_t now_ms = LOGIT_CURRENT_TIMESTAMP_MS();
-            const int64_t from_ms = (period_ms > 0) ? (now_ms - period_ms) : 0;
-
-            for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it) {
-                if (period_ms <= 0 || it->timestamp_ms >= from_ms) {
-                    result.value->push_back(to_snapshot(*it));
-                    if (limit > 0 && result.value->size() >= limit) {
-                        break;
-                    }
-                }
-            }
-
+            result.value = query(make_recent_query(limit, period_ms));
             if (order == LogReadOrder::Ascending) {
                 std::reverse(result.value->begin(), result.value->end());
             }
@@ -300,8 +344,56 @@ namespace logit {
         }
 #endif
 
+        /// \brief Reads records matching a query.
+        /// \details While insertion order matches timestamp order (the usual case)
+        /// the time window is located by binary search instead of a full scan.
+        /// Cold blocks are decompressed only when their timestamp range overlaps
+        /// the window.
+        std::vector<LogRecordSnapshot> query(const LogQuery& log_query) const override {
+            std::vector<LogRecordSnapshot> out;
+            m_run_query(log_query, [&out](const LogEntryView& entry) {
+                out.push_back(to_snapshot(entry));
+                return true;
+            });
+            return out;
+        }
+
+        /// \brief Counts records matching a query without copying them.
+        std::size_t count(const LogQuery& log_query) const override {
+            std::size_t matched = 0;
+            m_run_query(log_query, [&matched](const LogEntryView&) {
+                ++matched;
+                return true;
+            });
+            return matched;
+        }
+
+        /// \brief Visits records matching a query without copying them.
+        /// \details The matching records are pinned under the backend mutex and
+        /// the visitor runs after it is released, so producers keep appending
+        /// and evicting during the visit, and the visitor may log to this
+        /// backend. Views stay valid only for the duration of the visitor call.
+        /// The arena ring cannot be pinned; there the records are copied
+        /// once before the visit.
+        /// \param log_query Filter, limit and order.
+        /// \param visitor Receives each match; return false to stop.
+        void for_each_query(
+                const LogQuery& log_query,
+                const std::function<bool(const LogEntryView&)>& visitor) const {
+            m_run_query(log_query, visitor);
+        }
+
+        /// \brief Visits records in `[from_ms, to_ms)`, oldest first, without copying them.
+        /// \see for_each_query()
+        void for_each_entry(
+                int64_t from_ms,
+                int64_t to_ms,
+                const std::function<bool(const LogEntryView&)>& visitor) const {
+            m_run_query(make_range_query(from_ms, to_ms, 0), visitor);
+        }
+
     private:
-        static LogRecordSnapshot to_snapshot(const BufferedLogEntry& e) {
+        static LogRecordSnapshot to_snapshot(const LogEntryView& e) {
             LogRecordSnapshot snapshot;
             snapshot.level = e.level;
             snapshot.timestamp_ms = e.timestamp_ms;
@@ -312,25 +404,194 @@ namespace logit {
             return snapshot;
         }
 
-        void notify_callbacks(const LogRecordSnapshot& snapshot) const {
-            std::vector<Callback> callbacks_copy;
+        static LogQuery make_range_query(int64_t from_ms, int64_t to_ms, std::size_t limit) {
+            LogQuery log_query;
+            log_query.from_ms = from_ms;
+            log_query.to_ms = to_ms;
+            log_query.limit = limit;
+            return log_query;
+        }
+
+        /// \brief Newest-first query for read_recent().
+        static LogQuery make_recent_query(std::size_t limit, int64_t period_ms) {
+            LogQuery log_query;
+            if (period_ms > 0) {
+                log_query.from_ms = LOGIT_CURRENT_TIMESTAMP_MS() - period_ms;
+            }
+            log_query.limit = limit;
+            log_query.order = LogReadOrder::Descending;
+            return log_query;
+        }
+
+        /// \brief Records pinned for one query.
+        struct PinnedEntries {
+            detail::MemoryEntryStore::Snapshot hot;  ///< Hot records.
+            bool is_time_sorted = true;              ///< Hot records never decrease in timestamp.
+            std::vector<std::shared_ptr<const detail::MemoryColdTier::Block> > cold; ///< Overlapping cold blocks, oldest first.
+            int64_t cold_from_ms = 0;                ///< Age cutoff applied to cold records.
+        };
+
+        /// \brief Hot entries pinned for sealing outside the lock.
+        struct PendingSeal {
+            detail::MemoryEntryStore::Snapshot entries; ///< Pinned hot records, oldest first.
+            std::size_t count = 0;                      ///< Leading records to seal.
+            uint64_t    popped = 0;                     ///< `m_hot_popped` when pinned.
+        };
+
+        /// \brief Runs a query over the current storage.
+        /// \details Only pinning happens under the mutex; filtering, decompression
+        /// and the visitor run after it is released.
+        template <class Visitor>
+        void m_run_query(const LogQuery& log_query, const Visitor& visitor) const {
+            if (log_query.to_ms <= log_query.from_ms) {
+                return;
+            }
+            std::size_t matched = 0;
+            if (m_ring) {
+                const std::vector<detail::MemoryLogEntry> entries = m_ring_snapshot();
+                m_visit_query(entries, false, log_query, visitor, matched);
+                return;
+            }
+
+            PinnedEntries pinned;
             {
-                std::lock_guard<std::mutex> lock(m_callbacks_mutex);
-                callbacks_copy.reserve(m_callbacks.size());
-                for (const auto& kv : m_callbacks) {
-                    callbacks_copy.push_back(kv.second);
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pin_locked(log_query, pinned);
+            }
+            if (log_query.order == LogReadOrder::Descending) {
+                if (!m_visit_query(pinned.hot, pinned.is_time_sorted, log_query, visitor, matched)) return;
+                m_visit_cold(pinned, log_query, visitor, matched);
+                return;
+            }
+            if (!m_visit_cold(pinned, log_query, visitor, matched)) return;
+            m_visit_query(pinned.hot, pinned.is_time_sorted, log_query, visitor, matched);
+        }
+
+        /// \brief Evicts expired records and pins what the query can see.
+        void m_pin_locked(const LogQuery& log_query, PinnedEntries& pinned) const {
+            const int64_t now_ms = LOGIT_CURRENT_TIMESTAMP_MS();
+            m_evict_expired_locked(now_ms);
+            pinned.hot = m_entries.snapshot();
+            pinned.is_time_sorted = m_is_time_sorted;
+
+            // Blocks are evicted only once all of their records are too old, so
+            // records of a partially expired block are skipped at visit time.
+            pinned.cold_from_ms = log_query.from_ms;
+            if (m_config.max_age_ms > 0) {
+                pinned.cold_from_ms = (std::max)(pinned.cold_from_ms, now_ms - m_config.max_age_ms);
+            }
+            const std::deque<std::shared_ptr<const detail::MemoryColdTier::Block> >& blocks = m_cold.blocks();
+            for (std::size_t i = 0; i < blocks.size(); ++i) {
+                if (blocks[i]->max_timestamp_ms >= pinned.cold_from_ms &&
+                    blocks[i]->min_timestamp_ms < log_query.to_ms) {
+                    pinned.cold.push_back(blocks[i]);
                 }
             }
-            for (const auto& cb : callbacks_copy) {
-                try {
-                    cb(snapshot);
-                } catch (...) {
+        }
+
+        /// \brief Visits matches in the pinned cold blocks.
+        /// \return False when the visitor stopped or the limit was reached.
+        template <class Visitor>
+        bool m_visit_cold(
+                const PinnedEntries& pinned,
+                const LogQuery& log_query,
+                const Visitor& visitor,
+                std::size_t& matched) const {
+            if (pinned.cold.empty()) return true;
+            const LogQuery* cold_query = &log_query;
+            LogQuery clamped_query;
+            if (pinned.cold_from_ms > log_query.from_ms) {
+                clamped_query = log_query;
+                clamped_query.from_ms = pinned.cold_from_ms;
+                cold_query = &clamped_query;
+            }
+
+            const bool is_descending = log_query.order == LogReadOrder::Descending;
+            std::vector<detail::MemoryLogEntry> entries;
+            for (std::size_t i = 0; i < pinned.cold.size(); ++i) {
+                const detail::MemoryColdTier::Block& block =
+                    *pinned.cold[is_descending ? pinned.cold.size() - 1 - i : i];
+                if (!m_cold.decode(block, entries)) continue;
+                if (!m_visit_query(entries, block.is_time_sorted, *cold_query, visitor, matched)) return false;
+            }
+            return true;
+        }
+
+        /// \brief Index of the first record at or after `timestamp_ms` in a sorted range.
+        template <class Container>
+        static std::size_t m_lower_bound(
+                const Container& entries,
+                std::size_t first,
+                std::size_t last,
+                int64_t timestamp_ms) {
+            while (first < last) {
+                const std::size_t middle = first + (last - first) / 2;
+                if (entries[middle].timestamp_ms < timestamp_ms) {
+                    first = middle + 1;
+                } else {
+                    last = middle;
                 }
             }
+            return first;
+        }
+
+        /// \brief Visits matches in an oldest-first indexable container.
+        /// \param is_time_sorted True when timestamps never decrease, which
+        /// allows locating the time window by binary search.
+        /// \param matched Matches counted so far, shared across containers.
+        /// \return False when the visitor stopped or the limit was reached.
+        template <class Container, class Visitor>
+        static bool m_visit_query(
+                const Container& entries,
+                bool is_time_sorted,
+                const LogQuery& log_query,
+                const Visitor& visitor,
+                std::size_t& matched) {
+            std::size_t first = 0;
+            std::size_t last = entries.size();
+            if (is_time_sorted) {
+                first = m_lower_bound(entries, first, last, log_query.from_ms);
+                last = m_lower_bound(entries, first, last, log_query.to_ms);
+            }
+
+            if (log_query.limit > 0 && matched >= log_query.limit) return false;
+            if (log_query.order == LogReadOrder::Descending) {
+                for (std::size_t i = last; i > first;) {
+                    const LogEntryView entry = entries[--i].view();
+                    if (!log_query.matches(entry)) continue;
+                    ++matched;
+                    if (!visitor(entry)) return false;
+                    if (log_query.limit > 0 && matched >= log_query.limit) return false;
+                }
+                return true;
+            }
+            for (std::size_t i = first; i < last; ++i) {
+                const LogEntryView entry = entries[i].view();
+                if (!log_query.matches(entry)) continue;
+                ++matched;
+                if (!visitor(entry)) return false;
+                if (log_query.limit > 0 && matched >= log_query.limit) return false;
+            }
+            return true;
+        }
+
+        /// \brief Copies the ring contents that are still within `max_age_ms`.
+        std::vector<detail::MemoryLogEntry> m_ring_snapshot() const {
+            std::vector<detail::MemoryLogEntry> entries;
+            m_ring->snapshot(m_ring_min_timestamp(), entries);
+            return entries;
+        }
+
+        /// \brief Oldest timestamp still within `max_age_ms`.
+        int64_t m_ring_min_timestamp() const {
+            if (m_config.max_age_ms <= 0) {
+                return (std::numeric_limits<int64_t>::min)();
+            }
+            return LOGIT_CURRENT_TIMESTAMP_MS() - m_config.max_age_ms;
         }
 
         // Count only the retained formatted payload, not the full object footprint.
-        static std::size_t m_entry_bytes(const BufferedLogEntry& entry) {
+        static std::size_t m_entry_bytes(const detail::MemoryLogEntry& entry) {
             return entry.message.size();
         }
 
@@ -340,6 +601,11 @@ namespace logit {
             }
             m_total_bytes -= m_entry_bytes(m_entries.front());
             m_entries.pop_front();
+            ++m_hot_popped;
+            // Order is restored once every entry before the newest inversion is gone.
+            if (m_unsorted_prefix > 0 && --m_unsorted_prefix == 0) {
+                m_is_time_sorted = true;
+            }
         }
 
         void m_evict_expired_locked(int64_t now_ms) const {
@@ -348,24 +614,90 @@ namespace logit {
             }
 
             const int64_t cutoff = now_ms - m_config.max_age_ms;
+            m_cold.evict_expired(cutoff);
             while (!m_entries.empty() && m_entries.front().timestamp_ms < cutoff) {
                 m_pop_front_locked();
             }
         }
 
+        /// \brief Drops the oldest cold block, or the oldest hot entry when no block is left.
+        /// \details A compressed block cannot be trimmed, so `max_records` and
+        /// `max_bytes` evict a whole block at a time and may leave the buffer
+        /// below the limit by up to one block (about `cold_block_bytes` of messages).
+        void m_pop_oldest_locked() const {
+            if (!m_cold.empty()) {
+                m_cold.pop_front();
+            } else {
+                m_pop_front_locked();
+            }
+        }
+
+        /// \brief Pins the oldest hot entries for sealing once the hot tier holds
+        /// a full block beyond `cold_hot_bytes` and no other seal is running.
+        /// \return True when the caller must finish with m_seal_cold().
+        bool m_begin_seal_locked(PendingSeal& seal) const {
+            const std::size_t block_bytes = (std::max)(m_config.cold_block_bytes, static_cast<std::size_t>(1));
+            if (m_is_sealing || !m_cold.is_enabled() ||
+                m_total_bytes < m_config.cold_hot_bytes + block_bytes) {
+                return false;
+            }
+            std::size_t count = 0;
+            std::size_t bytes = 0;
+            while (count < m_entries.size() && bytes < block_bytes) {
+                bytes += m_entry_bytes(m_entries[count]);
+                ++count;
+            }
+            seal.entries = m_entries.snapshot();
+            seal.count = count;
+            seal.popped = m_hot_popped;
+            m_is_sealing = true;
+            return true;
+        }
+
+        /// \brief Compresses pinned entries without the lock, then stores the
+        /// block and applies the limits.
+        /// \details The block is dropped when any pinned entry was evicted in
+        /// the meantime; the next write seals again. On compression failure
+        /// the tier disables itself and the entries stay hot.
+        void m_seal_cold(PendingSeal& seal, int64_t now_ms) const {
+            for (;;) {
+                std::shared_ptr<const detail::MemoryColdTier::Block> block;
+                try {
+                    block = m_cold.compress(seal.entries, seal.count);
+                } catch (...) {
+                    block.reset();
+                }
+                seal.entries = detail::MemoryEntryStore::Snapshot();
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_is_sealing = false;
+                const bool is_stale = block && m_hot_popped != seal.popped;
+                if (!is_stale && m_cold.append(block)) {
+                    for (std::size_t i = 0; i < seal.count; ++i) {
+                        m_pop_front_locked();
+                    }
+                }
+                if (!m_begin_seal_locked(seal)) {
+                    m_enforce_limits_locked(now_ms);
+                    return;
+                }
+            }
+        }
+
         void m_enforce_limits_locked(int64_t now_ms) const {
             m_evict_expired_locked(now_ms);
 
             if (m_config.max_records > 0) {
-                while (m_entries.size() > m_config.max_records) {
-                    m_pop_front_locked();
+                while (m_entries.size() + m_cold.records() > m_config.max_records) {
+                    m_pop_oldest_locked();
                 }
             }
 
             if (m_config.max_bytes > 0) {
                 // If a single message exceeds the byte budget, eviction removes it too.
-                while (m_total_bytes > m_config.max_bytes && !m_entries.empty()) {
-                    m_pop_front_locked();
+                while (m_total_bytes + m_cold.bytes() > m_config.max_bytes &&
+                       (!m_entries.empty() || !m_cold.empty())) {
+                    m_pop_oldest_locked();
                 }
             }
         }
@@ -384,15 +716,20 @@ namespace logit {
         }
 
         Config m_config;
+        std::unique_ptr<detail::MemoryArenaRing> m_ring; ///< Mutex-free storage when `use_lock_free_ring` is set.
         mutable std::mutex m_mutex;
-        mutable std::deque<BufferedLogEntry> m_entries;
+        mutable detail::MemoryEntryStore m_entries; ///< Hot records, oldest first.
         mutable std::size_t m_total_bytes = 0;
+        mutable bool m_is_time_sorted = true; ///< True while buffered timestamps never decrease.
+        mutable std::size_t m_unsorted_prefix = 0; ///< Hot entries older than the newest timestamp inversion.
+        mutable uint64_t m_hot_popped = 0;     ///< Hot entries removed from the front so far.
+        mutable bool m_is_sealing = false;     ///< True while a thread compresses a cold block.
+        mutable detail::MemoryColdTier m_cold{m_config.cold_compress, m_config.cold_compress_level}; ///< Compressed older entries.
         std::atomic<int64_t> m_last_log_ts = ATOMIC_VAR_INIT(0);
+        std::atomic<uint64_t> m_ring_dropped = ATOMIC_VAR_INIT(0); ///< Records refused by the ring.
         std::atomic<int64_t> m_last_log_mono_ts = ATOMIC_VAR_INIT(0);
         std::atomic<int> m_log_level = ATOMIC_VAR_INIT(static_cast<int>(LogLevel::LOG_LVL_TRACE));
-        mutable std::mutex m_callbacks_mutex;
-        std::map<uint64_t, Callback> m_callbacks;
-        std::atomic<uint64_t> m_next_callback_id{1};
+        detail::LogSubscriberList m_subscribers; ///< Registered callbacks.
     };
 
 } // namespace logit
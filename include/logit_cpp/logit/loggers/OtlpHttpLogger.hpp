@@ -52,7 +52,8 @@ namespace logit {
     /// \brief Exports logs to an OTLP/HTTP endpoint using kurlyk.
     ///
     /// This backend is an outbound OTLP exporter/client. It serializes records to
-    /// OTLP/HTTP JSON and sends batches to an OpenTelemetry Collector-compatible endpoint.
+    /// OTLP/HTTP JSON, or protobuf with `format.encoding = OtlpEncoding::Protobuf`,
+    /// and sends batches to an OpenTelemetry Collector-compatible endpoint.
     class OtlpHttpLogger final : public ILogger {
     public:
         struct Config {
@@ -86,7 +87,7 @@ namespace logit {
             if (m_config.max_in_flight_requests == 0) {
                 m_config.max_in_flight_requests = 1;
             }
-            m_client.set_content_type("application/json");
+            m_client.set_content_type(otlp_content_type(m_config.format.encoding));
             m_client.set_timeout(config.request_timeout_sec);
             m_client.set_retry_attempts(config.retry_attempts, config.retry_delay_ms);
 
@@ -333,7 +334,7 @@ namespace logit {
         /// \brief Submits one batch asynchronously, splitting into payload chunks.
         /// \param batch Batch to export.
         void submit_batch_async(const std::vector<OtlpLogItem>& batch) {
-            auto chunks = build_otlp_logs_json_payload_chunks(
+            auto chunks = build_otlp_logs_payload_chunks(
                 batch, m_config.format, m_config.max_payload_bytes);
 
             if (chunks.empty()) {
@@ -341,7 +342,7 @@ namespace logit {
             }
 
             kurlyk::Headers headers;
-            headers.emplace("Content-Type", "application/json");
+            headers.emplace("Content-Type", otlp_content_type(m_config.format.encoding));
 
             auto weak_state = std::weak_ptr<OtlpHttpLoggerState>(m_state);
 
@@ -32,8 +32,9 @@ namespace logit {
     /// \ingroup LogBackends
     /// \brief Exports logs as OTLP JSON payloads via a user-provided callback.
     ///
-    /// This backend serializes records to OTLP/HTTP JSON and passes each batch
-    /// to a user-provided callback instead of sending HTTP itself.
+    /// This backend serializes records to OTLP/HTTP JSON (or protobuf, per
+    /// `format.encoding`) and passes each batch to a user-provided callback
+    /// instead of sending HTTP itself.
     class OtlpPayloadLogger final : public ILogger {
     public:
         struct Config {
@@ -91,7 +92,7 @@ namespace logit {
                 }
                 std::vector<OtlpLogItem> batch;
                 batch.push_back(item);
-                auto chunks = build_otlp_logs_json_payload_chunks(
+                auto chunks = build_otlp_logs_payload_chunks(
                     batch, m_config.format, m_config.max_payload_bytes);
                 if (m_config.on_payload) {
                     for (auto& chunk : chunks) {
@@ -275,7 +276,7 @@ namespace logit {
                 }
 
                 if (!batch.empty()) {
-                    auto chunks = build_otlp_logs_json_payload_chunks(
+                    auto chunks = build_otlp_logs_payload_chunks(
                         batch, m_config.format, m_config.max_payload_bytes);
                     if (m_config.on_payload) {
                         for (auto& chunk : chunks) {
@@ -9,6 +9,8 @@
 #include <iostream>
 #include <fstream>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <atomic>
 #include <queue>
 #include <functional>
@@ -20,6 +22,15 @@
 #include <unordered_map>
 #include <regex>
 #include <memory>
+#include <vector>
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
 
 namespace logit {
 
@@ -35,6 +46,9 @@ namespace logit {
             bool        use_dedicated_executor = false;
             std::size_t queue_capacity = 0;
             detail::QueuePolicy queue_policy = detail::QueuePolicy::Block;
+            bool        high_throughput = false;
+            size_t      name_block_size = 256;
+            int64_t     retention_sweep_interval_ms = 60000;
         };
 
         UniqueFileLogger() { warn(); }
@@ -50,6 +64,7 @@ namespace logit {
         void set_log_level(LogLevel) override {}
         LogLevel get_log_level() const override { return LogLevel::LOG_LVL_TRACE; }
         void wait() override {}
+        bool sync_files() { return false; }
 
     private:
         void warn() const {
@@ -76,6 +91,7 @@ namespace logit {
     /// - Unique file generation for each log message.
     /// - Automatic deletion of old files.
     /// - Synchronous or asynchronous operation.
+    /// - Optional high-throughput mode with batched writes and periodic retention.
     class UniqueFileLogger : public ILogger {
     public:
 
@@ -89,6 +105,9 @@ namespace logit {
             bool        use_dedicated_executor = false; ///< Use a dedicated executor instead of the global TaskExecutor; native builds create one worker thread per logger.
             std::size_t queue_capacity = 0;       ///< Maximum queue size for the dedicated executor (0 = unlimited).
             detail::QueuePolicy queue_policy = detail::QueuePolicy::Block; ///< Overflow policy for the dedicated executor.
+            bool        high_throughput = false; ///< Batch records per executor wakeup, create files with raw descriptors and run retention periodically.
+            size_t      name_block_size = 256;  ///< Number of file names derived from one random hash in high-throughput mode (max 65536).
+            int64_t     retention_sweep_interval_ms = 60000; ///< Interval of the background retention sweep in high-throughput mode (0 = sweep after every write).
         };
 
         /// \brief Default constructor that uses default configuration.
@@ -266,13 +285,18 @@ namespace logit {
                 info_lock.unlock();
 
                 try {
-                    remove_old_logs();
+                    sweep_old_logs();
                 } catch (const std::exception& e) {
                     std::cerr << "Log error: " << e.what() << std::endl;
                 }
                 return;
             }
 
+            if (m_config.high_throughput) {
+                enqueue_batch_record(message, record.timestamp_ms, thread_id);
+                return;
+            }
+
             std::unique_lock<std::mutex> info_lock(m_thread_log_info_mutex);
             m_thread_log_info[thread_id].pending_logs++;
             info_lock.unlock();
@@ -307,7 +331,7 @@ namespace logit {
                 info_lock.unlock();
 
                 try {
-                    remove_old_logs();
+                    sweep_old_logs();
                 } catch (const std::exception& e) {
                     std::cerr << "Async log error: " << e.what() << std::endl;
                 }
@@ -381,6 +405,54 @@ namespace logit {
             } else {
                 detail::TaskExecutor::get_instance().wait();
             }
+            drain_batch();
+        }
+
+        /// \brief Flushes the unique files written since the last call to stable storage.
+        /// \details Waits for queued records, fsyncs each file written since the
+        /// previous barrier, then fsyncs the log directory so the new entries survive
+        /// a crash. Writers only record the paths, so a whole batch shares one barrier
+        /// instead of paying an `fsync` per file. When more than 65536 files accumulate
+        /// between barriers, the list is dropped and the next barrier fsyncs every log
+        /// file in the directory instead.
+        /// \return True on success; false on Windows or when a flush failed.
+        bool sync_files() {
+            wait();
+#           if defined(_WIN32)
+            return false;
+#           else
+            std::vector<std::string> paths;
+            bool is_overflow = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                paths.swap(m_unsynced_paths);
+                is_overflow = m_is_unsynced_overflow;
+                m_is_unsynced_overflow = false;
+            }
+            if (is_overflow) {
+                const std::vector<LogFileInfo> files = list_log_files();
+                paths.clear();
+                for (size_t i = 0; i < files.size(); ++i) {
+                    paths.push_back(files[i].path);
+                }
+            }
+            bool ok = true;
+            for (size_t i = 0; i < paths.size(); ++i) {
+                const int fd = ::open(paths[i].c_str(), O_RDONLY);
+                if (fd < 0) {
+                    // Removed by retention or clear_logs() since it was written.
+                    if (errno != ENOENT) ok = false;
+                    continue;
+                }
+                ok = ::fsync(fd) == 0 && ok;
+                ::close(fd);
+            }
+            const int dir_fd = ::open(get_directory_path().c_str(), O_RDONLY);
+            if (dir_fd < 0) return false;
+            ok = ::fsync(dir_fd) == 0 && ok;
+            ::close(dir_fd);
+            return ok;
+#           endif
         }
 
         /// \brief Clears managed unique log files.
@@ -405,6 +477,8 @@ namespace logit {
                         ++result.cleared_records;
                     }
                 }
+                m_unsynced_paths.clear();
+                m_is_unsynced_overflow = false;
                 {
                     std::lock_guard<std::mutex> info_lock(m_thread_log_info_mutex);
                     m_thread_log_info.clear();
@@ -437,6 +511,8 @@ namespace logit {
             } else if (m_config.async) {
                 detail::TaskExecutor::get_instance().wait();
             }
+            drain_batch();
+            stop_retention_sweep();
         }
 
     private:
@@ -471,6 +547,55 @@ namespace logit {
         std::atomic<int>    m_log_level = ATOMIC_VAR_INIT(static_cast<int>(LogLevel::LOG_LVL_TRACE));
         std::atomic<bool>   m_shutdown = ATOMIC_VAR_INIT(false);
 
+        /// \brief Record waiting for the next batch drain in high-throughput mode.
+        struct PendingRecord {
+            std::string     message;
+            int64_t         timestamp_ms;
+            std::thread::id thread_id;
+        };
+
+        /// \brief Drain task handle that notices when the queue policy discards it.
+        /// \details A task dropped by `DropNewest` or evicted by `DropOldest` is destroyed
+        /// without running; the destructor then clears m_is_batch_scheduled so the next
+        /// record schedules a new drain instead of riding along with a task that is gone.
+        class BatchDrainTicket {
+        public:
+            explicit BatchDrainTicket(UniqueFileLogger* logger) : m_logger(logger) {}
+
+            ~BatchDrainTicket() {
+                if (!m_is_run) m_logger->on_batch_drain_dropped();
+            }
+
+            void run() {
+                m_is_run = true;
+                m_logger->drain_batch();
+            }
+
+        private:
+            UniqueFileLogger* m_logger;
+            bool              m_is_run = false;
+        };
+
+        mutable std::mutex         m_batch_mutex;     ///< Protects the pending batch and m_batch_pending.
+        mutable std::condition_variable m_batch_cv;   ///< Signals drained batches to get_last_log_file_*().
+        std::vector<PendingRecord> m_batch;           ///< Records accepted since the last drain.
+        std::unordered_map<std::thread::id, size_t> m_batch_pending; ///< Queued or draining records per thread.
+        mutable bool               m_is_batch_scheduled = false; ///< True while a drain task is queued; getters may schedule one.
+        const std::function<void()> m_schedule_batch_drain = [this]() { schedule_batch_drain(); }; ///< Lets const getters replace a dropped drain task.
+        std::string                m_directory_path;  ///< Cached log directory (high-throughput mode).
+        std::string                m_name_block_hash; ///< Random hash shared by the current name block.
+        size_t                     m_name_block_left = 0; ///< Names left in the current block.
+        size_t                     m_name_block_seq = 0;  ///< Sequence of the next name within the block.
+        std::vector<std::string>   m_unsynced_paths;  ///< Files written since the last sync_files(); guarded by m_mutex.
+        bool                       m_is_unsynced_overflow = false; ///< True when m_unsynced_paths hit max_unsynced_files.
+        std::thread                m_sweep_thread;    ///< Runs retention every retention_sweep_interval_ms (high-throughput mode).
+        std::mutex                 m_sweep_mutex;     ///< Guards m_is_sweep_stopping.
+        std::condition_variable    m_sweep_cv;        ///< Wakes the sweep thread on shutdown.
+        bool                       m_is_sweep_stopping = false; ///< Stops the sweep thread.
+#       if !defined(_WIN32) && defined(O_TMPFILE)
+        bool                       m_use_tmpfile = true; ///< Cleared once O_TMPFILE or linkat is unsupported.
+#       endif
+
         static Config make_config(
                 const std::string& directory,
                 bool async,
@@ -495,7 +620,11 @@ namespace logit {
             std::lock_guard<std::mutex> lock(m_mutex);
             try {
                 initialize_directory();
+                m_directory_path = get_directory_path();
                 remove_old_logs();
+                if (m_config.high_throughput && m_config.retention_sweep_interval_ms > 0) {
+                    m_sweep_thread = std::thread([this]() { run_retention_sweep(); });
+                }
             } catch (const std::exception& e) {
                 std::cerr << "Initialization error: " << e.what() << std::endl;
             }
@@ -522,6 +651,9 @@ namespace logit {
         /// \param timestamp_ms The timestamp of the log message in milliseconds.
         /// \return The name of the file the message was written to.
         std::string write_log(const std::string& message, const int64_t& timestamp_ms) {
+            if (m_config.high_throughput) {
+                return write_log_fast(message, timestamp_ms);
+            }
             std::string file_path = create_unique_file_path(timestamp_ms);
 #           if defined(_WIN32)
             std::ofstream file(utf8_to_ansi(file_path), std::ios_base::binary);
@@ -533,9 +665,282 @@ namespace logit {
             }
             file.write(message.data(), message.size());
             file.close();
+            track_unsynced_file(file_path);
             return file_path;
         }
 
+        /// \brief Queues a record for the next batch drain.
+        /// \details Only the first record of a batch schedules an executor task;
+        /// later records ride along with it. Every `name_block_size` records a
+        /// spare wakeup is scheduled. A drain task discarded by the queue policy
+        /// clears the scheduled flag (see BatchDrainTicket); wait() drains inline and
+        /// get_last_log_file_*() schedule a replacement, so a dropped task cannot strand the batch.
+        /// The per-thread pending count lives under the batch mutex, so a record
+        /// takes a single lock.
+        void enqueue_batch_record(const std::string& message, int64_t timestamp_ms, std::thread::id thread_id) {
+            bool is_schedule = false;
+            {
+                std::lock_guard<std::mutex> lock(m_batch_mutex);
+                PendingRecord record;
+                record.message = message;
+                record.timestamp_ms = timestamp_ms;
+                record.thread_id = thread_id;
+                m_batch.push_back(std::move(record));
+                ++m_batch_pending[thread_id];
+                const size_t block = m_config.name_block_size > 0 ? m_config.name_block_size : 1;
+                is_schedule = !m_is_batch_scheduled || m_batch.size() % block == 0;
+                m_is_batch_scheduled = true;
+            }
+            if (!is_schedule) return;
+            schedule_batch_drain();
+        }
+
+        /// \brief Queues a drain task on the logger's executor.
+        /// \details Only queues work; the caller sets m_is_batch_scheduled first.
+        void schedule_batch_drain() {
+            std::shared_ptr<BatchDrainTicket> ticket(new BatchDrainTicket(this));
+            auto drain_task = [ticket]() { ticket->run(); };
+            if (m_executor) {
+                m_executor->add_task(std::move(drain_task));
+            } else {
+                detail::TaskExecutor::get_instance().add_task(std::move(drain_task));
+            }
+        }
+
+        /// \brief Clears the scheduled flag after the queue policy discarded a drain task.
+        /// \details Wakes wait_batch_records(), which schedules a replacement.
+        void on_batch_drain_dropped() {
+            {
+                std::lock_guard<std::mutex> lock(m_batch_mutex);
+                m_is_batch_scheduled = false;
+            }
+            m_batch_cv.notify_all();
+        }
+
+        /// \brief Writes every pending record and publishes the results once per batch.
+        /// \details The batch is taken under m_mutex, so concurrent drains (executor
+        /// task and an inline drain from wait()) write batches in the order they were queued.
+        void drain_batch() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::vector<PendingRecord> batch;
+            {
+                std::lock_guard<std::mutex> batch_lock(m_batch_mutex);
+                batch.swap(m_batch);
+                m_is_batch_scheduled = false;
+            }
+            if (batch.empty()) return;
+
+            std::vector<std::string> paths(batch.size());
+            for (size_t i = 0; i < batch.size(); ++i) {
+                try {
+                    paths[i] = write_log_fast(batch[i].message, batch[i].timestamp_ms);
+                } catch (const std::exception& e) {
+                    std::cerr << "Async log error: " << e.what() << std::endl;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> info_lock(m_thread_log_info_mutex);
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    ThreadLogInfo& info = m_thread_log_info[batch[i].thread_id];
+                    if (!paths[i].empty()) {
+                        info.last_file_path = paths[i];
+                        info.last_file_name = get_file_name(paths[i]);
+                    } else {
+                        info.last_file_path = "Not available";
+                        info.last_file_name = "Not available";
+                    }
+                }
+            }
+            {
+                std::lock_guard<std::mutex> batch_lock(m_batch_mutex);
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    auto it = m_batch_pending.find(batch[i].thread_id);
+                    if (it != m_batch_pending.end() && --it->second == 0) {
+                        m_batch_pending.erase(it);
+                    }
+                }
+            }
+            m_batch_cv.notify_all();
+
+            try {
+                sweep_old_logs();
+            } catch (const std::exception& e) {
+                std::cerr << "Async log error: " << e.what() << std::endl;
+            }
+        }
+
+        /// \brief Runs retention after a write.
+        /// \details High-throughput mode with a sweep interval leaves retention to
+        /// the sweep thread, off the write path.
+        void sweep_old_logs() {
+            if (m_config.high_throughput && m_config.retention_sweep_interval_ms > 0) return;
+            remove_old_logs();
+        }
+
+        /// \brief Removes expired files every `retention_sweep_interval_ms`.
+        /// \details Runs on its own thread, so retention also happens while the
+        /// logger is idle. Only lists and removes expired files, so it never takes m_mutex.
+        void run_retention_sweep() {
+            std::unique_lock<std::mutex> lock(m_sweep_mutex);
+            for (;;) {
+                m_sweep_cv.wait_for(lock, std::chrono::milliseconds(m_config.retention_sweep_interval_ms),
+                                    [this]() { return m_is_sweep_stopping; });
+                if (m_is_sweep_stopping) return;
+                lock.unlock();
+                try {
+                    remove_old_logs();
+                } catch (const std::exception& e) {
+                    std::cerr << "Log retention error: " << e.what() << std::endl;
+                }
+                lock.lock();
+            }
+        }
+
+        void stop_retention_sweep() {
+            if (!m_sweep_thread.joinable()) return;
+            {
+                std::lock_guard<std::mutex> lock(m_sweep_mutex);
+                m_is_sweep_stopping = true;
+            }
+            m_sweep_cv.notify_one();
+            m_sweep_thread.join();
+        }
+
+        /// \brief Remembers a written file for the next sync_files() barrier.
+        /// \details Must be called with m_mutex held.
+        void track_unsynced_file(const std::string& file_path) {
+#           if defined(_WIN32)
+            (void)file_path;
+#           else
+            const size_t max_unsynced_files = 65536;
+            if (m_is_unsynced_overflow) return;
+            if (m_unsynced_paths.size() >= max_unsynced_files) {
+                m_unsynced_paths.clear();
+                m_is_unsynced_overflow = true;
+                return;
+            }
+            m_unsynced_paths.push_back(file_path);
+#           endif
+        }
+
+        /// \brief Creates the next file path of the current name block.
+        /// \details One random hash is drawn per block and each name appends a
+        /// four-digit hex sequence, so names stay unique and sort in write order.
+        /// \param timestamp_ms The timestamp in milliseconds.
+        /// \return The unique file path.
+        std::string next_block_file_path(int64_t timestamp_ms) {
+            if (m_name_block_left == 0) {
+                start_name_block();
+            }
+            --m_name_block_left;
+            char seq[8] = {0};
+            snprintf(seq, sizeof(seq), "_%.4x", static_cast<unsigned>(m_name_block_seq++));
+            if (m_directory_path.empty()) {
+                m_directory_path = get_directory_path();
+            }
+            return m_directory_path + "/" + format_timestamp(timestamp_ms) + "-" + m_name_block_hash + seq + ".log";
+        }
+
+        /// \brief Draws a new hash and resets the block sequence.
+        void start_name_block() {
+            const size_t max_block = 0x10000;
+            m_name_block_hash = generate_fixed_length_hash(m_config.hash_length);
+            m_name_block_left = m_config.name_block_size == 0 ? 1 : (std::min)(m_config.name_block_size, max_block);
+            m_name_block_seq = 0;
+        }
+
+        /// \brief Writes a log message to a new unique file without stream overhead.
+        /// \details On POSIX the file is created with `O_CREAT|O_EXCL`. On Linux it
+        /// is first written as an anonymous `O_TMPFILE` and linked into place, so
+        /// readers never observe a partially written file. A name collision
+        /// starts a new name block and retries.
+        /// \param message The log message to write.
+        /// \param timestamp_ms The timestamp of the log message in milliseconds.
+        /// \return The path of the file the message was written to.
+        std::string write_log_fast(const std::string& message, int64_t timestamp_ms) {
+#           if defined(_WIN32)
+            const std::string file_path = next_block_file_path(timestamp_ms);
+            std::ofstream file(utf8_to_ansi(file_path), std::ios_base::binary);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open log file: " + file_path);
+            }
+            file.write(message.data(), message.size());
+            return file_path;
+#           else
+#               if defined(O_CLOEXEC)
+            const int cloexec_flag = O_CLOEXEC;
+#               else
+            const int cloexec_flag = 0;
+#               endif
+            const int max_attempts = 8;
+            for (int attempt = 0; attempt < max_attempts; ++attempt) {
+                const std::string file_path = next_block_file_path(timestamp_ms);
+#               if defined(O_TMPFILE)
+                if (m_use_tmpfile) {
+                    const int fd = ::open(m_directory_path.c_str(), O_TMPFILE | O_WRONLY | cloexec_flag, 0644);
+                    if (fd >= 0) {
+                        const bool is_written = write_fd(fd, message.data(), message.size());
+                        char proc_path[64] = {0};
+                        snprintf(proc_path, sizeof(proc_path), "/proc/self/fd/%d", fd);
+                        const int link_result = is_written
+                            ? ::linkat(AT_FDCWD, proc_path, AT_FDCWD, file_path.c_str(), AT_SYMLINK_FOLLOW)
+                            : -1;
+                        const int link_error = errno;
+                        ::close(fd);
+                        if (!is_written) {
+                            throw std::runtime_error("Failed to write log file: " + file_path);
+                        }
+                        if (link_result == 0) {
+                            track_unsynced_file(file_path);
+                            return file_path;
+                        }
+                        if (link_error == EEXIST) {
+                            m_name_block_left = 0;
+                            continue;
+                        }
+                    }
+                    // Filesystem without O_TMPFILE or no /proc: use plain exclusive creation.
+                    m_use_tmpfile = false;
+                }
+#               endif
+                const int fd = ::open(file_path.c_str(), O_WRONLY | O_CREAT | O_EXCL | cloexec_flag, 0644);
+                if (fd < 0) {
+                    if (errno == EEXIST) {
+                        m_name_block_left = 0;
+                        continue;
+                    }
+                    throw std::runtime_error("Failed to open log file: " + file_path);
+                }
+                const bool is_written = write_fd(fd, message.data(), message.size());
+                ::close(fd);
+                if (!is_written) {
+                    ::unlink(file_path.c_str());
+                    throw std::runtime_error("Failed to write log file: " + file_path);
+                }
+                track_unsynced_file(file_path);
+                return file_path;
+            }
+            throw std::runtime_error("Failed to create unique log file in: " + m_directory_path);
+#           endif
+        }
+
+#       if !defined(_WIN32)
+        /// \brief Writes a whole buffer to a descriptor, retrying short writes.
+        static bool write_fd(int fd, const char* data, size_t size) {
+            while (size > 0) {
+                const ssize_t written = ::write(fd, data, size);
+                if (written < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+            return true;
+        }
+#       endif
+
         /// \brief Creates a unique file path based on the timestamp and a hash.
         /// \param timestamp_ms The timestamp in milliseconds.
         /// \return The unique file path.
@@ -777,6 +1182,7 @@ namespace logit {
         /// \return The last log file name for the calling thread, or an empty string if none exists.
         std::string get_last_log_file_name() const {
             auto thread_id = std::this_thread::get_id();
+            wait_batch_records(thread_id);
             std::unique_lock<std::mutex> lock(m_thread_log_info_mutex);
             m_pending_logs_cv.wait(lock, [this, thread_id]() {
                 auto it = m_thread_log_info.find(thread_id);
@@ -797,6 +1203,7 @@ namespace logit {
         /// \return The last log file path for the calling thread, or an empty string if none exists.
         std::string get_last_log_file_path() const {
             auto thread_id = std::this_thread::get_id();
+            wait_batch_records(thread_id);
             std::unique_lock<std::mutex> lock(m_thread_log_info_mutex);
             m_pending_logs_cv.wait(lock, [this, thread_id]() {
                 auto it = m_thread_log_info.find(thread_id);
@@ -809,6 +1216,24 @@ namespace logit {
             return std::string();
         }
 
+        /// \brief Waits until the records a thread queued in high-throughput mode are written.
+        /// \details Waits for the drain task. When the queue policy discarded it,
+        /// schedules a replacement instead of draining on the caller's thread.
+        void wait_batch_records(std::thread::id thread_id) const {
+            if (!m_config.high_throughput) return;
+            std::unique_lock<std::mutex> lock(m_batch_mutex);
+            while (m_batch_pending.find(thread_id) != m_batch_pending.end()) {
+                if (!m_is_batch_scheduled && !m_batch.empty()) {
+                    m_is_batch_scheduled = true;
+                    lock.unlock();
+                    m_schedule_batch_drain();
+                    lock.lock();
+                    continue;
+                }
+                m_batch_cv.wait(lock);
+            }
+        }
+
         /// \brief Retrieves the timestamp of the last log.
         /// \return The timestamp of the last log in milliseconds.
         int64_t get_last_log_ts() const {
@@ -926,6 +1351,102 @@ namespace logit {
             return results;
         }
 
+        /// \brief Reads a chunk of one log file into a caller-provided buffer.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Offset of the first byte to read.
+        /// \param buffer Destination buffer.
+        /// \param capacity Size of `buffer` in bytes.
+        /// \return Chunk result. Compressed files are unreadable.
+        LogFileChunkResult read_log_file_chunk(
+                const std::string& path,
+                uint64_t offset,
+                char* buffer,
+                std::size_t capacity) const override {
+            LogFileChunkResult result;
+            result.offset = offset;
+            result.next_offset = offset;
+            if (!try_make_log_file_info(path, result.file)) {
+                result.file.path = path;
+                result.file.name = get_file_name(path);
+                return result;
+            }
+            if (result.file.is_compressed) return result;
+
+            result.ok = detail::read_file_chunk(
+                to_native_path(path), offset, buffer, capacity, result.size, result.file_size);
+            if (!result.ok) {
+                result.size = 0;
+                return result;
+            }
+            result.next_offset = offset + result.size;
+            result.is_eof = result.next_offset >= result.file_size;
+            return result;
+        }
+
+        /// \brief Reads a byte range of one log file.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Offset of the first byte to read.
+        /// \param length Maximum number of bytes to read.
+        /// \return Read result. Compressed files are unreadable.
+        LogFileReadResult read_log_file_range(const std::string& path, uint64_t offset, uint64_t length) const override {
+            LogFileReadResult result;
+            if (!try_make_log_file_info(path, result.file)) {
+                result.file.path = path;
+                result.file.name = get_file_name(path);
+                return result;
+            }
+            if (result.file.is_compressed) return result;
+
+            const std::string native_path = to_native_path(path);
+            uint64_t file_size = 0;
+            if (!detail::get_file_size(native_path, file_size)) return result;
+            if (offset >= file_size) {
+                result.ok = true;
+                return result;
+            }
+            std::size_t size = 0;
+            result.content.resize(static_cast<std::size_t>((std::min)(length, file_size - offset)));
+            result.ok = detail::read_file_chunk(
+                native_path, offset, &result.content[0], result.content.size(), size, file_size);
+            result.content.resize(result.ok ? size : 0);
+            return result;
+        }
+
+        /// \brief Iterates over the lines of one log file from the last one backwards.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param callback Receives each line; return false to stop.
+        /// \return True when the file was read.
+        bool for_each_log_file_line_reverse(
+                const std::string& path,
+                const std::function<bool(const std::string&)>& callback) const override {
+            LogFileInfo info;
+            if (!try_make_log_file_info(path, info) || info.is_compressed) return false;
+            return detail::for_each_file_line_reverse(to_native_path(path), callback);
+        }
+
+        /// \brief Checks whether one log file has content beyond `offset`.
+        /// \details Unique files are complete once written, so this never blocks.
+        /// \param path Full path returned by `list_log_files()`.
+        /// \param offset Content size the caller has already consumed.
+        /// \param timeout_ms Ignored.
+        /// \return True when the file size differs from `offset`.
+        bool wait_log_file_data(const std::string& path, uint64_t offset, int64_t timeout_ms) const override {
+            (void)timeout_ms;
+            LogFileInfo info;
+            uint64_t file_size = 0;
+            if (!try_make_log_file_info(path, info) || info.is_compressed) return false;
+            if (!detail::get_file_size(to_native_path(path), file_size)) return false;
+            return file_size != offset;
+        }
+
+    private:
+        std::string to_native_path(const std::string& path) const {
+#           if defined(_WIN32)
+            return utf8_to_ansi(path);
+#           else
+            return path;
+#           endif
+        }
 
     }; // UniqueFileLogger
 
@@ -9,9 +9,16 @@
 
 namespace logit {
 
+    /// \brief Wire encoding of OTLP/HTTP log payloads.
+    enum class OtlpEncoding {
+        Json,     ///< OTLP/HTTP JSON (`application/json`).
+        Protobuf  ///< Binary ExportLogsServiceRequest (`application/x-protobuf`).
+    };
+
     /// \struct OtlpJsonFormatConfig
-    /// \brief Serialization settings for OTLP JSON payload construction.
+    /// \brief Serialization settings for OTLP payload construction.
     struct OtlpJsonFormatConfig {
+        OtlpEncoding encoding = OtlpEncoding::Json;   ///< Payload encoding.
         std::string service_name = "logit-app";       ///< `service.name` resource attribute.
         std::string service_namespace;                ///< Optional `service.namespace` resource attribute.
         std::string service_instance_id;              ///< Optional `service.instance.id` resource attribute.
@@ -12,6 +12,7 @@
 #include <cmath>
 #include <iomanip>
 #include <limits>
+#include <locale>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -26,15 +27,22 @@ namespace logit {
         std::string message;       ///< Formatted message body.
     };
 
-    /// \brief Escapes a string for JSON output.
-    /// \param value Input string.
-    /// \return Escaped JSON string content without surrounding quotes.
-    inline std::string otlp_json_escape(const std::string& value) {
-        std::string out;
-        out.reserve(value.size() + 16);
+    /// \brief Appends a string escaped for JSON output.
+    /// \param out Output buffer.
+    /// \param value Input string; written without surrounding quotes.
+    inline void otlp_append_json_escaped(std::string& out, const std::string& value) {
+        static const char* hex = "0123456789abcdef";
+        std::size_t run_start = 0;
 
-        for (size_t i = 0; i < value.size(); ++i) {
+        for (std::size_t i = 0; i < value.size(); ++i) {
             const unsigned char c = static_cast<unsigned char>(value[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+
+            // Copy the unescaped run in one piece.
+            out.append(value, run_start, i - run_start);
+            run_start = i + 1;
 
             switch (c) {
             case '"': out += "\\\""; break;
@@ -45,18 +53,23 @@ namespace logit {
             case '\r': out += "\\r"; break;
             case '\t': out += "\\t"; break;
             default:
-                if (c < 0x20) {
-                    static const char* hex = "0123456789abcdef";
-                    out += "\\u00";
-                    out += hex[(c >> 4) & 0x0F];
-                    out += hex[c & 0x0F];
-                } else {
-                    out += static_cast<char>(c);
-                }
+                out += "\\u00";
+                out += hex[(c >> 4) & 0x0F];
+                out += hex[c & 0x0F];
                 break;
             }
         }
 
+        out.append(value, run_start, value.size() - run_start);
+    }
+
+    /// \brief Escapes a string for JSON output.
+    /// \param value Input string.
+    /// \return Escaped JSON string content without surrounding quotes.
+    inline std::string otlp_json_escape(const std::string& value) {
+        std::string out;
+        out.reserve(value.size() + 16);
+        otlp_append_json_escaped(out, value);
         return out;
     }
 
@@ -76,68 +89,106 @@ namespace logit {
     }
 
     /// \brief Writes a comma before the next JSON value when needed.
-    /// \param os Output stream.
+    /// \param out Output buffer.
     /// \param first First-item flag to update.
-    inline void otlp_write_comma_if_needed(std::ostringstream& os, bool& first) {
+    inline void otlp_write_comma_if_needed(std::string& out, bool& first) {
         if (!first) {
-            os << ',';
+            out += ',';
         }
         first = false;
     }
 
+    /// \brief Writes the key part shared by all OTLP attributes.
+    /// \param out Output buffer.
+    /// \param key Attribute key.
+    /// \param value_type OTLP AnyValue field name.
+    inline void otlp_write_attr_prefix(std::string& out, const std::string& key, const char* value_type) {
+        out += "{\"key\":\"";
+        otlp_append_json_escaped(out, key);
+        out += "\",\"value\":{\"";
+        out += value_type;
+        out += "\":";
+    }
+
     /// \brief Writes a string OTLP attribute.
-    /// \param os Output stream.
+    /// \param out Output buffer.
     /// \param key Attribute key.
     /// \param value Attribute string value.
-    inline void otlp_write_string_attr(std::ostringstream& os, const std::string& key, const std::string& value) {
-        os << "{\"key\":\"" << otlp_json_escape(key)
-           << "\",\"value\":{\"stringValue\":\"" << otlp_json_escape(value) << "\"}}";
+    inline void otlp_write_string_attr(std::string& out, const std::string& key, const std::string& value) {
+        otlp_write_attr_prefix(out, key, "stringValue");
+        out += '"';
+        otlp_append_json_escaped(out, value);
+        out += "\"}}";
     }
 
     /// \brief Writes an int OTLP attribute.
-    /// \param os Output stream.
+    /// \param out Output buffer.
     /// \param key Attribute key.
     /// \param value Attribute integer value.
-    inline void otlp_write_int_attr(std::ostringstream& os, const std::string& key, int64_t value) {
-        os << "{\"key\":\"" << otlp_json_escape(key)
-           << "\",\"value\":{\"intValue\":\"" << value << "\"}}";
+    inline void otlp_write_int_attr(std::string& out, const std::string& key, int64_t value) {
+        otlp_write_attr_prefix(out, key, "intValue");
+        out += '"';
+        out += std::to_string(value);
+        out += "\"}}";
     }
 
     /// \brief Writes a bool OTLP attribute.
-    /// \param os Output stream.
+    /// \param out Output buffer.
     /// \param key Attribute key.
     /// \param value Attribute boolean value.
-    inline void otlp_write_bool_attr(std::ostringstream& os, const std::string& key, bool value) {
-        os << "{\"key\":\"" << otlp_json_escape(key)
-           << "\",\"value\":{\"boolValue\":" << (value ? "true" : "false") << "}}";
+    inline void otlp_write_bool_attr(std::string& out, const std::string& key, bool value) {
+        otlp_write_attr_prefix(out, key, "boolValue");
+        out += value ? "true" : "false";
+        out += "}}";
+    }
+
+    /// \brief Formats a finite double as a JSON number.
+    /// \details Uses the shortest of 15 or 17 significant digits that reads
+    /// back as the same double. Both directions use the classic locale, so a
+    /// global locale with a comma decimal separator cannot corrupt the JSON.
+    /// \param value Finite value.
+    /// \return Number text.
+    inline std::string otlp_format_double(double value) {
+        std::ostringstream stream;
+        stream.imbue(std::locale::classic());
+        stream << std::setprecision(15) << value;
+        std::string text = stream.str();
+
+        std::istringstream parser(text);
+        parser.imbue(std::locale::classic());
+        double parsed = 0.0;
+        if (!(parser >> parsed) || parsed != value) {
+            stream.str(std::string());
+            stream << std::setprecision(17) << value;
+            text = stream.str();
+        }
+        return text;
     }
 
     /// \brief Writes a double OTLP attribute.
-    /// \param os Output stream.
+    /// \details Finite values are formatted by \ref otlp_format_double.
+    /// \param out Output buffer.
     /// \param key Attribute key.
     /// \param value Attribute double value.
-    inline void otlp_write_double_attr(std::ostringstream& os, const std::string& key, double value) {
+    inline void otlp_write_double_attr(std::string& out, const std::string& key, double value) {
         if (std::isfinite(value)) {
-            os << "{\"key\":\"" << otlp_json_escape(key)
-               << "\",\"value\":{\"doubleValue\":"
-               << std::setprecision(std::numeric_limits<double>::max_digits10)
-               << value << "}}";
+            otlp_write_attr_prefix(out, key, "doubleValue");
+            out += otlp_format_double(value);
+            out += "}}";
         } else {
-            os << "{\"key\":\"" << otlp_json_escape(key)
-               << "\",\"value\":{\"stringValue\":\"" << otlp_json_escape(std::to_string(value)) << "\"}}";
+            otlp_write_string_attr(out, key, std::to_string(value));
         }
     }
 
     /// \brief Writes a uint64 OTLP attribute.
-    /// \param os Output stream.
+    /// \param out Output buffer.
     /// \param key Attribute key.
     /// \param value Attribute uint64 value.
-    inline void otlp_write_uint_attr(std::ostringstream& os, const std::string& key, uint64_t value) {
+    inline void otlp_write_uint_attr(std::string& out, const std::string& key, uint64_t value) {
         if (value <= static_cast<uint64_t>((std::numeric_limits<int64_t>::max)())) {
-            otlp_write_int_attr(os, key, static_cast<int64_t>(value));
+            otlp_write_int_attr(out, key, static_cast<int64_t>(value));
         } else {
-            os << "{\"key\":\"" << otlp_json_escape(key)
-               << "\",\"value\":{\"stringValue\":\"" << value << "\"}}";
+            otlp_write_string_attr(out, key, std::to_string(value));
         }
     }
 
@@ -154,50 +205,55 @@ namespace logit {
         return result;
     }
 
-    /// \brief Writes one OTLP JSON log record.
-    /// \param os Output stream.
-    /// \param item Log item to serialize.
+    /// \brief Passes an unsigned attribute to `sink`, as a string above the int64 range.
+    template <class Sink>
+    inline void otlp_visit_uint_attr(Sink& sink, const std::string& key, uint64_t value) {
+        if (value <= static_cast<uint64_t>((std::numeric_limits<int64_t>::max)())) {
+            sink.int_attr(key, static_cast<int64_t>(value));
+        } else {
+            sink.string_attr(key, std::to_string(value));
+        }
+    }
+
+    /// \brief Passes a double attribute to `sink`, as a string when not finite.
+    template <class Sink>
+    inline void otlp_visit_double_attr(Sink& sink, const std::string& key, double value) {
+        if (std::isfinite(value)) {
+            sink.double_attr(key, value);
+        } else {
+            sink.string_attr(key, std::to_string(value));
+        }
+    }
+
+    /// \brief Enumerates the attributes of one OTLP log record in export order.
+    /// \details Shared by the JSON and protobuf encoders. `sink` provides
+    /// `string_attr`, `int_attr`, `bool_attr` and `double_attr`.
+    /// \param item Log item to describe.
     /// \param config Export configuration.
-    inline void otlp_write_log_record_json(
-            std::ostringstream& os,
+    /// \param sink Attribute receiver.
+    template <class Sink>
+    inline void otlp_visit_log_record_attributes(
             const OtlpLogItem& item,
-            const OtlpJsonFormatConfig& config) {
+            const OtlpJsonFormatConfig& config,
+            Sink& sink) {
         const OtlpRecordSnapshot& r = item.record;
-        const int64_t time_unix_nano = r.timestamp_ms * 1000000LL;
-
-        os << '{';
-        os << "\"timeUnixNano\":\"" << time_unix_nano << "\",";
-        os << "\"severityText\":\"" << otlp_json_escape(to_c_str(r.log_level)) << "\",";
-        os << "\"severityNumber\":" << otlp_severity_number(r.log_level) << ',';
-        os << "\"body\":{\"stringValue\":\"" << otlp_json_escape(item.message) << "\"},";
-        os << "\"attributes\":[";
-
-        bool first = true;
 
         if (config.include_source) {
-            otlp_write_comma_if_needed(os, first);
-            otlp_write_string_attr(os, "code.file.path", r.file);
-
-            otlp_write_comma_if_needed(os, first);
-            otlp_write_int_attr(os, "code.line.number", r.line);
-
-            otlp_write_comma_if_needed(os, first);
-            otlp_write_string_attr(os, "code.function.name", r.function);
+            sink.string_attr("code.file.path", r.file);
+            sink.int_attr("code.line.number", r.line);
+            sink.string_attr("code.function.name", r.function);
         }
 
         if (config.include_thread_id) {
-            otlp_write_comma_if_needed(os, first);
-            otlp_write_string_attr(os, "thread.id", r.thread_id);
+            sink.string_attr("thread.id", r.thread_id);
         }
 
         if (config.include_format) {
-            otlp_write_comma_if_needed(os, first);
-            otlp_write_string_attr(os, "logit.format", r.format);
+            sink.string_attr("logit.format", r.format);
         }
 
         if (config.include_arg_names && !r.arg_names.empty()) {
-            otlp_write_comma_if_needed(os, first);
-            otlp_write_string_attr(os, "logit.arg_names", r.arg_names);
+            sink.string_attr("logit.arg_names", r.arg_names);
         }
 
         if (config.include_args && !r.args_array.empty()) {
@@ -230,80 +286,122 @@ namespace logit {
                 }
                 key_count[key] = 0;
 
-                otlp_write_comma_if_needed(os, first);
-
                 switch (arg.type) {
                 case VariableValue::ValueType::BOOL_VAL:
-                    otlp_write_bool_attr(os, key, arg.pod_value.bool_value);
+                    sink.bool_attr(key, arg.pod_value.bool_value);
                     break;
                 case VariableValue::ValueType::INT8_VAL:
-                    otlp_write_int_attr(os, key, static_cast<int64_t>(arg.pod_value.int8_value));
+                    sink.int_attr(key, static_cast<int64_t>(arg.pod_value.int8_value));
                     break;
                 case VariableValue::ValueType::INT16_VAL:
-                    otlp_write_int_attr(os, key, static_cast<int64_t>(arg.pod_value.int16_value));
+                    sink.int_attr(key, static_cast<int64_t>(arg.pod_value.int16_value));
                     break;
                 case VariableValue::ValueType::INT32_VAL:
-                    otlp_write_int_attr(os, key, static_cast<int64_t>(arg.pod_value.int32_value));
+                    sink.int_attr(key, static_cast<int64_t>(arg.pod_value.int32_value));
                     break;
                 case VariableValue::ValueType::INT64_VAL:
-                    otlp_write_int_attr(os, key, arg.pod_value.int64_value);
+                    sink.int_attr(key, arg.pod_value.int64_value);
                     break;
                 case VariableValue::ValueType::UINT8_VAL:
-                    otlp_write_uint_attr(os, key, static_cast<uint64_t>(arg.pod_value.uint8_value));
+                    otlp_visit_uint_attr(sink, key, static_cast<uint64_t>(arg.pod_value.uint8_value));
                     break;
                 case VariableValue::ValueType::UINT16_VAL:
-                    otlp_write_uint_attr(os, key, static_cast<uint64_t>(arg.pod_value.uint16_value));
+                    otlp_visit_uint_attr(sink, key, static_cast<uint64_t>(arg.pod_value.uint16_value));
                     break;
                 case VariableValue::ValueType::UINT32_VAL:
-                    otlp_write_uint_attr(os, key, static_cast<uint64_t>(arg.pod_value.uint32_value));
+                    otlp_visit_uint_attr(sink, key, static_cast<uint64_t>(arg.pod_value.uint32_value));
                     break;
                 case VariableValue::ValueType::UINT64_VAL:
-                    otlp_write_uint_attr(os, key, arg.pod_value.uint64_value);
+                    otlp_visit_uint_attr(sink, key, arg.pod_value.uint64_value);
                     break;
                 case VariableValue::ValueType::FLOAT_VAL:
-                    otlp_write_double_attr(os, key, static_cast<double>(arg.pod_value.float_value));
+                    otlp_visit_double_attr(sink, key, static_cast<double>(arg.pod_value.float_value));
                     break;
                 case VariableValue::ValueType::DOUBLE_VAL:
-                    otlp_write_double_attr(os, key, arg.pod_value.double_value);
+                    otlp_visit_double_attr(sink, key, arg.pod_value.double_value);
                     break;
                 case VariableValue::ValueType::LONG_DOUBLE_VAL:
-                    otlp_write_double_attr(os, key, static_cast<double>(arg.pod_value.long_double_value));
+                    otlp_visit_double_attr(sink, key, static_cast<double>(arg.pod_value.long_double_value));
                     break;
                 default:
-                    otlp_write_string_attr(os, key, arg.to_string());
+                    sink.string_attr(key, arg.to_string());
                     break;
                 }
             }
         }
 
-        otlp_write_comma_if_needed(os, first);
-        otlp_write_int_attr(os, "logit.logger_index", r.logger_index);
+        sink.int_attr("logit.logger_index", r.logger_index);
+        sink.bool_attr("logit.raw_mode", r.raw_mode);
+        sink.bool_attr("logit.print_mode", r.print_mode);
+        sink.bool_attr("logit.fmt_mode", r.fmt_mode);
+    }
 
-        otlp_write_comma_if_needed(os, first);
-        otlp_write_bool_attr(os, "logit.raw_mode", r.raw_mode);
+    /// \brief Attribute sink writing comma-separated OTLP JSON attributes.
+    struct OtlpJsonAttributeWriter {
+        std::string& out;   ///< Output buffer.
+        bool first = true;  ///< No attribute written yet.
 
-        otlp_write_comma_if_needed(os, first);
-        otlp_write_bool_attr(os, "logit.print_mode", r.print_mode);
+        explicit OtlpJsonAttributeWriter(std::string& buffer) : out(buffer) {}
 
-        otlp_write_comma_if_needed(os, first);
-        otlp_write_bool_attr(os, "logit.fmt_mode", r.fmt_mode);
+        void string_attr(const std::string& key, const std::string& value) {
+            otlp_write_comma_if_needed(out, first);
+            otlp_write_string_attr(out, key, value);
+        }
 
-        os << ']';
-        os << '}';
-    }
+        void int_attr(const std::string& key, int64_t value) {
+            otlp_write_comma_if_needed(out, first);
+            otlp_write_int_attr(out, key, value);
+        }
 
-    /// \brief Builds an OTLP ExportLogsServiceRequest JSON payload.
-    /// \param batch Log batch to serialize.
+        void bool_attr(const std::string& key, bool value) {
+            otlp_write_comma_if_needed(out, first);
+            otlp_write_bool_attr(out, key, value);
+        }
+
+        void double_attr(const std::string& key, double value) {
+            otlp_write_comma_if_needed(out, first);
+            otlp_write_double_attr(out, key, value);
+        }
+    };
+
+    /// \brief Appends one OTLP JSON log record.
+    /// \param os Output buffer.
+    /// \param item Log item to serialize.
     /// \param config Export configuration.
-    /// \return OTLP/HTTP JSON payload.
-    inline std::string build_otlp_logs_json_payload(
-            const std::vector<OtlpLogItem>& batch,
+    inline void otlp_write_log_record_json(
+            std::string& os,
+            const OtlpLogItem& item,
             const OtlpJsonFormatConfig& config) {
-        std::ostringstream os;
+        const OtlpRecordSnapshot& r = item.record;
+        const int64_t time_unix_nano = r.timestamp_ms * 1000000LL;
+
+        os += "{\"timeUnixNano\":\"";
+        os += std::to_string(time_unix_nano);
+        os += "\",\"severityText\":\"";
+        otlp_append_json_escaped(os, to_c_str(r.log_level));
+        os += "\",\"severityNumber\":";
+        os += std::to_string(otlp_severity_number(r.log_level));
+        os += ",\"body\":{\"stringValue\":\"";
+        otlp_append_json_escaped(os, item.message);
+        os += "\"},\"attributes\":[";
+
+        OtlpJsonAttributeWriter writer(os);
+        otlp_visit_log_record_attributes(item, config, writer);
+
+        os += "]}";
+    }
+
+    /// \brief Closes the arrays and objects opened by otlp_write_logs_json_header().
+    static const char OTLP_LOGS_JSON_FOOTER[] = "]}]}]}";
 
-        os << '{';
-        os << "\"resourceLogs\":[{";
-        os << "\"resource\":{\"attributes\":[";
+    /// \brief Length of OTLP_LOGS_JSON_FOOTER.
+    static const std::size_t OTLP_LOGS_JSON_FOOTER_SIZE = sizeof(OTLP_LOGS_JSON_FOOTER) - 1;
+
+    /// \brief Appends the ExportLogsServiceRequest envelope up to the opening of `logRecords`.
+    /// \param os Output buffer.
+    /// \param config Export configuration.
+    inline void otlp_write_logs_json_header(std::string& os, const OtlpJsonFormatConfig& config) {
+        os += "{\"resourceLogs\":[{\"resource\":{\"attributes\":[";
 
         bool resource_first = true;
         otlp_write_comma_if_needed(os, resource_first);
@@ -324,24 +422,28 @@ namespace logit {
             otlp_write_string_attr(os, "deployment.environment.name", config.deployment_environment);
         }
 
-        os << "]},";
-        os << "\"scopeLogs\":[{";
-        os << "\"scope\":{\"name\":\"logit-cpp\"},";
-        os << "\"logRecords\":[";
+        os += "]},\"scopeLogs\":[{\"scope\":{\"name\":\"logit-cpp\"},\"logRecords\":[";
+    }
+
+    /// \brief Builds an OTLP ExportLogsServiceRequest JSON payload.
+    /// \param batch Log batch to serialize.
+    /// \param config Export configuration.
+    /// \return OTLP/HTTP JSON payload.
+    inline std::string build_otlp_logs_json_payload(
+            const std::vector<OtlpLogItem>& batch,
+            const OtlpJsonFormatConfig& config) {
+        std::string os;
+        otlp_write_logs_json_header(os, config);
 
         for (size_t i = 0; i < batch.size(); ++i) {
             if (i != 0) {
-                os << ',';
+                os += ',';
             }
             otlp_write_log_record_json(os, batch[i], config);
         }
 
-        os << ']';
-        os << "}]";
-        os << "}]";
-        os << '}';
-
-        return os.str();
+        os.append(OTLP_LOGS_JSON_FOOTER, OTLP_LOGS_JSON_FOOTER_SIZE);
+        return os;
     }
 
 } // namespace logit
@@ -3,9 +3,10 @@
 #define _LOGIT_OTLP_PAYLOAD_SPLITTER_HPP_INCLUDED
 
 /// \file OtlpPayloadSplitter.hpp
-/// \brief Splits oversized OTLP log batches into multiple JSON payload chunks.
+/// \brief Splits oversized OTLP log batches into multiple JSON or protobuf payload chunks.
 
 #include "OtlpJsonSerializer.hpp"
+#include "OtlpProtobufSerializer.hpp"
 #include <string>
 #include <vector>
 
@@ -13,6 +14,10 @@ namespace logit {
 
     /// \brief Builds OTLP JSON payload chunks from a batch, splitting when a chunk
     ///        would exceed max_payload_bytes.
+    /// \details Single pass: the envelope is rendered once, each record is
+    /// rendered once into a reused buffer, and the exact chunk size is known
+    /// before a record is appended. A record larger than the limit on its
+    /// own still goes out as a chunk of one.
     /// \param batch Log items to serialize.
     /// \param format Serialization configuration.
     /// \param max_payload_bytes Maximum serialized size per chunk (0 = no splitting).
@@ -32,34 +37,113 @@ namespace logit {
         }
 
         std::vector<std::string> chunks;
-        std::vector<OtlpLogItem> current_payload;
+        std::string header;
+        otlp_write_logs_json_header(header, format);
+
+        std::string chunk = header;
+        std::size_t chunk_records = 0;
+        std::string record;
 
         for (std::size_t i = 0; i < batch.size(); ++i) {
-            std::vector<OtlpLogItem> candidate_payload = current_payload;
-            candidate_payload.push_back(batch[i]);
-
-            std::string candidate_json = build_otlp_logs_json_payload(candidate_payload, format);
-
-            if (candidate_json.size() <= max_payload_bytes) {
-                current_payload = std::move(candidate_payload);
-            } else if (current_payload.empty()) {
-                // Single oversized record: emit it as its own chunk anyway.
-                chunks.push_back(std::move(candidate_json));
-            } else {
-                // Close current chunk and start a new one with this record.
-                chunks.push_back(build_otlp_logs_json_payload(current_payload, format));
-                current_payload.clear();
-                current_payload.push_back(batch[i]);
+            record.clear();
+            otlp_write_log_record_json(record, batch[i], format);
+
+            const std::size_t separator = chunk_records == 0 ? 0 : 1;
+            if (chunk_records != 0 &&
+                chunk.size() + separator + record.size() + OTLP_LOGS_JSON_FOOTER_SIZE > max_payload_bytes) {
+                // Close the current chunk and start a new one with this record.
+                chunk.append(OTLP_LOGS_JSON_FOOTER, OTLP_LOGS_JSON_FOOTER_SIZE);
+                chunks.push_back(std::move(chunk));
+                chunk = header;
+                chunk_records = 0;
+            }
+
+            if (chunk_records != 0) {
+                chunk += ',';
             }
+            chunk += record;
+            ++chunk_records;
         }
 
-        if (!current_payload.empty()) {
-            chunks.push_back(build_otlp_logs_json_payload(current_payload, format));
+        chunk.append(OTLP_LOGS_JSON_FOOTER, OTLP_LOGS_JSON_FOOTER_SIZE);
+        chunks.push_back(std::move(chunk));
+        return chunks;
+    }
+
+    /// \brief Builds OTLP protobuf payload chunks from a batch, splitting when a chunk
+    ///        would exceed max_payload_bytes.
+    /// \details Same single pass and chunk boundaries rule as the JSON
+    /// variant; the exact chunk size comes from otlp_protobuf_payload_size().
+    /// \param batch Log items to serialize.
+    /// \param format Serialization configuration.
+    /// \param max_payload_bytes Maximum serialized size per chunk (0 = no splitting).
+    /// \return Vector of protobuf payloads, one per chunk.
+    inline std::vector<std::string> build_otlp_logs_protobuf_payload_chunks(
+            const std::vector<OtlpLogItem>& batch,
+            const OtlpJsonFormatConfig& format,
+            std::size_t max_payload_bytes) {
+        if (max_payload_bytes == 0) {
+            std::vector<std::string> chunks;
+            chunks.push_back(build_otlp_logs_protobuf_payload(batch, format));
+            return chunks;
+        }
+
+        if (batch.empty()) {
+            return {};
         }
 
+        std::vector<std::string> chunks;
+        const OtlpProtobufEnvelope envelope = make_otlp_protobuf_envelope(format);
+
+        std::string records;
+        std::size_t chunk_records = 0;
+        std::string record;
+
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            record.clear();
+            otlp_write_log_record_protobuf(record, batch[i], format);
+
+            const std::size_t field_size = otlp_pb_len_field_size(2, record.size());
+            if (chunk_records != 0 &&
+                otlp_protobuf_payload_size(envelope, records.size() + field_size) > max_payload_bytes) {
+                std::string chunk;
+                otlp_write_logs_protobuf_payload(chunk, envelope, records);
+                chunks.push_back(std::move(chunk));
+                records.clear();
+                chunk_records = 0;
+            }
+
+            otlp_pb_write_len_prefix(records, 2, record.size());
+            records += record;
+            ++chunk_records;
+        }
+
+        std::string chunk;
+        otlp_write_logs_protobuf_payload(chunk, envelope, records);
+        chunks.push_back(std::move(chunk));
         return chunks;
     }
 
+    /// \brief Builds payload chunks in the encoding selected by `format.encoding`.
+    /// \param batch Log items to serialize.
+    /// \param format Serialization configuration.
+    /// \param max_payload_bytes Maximum serialized size per chunk (0 = no splitting).
+    /// \return Vector of payloads, one per chunk.
+    inline std::vector<std::string> build_otlp_logs_payload_chunks(
+            const std::vector<OtlpLogItem>& batch,
+            const OtlpJsonFormatConfig& format,
+            std::size_t max_payload_bytes) {
+        if (format.encoding == OtlpEncoding::Protobuf) {
+            return build_otlp_logs_protobuf_payload_chunks(batch, format, max_payload_bytes);
+        }
+        return build_otlp_logs_json_payload_chunks(batch, format, max_payload_bytes);
+    }
+
+    /// \brief HTTP Content-Type of payloads in `encoding`.
+    inline const char* otlp_content_type(OtlpEncoding encoding) {
+        return encoding == OtlpEncoding::Protobuf ? "application/x-protobuf" : "application/json";
+    }
+
 } // namespace logit
 
 #endif // _LOGIT_OTLP_PAYLOAD_SPLITTER_HPP_INCLUDED
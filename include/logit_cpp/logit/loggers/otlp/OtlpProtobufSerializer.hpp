@@ -0,0 +1,233 @@
+#pragma once
+#ifndef _LOGIT_OTLP_PROTOBUF_SERIALIZER_HPP_INCLUDED
+#define _LOGIT_OTLP_PROTOBUF_SERIALIZER_HPP_INCLUDED
+
+/// \file OtlpProtobufSerializer.hpp
+/// \brief Dependency-free OTLP/HTTP protobuf encoding of logs.
+///
+/// Writes `opentelemetry.proto.collector.logs.v1.ExportLogsServiceRequest`
+/// by hand. Every nested length is computed before its message is written,
+/// so each record is encoded once and never moved.
+
+#include "OtlpJsonFormatConfig.hpp"
+#include "OtlpJsonSerializer.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace logit {
+
+    const uint32_t OTLP_PB_WIRE_VARINT = 0;  ///< Protobuf varint wire type.
+    const uint32_t OTLP_PB_WIRE_FIXED64 = 1; ///< Protobuf 64-bit wire type.
+    const uint32_t OTLP_PB_WIRE_LEN = 2;     ///< Protobuf length-delimited wire type.
+
+    /// \brief Number of bytes of `value` as a base-128 varint.
+    inline std::size_t otlp_pb_varint_size(uint64_t value) {
+        std::size_t size = 1;
+        while (value >= 0x80u) {
+            value >>= 7;
+            ++size;
+        }
+        return size;
+    }
+
+    /// \brief Appends `value` as a base-128 varint.
+    inline void otlp_pb_write_varint(std::string& out, uint64_t value) {
+        while (value >= 0x80u) {
+            out += static_cast<char>((value & 0x7Fu) | 0x80u);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    /// \brief Appends a field tag.
+    inline void otlp_pb_write_tag(std::string& out, uint32_t field, uint32_t wire_type) {
+        otlp_pb_write_varint(out, (static_cast<uint64_t>(field) << 3) | wire_type);
+    }
+
+    /// \brief Number of bytes of a field tag.
+    inline std::size_t otlp_pb_tag_size(uint32_t field) {
+        return otlp_pb_varint_size(static_cast<uint64_t>(field) << 3);
+    }
+
+    /// \brief Number of bytes of a length-delimited field with `length` bytes of content.
+    inline std::size_t otlp_pb_len_field_size(uint32_t field, std::size_t length) {
+        return otlp_pb_tag_size(field) + otlp_pb_varint_size(length) + length;
+    }
+
+    /// \brief Appends the tag and length of a length-delimited field; the content follows.
+    inline void otlp_pb_write_len_prefix(std::string& out, uint32_t field, std::size_t length) {
+        otlp_pb_write_tag(out, field, OTLP_PB_WIRE_LEN);
+        otlp_pb_write_varint(out, length);
+    }
+
+    /// \brief Appends a string or bytes field.
+    inline void otlp_pb_write_string(std::string& out, uint32_t field, const std::string& value) {
+        otlp_pb_write_len_prefix(out, field, value.size());
+        out += value;
+    }
+
+    /// \brief Appends a little-endian fixed64 field.
+    inline void otlp_pb_write_fixed64(std::string& out, uint32_t field, uint64_t value) {
+        otlp_pb_write_tag(out, field, OTLP_PB_WIRE_FIXED64);
+        for (int i = 0; i < 8; ++i) {
+            out += static_cast<char>((value >> (8 * i)) & 0xFFu);
+        }
+    }
+
+    /// \brief Attribute sink writing OTLP `KeyValue` messages into repeated field `field`.
+    /// \details AnyValue fields: 1 string_value, 2 bool_value, 3 int_value, 4 double_value.
+    struct OtlpProtobufAttributeWriter {
+        std::string& out; ///< Output buffer.
+        uint32_t field;   ///< Field number of the repeated `KeyValue`.
+
+        OtlpProtobufAttributeWriter(std::string& buffer, uint32_t attributes_field)
+            : out(buffer), field(attributes_field) {}
+
+        void string_attr(const std::string& key, const std::string& value) {
+            write_key(key, otlp_pb_len_field_size(1, value.size()));
+            otlp_pb_write_string(out, 1, value);
+        }
+
+        void int_attr(const std::string& key, int64_t value) {
+            const uint64_t bits = static_cast<uint64_t>(value);
+            write_key(key, otlp_pb_tag_size(3) + otlp_pb_varint_size(bits));
+            otlp_pb_write_tag(out, 3, OTLP_PB_WIRE_VARINT);
+            otlp_pb_write_varint(out, bits);
+        }
+
+        void bool_attr(const std::string& key, bool value) {
+            write_key(key, otlp_pb_tag_size(2) + 1);
+            otlp_pb_write_tag(out, 2, OTLP_PB_WIRE_VARINT);
+            out += value ? '\x01' : '\x00';
+        }
+
+        void double_attr(const std::string& key, double value) {
+            uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            write_key(key, otlp_pb_tag_size(4) + 8);
+            otlp_pb_write_fixed64(out, 4, bits);
+        }
+
+    private:
+        /// \brief Writes the `KeyValue` header and key, leaving an AnyValue of `value_size` bytes to write.
+        void write_key(const std::string& key, std::size_t value_size) {
+            const std::size_t key_value_size =
+                otlp_pb_len_field_size(1, key.size()) + otlp_pb_len_field_size(2, value_size);
+            otlp_pb_write_len_prefix(out, field, key_value_size);
+            otlp_pb_write_string(out, 1, key);
+            otlp_pb_write_len_prefix(out, 2, value_size);
+        }
+    };
+
+    /// \brief Appends the fields of one OTLP `LogRecord` message, without its own tag and length.
+    /// \details Carries the same fields as otlp_write_log_record_json():
+    /// time_unix_nano (1), severity_number (2), severity_text (3), body (5)
+    /// and attributes (6).
+    /// \param out Output buffer.
+    /// \param item Log item to serialize.
+    /// \param config Export configuration.
+    inline void otlp_write_log_record_protobuf(
+            std::string& out,
+            const OtlpLogItem& item,
+            const OtlpJsonFormatConfig& config) {
+        const OtlpRecordSnapshot& r = item.record;
+        const char* severity_text = to_c_str(r.log_level);
+        const std::size_t severity_text_size = std::strlen(severity_text);
+
+        otlp_pb_write_fixed64(out, 1, static_cast<uint64_t>(r.timestamp_ms * 1000000LL));
+        otlp_pb_write_tag(out, 2, OTLP_PB_WIRE_VARINT);
+        otlp_pb_write_varint(out, static_cast<uint64_t>(otlp_severity_number(r.log_level)));
+        otlp_pb_write_len_prefix(out, 3, severity_text_size);
+        out.append(severity_text, severity_text_size);
+        otlp_pb_write_len_prefix(out, 5, otlp_pb_len_field_size(1, item.message.size()));
+        otlp_pb_write_string(out, 1, item.message);
+
+        OtlpProtobufAttributeWriter writer(out, 6);
+        otlp_visit_log_record_attributes(item, config, writer);
+    }
+
+    /// \struct OtlpProtobufEnvelope
+    /// \brief Pre-encoded resource and scope of an ExportLogsServiceRequest.
+    struct OtlpProtobufEnvelope {
+        std::string resource; ///< ResourceLogs.resource field (1) with its tag and length.
+        std::string scope;    ///< ScopeLogs.scope field (1) with its tag and length.
+    };
+
+    /// \brief Encodes the resource attributes and instrumentation scope once per payload or batch.
+    /// \param config Export configuration.
+    /// \return Envelope shared by every chunk of a batch.
+    inline OtlpProtobufEnvelope make_otlp_protobuf_envelope(const OtlpJsonFormatConfig& config) {
+        std::string attributes;
+        OtlpProtobufAttributeWriter writer(attributes, 1);
+        writer.string_attr("service.name", config.service_name);
+        if (!config.service_namespace.empty()) {
+            writer.string_attr("service.namespace", config.service_namespace);
+        }
+        if (!config.service_instance_id.empty()) {
+            writer.string_attr("service.instance.id", config.service_instance_id);
+        }
+        if (!config.deployment_environment.empty()) {
+            writer.string_attr("deployment.environment.name", config.deployment_environment);
+        }
+
+        OtlpProtobufEnvelope envelope;
+        otlp_pb_write_len_prefix(envelope.resource, 1, attributes.size());
+        envelope.resource += attributes;
+
+        static const std::string scope_name = "logit-cpp";
+        otlp_pb_write_len_prefix(envelope.scope, 1, otlp_pb_len_field_size(1, scope_name.size()));
+        otlp_pb_write_string(envelope.scope, 1, scope_name);
+        return envelope;
+    }
+
+    /// \brief Exact size of a payload holding `records_size` bytes of encoded `log_records` fields.
+    inline std::size_t otlp_protobuf_payload_size(const OtlpProtobufEnvelope& envelope, std::size_t records_size) {
+        const std::size_t scope_logs_size = envelope.scope.size() + records_size;
+        const std::size_t resource_logs_size = envelope.resource.size() + otlp_pb_len_field_size(2, scope_logs_size);
+        return otlp_pb_len_field_size(1, resource_logs_size);
+    }
+
+    /// \brief Appends a complete ExportLogsServiceRequest around already encoded `log_records` fields.
+    /// \param out Output buffer.
+    /// \param envelope Pre-encoded resource and scope.
+    /// \param records Concatenated ScopeLogs.log_records fields (2) with tags and lengths.
+    inline void otlp_write_logs_protobuf_payload(
+            std::string& out,
+            const OtlpProtobufEnvelope& envelope,
+            const std::string& records) {
+        const std::size_t scope_logs_size = envelope.scope.size() + records.size();
+        const std::size_t resource_logs_size = envelope.resource.size() + otlp_pb_len_field_size(2, scope_logs_size);
+        out.reserve(out.size() + otlp_pb_len_field_size(1, resource_logs_size));
+        otlp_pb_write_len_prefix(out, 1, resource_logs_size);
+        out += envelope.resource;
+        otlp_pb_write_len_prefix(out, 2, scope_logs_size);
+        out += envelope.scope;
+        out += records;
+    }
+
+    /// \brief Builds an OTLP ExportLogsServiceRequest protobuf payload.
+    /// \param batch Log batch to serialize.
+    /// \param config Export configuration.
+    /// \return OTLP/HTTP protobuf payload.
+    inline std::string build_otlp_logs_protobuf_payload(
+            const std::vector<OtlpLogItem>& batch,
+            const OtlpJsonFormatConfig& config) {
+        std::string records;
+        std::string record;
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            record.clear();
+            otlp_write_log_record_protobuf(record, batch[i], config);
+            otlp_pb_write_len_prefix(records, 2, record.size());
+            records += record;
+        }
+
+        std::string out;
+        otlp_write_logs_protobuf_payload(out, make_otlp_protobuf_envelope(config), records);
+        return out;
+    }
+
+} // namespace logit
+
+#endif // _LOGIT_OTLP_PROTOBUF_SERIALIZER_HPP_INCLUDED
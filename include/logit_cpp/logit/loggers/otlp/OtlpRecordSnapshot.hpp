@@ -18,9 +18,9 @@ namespace logit {
     struct OtlpRecordSnapshot {
         LogLevel log_level = LogLevel::LOG_LVL_TRACE; ///< Log severity level.
         int64_t timestamp_ms = 0;                     ///< Timestamp in milliseconds.
-        std::string file;                             ///< Source file path.
+        detail::InternedStringRef file;               ///< Source file path (interned).
         int line = 0;                                 ///< Source line number.
-        std::string function;                         ///< Source function name.
+        detail::InternedStringRef function;           ///< Source function name (interned).
         std::string format;                           ///< Original message or format string.
         std::string arg_names;                        ///< Original argument names.
         std::vector<VariableValue> args_array;        ///< Structured argument values.
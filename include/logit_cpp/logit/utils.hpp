@@ -12,12 +12,14 @@
 
 #include "config.hpp"
 #include "enums.hpp"
+#include "detail/StringInterner.hpp"
 #include "utils/format.hpp"
 #include "utils/VariableValue.hpp"
 #include "utils/argument_utils.hpp"
 #include "utils/BufferedLogEntry.hpp"
 #include "utils/LogFileInfo.hpp"
 #include "utils/LogFileReadResult.hpp"
+#include "utils/LogFileChunkResult.hpp"
 #include "utils/encoding_utils.hpp"
 #include "utils/path_utils.hpp"
 #include "detail/LogContext.hpp"
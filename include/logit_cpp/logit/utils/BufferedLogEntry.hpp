@@ -23,6 +23,46 @@ namespace logit {
         std::string message;                         ///< Formatted message text stored in the buffer.
     };
 
+    /// \struct LogEntryView
+    /// \brief Non-owning view of a buffered log entry.
+    /// \details Passed to in-place visitors such as
+    /// `MemoryLogger::for_each_query()`. The referenced strings are valid only
+    /// for the duration of the visitor call.
+    struct LogEntryView {
+        LogLevel           level;        ///< Severity of the log entry.
+        int64_t            timestamp_ms; ///< Wall-clock timestamp in milliseconds.
+        const std::string& file;         ///< Source file path or leaf name.
+        int                line;         ///< Source line number.
+        const std::string& function;     ///< Function name captured at the call site.
+        const std::string& message;      ///< Formatted message text stored in the buffer.
+
+        LogEntryView(
+                LogLevel level,
+                int64_t timestamp_ms,
+                const std::string& file,
+                int line,
+                const std::string& function,
+                const std::string& message) :
+                level(level),
+                timestamp_ms(timestamp_ms),
+                file(file),
+                line(line),
+                function(function),
+                message(message) {}
+
+        /// \brief Copies the viewed fields into an owning entry.
+        BufferedLogEntry to_entry() const {
+            BufferedLogEntry entry;
+            entry.level = level;
+            entry.timestamp_ms = timestamp_ms;
+            entry.file = file;
+            entry.line = line;
+            entry.function = function;
+            entry.message = message;
+            return entry;
+        }
+    };
+
 } // namespace logit
 
 #endif // _LOGIT_BUFFERED_LOG_ENTRY_HPP_INCLUDED
@@ -0,0 +1,29 @@
+#pragma once
+#ifndef _LOGIT_LOG_FILE_CHUNK_RESULT_HPP_INCLUDED
+#define _LOGIT_LOG_FILE_CHUNK_RESULT_HPP_INCLUDED
+
+/// \file LogFileChunkResult.hpp
+/// \brief Public DTO that describes one chunk read from a persisted log file.
+
+#include "LogFileInfo.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace logit {
+
+    /// \brief Result of reading a chunk of a persisted log file into a caller-provided buffer.
+    /// \details Offsets refer to the uncompressed file content. Pass `next_offset`
+    /// to the next call to iterate over the file chunk by chunk.
+    struct LogFileChunkResult {
+        LogFileInfo  file;             ///< Metadata for the requested file.
+        uint64_t     offset = 0;       ///< Offset of the first byte copied into the buffer.
+        std::size_t  size = 0;         ///< Number of bytes copied into the buffer.
+        uint64_t     next_offset = 0;  ///< Offset that continues the iteration.
+        uint64_t     file_size = 0;    ///< Readable content size at the time of the read.
+        bool         is_eof = false;   ///< True when the chunk reached the end of the readable content.
+        bool         ok = false;       ///< Whether the read succeeded.
+    };
+
+} // namespace logit
+
+#endif // _LOGIT_LOG_FILE_CHUNK_RESULT_HPP_INCLUDED
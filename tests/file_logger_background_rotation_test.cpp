@@ -0,0 +1,168 @@
+#include "file_logger_test_utils.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace {
+
+using namespace file_logger_test;
+
+std::string rotated_path(const std::string& current, const std::string& suffix) {
+    std::string rotated = current;
+    const size_t pos = rotated.rfind(".log");
+    if (pos != std::string::npos) rotated.insert(pos, suffix);
+    return rotated;
+}
+
+bool check_size_rotation() {
+    std::system("rm -rf background_rotation_size");
+    logit::FileLogger::Config cfg = make_sync_config("background_rotation_size");
+    cfg.max_file_size_bytes = 20;
+    cfg.background_rotation = true;
+    bool ok = true;
+    std::string current;
+    {
+        logit::FileLogger logger(cfg);
+        const int64_t now_ms = current_day_ms();
+        const std::string msg = "0123456789"; // 10 bytes with newline
+        logger.log(make_record(now_ms), msg);
+        logger.log(make_record(now_ms), msg);
+        logger.log(make_record(now_ms), msg);
+        logger.wait();
+
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        ok = ok && file_exists(rotated_path(current, ".001"));
+        ok = ok && file_exists(rotated_path(current, ".002"));
+        const std::vector<logit::LogFileInfo> files = logger.list_log_files();
+        ok = ok && files.size() == 3;
+    }
+    ok = ok && read_file(current) == "0123456789\n";
+    ok = ok && !file_exists(current.substr(0, current.find_last_of('/') + 1) + ".logit-next.log");
+    std::system("rm -rf background_rotation_size");
+    return ok;
+}
+
+bool check_interval_rotation(bool background_rotation) {
+    std::system("rm -rf background_rotation_interval");
+    logit::FileLogger::Config cfg = make_sync_config("background_rotation_interval");
+    cfg.rotation_interval_ms = 60000;
+    cfg.background_rotation = background_rotation;
+    bool ok = true;
+    std::string current;
+    {
+        logit::FileLogger logger(cfg);
+        const int64_t day_ms = current_day_ms();
+        logger.log(make_record(day_ms + 1000), "first");
+        logger.log(make_record(day_ms + 59000), "second");
+        logger.log(make_record(day_ms + 60000), "third");
+        logger.wait();
+
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    }
+    ok = ok && read_file(rotated_path(current, ".001")) == "first\nsecond\n";
+    ok = ok && read_file(current) == "third\n";
+    ok = ok && !file_exists(rotated_path(current, ".002"));
+    std::system("rm -rf background_rotation_interval");
+    return ok;
+}
+
+bool check_path_follows_swap_and_leftover_spare() {
+    std::system("rm -rf background_rotation_swap && mkdir -p background_rotation_swap");
+    {
+        std::ofstream leftover("background_rotation_swap/.logit-next.log");
+        leftover << "stale\n";
+    }
+    logit::FileLogger::Config cfg = make_sync_config("background_rotation_swap");
+    cfg.max_file_size_bytes = 12;
+    cfg.background_rotation = true;
+    bool ok = true;
+    {
+        logit::FileLogger logger(cfg);
+        logger.wait();
+        const int64_t now_ms = current_day_ms();
+        logger.log(make_record(now_ms), "first-line");
+        logger.wait();
+        logger.log(make_record(now_ms), "second-line");
+
+        // The published path names the file receiving the bytes as soon as the helper renamed it.
+        const std::string current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        const logit::LogFileReadResult active = logger.read_log_file(current);
+        ok = ok && active.ok && active.content == "second-line\n";
+        ok = ok && read_file(rotated_path(current, ".002")) == "first-line\n";
+        // The leftover spare was recovered first instead of being prepended.
+        ok = ok && read_file(rotated_path(current, ".001")) == "stale\n";
+    }
+    std::system("rm -rf background_rotation_swap");
+    return ok;
+}
+
+bool check_stream_rotation_finishes_on_helper() {
+    std::system("rm -rf background_rotation_stream");
+    logit::FileLogger::Config cfg = make_sync_config("background_rotation_stream");
+    cfg.rotation_interval_ms = 60000;
+    cfg.stream_compress = logit::CompressType::GZIP;
+    cfg.background_rotation = true;
+    bool ok = true;
+    {
+        logit::FileLogger logger(cfg);
+        const int64_t day_ms = current_day_ms();
+        logger.log(make_record(day_ms + 1000), "first");
+        logger.log(make_record(day_ms + 59000), "second");
+        logger.log(make_record(day_ms + 60000), "third");
+        logger.wait();
+
+        // The helper appended the buffered frame and the seek table of the rotated file.
+        const std::string current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        const logit::LogFileReadResult rotated =
+            logger.read_log_file_time_range(rotated_path(current, ".001"), day_ms + 59000, day_ms + 59000);
+        ok = ok && rotated.ok && rotated.content == "first\nsecond\n";
+        const logit::LogFileReadResult active = logger.read_log_file(current);
+        ok = ok && active.ok && active.content == "third\n";
+    }
+    std::system("rm -rf background_rotation_stream");
+    return ok;
+}
+
+bool check_day_change_keeps_external_file() {
+    std::system("rm -rf background_rotation_day && mkdir -p background_rotation_day");
+    logit::FileLogger::Config cfg = make_sync_config("background_rotation_day");
+    cfg.background_rotation = true;
+    bool ok = true;
+    {
+        logit::FileLogger logger(cfg);
+        const int64_t day_ms = current_day_ms();
+        logger.log(make_record(day_ms + 1000), "today");
+        logger.wait();
+        const std::string today = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        const std::string dir = today.substr(0, today.find_last_of('/') + 1);
+        const std::string next_day = dir + time_shield::to_iso8601_date(
+            time_shield::ms_to_sec(day_ms) + time_shield::SEC_PER_DAY);
+        {
+            // Created behind the logger's back, so only the helper can notice it.
+            std::ofstream external((next_day + ".log").c_str());
+            external << "external\n";
+        }
+        logger.log(make_record(day_ms + 86400000 + 1000), "tomorrow");
+        logger.wait();
+
+        ok = ok && logger.get_string_param(logit::LoggerParam::LastFilePath) == next_day + ".log";
+        ok = ok && read_file(today) == "today\n";
+        const logit::LogFileReadResult active = logger.read_log_file(next_day + ".log");
+        ok = ok && active.ok && active.content == "tomorrow\n";
+        ok = ok && read_file(next_day + ".001.log") == "external\n";
+    }
+    std::system("rm -rf background_rotation_day");
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    if (!check_size_rotation()) return 1;
+    if (!check_interval_rotation(false)) return 1;
+    if (!check_interval_rotation(true)) return 1;
+    if (!check_path_follows_swap_and_leftover_spare()) return 1;
+    if (!check_stream_rotation_finishes_on_helper()) return 1;
+    if (!check_day_change_keeps_external_file()) return 1;
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "file_logger_test_utils.hpp"
+#if defined(LOGIT_HAS_ZLIB)
+#include <cstdlib>
+#include <string>
+
+using namespace file_logger_test;
+
+int main() {
+    bool ok = true;
+
+    // Levels drop linearly from 9 to 1 while up to four files are waiting.
+    logit::detail::CompressionWorker worker(logit::CompressType::GZIP, 9, "", 2, 0, 1, 4);
+    ok = ok && worker.select_level(0) == 9;
+    ok = ok && worker.select_level(2) == 5;
+    ok = ok && worker.select_level(4) == 1;
+    ok = ok && worker.select_level(100) == 1;
+
+    logit::detail::CompressionWorker fixed(logit::CompressType::GZIP, 6, "");
+    ok = ok && fixed.select_level(100) == 6;
+
+    std::system("rm -rf compression_pool_test");
+    logit::FileLogger::Config cfg = make_sync_config("compression_pool_test");
+    cfg.compress = logit::CompressType::GZIP;
+    cfg.compress_level = 9;
+    cfg.compress_threads = 3;
+    cfg.compress_fast_level = 1;
+    cfg.compress_backlog_threshold = 2;
+    cfg.max_file_size_bytes = 20; // one 10-byte record per file
+
+    std::string current;
+    {
+        logit::FileLogger logger(cfg);
+        for (int i = 0; i < 8; ++i) {
+            logger.log(make_record(current_day_ms()), "record-" + std::to_string(i) + "!!");
+        }
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        const int64_t backlog = logger.get_int_param(logit::LoggerParam::CompressionBacklog);
+        ok = ok && backlog >= 0 && backlog <= 7;
+        logger.wait();
+    }
+
+    for (int i = 1; i <= 7; ++i) {
+        std::string rotated = current;
+        rotated.insert(rotated.rfind(".log"), ".00" + std::to_string(i));
+        ok = ok && !file_exists(rotated);
+        ok = ok && gz_read_all(rotated + ".gz") == "record-" + std::to_string(i - 1) + "!!\n";
+    }
+    return ok ? 0 : 1;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,49 @@
+#include "file_logger_test_utils.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace file_logger_test;
+
+bool has_day(const std::vector<logit::LogFileInfo>& files, int64_t day_ms) {
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (files[i].day_start_ms == day_ms) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+/// Day changes expire the files the logger knows about; the directory is only listed at startup and shutdown.
+int main() {
+    std::system("rm -rf day_retention_test");
+    logit::FileLogger::Config cfg = make_sync_config("day_retention_test");
+    cfg.auto_delete_days = 2;
+    cfg.max_file_size_bytes = 20;
+    const int64_t day_ms = 86400000;
+    const int64_t first_day_ms = current_day_ms() - 10 * day_ms;
+    const std::string external = "day_retention_test/2000-01-01.log";
+    bool ok = true;
+    {
+        logit::FileLogger logger(cfg);
+        for (int i = 0; i < 4; ++i) {
+            logger.log(make_record(first_day_ms + i), "first-day-" + std::to_string(i));
+        }
+        logger.log(make_record(first_day_ms + day_ms), "second-day");
+        std::ofstream(external.c_str()).close();
+
+        logger.log(make_record(first_day_ms + 3 * day_ms), "fourth-day");
+        const std::vector<logit::LogFileInfo> files = logger.list_log_files();
+        ok = ok && !has_day(files, first_day_ms);
+        ok = ok && has_day(files, first_day_ms + day_ms) && has_day(files, first_day_ms + 3 * day_ms);
+        ok = ok && file_exists(external);
+
+        logger.shutdown();
+        ok = ok && !file_exists(external);
+    }
+    std::system("rm -rf day_retention_test");
+    return ok ? 0 : 1;
+}
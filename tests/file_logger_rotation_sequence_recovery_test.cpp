@@ -0,0 +1,46 @@
+#include "file_logger_test_utils.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace {
+
+using namespace file_logger_test;
+
+std::string make_rotated_path(const std::string& current, const std::string& suffix) {
+    std::string rotated = current;
+    rotated.insert(rotated.rfind(".log"), suffix);
+    return rotated;
+}
+
+} // namespace
+
+int main() {
+    std::system("rm -rf rotation_seq_recovery");
+    logit::FileLogger::Config cfg = make_sync_config("rotation_seq_recovery");
+    cfg.max_file_size_bytes = 20; // one 10-byte record per file
+    cfg.max_rotated_files = 3;
+    cfg.naming = logit::RotationNaming::Sequence;
+
+    std::string current;
+    {
+        logit::FileLogger logger(cfg);
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        // Files left by a previous run: the sequence continues after the highest one.
+        std::ofstream(make_rotated_path(current, ".002").append(".gz").c_str()).close();
+        std::ofstream(make_rotated_path(current, ".005").c_str()).close();
+
+        for (int i = 0; i < 4; ++i) {
+            logger.log(make_record(current_day_ms()), "0123456789");
+        }
+    }
+
+    bool ok = true;
+    ok = ok && file_exists(make_rotated_path(current, ".006"));
+    ok = ok && file_exists(make_rotated_path(current, ".007"));
+    ok = ok && file_exists(make_rotated_path(current, ".008"));
+    ok = ok && !file_exists(make_rotated_path(current, ".001"));
+    ok = ok && !file_exists(make_rotated_path(current, ".005"));
+    ok = ok && !file_exists(make_rotated_path(current, ".002") + ".gz");
+    return ok ? 0 : 1;
+}
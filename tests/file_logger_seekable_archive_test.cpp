@@ -0,0 +1,270 @@
+#include "file_logger_test_utils.hpp"
+#if defined(LOGIT_HAS_ZLIB)
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace file_logger_test;
+
+logit::FileLogger::Config make_config() {
+    logit::FileLogger::Config cfg = make_sync_config("seekable_gzip_test");
+    cfg.stream_compress = logit::CompressType::GZIP;
+    cfg.stream_frame_bytes = 14; // two records per frame
+    cfg.stream_flush_interval_ms = 0;
+    return cfg;
+}
+
+bool check_large_gzip_table() {
+    std::vector<logit::detail::SeekFrameEntry> entries(3000);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        entries[i].offset = i * 10;
+        entries[i].compressed_size = 10;
+        entries[i].size = 20;
+        entries[i].first_ts_ms = static_cast<int64_t>(i);
+        entries[i].last_ts_ms = static_cast<int64_t>(i) + 1;
+    }
+    std::string member;
+    std::string trailer;
+    if (!logit::detail::compress_string_gzip("x\n", member, 6)) return false;
+    // The table exceeds one FEXTRA field and is split over several members.
+    if (!logit::detail::make_seek_table_trailer(true, entries, trailer)) return false;
+    {
+        std::ofstream out("seekable_large_table.gz", std::ios_base::binary | std::ios_base::trunc);
+        out << member << trailer;
+    }
+    std::vector<logit::detail::SeekFrameEntry> parsed;
+    uint64_t table_offset = 0;
+    bool ok = logit::detail::read_seek_table("seekable_large_table.gz", true, parsed, table_offset);
+    ok = ok && parsed.size() == entries.size() && table_offset == member.size();
+    ok = ok && parsed[2999].offset == 29990 && parsed[2999].last_ts_ms == 3000;
+    ok = ok && gz_read_all("seekable_large_table.gz") == "x\n";
+    std::remove("seekable_large_table.gz");
+    return ok;
+}
+
+bool check_rotated_archive(int64_t day_ms) {
+    std::system("rm -rf seekable_rotated_test");
+    logit::FileLogger::Config cfg = make_sync_config("seekable_rotated_test");
+    cfg.max_file_size_bytes = 80;       // ten records per file
+    cfg.time_index_interval_bytes = 32; // four records per index block
+    cfg.compress = logit::CompressType::GZIP;
+    cfg.compress_async = false;
+    bool ok = true;
+    {
+        logit::FileLogger logger(cfg);
+        std::string expected;
+        for (int i = 0; i < 15; ++i) {
+            const std::string line = "line-" + std::to_string(10 + i);
+            logger.log(make_record(day_ms + 1000 * i), line);
+            if (i < 10) expected += line + "\n";
+        }
+        std::string rotated;
+        const std::vector<logit::LogFileInfo> files = logger.list_log_files();
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (files[i].is_compressed) rotated = files[i].path;
+        }
+        ok = ok && !rotated.empty();
+
+        // Regular compression writes frames and a seek table with the .idx timestamps.
+        std::vector<logit::detail::SeekFrameEntry> frames;
+        uint64_t table_offset = 0;
+        ok = ok && logit::detail::read_seek_table(rotated, true, frames, table_offset);
+        ok = ok && frames.size() == 1 && frames[0].size == 80;
+        ok = ok && frames[0].first_ts_ms == day_ms && frames[0].last_ts_ms == day_ms + 9000;
+        ok = ok && gz_read_all(rotated) == expected;
+
+        const logit::LogFileReadResult window = logger.read_log_file_time_range(rotated, day_ms, day_ms + 9000);
+        ok = ok && window.ok && window.content == expected;
+        const logit::LogFileReadResult bytes = logger.read_log_file_range(rotated, 72, 100);
+        ok = ok && bytes.ok && bytes.content == "line-19\n";
+    }
+    std::system("rm -rf seekable_rotated_test");
+    return ok;
+}
+
+/// Archives without a seek table (external tools, older releases) are decoded by a resumable cursor.
+bool check_archive_without_table(int64_t day_ms) {
+    std::system("rm -rf seekable_plain_gzip_test");
+    logit::FileLogger::Config cfg = make_sync_config("seekable_plain_gzip_test");
+    cfg.max_file_size_bytes = 80;
+    cfg.compress = logit::CompressType::GZIP;
+    cfg.compress_async = false;
+    bool ok = true;
+    {
+        logit::FileLogger logger(cfg);
+        for (int i = 0; i < 11; ++i) {
+            logger.log(make_record(day_ms + 1000 * i), "line-" + std::to_string(10 + i));
+        }
+        std::string archive;
+        const std::vector<logit::LogFileInfo> files = logger.list_log_files();
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (files[i].is_compressed) archive = files[i].path;
+        }
+        ok = ok && !archive.empty();
+
+        std::string expected;
+        std::string first;
+        std::string second;
+        for (int i = 0; i < 40; ++i) {
+            (i < 20 ? first : second) += "entry-" + std::to_string(100 + i) + "\n";
+            expected += "entry-" + std::to_string(100 + i) + "\n";
+        }
+        std::string member;
+        {
+            std::ofstream out(archive.c_str(), std::ios_base::binary | std::ios_base::trunc);
+            ok = ok && logit::detail::compress_string_gzip(first, member, 6);
+            out << member;
+            ok = ok && logit::detail::compress_string_gzip(second, member, 6);
+            out << member;
+        }
+        std::vector<logit::detail::SeekFrameEntry> frames;
+        uint64_t table_offset = 0;
+        ok = ok && !logit::detail::read_seek_table(archive, true, frames, table_offset);
+
+        std::string chunked;
+        char buffer[16];
+        uint64_t offset = 0;
+        for (int guard = 0; ok && guard < 1000; ++guard) {
+            const logit::LogFileChunkResult chunk = logger.read_log_file_chunk(archive, offset, buffer, sizeof(buffer));
+            ok = ok && chunk.ok && chunk.offset == offset;
+            chunked.append(buffer, chunk.size);
+            offset = chunk.next_offset;
+            if (chunk.is_eof) break;
+        }
+        ok = ok && chunked == expected;
+
+        const logit::LogFileReadResult bytes = logger.read_log_file_range(archive, 18, 20);
+        ok = ok && bytes.ok && bytes.content == expected.substr(18, 20);
+
+        std::vector<std::string> tail;
+        ok = ok && logger.for_each_log_file_line_reverse(archive, [&tail](const std::string& line) {
+            tail.push_back(line);
+            return tail.size() < 2;
+        });
+        ok = ok && tail.size() == 2 && tail[0] == "entry-139" && tail[1] == "entry-138";
+
+        ok = ok && logger.wait_log_file_data(archive, 0, 0);
+        ok = ok && !logger.wait_log_file_data(archive, expected.size(), 0);
+
+        // An appended member is picked up from where the previous pass ended.
+        {
+            std::ofstream out(archive.c_str(), std::ios_base::binary | std::ios_base::app);
+            ok = ok && logit::detail::compress_string_gzip("entry-140\n", member, 6);
+            out << member;
+        }
+        ok = ok && logger.wait_log_file_data(archive, expected.size(), 0);
+        const logit::LogFileChunkResult appended = logger.read_log_file_chunk(archive, offset, buffer, sizeof(buffer));
+        ok = ok && appended.ok && appended.is_eof && std::string(buffer, appended.size) == "entry-140\n";
+    }
+    std::system("rm -rf seekable_plain_gzip_test");
+    return ok;
+}
+
+/// Late records make frame timestamps non-monotonic; the time range lookup must not stop early.
+bool check_out_of_order_records(int64_t day_ms) {
+    std::system("rm -rf seekable_unordered_test");
+    logit::FileLogger::Config cfg = make_sync_config("seekable_unordered_test");
+    cfg.stream_compress = logit::CompressType::GZIP;
+    cfg.stream_frame_bytes = 14; // two records per frame
+    cfg.stream_flush_interval_ms = 0;
+    bool ok = true;
+    {
+        logit::FileLogger logger(cfg);
+        logger.log(make_record(day_ms + 10000), "late-0");
+        logger.log(make_record(day_ms + 11000), "late-1");
+        logger.log(make_record(day_ms + 2000), "back-2");
+        logger.log(make_record(day_ms + 3000), "back-3");
+        logger.log(make_record(day_ms + 20000), "next-4");
+        logger.log(make_record(day_ms + 21000), "next-5");
+        logger.wait();
+        const std::string current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+
+        const logit::LogFileReadResult back = logger.read_log_file_time_range(current, day_ms + 2000, day_ms + 3000);
+        ok = ok && back.ok && back.content == "back-2\nback-3\n";
+        const logit::LogFileReadResult spanning = logger.read_log_file_time_range(current, day_ms, day_ms + 10000);
+        ok = ok && spanning.ok && spanning.content == "late-0\nlate-1\nback-2\nback-3\n";
+    }
+
+    std::vector<logit::detail::SeekFrameEntry> blocks(3);
+    const int64_t first_ts[] = {10, 2, 20};
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        blocks[i].first_ts_ms = first_ts[i];
+        blocks[i].last_ts_ms = first_ts[i] + 1;
+    }
+    ok = ok && logit::detail::find_seek_frame_range(blocks, 2, 3) == std::make_pair<size_t, size_t>(1, 2);
+    ok = ok && logit::detail::find_seek_frame_range(blocks, 30, 40) == std::make_pair<size_t, size_t>(3, 3);
+    std::sort(blocks.begin(), blocks.end(),
+              [](const logit::detail::SeekFrameEntry& a, const logit::detail::SeekFrameEntry& b) {
+                  return a.first_ts_ms < b.first_ts_ms;
+              });
+    ok = ok && logit::detail::find_seek_frame_range(blocks, 3, 11) == std::make_pair<size_t, size_t>(0, 2);
+    std::system("rm -rf seekable_unordered_test");
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    if (!check_large_gzip_table()) return 1;
+    if (!check_rotated_archive(current_day_ms())) return 1;
+    if (!check_archive_without_table(current_day_ms())) return 1;
+    if (!check_out_of_order_records(current_day_ms())) return 1;
+
+    std::system("rm -rf seekable_gzip_test");
+    const int64_t day_ms = current_day_ms();
+    std::string expected;
+    std::string current;
+    bool ok = true;
+
+    {
+        logit::FileLogger logger(make_config());
+        for (int i = 0; i < 10; ++i) {
+            const std::string line = "line-" + std::to_string(i);
+            logger.log(make_record(day_ms + 1000 * i), line);
+            expected += line + "\n";
+        }
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    }
+
+    std::vector<logit::detail::SeekFrameEntry> frames;
+    uint64_t table_offset = 0;
+    ok = ok && logit::detail::read_seek_table(current, true, frames, table_offset);
+    ok = ok && frames.size() == 5 && frames[2].first_ts_ms == day_ms + 4000 && frames[2].last_ts_ms == day_ms + 5000;
+    ok = ok && gz_read_all(current) == expected;
+
+    {
+        logit::FileLogger logger(make_config());
+        logger.log(make_record(day_ms + 20000), "line-20");
+        logger.log(make_record(day_ms + 21000), "line-21");
+        logger.wait();
+        expected += "line-20\nline-21\n";
+
+        const logit::LogFileReadResult full = logger.read_log_file(current);
+        ok = ok && full.ok && full.content == expected;
+
+        const logit::LogFileReadResult bytes = logger.read_log_file_range(current, 7, 10);
+        ok = ok && bytes.ok && bytes.content == "line-1\nlin";
+
+        const logit::LogFileReadResult tail = logger.read_log_file_range(current, expected.size() - 8, 100);
+        ok = ok && tail.ok && tail.content == "line-21\n";
+
+        const logit::LogFileReadResult window = logger.read_log_file_time_range(current, day_ms + 4500, day_ms + 5000);
+        ok = ok && window.ok && window.content == "line-4\nline-5\n";
+
+        const logit::LogFileReadResult reopened = logger.read_log_file_time_range(current, day_ms + 20000, day_ms + 30000);
+        ok = ok && reopened.ok && reopened.content == "line-20\nline-21\n";
+    }
+
+    ok = ok && logit::detail::read_seek_table(current, true, frames, table_offset) && frames.size() == 6;
+    ok = ok && gz_read_all(current) == expected;
+    std::system("rm -rf seekable_gzip_test");
+    return ok ? 0 : 1;
+}
+#else
+int main() { return 0; }
+#endif
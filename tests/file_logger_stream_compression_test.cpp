@@ -0,0 +1,96 @@
+#include "file_logger_test_utils.hpp"
+#if defined(LOGIT_HAS_ZLIB)
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace {
+
+using namespace file_logger_test;
+
+bool ends_with(const std::string& value, const std::string& suffix) {
+    return value.size() >= suffix.size() &&
+           value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool check_truncated_member() {
+    std::string first;
+    std::string second;
+    if (!logit::detail::compress_string_gzip("first\n", first, 6)) return false;
+    if (!logit::detail::compress_string_gzip("second\n", second, 6)) return false;
+    const std::string stream = first + second + second.substr(0, second.size() / 2);
+    std::string out;
+    if (!logit::detail::decompress_string_gzip_members(stream, out)) return false;
+    if (out != "first\nsecond\n") return false;
+    return !logit::detail::decompress_string_gzip_members("not gzip data", out);
+}
+
+bool check_quiet_flush() {
+    std::system("rm -rf stream_gzip_quiet_test");
+    logit::FileLogger::Config cfg = make_sync_config("stream_gzip_quiet_test");
+    cfg.stream_compress = logit::CompressType::GZIP;
+    cfg.stream_flush_interval_ms = 50;
+    bool ok = true;
+    {
+        logit::FileLogger logger(cfg);
+        logger.log(make_record(LOGIT_CURRENT_TIMESTAMP_MS()), "lonely");
+        const std::string current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+
+        // No further record arrives; the frame is appended once the interval elapses.
+        std::string on_disk;
+        for (int i = 0; i < 100 && on_disk.empty(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            on_disk = gz_read_all(current);
+        }
+        ok = ok && on_disk == "lonely\n";
+        logit::LogFileReadResult result = logger.read_log_file(current);
+        ok = ok && result.ok && result.content == "lonely\n";
+    }
+    std::system("rm -rf stream_gzip_quiet_test");
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    if (!check_truncated_member()) return 1;
+    if (!check_quiet_flush()) return 1;
+
+    std::system("rm -rf stream_gzip_test");
+    logit::FileLogger::Config cfg = make_sync_config("stream_gzip_test");
+    cfg.stream_compress = logit::CompressType::GZIP;
+    cfg.stream_frame_bytes = 16;
+    cfg.stream_flush_interval_ms = 0;
+
+    const std::string expected = "alpha\nbravo\ncharlie\ndelta\necho\n";
+    std::string current;
+    bool ok = true;
+    {
+        logit::FileLogger logger(cfg);
+        const int64_t now_ms = LOGIT_CURRENT_TIMESTAMP_MS();
+        logger.log(make_record(now_ms), "alpha");
+        logger.log(make_record(now_ms), "bravo");
+        logger.log(make_record(now_ms), "charlie");
+        logger.log(make_record(now_ms), "delta");
+        logger.log(make_record(now_ms), "echo");
+
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        ok = ok && ends_with(current, ".log.gz");
+
+        // Only complete frames are visible before wait().
+        logit::LogFileReadResult partial = logger.read_log_file(current);
+        ok = ok && partial.ok && partial.file.is_compressed;
+        ok = ok && partial.content == "alpha\nbravo\ncharlie\n";
+
+        logger.wait();
+        logit::LogFileReadResult full = logger.read_log_file(current);
+        ok = ok && full.ok && full.content == expected;
+    }
+    ok = ok && gz_read_all(current) == expected;
+    std::system("rm -rf stream_gzip_test");
+    return ok ? 0 : 1;
+}
+#else
+int main() { return 0; }
+#endif
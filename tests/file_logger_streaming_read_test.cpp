@@ -0,0 +1,97 @@
+#include <logit.hpp>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string make_unique_directory_name(const std::string& prefix) {
+    const long long stamp = static_cast<long long>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+    return prefix + "_" + std::to_string(stamp);
+}
+
+std::string read_by_chunks(int logger_index, const std::string& path, uint64_t offset) {
+    char buffer[16];
+    std::string content;
+    for (;;) {
+        const logit::LogFileChunkResult chunk =
+            LOGIT_READ_LOG_FILE_CHUNK(logger_index, path, offset, buffer, sizeof(buffer));
+        if (!chunk.ok) return "<error>";
+        content.append(buffer, chunk.size);
+        offset = chunk.next_offset;
+        if (chunk.is_eof) break;
+    }
+    return content;
+}
+
+std::vector<std::string> last_lines(int logger_index, const std::string& path, size_t count) {
+    std::vector<std::string> lines;
+    LOGIT_FOR_EACH_LOG_FILE_LINE_REVERSE(logger_index, path, [&](const std::string& line) {
+        lines.push_back(line);
+        return lines.size() < count;
+    });
+    return lines;
+}
+
+} // namespace
+
+int main() {
+    logit::FileLogger::Config cfg;
+    cfg.directory = make_unique_directory_name("streaming_read_logs");
+    cfg.async = false;
+    logit::Logger::get_instance().add_logger(
+        std::unique_ptr<logit::FileLogger>(new logit::FileLogger(cfg)),
+        std::unique_ptr<logit::SimpleLogFormatter>(new logit::SimpleLogFormatter("%v")));
+
+    logit::UniqueFileLogger::Config unique_cfg;
+    unique_cfg.directory = make_unique_directory_name("streaming_read_unique_logs");
+    unique_cfg.async = false;
+    logit::Logger::get_instance().add_logger(
+        std::unique_ptr<logit::UniqueFileLogger>(new logit::UniqueFileLogger(unique_cfg)),
+        std::unique_ptr<logit::SimpleLogFormatter>(new logit::SimpleLogFormatter("%v")));
+
+    std::string expected;
+    for (int i = 0; i < 40; ++i) {
+        const std::string line = "line-" + std::to_string(i);
+        LOGIT_INFO_TO(0, line);
+        expected += line + "\n";
+    }
+    const std::string path = LOGIT_GET_LAST_FILE_PATH(0);
+
+    if (read_by_chunks(0, path, 0) != expected) return 1;
+    if (read_by_chunks(0, path, 7) != expected.substr(7)) return 1;
+
+    const logit::LogFileReadResult range = LOGIT_READ_LOG_FILE_RANGE(0, path, 7, 10);
+    if (!range.ok || range.content != "line-1\nlin") return 1;
+
+    const std::vector<std::string> tail = last_lines(0, path, 3);
+    if (tail.size() != 3 || tail[0] != "line-39" || tail[1] != "line-38" || tail[2] != "line-37") {
+        return 1;
+    }
+
+    const uint64_t consumed = expected.size();
+    if (LOGIT_WAIT_LOG_FILE_DATA(0, path, consumed, 20)) return 1;
+
+    std::atomic<bool> has_woken(false);
+    std::thread follower([&]() {
+        has_woken = LOGIT_WAIT_LOG_FILE_DATA(0, path, consumed, 5000);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    LOGIT_INFO_TO(0, std::string("line-40"));
+    follower.join();
+    if (!has_woken) return 1;
+    if (read_by_chunks(0, path, consumed) != "line-40\n") return 1;
+
+    LOGIT_INFO_TO(1, std::string("unique-a"));
+    const std::string unique_path = LOGIT_GET_LAST_FILE_PATH(1);
+    if (read_by_chunks(1, unique_path, 0) != "unique-a") return 1;
+    const std::vector<std::string> unique_tail = last_lines(1, unique_path, 5);
+    if (unique_tail.size() != 1 || unique_tail[0] != "unique-a") return 1;
+    if (!LOGIT_WAIT_LOG_FILE_DATA(1, unique_path, 0, 0)) return 1;
+
+    LOGIT_SHUTDOWN();
+    return 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#ifndef _LOGIT_TESTS_FILE_LOGGER_TEST_UTILS_HPP_INCLUDED
+#define _LOGIT_TESTS_FILE_LOGGER_TEST_UTILS_HPP_INCLUDED
+
+/// \file file_logger_test_utils.hpp
+/// \brief Helpers shared by the FileLogger rotation, compression and index tests.
+
+#include <logit.hpp>
+#if defined(LOGIT_HAS_ZLIB)
+#include <zlib.h>
+#endif
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace file_logger_test {
+
+inline logit::LogRecord make_record(int64_t timestamp_ms) {
+    return logit::LogRecord(logit::LogLevel::LOG_LVL_INFO, timestamp_ms, __FILE__, __LINE__,
+                            "main", "", "", -1, false);
+}
+
+/// \brief Start of the current UTC day, so records land in today's file.
+inline int64_t current_day_ms() {
+    const int64_t now_ms = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    return now_ms - now_ms % 86400000;
+}
+
+/// \brief Synchronous FileLogger configuration writing to `directory`.
+inline logit::FileLogger::Config make_sync_config(const std::string& directory) {
+    logit::FileLogger::Config cfg;
+    cfg.directory = directory;
+    cfg.async = false;
+    return cfg;
+}
+
+inline bool file_exists(const std::string& path) {
+    std::ifstream in(path.c_str());
+    return in.good();
+}
+
+inline std::string read_file(const std::string& path) {
+    std::ifstream in(path.c_str(), std::ios_base::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+#if defined(LOGIT_HAS_ZLIB)
+/// \brief Decompresses a gzip file with zlib, independently of the logger's readers.
+inline std::string gz_read_all(const std::string& path) {
+    gzFile gz = gzopen(path.c_str(), "rb");
+    if (!gz) return std::string();
+    char buf[128];
+    std::string out;
+    int n;
+    while ((n = gzread(gz, buf, sizeof(buf))) > 0) out.append(buf, n);
+    gzclose(gz);
+    return out;
+}
+#endif
+
+} // namespace file_logger_test
+
+#endif // _LOGIT_TESTS_FILE_LOGGER_TEST_UTILS_HPP_INCLUDED
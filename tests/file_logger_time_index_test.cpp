@@ -0,0 +1,74 @@
+#include "file_logger_test_utils.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace file_logger_test;
+
+std::string make_line(int i) {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "line-%02d", i);
+    return buf;
+}
+
+std::string make_lines(int from, int to) {
+    std::string out;
+    for (int i = from; i <= to; ++i) out += make_line(i) + "\n";
+    return out;
+}
+
+logit::FileLogger::Config make_config() {
+    logit::FileLogger::Config cfg = make_sync_config("time_index_test");
+    cfg.max_file_size_bytes = 80;       // ten records per file
+    cfg.time_index_interval_bytes = 32; // four records per index block
+    return cfg;
+}
+
+} // namespace
+
+int main() {
+    std::system("rm -rf time_index_test");
+    const int64_t day_ms = current_day_ms();
+    std::string current;
+    bool ok = true;
+
+    {
+        logit::FileLogger logger(make_config());
+        for (int i = 0; i < 30; ++i) {
+            logger.log(make_record(day_ms + 1000 * i), make_line(i));
+        }
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+
+        const std::vector<logit::LogFileInfo> files = logger.list_log_files();
+        ok = ok && files.size() == 3;
+
+        const logit::LogFileReadResult live = logger.read_log_file_time_range(current, day_ms + 25000, day_ms + 25000);
+        ok = ok && live.ok && live.content == make_lines(24, 27);
+
+        const std::vector<logit::LogFileReadResult> first = logger.read_log_range(day_ms + 5000, day_ms + 6000);
+        ok = ok && first.size() == 1 && first[0].ok && first[0].content == make_lines(4, 7);
+
+        const std::vector<logit::LogFileReadResult> spanning = logger.read_log_range(day_ms + 9000, day_ms + 10000);
+        ok = ok && spanning.size() == 2;
+        ok = ok && spanning[0].content == make_lines(8, 9) && spanning[1].content == make_lines(10, 13);
+
+        const std::vector<logit::LogFileReadResult> none = logger.read_log_range(day_ms - 5000, day_ms - 1000);
+        ok = ok && none.empty();
+    }
+
+    ok = ok && file_exists(current + ".idx");
+
+    {
+        logit::FileLogger logger(make_config());
+        const logit::LogFileReadResult reopened = logger.read_log_file_time_range(current, day_ms + 21000, day_ms + 21000);
+        ok = ok && reopened.ok && reopened.content == make_lines(20, 23);
+
+        logger.clear_logs();
+        ok = ok && !file_exists(current + ".idx");
+    }
+
+    return ok ? 0 : 1;
+}
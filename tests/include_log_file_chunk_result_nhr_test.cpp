@@ -0,0 +1,13 @@
+#include <logit/utils.hpp>
+#include <logit/utils/LogFileChunkResult.hpp>
+
+int main() {
+    logit::LogFileChunkResult chunk;
+    chunk.file.name = "2026-04-02.log";
+    chunk.offset = 16;
+    chunk.size = 8;
+    chunk.next_offset = 24;
+    chunk.is_eof = true;
+    chunk.ok = true;
+    return chunk.ok && chunk.next_offset == chunk.offset + chunk.size ? 0 : 1;
+}
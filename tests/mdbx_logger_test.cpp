@@ -3,11 +3,17 @@
 
 #ifdef LOGIT_WITH_MDBX
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 #if __cplusplus >= 201703L
 #include <filesystem>
@@ -79,6 +85,36 @@ logit::LogRecord make_record(logit::LogLevel level, int64_t timestamp_ms, int li
         false);
 }
 
+logit::LogRecord make_file_record(logit::LogLevel level, int64_t timestamp_ms, const char* file, int line) {
+    return logit::LogRecord(
+        level,
+        timestamp_ms,
+        file,
+        line,
+        "make_file_record",
+        "message",
+        "",
+        -1,
+        false,
+        false,
+        false);
+}
+
+logit::LogRecord make_named_record(int64_t timestamp_ms, const char* file, const char* function) {
+    return logit::LogRecord(
+        logit::LogLevel::LOG_LVL_INFO,
+        timestamp_ms,
+        file,
+        1,
+        function,
+        "message",
+        "",
+        -1,
+        false,
+        false,
+        false);
+}
+
 mdbxc::Config make_raw_db_config(const std::string& path) {
     mdbxc::Config config;
     config.pathname = path;
@@ -144,6 +180,13 @@ void write_raw_record_value(const std::string& path, const std::string& key, con
     records.insert_or_assign(key, value);
 }
 
+std::string read_raw_record_value(const std::string& path, const std::string& key) {
+    auto connection = mdbxc::Connection::create(make_raw_db_config(path));
+    mdbxc::KeyValueTable<std::string, std::string> records(connection, "log_records_by_time");
+    auto value = records.find(key);
+    return value ? *value : std::string();
+}
+
 void test_sync_range_session_and_sequences() {
     const std::string path = make_db_path("sync");
     cleanup_db(path);
@@ -183,7 +226,7 @@ void test_sync_range_session_and_sequences() {
         assert(session_opt->app_name == "mdbx-test");
         assert(session_opt->start_time_ms > 0);
         assert(session_opt->end_time_ms == 0);
-        assert(session_opt->schema_version == 1);
+        assert(session_opt->schema_version == 2);
 
         logger.shutdown();
         session_opt = logger.read_session(session_id);
@@ -194,6 +237,110 @@ void test_sync_range_session_and_sequences() {
     cleanup_db(path);
 }
 
+void test_key_and_payload_cursors_survive_reopen() {
+    const std::string path = make_db_path("cursors");
+    cleanup_db(path);
+
+    logit::MdbxLogger::Config config;
+    config.path = path;
+    config.async = false;
+    config.large_payload_threshold = 4;
+    config.payload_preview_size = 2;
+
+    uint64_t first_payload_id = 0;
+    {
+        logit::MdbxLogger logger(config);
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 2500, 1), "a");
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 2500, 2), "large-payload-1");
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 2400, 3), "b");
+        auto records = logger.read_range(2500, 2501);
+        assert(records.size() == 2);
+        assert(records[1].sequence == 1);
+        first_payload_id = records[1].payload_id;
+        assert(first_payload_id != 0);
+        logger.shutdown();
+    }
+
+    {
+        logit::MdbxLogger logger(config);
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 2500, 4), "large-payload-2");
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 2400, 5), "c");
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 2500, 6), "d");
+
+        auto newest = logger.read_range(2500, 2501);
+        assert(newest.size() == 4);
+        assert(newest[2].sequence == 2);
+        assert(newest[2].line == 4);
+        assert(newest[2].payload_id > first_payload_id);
+        assert(newest[3].sequence == 3);
+
+        auto older = logger.read_range(2400, 2401);
+        assert(older.size() == 2);
+        assert(older[0].message == "b");
+        assert(older[1].message == "c");
+        assert(older[1].sequence == 1);
+
+        auto first_payload = logger.read_payload_data(first_payload_id);
+        assert(first_payload);
+        assert(*first_payload == "large-payload-1");
+        logger.shutdown();
+    }
+
+    cleanup_db(path);
+}
+
+void test_compact_rows_with_legacy_rows() {
+    const std::string path = make_db_path("compact");
+    cleanup_db(path);
+
+    const char* file = "src/network/very/long/path/to/Session.cpp";
+    logit::MdbxLogger::Config config;
+    config.path = path;
+    config.async = false;
+    {
+        config.record_schema_version = 1;
+        logit::MdbxLogger logger(config);
+        logger.log(make_file_record(logit::LogLevel::LOG_LVL_INFO, 2700, file, 10), "legacy-row");
+        logger.shutdown();
+    }
+    {
+        config.record_schema_version = 2;
+        logit::MdbxLogger logger(config);
+        logger.log(make_file_record(logit::LogLevel::LOG_LVL_WARN, 2701, file, -20), "compact-row");
+        logger.log(make_record(logit::LogLevel::LOG_LVL_ERROR, 2702, 30), "other-file");
+        logger.shutdown();
+    }
+
+    const std::string legacy_value = read_raw_record_value(path, logit::detail::make_mdbx_record_key(2700, 0));
+    const std::string compact_value = read_raw_record_value(path, logit::detail::make_mdbx_record_key(2701, 0));
+    assert(!legacy_value.empty());
+    assert(!compact_value.empty());
+    assert(compact_value.size() * 2 < legacy_value.size());
+
+    {
+        logit::MdbxLogger logger(config);
+        auto records = logger.read_range(2700, 2703);
+        assert(records.size() == 3);
+        assert(records[0].message == "legacy-row");
+        assert(records[0].file == file);
+        assert(records[1].message == "compact-row");
+        assert(records[1].timestamp_ms == 2701);
+        assert(records[1].level == logit::LogLevel::LOG_LVL_WARN);
+        assert(records[1].file == file);
+        assert(records[1].function == "make_file_record");
+        assert(records[1].line == -20);
+        assert(records[2].file == "mdbx_logger_test.cpp");
+        assert(records[2].function == "make_record");
+
+        logit::LogQuery by_file;
+        by_file.file = file;
+        assert(logger.count(by_file) == 2);
+        logger.shutdown();
+    }
+
+    cleanup_db(path);
+}
+
 void test_async_large_payload_spill() {
     const std::string path = make_db_path("payload");
     cleanup_db(path);
@@ -278,6 +425,143 @@ void test_gzip_payload_compression() {
 }
 #endif
 
+#if defined(LOGIT_HAS_ZSTD)
+std::string make_json_payload(int index) {
+    std::ostringstream os;
+    os << "{\"orders\":[";
+    for (int i = 0; i < 40; ++i) {
+        if (i > 0) os << ",";
+        os << "{\"id\":" << (index * 100 + i)
+           << ",\"symbol\":\"BTCUSDT\",\"side\":\"" << (i % 2 ? "BUY" : "SELL")
+           << "\",\"price\":" << (30000 + (index * 7 + i) % 997)
+           << ",\"status\":\"accepted\",\"venue\":\"primary\"}";
+    }
+    os << "]}";
+    return os.str();
+}
+
+void test_zstd_dictionary_payload_compression() {
+    const std::string path = make_db_path("zstd_dict");
+    cleanup_db(path);
+
+    logit::MdbxLogger::Config config;
+    config.path = path;
+    config.async = false;
+    config.large_payload_threshold = 1024;
+    config.payload_compression = logit::MdbxPayloadCompression::ZstdDictionary;
+    config.zstd_dictionary_size = 8 * 1024;
+    config.zstd_dictionary_sample_bytes = 256 * 1024;
+
+    uint64_t dictionary_payload_id = 0;
+    uint32_t dictionary_id = 0;
+    std::string dictionary_message;
+    {
+        logit::MdbxLogger logger(config);
+        // Training runs in the background; keep logging until it lands.
+        for (int i = 0; i < 4000 && dictionary_payload_id == 0; ++i) {
+            const std::string message = make_json_payload(i);
+            logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 6000 + i, i), message);
+            auto records = logger.read_range(6000 + i, 6001 + i);
+            assert(records.size() == 1);
+            auto payload = logger.read_payload(records[0].payload_id);
+            assert(payload);
+            if (payload->compression == logit::MdbxPayloadCompression::ZstdDictionary) {
+                dictionary_payload_id = payload->payload_id;
+                dictionary_id = payload->dictionary_id;
+                dictionary_message = message;
+
+                std::string plain;
+                const bool is_compressed = logit::detail::compress_string_zstd(
+                    message, plain, config.payload_compression_level);
+                assert(is_compressed);
+                assert(payload->data.size() < plain.size());
+            } else {
+                assert(payload->compression == logit::MdbxPayloadCompression::Zstd);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        assert(dictionary_payload_id != 0);
+        assert(dictionary_id != 0);
+
+        auto data = logger.read_payload_data(dictionary_payload_id);
+        assert(data);
+        assert(*data == dictionary_message);
+        logger.shutdown();
+    }
+
+    {
+        logit::MdbxLogger logger(config);
+        auto data = logger.read_payload_data(dictionary_payload_id);
+        assert(data);
+        assert(*data == dictionary_message);
+
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 20000, 1), make_json_payload(20000));
+        auto records = logger.read_range(20000, 20001);
+        assert(records.size() == 1);
+        auto payload = logger.read_payload(records[0].payload_id);
+        assert(payload);
+        assert(payload->compression == logit::MdbxPayloadCompression::ZstdDictionary);
+        assert(payload->dictionary_id == dictionary_id);
+        auto reopened_data = logger.read_payload_data(records[0].payload_id);
+        assert(reopened_data);
+        assert(*reopened_data == make_json_payload(20000));
+        logger.shutdown();
+    }
+
+    cleanup_db(path);
+}
+
+void test_dictionary_error_callback_can_log() {
+    const std::string path = make_db_path("zstd_dict_error_log");
+    cleanup_db(path);
+
+    logit::MdbxLogger::Config config;
+    config.path = path;
+    config.async = false;
+    config.large_payload_threshold = 16;
+    config.payload_compression = logit::MdbxPayloadCompression::ZstdDictionary;
+    config.zstd_dictionary_size = 8 * 1024;
+    // One sample per training run, which zstd rejects, so every run reports an error.
+    config.zstd_dictionary_sample_bytes = 1;
+
+    std::atomic<logit::MdbxLogger*> target(nullptr);
+    std::atomic<int> error_count(0);
+    config.on_error = [&target, &error_count](const std::string&) {
+        const int index = error_count.fetch_add(1);
+        // Give the writer time to start the next training while this one is
+        // still inside the callback, then log back into the same backend.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        logit::MdbxLogger* logger = target.load();
+        if (logger != nullptr && index < 3) {
+            logger->log(make_record(logit::LogLevel::LOG_LVL_ERROR, 31000 + index, index), "training failed");
+        }
+    };
+
+    {
+        logit::MdbxLogger logger(config);
+        target.store(&logger);
+        for (int i = 0; i < 20; ++i) {
+            logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 30000 + i, i), make_json_payload(i));
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        while (error_count.load() < 3) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        logger.shutdown();
+        target.store(nullptr);
+    }
+
+    {
+        logit::MdbxLogger logger(config);
+        assert(logger.read_range(30000, 30020).size() == 20);
+        assert(logger.read_range(31000, 31003).size() == 3);
+        logger.shutdown();
+    }
+
+    cleanup_db(path);
+}
+#endif
+
 void test_counters_zero_for_sync_writes() {
     const std::string path = make_db_path("counters");
     cleanup_db(path);
@@ -324,6 +608,52 @@ void test_on_error_callback() {
     cleanup_db(path);
 }
 
+void test_aborted_write_rolls_back_dictionary() {
+    const std::string path = make_db_path("aborted_write");
+    cleanup_db(path);
+
+    logit::MdbxLogger::Config config;
+    config.path = path;
+    config.async = false;
+    {
+        std::vector<std::string> errors;
+        config.on_error = [&errors](const std::string& msg) {
+            errors.push_back(msg);
+        };
+        logit::MdbxLogger logger(config);
+
+        // The new file name takes a dictionary id, then the function name is
+        // too long for an MDBX key, so the write transaction is aborted.
+        const std::string oversized(4096, 'f');
+        logger.log(make_named_record(7000, "aborted_new.cpp", oversized.c_str()), "aborted");
+        assert(logger.failed_export_count() == 1);
+        assert(errors.size() == 1);
+        assert(logger.read_range(7000, 7001).empty());
+
+        // Ids of the aborted transaction are handed out again.
+        logger.log(make_named_record(7001, "mdbx_logger_test.cpp", "aborted_other"), "first");
+        logger.log(make_named_record(7002, "aborted_new.cpp", "aborted_other"), "second");
+        assert(logger.failed_export_count() == 1);
+        logger.shutdown();
+    }
+
+    {
+        // A fresh dictionary mirror shows what was committed.
+        config.on_error = nullptr;
+        logit::MdbxLogger logger(config);
+        const auto records = logger.read_range(7000, 7003);
+        assert(records.size() == 2);
+        assert(records[0].message == "first");
+        assert(records[0].function == "aborted_other");
+        assert(records[1].message == "second");
+        assert(records[1].file == "aborted_new.cpp");
+        assert(records[1].function == "aborted_other");
+        logger.shutdown();
+    }
+
+    cleanup_db(path);
+}
+
 void test_nested_parent_directory_created() {
     const std::string path = make_nested_db_path("nested");
     cleanup_path_tree(path);
@@ -633,6 +963,510 @@ void test_read_recent() {
     cleanup_db(path);
 }
 
+void test_secondary_indexes() {
+    const std::string path = make_db_path("indexes");
+    cleanup_db(path);
+
+    const char* session_file = "net/Session.cpp";
+    const char* engine_file = "core/Engine.cpp";
+    uint64_t first_session_id = 0;
+    {
+        // Written without indexes; enabling them below rebuilds them from the records.
+        logit::MdbxLogger::Config config;
+        config.path = path;
+        config.async = false;
+        logit::MdbxLogger logger(config);
+        first_session_id = logger.session_id();
+        for (int i = 0; i < 100; ++i) {
+            logger.log(
+                make_file_record(
+                    i % 10 == 0 ? logit::LogLevel::LOG_LVL_ERROR : logit::LogLevel::LOG_LVL_INFO,
+                    7000 + i,
+                    i % 2 == 0 ? session_file : engine_file,
+                    i),
+                "first-" + std::to_string(i));
+        }
+        logger.shutdown();
+    }
+
+    logit::MdbxLogger::Config config;
+    config.path = path;
+    config.async = false;
+    config.index_by_level = true;
+    config.index_by_file = true;
+    config.index_by_session = true;
+    logit::MdbxLogger logger(config);
+    for (int i = 0; i < 100; ++i) {
+        logger.log(
+            make_file_record(
+                i % 10 == 0 ? logit::LogLevel::LOG_LVL_ERROR : logit::LogLevel::LOG_LVL_INFO,
+                7100 + i,
+                i % 2 == 0 ? session_file : engine_file,
+                i),
+            "second-" + std::to_string(i));
+    }
+
+    logit::LogQuery errors;
+    errors.min_level = logit::LogLevel::LOG_LVL_ERROR;
+    auto found = logger.query(errors);
+    assert(found.size() == 20);
+    assert(found.front().timestamp_ms == 7000);
+    assert(found.back().timestamp_ms == 7190);
+    assert(logger.count(errors) == 20);
+
+    errors.from_ms = 7050;
+    errors.to_ms = 7150;
+    errors.limit = 3;
+    errors.order = logit::LogReadOrder::Descending;
+    found = logger.query(errors);
+    assert(found.size() == 3);
+    assert(found[0].timestamp_ms == 7140);
+    assert(found[2].timestamp_ms == 7120);
+    assert(logger.count(errors) == 3);
+
+    logit::LogQuery by_file;
+    by_file.file = session_file;
+    assert(logger.count(by_file) == 100);
+    by_file.message_contains = "second-";
+    found = logger.query(by_file);
+    assert(found.size() == 50);
+    assert(found.front().timestamp_ms == 7100);
+    assert(found.front().file == session_file);
+
+    const auto first_session = logger.query_session(first_session_id);
+    assert(first_session.size() == 100);
+    assert(first_session.back().message == "first-99");
+
+    logit::LogQuery newest;
+    newest.limit = 5;
+    newest.order = logit::LogReadOrder::Descending;
+    const auto own_session = logger.query_session(logger.session_id(), newest);
+    assert(own_session.size() == 5);
+    assert(own_session[0].timestamp_ms == 7199);
+    assert(own_session[0].session_id == logger.session_id());
+
+    assert(logger.clear_logs().ok);
+    errors = logit::LogQuery();
+    errors.min_level = logit::LogLevel::LOG_LVL_ERROR;
+    assert(logger.count(errors) == 0);
+    logger.log(make_file_record(logit::LogLevel::LOG_LVL_FATAL, 7300, engine_file, 1), "after-clear");
+    found = logger.query(errors);
+    assert(found.size() == 1);
+    assert(found[0].timestamp_ms == 7300);
+
+    logger.shutdown();
+    cleanup_db(path);
+}
+
+void test_read_page() {
+    const std::string path = make_db_path("page");
+    cleanup_db(path);
+
+    logit::MdbxLogger::Config config;
+    config.path = path;
+    config.async = false;
+    logit::MdbxLogger logger(config);
+    for (int i = 0; i < 1000; ++i) {
+        const logit::LogLevel level = i % 7 == 0 ? logit::LogLevel::LOG_LVL_ERROR : logit::LogLevel::LOG_LVL_INFO;
+        // Gaps of up to 5 s make descending pages span several time windows.
+        logger.log(make_file_record(level, 1000 + static_cast<int64_t>(i) * (i % 5) * 250, i % 2 ? "a.cpp" : "b.cpp", i),
+                   "msg-" + std::to_string(i));
+    }
+    const std::vector<logit::LogRecordSnapshot> all = logger.read_range(0, (std::numeric_limits<int64_t>::max)());
+    assert(all.size() == 1000);
+
+    const auto read_all_pages = [&logger](const logit::LogQuery& log_query, std::size_t page_size) {
+        std::vector<logit::LogRecordSnapshot> out;
+        std::string token;
+        do {
+            auto page = logger.read_page(log_query, page_size, token);
+            assert(page.value);
+            assert(page.value->records.size() <= page_size);
+            out.insert(out.end(), page.value->records.begin(), page.value->records.end());
+            token = page.value->next_token;
+        } while (!token.empty());
+        return out;
+    };
+    const auto same_records = [](const std::vector<logit::LogRecordSnapshot>& a,
+                                 const std::vector<logit::LogRecordSnapshot>& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].timestamp_ms != b[i].timestamp_ms || a[i].sequence != b[i].sequence ||
+                a[i].message != b[i].message || a[i].file != b[i].file) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    logit::LogQuery ascending;
+    assert(same_records(read_all_pages(ascending, 64), all));
+
+    logit::LogQuery descending;
+    descending.order = logit::LogReadOrder::Descending;
+    std::vector<logit::LogRecordSnapshot> reversed(all.rbegin(), all.rend());
+    assert(same_records(read_all_pages(descending, 64), reversed));
+    assert(same_records(read_all_pages(descending, 1000), reversed));
+
+    logit::LogQuery filtered;
+    filtered.min_level = logit::LogLevel::LOG_LVL_ERROR;
+    filtered.file = "a.cpp";
+    filtered.from_ms = 2000;
+    filtered.to_ms = 500000;
+    assert(same_records(read_all_pages(filtered, 5), logger.query(filtered)));
+    filtered.order = logit::LogReadOrder::Descending;
+    assert(same_records(read_all_pages(filtered, 5), logger.query(filtered)));
+
+    auto bad_token = logger.read_page(ascending, 10, "not-a-token");
+    assert(!bad_token.value);
+    assert(bad_token.error == logit::LogReadError::DecodeError);
+
+    std::vector<logit::LogRecordSnapshot> newest(all.end() - 10, all.end());
+    assert(same_records(logger.read_recent(10, 0, logit::LogReadOrder::Ascending), newest));
+
+    // The visitor runs outside the storage lock and may log to the same backend.
+    std::size_t visited = 0;
+    logit::LogQuery limited;
+    limited.limit = 300;
+    logger.for_each_query(limited, [&logger, &visited](const logit::LogEntryView& entry) {
+        if (visited == 0) {
+            logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 1, 1), "from visitor");
+        }
+        ++visited;
+        return !entry.message.empty();
+    });
+    assert(visited == 300);
+
+    logger.shutdown();
+    cleanup_db(path);
+}
+
+void test_retention() {
+    const std::string path = make_db_path("retention");
+    cleanup_db(path);
+
+    logit::MdbxLogger::Config config;
+    config.path = path;
+    config.async = false;
+    config.large_payload_threshold = 16;
+    config.payload_preview_size = 4;
+    config.index_by_level = true;
+    config.index_by_session = true;
+    config.retention.max_records = 100;
+    config.retention.batch_size = 16;
+    config.retention.interval_ms = 3600 * 1000;
+
+    uint64_t old_session_id = 0;
+    {
+        logit::MdbxLogger::Config old_config = config;
+        old_config.retention = logit::MdbxLogger::RetentionPolicy();
+        logit::MdbxLogger logger(old_config);
+        old_session_id = logger.session_id();
+        logger.log(make_record(logit::LogLevel::LOG_LVL_ERROR, 500, 1), "from the old session");
+        logger.shutdown();
+    }
+
+    {
+        logit::MdbxLogger logger(config);
+        for (int i = 0; i < 300; ++i) {
+            const logit::LogLevel level = i % 10 == 0 ? logit::LogLevel::LOG_LVL_ERROR : logit::LogLevel::LOG_LVL_INFO;
+            const std::string message = i % 3 == 0 ? std::string(64, 'p') : std::string("short");
+            logger.log(make_record(level, 1000 + i, i), message);
+        }
+        auto first = logger.read_range(1000, 1001);
+        assert(first.size() == 1);
+        const uint64_t old_payload_id = first[0].payload_id;
+        assert(old_payload_id != 0);
+
+        assert(logger.enforce_retention() == 201);
+        assert(logger.retention_deleted_count() == 201);
+        assert(logger.retention_deleted_payload_count() == 68);
+        assert(logger.retention_lag_ms() == 0);
+
+        auto records = logger.read_range(0, 5000);
+        assert(records.size() == 100);
+        assert(records.front().timestamp_ms == 1200);
+        assert(records.back().timestamp_ms == 1299);
+        assert(logger.read_payload_result(old_payload_id).error == logit::LogReadError::NotFound);
+        auto kept_data = logger.read_payload_data(records[1].payload_id);
+        assert(kept_data);
+        assert(*kept_data == std::string(64, 'p'));
+
+        logit::LogQuery errors;
+        errors.min_level = logit::LogLevel::LOG_LVL_ERROR;
+        assert(logger.count(errors) == 10);
+        assert(logger.query_session(logger.session_id()).size() == 100);
+        assert(logger.enforce_retention() == 0);
+        logger.shutdown();
+    }
+    cleanup_db(path);
+
+    logit::MdbxLogger::Config age_config;
+    age_config.path = path;
+    age_config.async = false;
+    age_config.retention.max_age_ms = 60 * 1000;
+    {
+        logit::MdbxLogger logger(age_config);
+        const int64_t now_ms = LOGIT_CURRENT_TIMESTAMP_MS();
+        for (int i = 0; i < 5; ++i) {
+            logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, now_ms - 120 * 1000 + i, i), "expired");
+        }
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, now_ms, 5), "fresh");
+        logger.enforce_retention();
+        auto records = logger.read_range(0, now_ms + 1);
+        assert(records.size() == 1);
+        assert(records[0].message == "fresh");
+        logger.shutdown();
+    }
+    cleanup_db(path);
+
+    logit::MdbxLogger::Config session_config;
+    session_config.path = path;
+    session_config.async = false;
+    {
+        logit::MdbxLogger logger(session_config);
+        old_session_id = logger.session_id();
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 7000, 1), "old session");
+        logger.shutdown();
+    }
+    session_config.retention.max_sessions = 1;
+    {
+        logit::MdbxLogger logger(session_config);
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 8000, 1), "current session");
+        logger.enforce_retention();
+        assert(logger.retention_deleted_count() == 1);
+        auto records = logger.read_range(0, 9000);
+        assert(records.size() == 1);
+        assert(records[0].session_id == logger.session_id());
+        assert(!logger.read_session(old_session_id));
+        logger.shutdown();
+    }
+    cleanup_db(path);
+}
+
+void test_histogram() {
+    const std::string path = make_db_path("histogram");
+    cleanup_db(path);
+
+    struct Written {
+        int64_t timestamp_ms;
+        logit::LogLevel level;
+        const char* file;
+        uint64_t bytes;
+    };
+    std::vector<Written> written;
+    const auto write = [&written](logit::MdbxLogger& logger, int from, int to) {
+        for (int i = from; i < to; ++i) {
+            const logit::LogLevel level = i % 10 == 0 ? logit::LogLevel::LOG_LVL_ERROR
+                : (i % 4 == 0 ? logit::LogLevel::LOG_LVL_WARN : logit::LogLevel::LOG_LVL_INFO);
+            const char* file = i % 2 ? "a.cpp" : "b.cpp";
+            const std::string message = i % 25 == 0 ? std::string(64, 'p') : "m-" + std::to_string(i);
+            const int64_t timestamp_ms = 10000 + static_cast<int64_t>(i) * 37;
+            logger.log(make_file_record(level, timestamp_ms, file, i), message);
+            // Spilled messages keep a 4-byte preview next to the 64-byte payload.
+            written.push_back({timestamp_ms, level, file, message.size() > 16 ? 4u + 64u : message.size()});
+        }
+    };
+    const auto expect = [&written](const logit::MdbxLogger& logger, int64_t from_ms, int64_t to_ms,
+                                   int64_t bucket_ms, int64_t base_ms, const std::string& file) {
+        const int64_t step_ms = bucket_ms <= base_ms ? base_ms : (bucket_ms + base_ms - 1) / base_ms * base_ms;
+        const int64_t first_ms = from_ms / step_ms * step_ms;
+        const int64_t end_ms = (to_ms - 1) / step_ms * step_ms + step_ms;
+        std::map<int64_t, logit::MdbxLogger::HistogramBucket> expected;
+        for (size_t i = 0; i < written.size(); ++i) {
+            const Written& w = written[i];
+            if (w.timestamp_ms < first_ms || w.timestamp_ms >= end_ms || (!file.empty() && file != w.file)) {
+                continue;
+            }
+            logit::MdbxLogger::HistogramBucket& bucket = expected[w.timestamp_ms / step_ms * step_ms];
+            bucket.start_ms = w.timestamp_ms / step_ms * step_ms;
+            ++bucket.counts[static_cast<size_t>(w.level)];
+            bucket.bytes += w.bytes;
+        }
+        auto result = logger.read_histogram(from_ms, to_ms, bucket_ms, file);
+        assert(result.value);
+        assert(result.value->size() == expected.size());
+        size_t index = 0;
+        for (auto it = expected.begin(); it != expected.end(); ++it, ++index) {
+            const logit::MdbxLogger::HistogramBucket& bucket = (*result.value)[index];
+            assert(bucket.start_ms == it->second.start_ms);
+            assert(bucket.counts == it->second.counts);
+            assert(bucket.bytes == it->second.bytes);
+        }
+    };
+
+    logit::MdbxLogger::Config config;
+    config.path = path;
+    config.async = false;
+    config.large_payload_threshold = 16;
+    config.payload_preview_size = 4;
+    config.rollup_bucket_ms = 1000;
+    {
+        // Without rollups the histogram is computed by scanning records.
+        logit::MdbxLogger logger(config);
+        write(logger, 0, 200);
+        expect(logger, 10000, 20000, 1000, 1000, "");
+        expect(logger, 10500, 12000, 2500, 1000, "a.cpp");
+        logger.shutdown();
+    }
+
+    config.rollup_by_level = true;
+    config.rollup_by_file = true;
+    config.retention.max_records = 100;
+    config.retention.interval_ms = 3600 * 1000;
+    {
+        // Enabling rollups rebuilds them; retention keeps them current.
+        logit::MdbxLogger logger(config);
+        expect(logger, 10000, 20000, 1000, 1000, "");
+        expect(logger, 10500, 12000, 2500, 1000, "");
+        expect(logger, 0, 20000, 0, 1000, "b.cpp");
+        expect(logger, 10500, 12000, 2500, 1000, "a.cpp");
+        assert(logger.read_histogram(0, 20000, 1000, "missing.cpp").value->empty());
+
+        // The first synchronous write already runs a retention step.
+        write(logger, 200, 250);
+        logger.enforce_retention();
+        assert(logger.retention_deleted_count() == 150);
+        written.erase(written.begin(), written.begin() + 150);
+        expect(logger, 0, 30000, 1000, 1000, "");
+        expect(logger, 0, 30000, 4000, 1000, "b.cpp");
+        logger.shutdown();
+    }
+
+    config.rollup_bucket_ms = 500;
+    config.retention = logit::MdbxLogger::RetentionPolicy();
+    {
+        // A new bucket size rebuilds the rollups; new records update them.
+        logit::MdbxLogger logger(config);
+        expect(logger, 0, 30000, 0, 500, "");
+        expect(logger, 15000, 18000, 700, 500, "a.cpp");
+        write(logger, 250, 300);
+        expect(logger, 0, 30000, 2000, 500, "");
+        expect(logger, 0, 30000, 1000, 500, "a.cpp");
+        logger.shutdown();
+    }
+    cleanup_db(path);
+}
+
+void test_text_index() {
+    const std::string path = make_db_path("text");
+    cleanup_db(path);
+
+    struct Written {
+        int64_t timestamp_ms;
+        logit::LogLevel level;
+        std::string text;
+    };
+    std::vector<Written> written;
+    const auto write = [&written](logit::MdbxLogger& logger, int from, int to) {
+        for (int i = from; i < to; ++i) {
+            const logit::LogLevel level = i % 3 == 0 ? logit::LogLevel::LOG_LVL_ERROR : logit::LogLevel::LOG_LVL_INFO;
+            // Every seventh record arrives late, and every tenth spills with the request id past the preview.
+            const int64_t timestamp_ms = 10000 + static_cast<int64_t>(i) * 10 - (i % 7 == 0 ? 55 : 0);
+            std::string text = "order " + std::to_string(i) + " request-id=REQ-" + std::to_string(i % 40) + ";";
+            if (i % 10 == 0) {
+                text = std::string(80, '.') + text;
+            }
+            logger.log(make_record(level, timestamp_ms, i), text);
+            written.push_back({timestamp_ms, level, text});
+        }
+    };
+    const auto expect = [&written](const logit::MdbxLogger& logger, const std::string& text, const logit::LogQuery& log_query) {
+        std::vector<std::pair<int64_t, std::string>> expected;
+        for (size_t i = 0; i < written.size(); ++i) {
+            const Written& w = written[i];
+            if (w.timestamp_ms >= log_query.from_ms && w.timestamp_ms < log_query.to_ms &&
+                static_cast<int>(w.level) >= static_cast<int>(log_query.min_level) &&
+                w.text.find(text) != std::string::npos) {
+                expected.emplace_back(w.timestamp_ms, w.text);
+            }
+        }
+        std::stable_sort(expected.begin(), expected.end(),
+            [](const std::pair<int64_t, std::string>& a, const std::pair<int64_t, std::string>& b) {
+                return a.first < b.first;
+            });
+        if (log_query.order == logit::LogReadOrder::Descending) {
+            std::reverse(expected.begin(), expected.end());
+        }
+        if (log_query.limit > 0 && expected.size() > log_query.limit) {
+            expected.resize(log_query.limit);
+        }
+        auto result = logger.search_text(text, log_query);
+        assert(result.value);
+        assert(result.value->size() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            const logit::LogRecordSnapshot& record = (*result.value)[i];
+            assert(record.timestamp_ms == expected[i].first);
+            if (record.payload_id == 0) {
+                assert(record.message == expected[i].second);
+            } else {
+                assert(*logger.read_payload_data(record.payload_id) == expected[i].second);
+            }
+        }
+    };
+
+    logit::MdbxLogger::Config config;
+    config.path = path;
+    config.async = false;
+    config.large_payload_threshold = 64;
+    config.payload_preview_size = 16;
+    logit::LogQuery all;
+    logit::LogQuery window;
+    window.from_ms = 11000;
+    window.to_ms = 12500;
+    logit::LogQuery newest_errors;
+    newest_errors.min_level = logit::LogLevel::LOG_LVL_ERROR;
+    newest_errors.order = logit::LogReadOrder::Descending;
+    newest_errors.limit = 4;
+    {
+        // Without the index the time window is scanned.
+        logit::MdbxLogger logger(config);
+        write(logger, 0, 300);
+        expect(logger, "REQ-7;", all);
+        expect(logger, "REQ-1", window);
+        logger.shutdown();
+    }
+
+    config.index_by_text = true;
+    config.text_index_batch_size = 64;
+    {
+        // Enabling the index queues every stored record; searches stay exact while it catches up.
+        logit::MdbxLogger logger(config);
+        expect(logger, "REQ-7;", all);
+        assert(logger.update_text_index() == 300);
+        expect(logger, "REQ-7;", all);
+        expect(logger, "REQ-1", window);
+        expect(logger, "REQ-3", newest_errors);
+        expect(logger, "order 25 ", all);
+        expect(logger, "missing text", all);
+        expect(logger, "Q-", window);
+
+        write(logger, 300, 400);
+        expect(logger, "REQ-7;", all);
+        logger.update_text_index();
+        expect(logger, "REQ-7;", all);
+        expect(logger, "REQ-3", newest_errors);
+        logger.shutdown();
+    }
+
+    config.retention.max_records = 150;
+    config.retention.interval_ms = 3600 * 1000;
+    {
+        logit::MdbxLogger logger(config);
+        logger.enforce_retention();
+        // Retention deletes by key; keep the 150 newest timestamps.
+        std::sort(written.begin(), written.end(), [](const Written& a, const Written& b) {
+            return a.timestamp_ms < b.timestamp_ms;
+        });
+        written.erase(written.begin(), written.begin() + 250);
+        logger.update_text_index();
+        expect(logger, "REQ-7;", all);
+        expect(logger, "order 1", all);
+        logger.shutdown();
+    }
+    cleanup_db(path);
+}
+
 void test_callback_sync() {
     const std::string path = make_db_path("cb_sync");
     cleanup_db(path);
@@ -665,6 +1499,130 @@ void test_callback_sync() {
     cleanup_db(path);
 }
 
+void test_async_unbounded_queue() {
+    const std::string path = make_db_path("unbounded_queue");
+    cleanup_db(path);
+
+    {
+        logit::MdbxLogger::Config config;
+        config.path = path;
+        config.async = true;
+        config.flush_interval_ms = 5;
+        config.max_queue_size = 0;
+
+        logit::MdbxLogger logger(config);
+        std::atomic<bool> is_worker_blocked(false);
+        std::atomic<bool> is_released(false);
+        logger.add_log_callback([&is_worker_blocked, &is_released](const logit::LogRecordSnapshot&) {
+            is_worker_blocked = true;
+            while (!is_released.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+        // The worker stays inside the callback while more records arrive than
+        // the ring holds; max_queue_size = 0 must neither drop nor block them.
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 70000, 0), "first");
+        while (!is_worker_blocked.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const int count = 20000;
+        for (int i = 1; i <= count; ++i) {
+            logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 70001, i), "queued");
+        }
+        is_released = true;
+        logger.wait();
+
+        assert(logger.dropped_count() == 0);
+        assert(logger.write_stats().records == static_cast<uint64_t>(count + 1));
+        // Equal timestamps are keyed by write order, so lines show the queue order.
+        const auto records = logger.read_range(70001, 70002);
+        assert(records.size() == static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            assert(records[i].line == i + 1);
+        }
+        logger.shutdown();
+    }
+
+    cleanup_db(path);
+}
+
+void test_async_group_commit() {
+    const std::string path = make_db_path("group_commit");
+    cleanup_db(path);
+
+    {
+        logit::MdbxLogger::Config config;
+        config.path = path;
+        config.async = true;
+        config.flush_interval_ms = 5;
+        config.max_batch_size = 64;
+        config.max_queue_size = 16;
+        config.drop_on_overflow = false;
+        config.target_write_latency_ms = 20;
+
+        logit::MdbxLogger logger(config);
+        assert(logger.write_stats().transactions == 0);
+        assert(logger.write_stats().batch_limit <= 32);
+
+        const int threads = 4;
+        const int per_thread = 500;
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; ++t) {
+            producers.push_back(std::thread([&logger, t]() {
+                for (int i = 0; i < per_thread; ++i) {
+                    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 50000 + t * per_thread + i, i), "group");
+                }
+            }));
+        }
+        for (size_t t = 0; t < producers.size(); ++t) {
+            producers[t].join();
+        }
+        logger.wait();
+
+        assert(logger.dropped_count() == 0);
+        assert(logger.read_range(50000, 50000 + threads * per_thread).size() == static_cast<size_t>(threads * per_thread));
+
+        const logit::MdbxLogger::WriteStats stats = logger.write_stats();
+        assert(stats.records == static_cast<uint64_t>(threads * per_thread));
+        assert(stats.transactions > 0 && stats.transactions <= stats.records);
+        assert(stats.batch_limit >= 1 && stats.batch_limit <= 64);
+        assert(stats.average_batch_size >= 1.0 && stats.average_batch_size <= 64.0);
+        assert(stats.transactions_per_second > 0.0);
+        assert(stats.p99_write_latency_us >= 0);
+
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 60000, 1), "after");
+        logger.wait();
+        assert(logger.write_stats().records == stats.records + 1);
+        assert(logger.read_range(60000, 60001).size() == 1);
+        logger.shutdown();
+    }
+    cleanup_db(path);
+
+    {
+        logit::MdbxLogger::Config config;
+        config.path = path;
+        config.async = true;
+        config.flush_interval_ms = 5;
+        config.max_batch_size = 8;
+        config.adaptive_batching = false;
+
+        logit::MdbxLogger logger(config);
+        for (int i = 0; i < 100; ++i) {
+            logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 70000 + i, i), "fixed");
+        }
+        logger.wait();
+        const logit::MdbxLogger::WriteStats stats = logger.write_stats();
+        assert(stats.batch_limit == 8);
+        assert(stats.linger_us == 0);
+        assert(stats.records == 100);
+        assert(stats.transactions >= 13);
+        logger.shutdown();
+    }
+
+    cleanup_db(path);
+}
+
 void test_callback_async() {
     const std::string path = make_db_path("cb_async");
     cleanup_db(path);
@@ -770,12 +1728,19 @@ void test_callback_exception_safe() {
 
 int main() {
     test_sync_range_session_and_sequences();
+    test_key_and_payload_cursors_survive_reopen();
+    test_compact_rows_with_legacy_rows();
     test_async_large_payload_spill();
 #if defined(LOGIT_HAS_ZLIB)
     test_gzip_payload_compression();
+#endif
+#if defined(LOGIT_HAS_ZSTD)
+    test_zstd_dictionary_payload_compression();
+    test_dictionary_error_callback_can_log();
 #endif
     test_counters_zero_for_sync_writes();
     test_on_error_callback();
+    test_aborted_write_rolls_back_dictionary();
     test_nested_parent_directory_created();
     test_init_error_callback_and_rethrow();
     test_read_result_not_found();
@@ -784,6 +1749,13 @@ int main() {
     test_clear_logs_can_remove_sessions();
     test_read_range_empty_and_limits();
     test_read_recent();
+    test_secondary_indexes();
+    test_read_page();
+    test_retention();
+    test_histogram();
+    test_text_index();
+    test_async_unbounded_queue();
+    test_async_group_commit();
     test_callback_sync();
     test_callback_async();
     test_callback_order();
@@ -1,5 +1,7 @@
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -163,6 +165,98 @@ bool test_thread_safety() {
     logger.log(make_record(sequence.fetch_add(1, std::memory_order_relaxed), 9999), "after-remove");
     return primary_calls.load() == calls_after_remove;
 }
+
+bool test_async_delivery_and_drops() {
+    logit::MemoryLogger logger(logit::MemoryLogger::Config{0, 0, 0});
+    const std::thread::id writer_thread = std::this_thread::get_id();
+
+    std::mutex gate_mutex;
+    std::condition_variable gate_cv;
+    bool is_open = false;
+    std::atomic<int> slow_calls(0);
+    std::atomic<bool> failed(false);
+    std::vector<std::string> sync_messages;
+
+    logger.add_log_callback([&sync_messages](const logit::LogRecordSnapshot& view) {
+        sync_messages.push_back(view.message);
+    });
+
+    logit::LogCallbackOptions options;
+    options.async = true;
+    options.queue_capacity = 2;
+    const uint64_t slow_id = logger.add_log_callback(
+        [&](const logit::LogRecordSnapshot&) {
+            if (std::this_thread::get_id() == writer_thread) {
+                failed = true;
+            }
+            std::unique_lock<std::mutex> lock(gate_mutex);
+            gate_cv.wait(lock, [&is_open]() { return is_open; });
+            slow_calls.fetch_add(1, std::memory_order_relaxed);
+        },
+        options);
+
+    const int total = 20;
+    for (int i = 0; i < total; ++i) {
+        logger.log(make_record(400 + i, 40 + i, "async"), "async-" + std::to_string(i));
+    }
+
+    // The blocked subscriber must not have stalled the writer.
+    if (sync_messages.size() != static_cast<size_t>(total)) {
+        return false;
+    }
+    const uint64_t dropped = logger.get_log_callback_dropped(slow_id);
+    if (dropped == 0) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(gate_mutex);
+        is_open = true;
+    }
+    gate_cv.notify_all();
+    logger.wait();
+
+    if (failed.load() ||
+        static_cast<uint64_t>(slow_calls.load()) + logger.get_log_callback_dropped(slow_id) !=
+            static_cast<uint64_t>(total)) {
+        return false;
+    }
+
+    if (!logger.remove_log_callback(slow_id)) {
+        return false;
+    }
+    logger.log(make_record(500, 50, "async"), "after-remove");
+    logger.wait();
+    return static_cast<uint64_t>(slow_calls.load()) + dropped <= static_cast<uint64_t>(total);
+}
+
+bool test_async_order() {
+    logit::MemoryLogger logger(logit::MemoryLogger::Config{0, 0, 0});
+    std::vector<std::string> received;
+
+    logit::LogCallbackOptions options;
+    options.async = true;
+    logger.add_log_callback(
+        [&received](const logit::LogRecordSnapshot& view) {
+            received.push_back(view.message);
+        },
+        options);
+
+    for (int i = 0; i < 100; ++i) {
+        logger.log(make_record(600 + i, 60, "ordered_async"), std::to_string(i));
+    }
+    logger.wait();
+
+    if (received.size() != 100) {
+        return false;
+    }
+    for (int i = 0; i < 100; ++i) {
+        if (received[i] != std::to_string(i)) {
+            return false;
+        }
+    }
+    return true;
+}
 } // namespace
 
 int main() {
@@ -178,5 +272,11 @@ int main() {
     if (!test_thread_safety()) {
         return 1;
     }
+    if (!test_async_delivery_and_drops()) {
+        return 1;
+    }
+    if (!test_async_order()) {
+        return 1;
+    }
     return 0;
 }
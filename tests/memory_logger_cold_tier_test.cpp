@@ -0,0 +1,175 @@
+#include <atomic>
+
+namespace {
+std::atomic<long long> g_now_ms(0);
+
+long long test_now_ms() {
+    return g_now_ms.load();
+}
+} // namespace
+
+#define LOGIT_CURRENT_TIMESTAMP_MS() test_now_ms()
+
+#include <logit.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+logit::LogRecord make_record(int64_t ts, int line) {
+    return logit::LogRecord(logit::LogLevel::LOG_LVL_INFO, ts, "memory_logger_cold_tier_test.cpp", line,
+                            line % 2 == 0 ? "even" : "odd", "", "", -1, false);
+}
+
+std::string make_message(int i) {
+    return "order " + std::to_string(i) + " accepted: symbol=BTCUSDT side=BUY price=64000.00 qty=0.010 "
+           "venue=primary account=main strategy=market-maker-v2 latency_us=120 status=ok";
+}
+
+logit::MemoryLogger::Config make_cold_config(std::size_t max_records, std::size_t max_bytes, int64_t max_age_ms) {
+    logit::MemoryLogger::Config config(max_records, max_bytes, max_age_ms);
+    config.cold_compress = logit::CompressType::GZIP;
+    config.cold_hot_bytes = 4 * 1024;
+    config.cold_block_bytes = 8 * 1024;
+    return config;
+}
+
+void fill(logit::MemoryLogger& logger, int count) {
+    for (int i = 0; i < count; ++i) {
+        g_now_ms = 1000 + i;
+        logger.log(make_record(1000 + i, i), make_message(i));
+    }
+}
+
+bool test_more_history_in_same_budget() {
+    const std::size_t budget = 64 * 1024;
+    logit::MemoryLogger plain(logit::MemoryLogger::Config(0, budget, 0));
+    logit::MemoryLogger cold(make_cold_config(0, budget, 0));
+    fill(plain, 2000);
+    fill(cold, 2000);
+
+    const std::vector<logit::BufferedLogEntry> plain_entries = plain.get_buffered_entries();
+    const std::vector<logit::BufferedLogEntry> entries = cold.get_buffered_entries();
+    if (entries.size() < plain_entries.size() * 3 || entries.size() > 2000) {
+        return false;
+    }
+    const int first = 2000 - static_cast<int>(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const int index = first + static_cast<int>(i);
+        if (entries[i].timestamp_ms != 1000 + index ||
+            entries[i].line != index ||
+            entries[i].function != (index % 2 == 0 ? "even" : "odd") ||
+            entries[i].file != "memory_logger_cold_tier_test.cpp" ||
+            entries[i].message != make_message(index)) {
+            return false;
+        }
+    }
+    const std::vector<std::string> strings = cold.get_buffered_strings();
+    return strings.size() == entries.size() && strings.back() == make_message(1999);
+}
+
+bool test_queries_across_tiers() {
+    logit::MemoryLogger logger(make_cold_config(0, 0, 0));
+    fill(logger, 1000);
+
+    const std::vector<logit::LogRecordSnapshot> range = logger.read_range(1100, 1110);
+    if (range.size() != 10 || range[0].timestamp_ms != 1100 || range[9].timestamp_ms != 1109) {
+        return false;
+    }
+
+    const std::vector<logit::LogRecordSnapshot> recent = logger.read_recent(3, 0, logit::LogReadOrder::Descending);
+    if (recent.size() != 3 || recent[0].timestamp_ms != 1999 || recent[2].timestamp_ms != 1997) {
+        return false;
+    }
+
+    // A descending limit larger than the hot tier continues into the cold blocks.
+    const std::vector<logit::LogRecordSnapshot> tail = logger.read_recent(900, 0, logit::LogReadOrder::Ascending);
+    if (tail.size() != 900 || tail.front().timestamp_ms != 1100 || tail.back().timestamp_ms != 1999) {
+        return false;
+    }
+
+    logit::LogQuery even;
+    even.function = "even";
+    even.from_ms = 1000;
+    even.to_ms = 1500;
+    if (logger.count(even) != 250) {
+        return false;
+    }
+    even.limit = 2;
+    even.order = logit::LogReadOrder::Descending;
+    const std::vector<logit::LogRecordSnapshot> last_even = logger.query(even);
+    return last_even.size() == 2 && last_even[0].timestamp_ms == 1498 && last_even[1].timestamp_ms == 1496;
+}
+
+bool test_age_and_clear() {
+    logit::MemoryLogger logger(make_cold_config(0, 0, 500));
+    fill(logger, 1000);
+
+    const std::vector<logit::BufferedLogEntry> entries = logger.get_buffered_entries();
+    if (entries.size() != 501 || entries.front().timestamp_ms != 1499) {
+        return false;
+    }
+    if (logger.read_range(1000, 1499).size() != 0) {
+        return false;
+    }
+
+    const logit::LogClearResult cleared = logger.clear_logs();
+    return cleared.ok && cleared.cleared_records >= 501 && logger.get_buffered_entries().empty();
+}
+
+bool test_record_limit_counts_both_tiers() {
+    logit::MemoryLogger logger(make_cold_config(300, 0, 0));
+    fill(logger, 1000);
+    const std::vector<logit::BufferedLogEntry> entries = logger.get_buffered_entries();
+    return !entries.empty() && entries.size() <= 300 && entries.back().timestamp_ms == 1999;
+}
+bool test_concurrent_sealing() {
+    logit::MemoryLogger logger(make_cold_config(0, 0, 0));
+    const int threads = 4;
+    const int per_thread = 1000;
+    g_now_ms = 1000;
+    std::atomic<bool> is_reading(true);
+    std::thread reader([&logger, &is_reading]() {
+        while (is_reading.load()) {
+            logger.read_recent(50, 0, logit::LogReadOrder::Descending);
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threads; ++t) {
+        writers.emplace_back([&logger, t, per_thread]() {
+            for (int i = 0; i < per_thread; ++i) {
+                logger.log(make_record(1000 + i, t), make_message(t * per_thread + i));
+            }
+        });
+    }
+    for (std::size_t t = 0; t < writers.size(); ++t) {
+        writers[t].join();
+    }
+    is_reading = false;
+    reader.join();
+
+    // Every record survives sealing, whichever thread compressed its block.
+    const std::vector<logit::BufferedLogEntry> entries = logger.get_buffered_entries();
+    if (entries.size() != static_cast<std::size_t>(threads * per_thread)) {
+        return false;
+    }
+    std::vector<int> next(threads, 0);
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const int t = entries[i].line;
+        if (entries[i].message != make_message(t * per_thread + next[t])) {
+            return false;
+        }
+        ++next[t];
+    }
+    return true;
+}
+} // namespace
+
+int main() {
+    return test_more_history_in_same_budget() &&
+           test_queries_across_tiers() &&
+           test_age_and_clear() &&
+           test_record_limit_counts_both_tiers() &&
+           test_concurrent_sealing() ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+#include <atomic>
+
+namespace {
+std::atomic<long long> g_now_ms(0);
+
+long long test_now_ms() {
+    return g_now_ms.load();
+}
+} // namespace
+
+#define LOGIT_CURRENT_TIMESTAMP_MS() test_now_ms()
+
+#include <logit.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+logit::LogRecord make_record(logit::LogLevel level, int64_t ts, const char* file, const char* function) {
+    return logit::LogRecord(level, ts, file, 1, function, "", "", -1, false);
+}
+
+void fill(logit::MemoryLogger& logger) {
+    g_now_ms = 10000;
+    for (int i = 0; i < 100; ++i) {
+        const logit::LogLevel level = (i % 10 == 0) ? logit::LogLevel::LOG_LVL_ERROR : logit::LogLevel::LOG_LVL_INFO;
+        const char* file = (i % 2 == 0) ? "net/Session.cpp" : "db/Store.cpp";
+        const char* function = (i % 3 == 0) ? "on_read" : "on_write";
+        logger.log(make_record(level, 1000 + i * 10, file, function), "msg-" + std::to_string(i) + (i == 42 ? " request-id=abc" : ""));
+    }
+}
+
+bool test_filters(const logit::MemoryLogger& logger) {
+    logit::LogQuery errors;
+    errors.min_level = logit::LogLevel::LOG_LVL_ERROR;
+    if (logger.count(errors) != 10) return false;
+
+    errors.from_ms = 1500;
+    errors.to_ms = 1800;
+    const std::vector<logit::LogRecordSnapshot> window = logger.query(errors);
+    if (window.size() != 3 || window[0].message != "msg-50" || window[2].message != "msg-70") return false;
+
+    logit::LogQuery by_file;
+    by_file.file = "net/";
+    by_file.file_match = logit::LogMatchMode::Prefix;
+    by_file.function = "on_read";
+    by_file.limit = 2;
+    by_file.order = logit::LogReadOrder::Descending;
+    const std::vector<logit::LogRecordSnapshot> newest = logger.query(by_file);
+    if (newest.size() != 2 || newest[0].message != "msg-96" || newest[1].message != "msg-90") return false;
+
+    by_file.file_match = logit::LogMatchMode::Exact;
+    if (logger.count(by_file) != 0) return false;
+
+    logit::LogQuery text;
+    text.message_contains = "request-id=abc";
+    const std::vector<logit::LogRecordSnapshot> found = logger.query(text);
+    if (found.size() != 1 || found[0].timestamp_ms != 1420) return false;
+
+    std::vector<std::string> visited;
+    logit::LogQuery all;
+    logger.for_each_query(all, [&visited](const logit::LogEntryView& entry) {
+        visited.push_back(entry.message);
+        return visited.size() < 3;
+    });
+    return visited.size() == 3 && visited[0] == "msg-0" && visited[2] == "msg-2";
+}
+
+bool test_unsorted_timestamps() {
+    logit::MemoryLogger logger(logit::MemoryLogger::Config{0, 0, 0});
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 300, "a.cpp", "f"), "late");
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 100, "a.cpp", "f"), "early");
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 200, "a.cpp", "f"), "middle");
+    const std::vector<logit::LogRecordSnapshot> range = logger.read_range(100, 250);
+    return range.size() == 2 && range[0].message == "early" && range[1].message == "middle";
+}
+
+bool test_evicted_inversion() {
+    logit::MemoryLogger logger(logit::MemoryLogger::Config{3, 0, 0});
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 100, "a.cpp", "f"), "a");
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 300, "a.cpp", "f"), "b");
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 200, "a.cpp", "f"), "c");
+    if (logger.is_time_sorted()) return false;
+
+    // Evicting "a" leaves the 300 -> 200 inversion in place.
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 400, "a.cpp", "f"), "d");
+    if (logger.is_time_sorted()) return false;
+    std::vector<logit::LogRecordSnapshot> range = logger.read_range(150, 250);
+    if (range.size() != 1 || range[0].message != "c") return false;
+
+    // Evicting "b" removes it, and time windows use binary search again.
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 500, "a.cpp", "f"), "e");
+    if (!logger.is_time_sorted()) return false;
+    range = logger.read_range(200, 450);
+    return range.size() == 2 && range[0].message == "c" && range[1].message == "d";
+}
+
+bool test_macros() {
+    LOGIT_ADD_MEMORY_LOGGER_SINGLE_MODE(0, 0, 0);
+    LOGIT_ERROR_TO(0, "macro-error");
+    LOGIT_INFO_TO(0, "macro-info");
+    LOGIT_WAIT();
+
+    logit::LogQuery errors;
+    errors.min_level = logit::LogLevel::LOG_LVL_ERROR;
+    const std::vector<logit::LogRecordSnapshot> found = LOGIT_QUERY_LOGS(0, errors);
+    return LOGIT_COUNT_LOGS(0, errors) == 1 && found.size() == 1 &&
+           found[0].message.find("macro-error") != std::string::npos;
+}
+} // namespace
+
+int main() {
+    logit::MemoryLogger logger(logit::MemoryLogger::Config{0, 0, 0});
+    fill(logger);
+
+    logit::MemoryLogger::Config ring_config(0, 0, 0);
+    ring_config.use_lock_free_ring = true;
+    ring_config.ring_arena_bytes = 64 * 1024;
+    logit::MemoryLogger ring_logger(ring_config);
+    fill(ring_logger);
+
+    logit::MemoryLogger::Config cold_config(0, 0, 0);
+    cold_config.cold_compress = logit::CompressType::GZIP;
+    cold_config.cold_hot_bytes = 64;
+    cold_config.cold_block_bytes = 128;
+    logit::MemoryLogger cold_logger(cold_config);
+    fill(cold_logger);
+
+    return test_filters(logger) && test_filters(ring_logger) && test_filters(cold_logger) &&
+           test_unsorted_timestamps() && test_evicted_inversion() && test_macros() ? 0 : 1;
+}
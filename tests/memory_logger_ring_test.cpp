@@ -0,0 +1,161 @@
+#include <atomic>
+
+namespace {
+std::atomic<long long> g_now_ms(0);
+
+long long test_now_ms() {
+    return g_now_ms.load();
+}
+} // namespace
+
+#define LOGIT_CURRENT_TIMESTAMP_MS() test_now_ms()
+
+#include <logit.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+logit::LogRecord make_record(logit::LogLevel level, int64_t ts, int line, const std::string& function) {
+    return logit::LogRecord(level, ts, "memory_logger_ring_test.cpp", line, function, "", "", -1, false);
+}
+
+logit::MemoryLogger::Config make_ring_config(std::size_t max_records, std::size_t max_bytes, int64_t max_age_ms) {
+    logit::MemoryLogger::Config config(max_records, max_bytes, max_age_ms);
+    config.use_lock_free_ring = true;
+    return config;
+}
+
+bool test_retention_limits() {
+    logit::MemoryLogger logger(make_ring_config(3, 10, 50));
+
+    g_now_ms = 100;
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 100, 10, "first"), "12345");
+    g_now_ms = 130;
+    logger.log(make_record(logit::LogLevel::LOG_LVL_WARN, 130, 20, "second"), "6789");
+    g_now_ms = 140;
+    logger.log(make_record(logit::LogLevel::LOG_LVL_ERROR, 140, 30, "third"), "abcdef");
+
+    const auto entries = logger.get_buffered_entries();
+    if (entries.size() != 2 ||
+        entries[0].level != logit::LogLevel::LOG_LVL_WARN ||
+        entries[0].timestamp_ms != 130 ||
+        entries[0].line != 20 ||
+        entries[0].function != "second" ||
+        entries[0].file != "memory_logger_ring_test.cpp" ||
+        entries[0].message != "6789" ||
+        entries[1].message != "abcdef") {
+        return false;
+    }
+
+    g_now_ms = 160;
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 160, 40, "fourth"), "xy");
+    const auto strings = logger.get_buffered_strings();
+    if (strings.size() != 2 || strings[0] != "abcdef" || strings[1] != "xy") {
+        return false;
+    }
+
+    const auto recent = logger.read_recent(1);
+    if (recent.size() != 1 || recent[0].message != "xy") {
+        return false;
+    }
+    const auto range = logger.read_range(140, 150);
+    if (range.size() != 1 || range[0].function != "third") {
+        return false;
+    }
+
+    g_now_ms = 211;
+    if (!logger.get_buffered_strings().empty()) {
+        return false;
+    }
+
+    g_now_ms = 300;
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 300, 50, "fifth"), "ab");
+    logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 300, 51, "sixth"), "cd");
+    const logit::LogClearResult cleared = logger.clear_logs();
+    if (!cleared.ok || cleared.cleared_records != 2 || !logger.get_buffered_entries().empty()) {
+        return false;
+    }
+
+    logit::MemoryLogger::Config oversized_config = make_ring_config(10, 4, 0);
+    logit::MemoryLogger oversized(oversized_config);
+    int published = 0;
+    oversized.add_log_callback([&published](const logit::LogRecordSnapshot&) { ++published; });
+    oversized.log(make_record(logit::LogLevel::LOG_LVL_INFO, 700, 70, "big"), "12345");
+    // Larger than max_bytes: refused, counted and not reported as written.
+    if (!oversized.get_buffered_strings().empty() ||
+        published != 0 ||
+        oversized.dropped_count() != 1 ||
+        oversized.get_int_param(logit::LoggerParam::DroppedLogCount) != 1 ||
+        oversized.get_int_param(logit::LoggerParam::LastLogTimestamp) != 0) {
+        return false;
+    }
+    oversized.log(make_record(logit::LogLevel::LOG_LVL_INFO, 710, 71, "fits"), "1234");
+    const auto fitted = oversized.get_buffered_strings();
+    return fitted.size() == 1 && fitted[0] == "1234" && published == 1 &&
+           oversized.dropped_count() == 1 && oversized.get_int_param(logit::LoggerParam::LastLogTimestamp) == 710;
+}
+
+bool test_arena_wrap_and_concurrency() {
+    const int thread_count = 4;
+    const int per_thread = 5000;
+    logit::MemoryLogger::Config config = make_ring_config(256, 0, 0);
+    config.ring_arena_bytes = 8 * 1024;
+    logit::MemoryLogger logger(config);
+    g_now_ms = 1000;
+
+    std::atomic<bool> is_done(false);
+    std::atomic<bool> is_torn(false);
+    std::thread reader([&]() {
+        while (!is_done.load()) {
+            const auto entries = logger.get_buffered_entries();
+            for (size_t i = 0; i < entries.size(); ++i) {
+                // Function and message are written from the same thread id;
+                // a torn copy would mix them.
+                if (entries[i].message.compare(0, entries[i].function.size(), entries[i].function) != 0) {
+                    is_torn = true;
+                }
+            }
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < thread_count; ++t) {
+        writers.push_back(std::thread([&logger, t]() {
+            const std::string function = "writer" + std::to_string(t);
+            for (int i = 0; i < per_thread; ++i) {
+                logger.log(make_record(logit::LogLevel::LOG_LVL_INFO, 1000, i, function),
+                           function + "-message-" + std::to_string(i));
+            }
+        }));
+    }
+    for (size_t i = 0; i < writers.size(); ++i) {
+        writers[i].join();
+    }
+    is_done = true;
+    reader.join();
+    if (is_torn.load()) {
+        return false;
+    }
+
+    const auto entries = logger.get_buffered_entries();
+    if (entries.empty() || entries.size() > 256) {
+        return false;
+    }
+    std::vector<int> last_line(thread_count, -1);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const int t = entries[i].function[entries[i].function.size() - 1] - '0';
+        if (entries[i].message != entries[i].function + "-message-" + std::to_string(entries[i].line) ||
+            entries[i].line <= last_line[t]) {
+            return false;
+        }
+        last_line[t] = entries[i].line;
+    }
+    return true;
+}
+} // namespace
+
+int main() {
+    return test_retention_limits() && test_arena_wrap_and_concurrency() ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+#include <logit.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+logit::LogRecord make_record(int64_t ts, int line) {
+    return logit::LogRecord(logit::LogLevel::LOG_LVL_INFO, ts, "memory_logger_view_test.cpp", line,
+                            "producer", "", "", -1, false);
+}
+
+bool test_visit_while_evicting() {
+    logit::MemoryLogger logger(logit::MemoryLogger::Config{300, 0, 0});
+    for (int i = 0; i < 300; ++i) {
+        logger.log(make_record(1000 + i, i), "msg-" + std::to_string(i));
+    }
+
+    // The visitor logs to the same backend; every pinned record is evicted
+    // during the visit, yet its views must stay intact.
+    int next = 0;
+    bool is_intact = true;
+    logger.for_each_entry(1000, 1300, [&](const logit::LogEntryView& entry) {
+        logger.log(make_record(5000 + next, next), "new-" + std::to_string(next));
+        is_intact = is_intact &&
+                    entry.timestamp_ms == 1000 + next &&
+                    entry.line == next &&
+                    entry.function == "producer" &&
+                    entry.message == "msg-" + std::to_string(next);
+        ++next;
+        return true;
+    });
+    if (!is_intact || next != 300) {
+        return false;
+    }
+
+    const std::vector<logit::BufferedLogEntry> entries = logger.get_buffered_entries();
+    return entries.size() == 300 && entries.front().message == "new-0" && entries.back().message == "new-299";
+}
+
+bool test_range_and_stop() {
+    logit::MemoryLogger logger(logit::MemoryLogger::Config{0, 0, 0});
+    for (int i = 0; i < 1000; ++i) {
+        logger.log(make_record(1000 + i, i), "msg-" + std::to_string(i));
+    }
+    std::vector<int> lines;
+    logger.for_each_entry(1500, 1600, [&lines](const logit::LogEntryView& entry) {
+        lines.push_back(entry.line);
+        return lines.size() < 10;
+    });
+    return lines.size() == 10 && lines.front() == 500 && lines.back() == 509;
+}
+
+bool test_concurrent_readers() {
+    logit::MemoryLogger logger(logit::MemoryLogger::Config{1000, 0, 0});
+    std::atomic<bool> is_done(false);
+    std::atomic<bool> is_torn(false);
+    std::thread reader([&]() {
+        while (!is_done.load()) {
+            logger.for_each_query(logit::LogQuery(), [&is_torn](const logit::LogEntryView& entry) {
+                if (entry.message != "msg-" + std::to_string(entry.line)) {
+                    is_torn = true;
+                }
+                return true;
+            });
+        }
+    });
+    for (int i = 0; i < 20000; ++i) {
+        logger.log(make_record(1000 + i, i), "msg-" + std::to_string(i));
+    }
+    is_done = true;
+    reader.join();
+    return !is_torn.load() && logger.get_buffered_entries().size() == 1000;
+}
+} // namespace
+
+int main() {
+    return test_visit_while_evicting() &&
+           test_range_and_stop() &&
+           test_concurrent_readers() ? 0 : 1;
+}
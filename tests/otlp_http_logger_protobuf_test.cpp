@@ -0,0 +1,202 @@
+#include <logit.hpp>
+
+#if defined(LOGIT_WITH_OTLP)
+
+#include <server_http.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using HttpServer = SimpleWeb::Server<SimpleWeb::HTTP>;
+
+namespace {
+
+struct RequestCapture {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::atomic<int> count{0};
+    std::vector<std::string> bodies;
+    std::vector<std::string> content_types;
+    std::vector<std::string> content_encodings;
+};
+
+bool wait_for_server(unsigned short port) {
+    for (int i = 0; i < 50; ++i) {
+        try {
+            kurlyk::HttpClient client("http://127.0.0.1:" + std::to_string(port));
+            client.set_timeout(1);
+            auto future = client.get("/health", {}, {});
+            if (future.wait_for(std::chrono::seconds(2)) == std::future_status::ready) {
+                auto response = future.get();
+                if (response && response->status_code == 200) {
+                    return true;
+                }
+            }
+        } catch (...) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    return false;
+}
+
+void start_server(HttpServer& server, std::thread& thread, RequestCapture& capture, unsigned short port) {
+    server.config.port = port;
+
+    server.resource["^/health$"]["GET"] = [](std::shared_ptr<HttpServer::Response> response,
+                                              std::shared_ptr<HttpServer::Request>) {
+        response->write(SimpleWeb::StatusCode::success_ok, "ok");
+    };
+
+    // Stand-in collector: records each export and accepts it.
+    server.resource["^/v1/logs$"]["POST"] = [&capture](std::shared_ptr<HttpServer::Response> response,
+                                                         std::shared_ptr<HttpServer::Request> request) {
+        {
+            std::lock_guard<std::mutex> lock(capture.mutex);
+            capture.bodies.push_back(request->content.string());
+
+            auto type = request->header.find("Content-Type");
+            capture.content_types.push_back(type != request->header.end() ? type->second : std::string());
+
+            auto encoding = request->header.find("Content-Encoding");
+            capture.content_encodings.push_back(encoding != request->header.end() ? encoding->second : std::string());
+
+            capture.count.fetch_add(1);
+        }
+        capture.cv.notify_all();
+
+        response->write(SimpleWeb::StatusCode::success_ok, "");
+    };
+
+    thread = std::thread([&server]() {
+        server.start();
+    });
+
+    assert(wait_for_server(port));
+}
+
+void stop_server(HttpServer& server, std::thread& thread) {
+    server.stop();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void log_messages(logit::OtlpHttpLogger& logger, int count, const std::string& text) {
+    for (int i = 0; i < count; ++i) {
+        logit::LogRecord record(
+            logit::LogLevel::LOG_LVL_INFO, 1710000000123LL + i,
+            "test.cpp", 100 + i, "test_func", "protobuf test", "",
+            -1, false, false, false);
+        logger.log(record, text + std::to_string(i));
+    }
+}
+
+void wait_for_requests(RequestCapture& capture, int count) {
+    std::unique_lock<std::mutex> lock(capture.mutex);
+    capture.cv.wait_for(lock, std::chrono::seconds(3), [&capture, count]() {
+        return capture.count.load() >= count;
+    });
+}
+
+} // namespace
+
+int main() {
+    const unsigned short port = 43184;
+
+    RequestCapture capture;
+    HttpServer server;
+    std::thread server_thread;
+    start_server(server, server_thread, capture, port);
+
+    logit::OtlpHttpLogger::Config config;
+    config.host = "http://127.0.0.1:" + std::to_string(port);
+    config.path = "/v1/logs";
+    config.format.service_name = "protobuf-test";
+    config.format.encoding = logit::OtlpEncoding::Protobuf;
+    config.max_batch_size = 256;
+    config.export_interval_ms = 50;
+    config.request_timeout_sec = 2;
+
+    // Plain protobuf: one ExportLogsServiceRequest with every record.
+    {
+        logit::OtlpHttpLogger logger(config);
+        log_messages(logger, 3, "protobuf message ");
+        logger.wait();
+        logger.shutdown();
+        assert(logger.failed_export_count() == 0);
+    }
+    wait_for_requests(capture, 1);
+
+    {
+        std::lock_guard<std::mutex> lock(capture.mutex);
+        assert(capture.count.load() >= 1);
+        for (std::size_t i = 0; i < capture.bodies.size(); ++i) {
+            const std::string& body = capture.bodies[i];
+            assert(capture.content_types[i] == "application/x-protobuf");
+            assert(capture.content_encodings[i].empty());
+            assert(!body.empty());
+            assert(static_cast<unsigned char>(body[0]) == 0x0A); // ExportLogsServiceRequest.resource_logs
+            assert(body.find("protobuf-test") != std::string::npos);
+            assert(body.find("resourceLogs") == std::string::npos);
+        }
+        std::string all;
+        for (std::size_t i = 0; i < capture.bodies.size(); ++i) {
+            all += capture.bodies[i];
+        }
+        assert(all.find("protobuf message 0") != std::string::npos);
+        assert(all.find("protobuf message 2") != std::string::npos);
+        capture.bodies.clear();
+        capture.content_types.clear();
+        capture.content_encodings.clear();
+        capture.count.store(0);
+    }
+
+    // Chunking applies to protobuf: a small limit spreads one batch over several requests.
+    config.max_payload_bytes = 600;
+#if defined(LOGIT_HAS_ZLIB)
+    config.compression = logit::OtlpCompression::Gzip;
+#endif
+    {
+        logit::OtlpHttpLogger logger(config);
+        log_messages(logger, 20, "chunked protobuf message ");
+        logger.wait();
+        logger.shutdown();
+    }
+    wait_for_requests(capture, 2);
+
+    {
+        std::lock_guard<std::mutex> lock(capture.mutex);
+        assert(capture.count.load() >= 2);
+        for (std::size_t i = 0; i < capture.bodies.size(); ++i) {
+            const std::string& body = capture.bodies[i];
+            assert(capture.content_types[i] == "application/x-protobuf");
+#if defined(LOGIT_HAS_ZLIB)
+            assert(capture.content_encodings[i] == "gzip");
+            assert(body.size() >= 2);
+            assert(static_cast<unsigned char>(body[0]) == 0x1f);
+            assert(static_cast<unsigned char>(body[1]) == 0x8b);
+#else
+            assert(body.size() <= 600);
+#endif
+        }
+    }
+
+    stop_server(server, server_thread);
+
+    return 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif
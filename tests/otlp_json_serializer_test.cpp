@@ -1,9 +1,39 @@
 #include <logit/loggers/otlp/OtlpJsonSerializer.hpp>
 #include <cassert>
+#include <clocale>
+#include <locale>
 #include <string>
 #include <vector>
 
+namespace {
+struct CommaDecimal : std::numpunct<char> {
+    char do_decimal_point() const override { return ','; }
+};
+
+std::string double_attr(double value) {
+    std::string out;
+    logit::otlp_write_double_attr(out, "px", value);
+    return out;
+}
+
+void check_double_attrs_ignore_locale() {
+    // A comma decimal separator must not leak into JSON numbers.
+    const std::locale previous = std::locale::global(std::locale(std::locale::classic(), new CommaDecimal));
+    std::setlocale(LC_NUMERIC, "de_DE.UTF-8");
+
+    assert(double_attr(3.14) == "{\"key\":\"px\",\"value\":{\"doubleValue\":3.14}}");
+    assert(double_attr(0.1).find("\"doubleValue\":0.1}") != std::string::npos);
+    assert(double_attr(-2.5e-300).find("\"doubleValue\":-2.5e-300}") != std::string::npos);
+    assert(double_attr(0.30000000000000004).find("\"doubleValue\":0.30000000000000004}") != std::string::npos);
+
+    std::setlocale(LC_NUMERIC, "C");
+    std::locale::global(previous);
+}
+} // namespace
+
 int main() {
+    check_double_attrs_ignore_locale();
+
     logit::OtlpJsonFormatConfig config;
     config.include_arg_names = true;
     config.service_name = "trade-bot";
@@ -102,6 +102,36 @@ int main() {
         assert(chunks[0].find("\"resourceLogs\"") != std::string::npos);
     }
 
+    // Test e: 256 records => every chunk equals the payload of its records and
+    //         is cut only where the next record would not fit
+    {
+        std::vector<logit::OtlpLogItem> batch;
+        for (int i = 0; i < 256; ++i) {
+            batch.push_back(make_item("linear-split-" + std::string(static_cast<std::size_t>(i % 37), 'q') + "\"\n"));
+        }
+
+        const std::size_t limit = 4096;
+        auto chunks = logit::build_otlp_logs_json_payload_chunks(batch, config, limit);
+        assert(chunks.size() > 1);
+
+        std::size_t next = 0;
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            std::vector<logit::OtlpLogItem> expected;
+            while (next < batch.size()) {
+                expected.push_back(batch[next]);
+                if (logit::build_otlp_logs_json_payload(expected, config).size() > limit) {
+                    expected.pop_back();
+                    break;
+                }
+                ++next;
+            }
+            assert(!expected.empty());
+            assert(chunks[c] == logit::build_otlp_logs_json_payload(expected, config));
+            assert(chunks[c].size() <= limit);
+        }
+        assert(next == batch.size());
+    }
+
     return 0;
 }
 
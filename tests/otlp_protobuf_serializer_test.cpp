@@ -0,0 +1,235 @@
+#include <logit/utils.hpp>
+
+#ifdef LOGIT_WITH_OTLP
+
+#include <logit/loggers/otlp/OtlpPayloadSplitter.hpp>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Decoded protobuf field: varint/fixed64 value or length-delimited bytes.
+struct Field {
+    uint32_t number = 0;
+    uint32_t wire_type = 0;
+    uint64_t value = 0;
+    std::string bytes;
+};
+
+uint64_t read_varint(const std::string& data, std::size_t& pos) {
+    uint64_t value = 0;
+    int shift = 0;
+    while (true) {
+        assert(pos < data.size());
+        const unsigned char byte = static_cast<unsigned char>(data[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+        if ((byte & 0x80u) == 0) {
+            return value;
+        }
+        shift += 7;
+        assert(shift < 64);
+    }
+}
+
+std::vector<Field> decode(const std::string& data) {
+    std::vector<Field> fields;
+    std::size_t pos = 0;
+    while (pos < data.size()) {
+        const uint64_t tag = read_varint(data, pos);
+        Field field;
+        field.number = static_cast<uint32_t>(tag >> 3);
+        field.wire_type = static_cast<uint32_t>(tag & 7u);
+        if (field.wire_type == 0) {
+            field.value = read_varint(data, pos);
+        } else if (field.wire_type == 1) {
+            assert(pos + 8 <= data.size());
+            for (int i = 0; i < 8; ++i) {
+                field.value |= static_cast<uint64_t>(static_cast<unsigned char>(data[pos + i])) << (8 * i);
+            }
+            pos += 8;
+        } else {
+            assert(field.wire_type == 2);
+            const uint64_t length = read_varint(data, pos);
+            assert(pos + length <= data.size());
+            field.bytes = data.substr(pos, static_cast<std::size_t>(length));
+            pos += static_cast<std::size_t>(length);
+        }
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+std::vector<Field> fields_of(const std::vector<Field>& fields, uint32_t number) {
+    std::vector<Field> out;
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].number == number) {
+            out.push_back(fields[i]);
+        }
+    }
+    return out;
+}
+
+const Field& single(const std::vector<Field>& fields, uint32_t number) {
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].number == number) {
+            return fields[i];
+        }
+    }
+    assert(false && "missing field");
+    return fields[0];
+}
+
+/// Finds attribute `key` in repeated KeyValue fields and returns its decoded AnyValue.
+std::vector<Field> find_attribute(const std::vector<Field>& key_values, const std::string& key) {
+    for (std::size_t i = 0; i < key_values.size(); ++i) {
+        const std::vector<Field> kv = decode(key_values[i].bytes);
+        if (single(kv, 1).bytes == key) {
+            return decode(single(kv, 2).bytes);
+        }
+    }
+    assert(false && "missing attribute");
+    return std::vector<Field>();
+}
+
+/// Returns the LogRecord messages of a payload.
+std::vector<Field> log_records(const std::string& payload) {
+    const std::vector<Field> request = decode(payload);
+    assert(request.size() == 1 && request[0].number == 1);
+    const std::vector<Field> resource_logs = decode(request[0].bytes);
+    const std::vector<Field> scope_logs = decode(single(resource_logs, 2).bytes);
+    return fields_of(scope_logs, 2);
+}
+
+logit::OtlpLogItem make_item(const std::string& message) {
+    logit::OtlpLogItem item;
+    item.record.log_level = logit::LogLevel::LOG_LVL_WARN;
+    item.record.timestamp_ms = 1710000000123LL;
+    item.record.file = "src/main.cpp";
+    item.record.line = 42;
+    item.record.function = "main";
+    item.record.format = "%v";
+    item.record.thread_id = "t1";
+    item.record.logger_index = -1;
+    item.record.print_mode = false;
+    item.record.fmt_mode = false;
+    item.record.raw_mode = false;
+    item.message = message;
+    return item;
+}
+
+} // namespace
+
+int main() {
+    logit::OtlpJsonFormatConfig config;
+    config.encoding = logit::OtlpEncoding::Protobuf;
+    config.service_name = "proto-test";
+    config.service_namespace = "tests";
+
+    // Test a: envelope, record fields and typed attributes decode as OTLP
+    {
+        logit::OtlpLogItem item = make_item("hello \"proto\"\n");
+        item.record.args_array.push_back(logit::VariableValue("px", 3.14));
+        item.record.args_array.push_back(logit::VariableValue("vol", 100));
+        item.record.args_array.push_back(logit::VariableValue("ok", true));
+        item.record.args_array.push_back(logit::VariableValue("big", 18446744073709551615ULL));
+        std::vector<logit::OtlpLogItem> batch(1, item);
+
+        const std::string payload = logit::build_otlp_logs_protobuf_payload(batch, config);
+        const std::vector<Field> request = decode(payload);
+        const std::vector<Field> resource_logs = decode(request[0].bytes);
+        const std::vector<Field> resource = decode(single(resource_logs, 1).bytes);
+        const std::vector<Field> resource_attrs = fields_of(resource, 1);
+        assert(resource_attrs.size() == 2);
+        assert(single(find_attribute(resource_attrs, "service.name"), 1).bytes == "proto-test");
+        assert(single(find_attribute(resource_attrs, "service.namespace"), 1).bytes == "tests");
+
+        const std::vector<Field> scope_logs = decode(single(resource_logs, 2).bytes);
+        const std::vector<Field> scope = decode(single(scope_logs, 1).bytes);
+        assert(single(scope, 1).bytes == "logit-cpp");
+
+        const std::vector<Field> records = log_records(payload);
+        assert(records.size() == 1);
+        const std::vector<Field> record = decode(records[0].bytes);
+        assert(single(record, 1).wire_type == 1);
+        assert(single(record, 1).value == 1710000000123000000ULL);
+        assert(single(record, 2).value == 13);
+        assert(single(record, 3).bytes == "WARN");
+        assert(single(decode(single(record, 5).bytes), 1).bytes == "hello \"proto\"\n");
+
+        const std::vector<Field> attrs = fields_of(record, 6);
+        assert(single(find_attribute(attrs, "code.file.path"), 1).bytes == "src/main.cpp");
+        assert(single(find_attribute(attrs, "code.line.number"), 3).value == 42);
+        assert(static_cast<int64_t>(single(find_attribute(attrs, "logit.logger_index"), 3).value) == -1);
+        assert(single(find_attribute(attrs, "logit.arg.ok"), 2).value == 1);
+        assert(single(find_attribute(attrs, "logit.arg.vol"), 3).value == 100);
+        assert(single(find_attribute(attrs, "logit.arg.big"), 1).bytes == "18446744073709551615");
+        const uint64_t px_bits = single(find_attribute(attrs, "logit.arg.px"), 4).value;
+        double px = 0.0;
+        std::memcpy(&px, &px_bits, sizeof(px));
+        assert(px == 3.14);
+
+        // The JSON form of the same batch carries more bytes.
+        config.encoding = logit::OtlpEncoding::Json;
+        assert(logit::build_otlp_logs_payload_chunks(batch, config, 0)[0].size() > payload.size());
+        config.encoding = logit::OtlpEncoding::Protobuf;
+        assert(logit::build_otlp_logs_payload_chunks(batch, config, 0)[0] == payload);
+        assert(std::string(logit::otlp_content_type(config.encoding)) == "application/x-protobuf");
+    }
+
+    // Test b: 256 records split greedily, every chunk within the limit
+    {
+        std::vector<logit::OtlpLogItem> batch;
+        for (int i = 0; i < 256; ++i) {
+            batch.push_back(make_item("chunked-" + std::to_string(i) + std::string(static_cast<std::size_t>(i % 53), 'z')));
+        }
+
+        const std::size_t limit = 2048;
+        auto chunks = logit::build_otlp_logs_protobuf_payload_chunks(batch, config, limit);
+        assert(chunks.size() > 1);
+
+        std::size_t next = 0;
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            std::vector<logit::OtlpLogItem> expected;
+            while (next < batch.size()) {
+                expected.push_back(batch[next]);
+                if (logit::build_otlp_logs_protobuf_payload(expected, config).size() > limit) {
+                    expected.pop_back();
+                    break;
+                }
+                ++next;
+            }
+            assert(!expected.empty());
+            assert(chunks[c] == logit::build_otlp_logs_protobuf_payload(expected, config));
+            assert(chunks[c].size() <= limit);
+            assert(log_records(chunks[c]).size() == expected.size());
+        }
+        assert(next == batch.size());
+    }
+
+    // Test c: empty batch => no chunks; oversized record => chunk of one
+    {
+        std::vector<logit::OtlpLogItem> batch;
+        assert(logit::build_otlp_logs_protobuf_payload_chunks(batch, config, 1024).empty());
+
+        batch.push_back(make_item(std::string(5000, 'X')));
+        batch.push_back(make_item("small"));
+        auto chunks = logit::build_otlp_logs_protobuf_payload_chunks(batch, config, 1024);
+        assert(chunks.size() == 2);
+        assert(chunks[0].size() > 1024);
+        assert(log_records(chunks[0]).size() == 1);
+        assert(log_records(chunks[1]).size() == 1);
+    }
+
+    return 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif
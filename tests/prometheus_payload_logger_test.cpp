@@ -1,4 +1,4 @@
-#include <logit/utils.hpp>
+#include <logit.hpp>
 #include <logit/loggers/PrometheusPayloadLogger.hpp>
 #include <logit/loggers/prometheus/PrometheusMetricBuilders.hpp>
 
@@ -7,6 +7,7 @@
 #include <cassert>
 #include <chrono>
 #include <cstdint>
+#include <cstdlib>
 #include <memory>
 #include <string>
 #include <vector>
@@ -207,6 +208,33 @@ int main() {
         logger->shutdown();
     }
 
+#if !defined(__EMSCRIPTEN__)
+    // Test 9: FileLogger publishes its compression backlog through a registry
+    {
+        logit::FileLogger::Config file_config;
+        file_config.directory = "prometheus_backlog_logs";
+        file_config.compress = logit::CompressType::GZIP;
+        logit::FileLogger file_logger(file_config);
+
+        logit::PrometheusRegistry registry;
+        file_logger.register_prometheus_metrics(registry, "archive");
+
+        logit::PrometheusPayloadLogger::Config config;
+        config.on_collect = [&registry](std::vector<logit::PrometheusMetricFamily>& families) {
+            registry.collect(families);
+        };
+        auto logger = std::unique_ptr<logit::PrometheusPayloadLogger>(new logit::PrometheusPayloadLogger(config));
+
+        std::string payload = logger->collect_payload();
+        assert(payload.find("# TYPE logit_compression_backlog gauge") != std::string::npos);
+        assert(payload.find("logit_compression_backlog{logger=\"archive\"} 0") != std::string::npos);
+
+        logger->shutdown();
+        file_logger.shutdown();
+        std::system("rm -rf prometheus_backlog_logs");
+    }
+#endif
+
     return 0;
 }
 
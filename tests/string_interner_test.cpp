@@ -0,0 +1,114 @@
+#include <logit.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+bool test_dedup_and_ids() {
+    logit::detail::StringInterner interner;
+    const logit::detail::InternedString* empty = interner.empty();
+    if (!empty || empty->id != 0 || !empty->value.empty()) {
+        return false;
+    }
+
+    const std::string name = "src/very/long/path/to/some_source_file.cpp";
+    const logit::detail::InternedString* first = interner.intern(name);
+    const logit::detail::InternedString* second = interner.intern(std::string(name));
+    const logit::detail::InternedString* other = interner.intern("main", 4);
+    if (first != second || first == other || first->value != name || other->value != "main") {
+        return false;
+    }
+    if (interner.find(first->id) != first || interner.find(other->id) != other ||
+        interner.find(1000000) != nullptr || interner.intern("", 0) != empty) {
+        return false;
+    }
+    return interner.size() == 3;
+}
+
+bool test_concurrent_growth() {
+    logit::detail::StringInterner interner;
+    const int thread_count = 4;
+    const int name_count = 5000;
+    std::vector<std::vector<const logit::detail::InternedString*> > results(thread_count);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&interner, &results, t, name_count]() {
+            results[t].resize(name_count);
+            for (int i = 0; i < name_count; ++i) {
+                const int index = (i * 7 + t * 131) % name_count;
+                results[t][index] = interner.intern("function_" + std::to_string(index));
+            }
+        });
+    }
+    for (size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+
+    if (interner.size() != static_cast<std::size_t>(name_count) + 1) {
+        return false;
+    }
+    for (int i = 0; i < name_count; ++i) {
+        const logit::detail::InternedString* entry = results[0][i];
+        if (entry->value != "function_" + std::to_string(i) || interner.find(entry->id) != entry) {
+            return false;
+        }
+        for (int t = 1; t < thread_count; ++t) {
+            if (results[t][i] != entry) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool test_handles() {
+    logit::detail::InternedStringRef empty;
+    logit::detail::InternedStringRef file = "handle_test.cpp";
+    logit::detail::InternedStringRef same(std::string("handle_test.cpp"));
+    const std::string& text = file;
+    if (!empty.empty() || empty.id() != 0 || file != same || file == empty ||
+        text != "handle_test.cpp" || file.str().size() != 15) {
+        return false;
+    }
+
+    logit::detail::InternedStringRef copy;
+    copy = same;
+    const logit::detail::InternedStringRef by_id(
+        logit::detail::StringInterner::instance().find(file.id()));
+    return copy == file && by_id == file &&
+           logit::detail::InternedStringRef(static_cast<const logit::detail::InternedString*>(nullptr)) == empty;
+}
+
+bool test_memory_logger_entries() {
+    logit::MemoryLogger logger(logit::MemoryLogger::Config{0, 0, 0});
+    for (int i = 0; i < 3; ++i) {
+        logger.log(logit::LogRecord(logit::LogLevel::LOG_LVL_INFO, 100 + i, "interned.cpp", 10 + i, "worker",
+                                    "", "", -1, false),
+                   "msg-" + std::to_string(i));
+    }
+    const std::vector<logit::BufferedLogEntry> entries = logger.get_buffered_entries();
+    if (entries.size() != 3 || entries[2].file != "interned.cpp" || entries[2].function != "worker" ||
+        entries[2].line != 12 || entries[2].message != "msg-2") {
+        return false;
+    }
+
+    const std::string* file = nullptr;
+    bool is_shared = true;
+    logger.for_each_query(logit::LogQuery(), [&file, &is_shared](const logit::LogEntryView& entry) {
+        if (file && file != &entry.file) {
+            is_shared = false;
+        }
+        file = &entry.file;
+        return true;
+    });
+    return is_shared && file != nullptr;
+}
+} // namespace
+
+int main() {
+    return test_dedup_and_ids() &&
+           test_concurrent_growth() &&
+           test_handles() &&
+           test_memory_logger_entries() ? 0 : 1;
+}
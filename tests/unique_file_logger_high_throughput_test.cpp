@@ -0,0 +1,209 @@
+#include <logit.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string make_unique_directory_name(const std::string& prefix) {
+    const long long stamp = static_cast<long long>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+    return prefix + "_" + std::to_string(stamp);
+}
+
+logit::LogRecord make_record(int64_t ts) {
+    return logit::LogRecord(
+        logit::LogLevel::LOG_LVL_INFO, ts, __FILE__, __LINE__, "main", "", "", -1, false);
+}
+
+bool file_exists(const std::string& path) {
+    std::ifstream in(path.c_str(), std::ios_base::binary);
+    return in.is_open();
+}
+
+std::string write_expired_file(const std::string& directory) {
+    const std::string path = logit::get_exec_dir() + "/" + directory + "/2000-01-01_00-00-00-000-expired.log";
+    std::ofstream out(path.c_str(), std::ios_base::binary);
+    out << "expired";
+    return path;
+}
+
+bool test_batched_async_writes() {
+    logit::UniqueFileLogger::Config cfg;
+    cfg.directory = make_unique_directory_name("unique_high_throughput_logs");
+    cfg.async = true;
+    cfg.use_dedicated_executor = true;
+    cfg.high_throughput = true;
+    cfg.name_block_size = 4;
+    cfg.retention_sweep_interval_ms = 3600 * 1000;
+    logit::UniqueFileLogger logger(cfg);
+
+    const std::string expired_path = write_expired_file(cfg.directory);
+    const int64_t ts = LOGIT_CURRENT_TIMESTAMP_MS();
+    const int per_thread = 25;
+    std::thread worker([&]() {
+        for (int i = 0; i < per_thread; ++i) {
+            logger.log(make_record(ts), "worker-" + std::to_string(i));
+        }
+    });
+    for (int i = 0; i < per_thread; ++i) {
+        logger.log(make_record(ts), "main-" + std::to_string(i));
+    }
+    worker.join();
+
+    const std::string last_name = logger.get_string_param(logit::LoggerParam::LastFileName);
+    if (!logger.sync_files()) {
+        std::cerr << "sync_files failed" << std::endl;
+        return false;
+    }
+
+    const std::vector<logit::LogFileInfo> files = logger.list_log_files();
+    std::set<std::string> names;
+    std::set<std::string> contents;
+    bool has_last_name = false;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (files[i].path == expired_path) continue;
+        names.insert(files[i].name);
+        const logit::LogFileReadResult read = logger.read_log_file(files[i].path);
+        if (!read.ok) return false;
+        contents.insert(read.content);
+        if (files[i].name == last_name) has_last_name = true;
+    }
+    if (names.size() != 2 * per_thread || contents.size() != 2 * per_thread) {
+        std::cerr << "unexpected file count: " << names.size() << std::endl;
+        return false;
+    }
+    if (contents.count("main-0") == 0 || contents.count("worker-24") == 0 || !has_last_name) {
+        std::cerr << "missing content or last file name" << std::endl;
+        return false;
+    }
+    // Retention runs only from the periodic sweep, not after every record.
+    if (!file_exists(expired_path)) {
+        std::cerr << "expired file removed before the sweep interval" << std::endl;
+        return false;
+    }
+    logger.clear_logs();
+    logger.shutdown();
+    return true;
+}
+
+bool test_sync_mode_sweep() {
+    logit::UniqueFileLogger::Config cfg;
+    cfg.directory = make_unique_directory_name("unique_high_throughput_sync_logs");
+    cfg.async = false;
+    cfg.high_throughput = true;
+    cfg.retention_sweep_interval_ms = 0;
+    logit::UniqueFileLogger logger(cfg);
+
+    logger.log(make_record(LOGIT_CURRENT_TIMESTAMP_MS()), "sync-first");
+    const std::string expired_path = write_expired_file(cfg.directory);
+    logger.log(make_record(LOGIT_CURRENT_TIMESTAMP_MS()), "sync-record");
+    const std::string path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    const logit::LogFileReadResult read = logger.read_log_file(path);
+    if (!read.ok || read.content != "sync-record") {
+        std::cerr << "sync record not readable" << std::endl;
+        return false;
+    }
+    if (file_exists(expired_path)) {
+        std::cerr << "expired file survived the sweep" << std::endl;
+        return false;
+    }
+    logger.clear_logs();
+    return true;
+}
+
+/// The sweep thread expires files while no records arrive.
+bool test_idle_sweep() {
+    logit::UniqueFileLogger::Config cfg;
+    cfg.directory = make_unique_directory_name("unique_high_throughput_idle_logs");
+    cfg.async = true;
+    cfg.high_throughput = true;
+    cfg.retention_sweep_interval_ms = 20;
+    logit::UniqueFileLogger logger(cfg);
+
+    const std::string expired_path = write_expired_file(cfg.directory);
+    for (int i = 0; i < 200 && file_exists(expired_path); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (file_exists(expired_path)) {
+        std::cerr << "idle logger did not sweep" << std::endl;
+        return false;
+    }
+    logger.shutdown();
+    return true;
+}
+
+/// Logs a record while the shared executor is stalled with a full queue, so its drain task is dropped.
+bool log_with_dropped_drain(logit::UniqueFileLogger& logger, const std::string& message) {
+    logit::detail::TaskExecutor& executor = logit::detail::TaskExecutor::get_instance();
+    executor.set_max_queue_size(2);
+    executor.set_queue_policy(logit::detail::QueuePolicy::DropNewest);
+    std::promise<void> release;
+    std::shared_future<void> released(release.get_future());
+    executor.add_task([released]() { released.wait(); });
+    const std::size_t dropped = executor.dropped_tasks();
+    for (int i = 0; i < 64 && executor.dropped_tasks() == dropped; ++i) {
+        executor.add_task([]() {});
+    }
+    const std::size_t full = executor.dropped_tasks();
+
+    logger.log(make_record(LOGIT_CURRENT_TIMESTAMP_MS()), message);
+    const bool is_dropped = executor.dropped_tasks() > full;
+    release.set_value();
+    executor.wait();
+    executor.set_queue_policy(logit::detail::QueuePolicy::Block);
+    executor.set_max_queue_size(0);
+    if (!is_dropped) {
+        std::cerr << "drain task was not dropped" << std::endl;
+    }
+    return is_dropped;
+}
+
+/// A drain task dropped by a full shared queue must not strand the batch.
+bool test_dropped_drain_task() {
+    logit::UniqueFileLogger::Config cfg;
+    cfg.directory = make_unique_directory_name("unique_high_throughput_drop_logs");
+    cfg.async = true;
+    cfg.high_throughput = true;
+    cfg.name_block_size = 1000; // no spare wakeups during the test
+    cfg.retention_sweep_interval_ms = 3600 * 1000;
+    logit::UniqueFileLogger logger(cfg);
+
+    if (!log_with_dropped_drain(logger, "dropped-drain")) return false;
+
+    // The next record schedules a new drain instead of waiting for the dropped one.
+    logger.log(make_record(LOGIT_CURRENT_TIMESTAMP_MS()), "after-drop");
+    const std::string last_path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    const logit::LogFileReadResult last = logger.read_log_file(last_path);
+    if (!last.ok || last.content != "after-drop" || logger.list_log_files().size() != 2) {
+        std::cerr << "records stranded after a dropped drain task" << std::endl;
+        return false;
+    }
+
+    // Without a further record, the getter schedules the replacement drain itself.
+    if (!log_with_dropped_drain(logger, "getter-drain")) return false;
+    const logit::LogFileReadResult waited =
+        logger.read_log_file(logger.get_string_param(logit::LoggerParam::LastFilePath));
+    if (!waited.ok || waited.content != "getter-drain") {
+        std::cerr << "getter did not replace the dropped drain task" << std::endl;
+        return false;
+    }
+    logger.clear_logs();
+    logger.shutdown();
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const bool ok = test_batched_async_writes() && test_sync_mode_sweep() && test_idle_sweep() &&
+                    test_dropped_drain_task();
+    std::cout << (ok ? "PASS" : "FAIL") << ": unique_file_logger_high_throughput" << std::endl;
+    return ok ? 0 : 1;
+}